@@ -135,6 +135,7 @@ SOURCES += src/main.cpp \
     src/network/NetworkManager.cpp \
     src/scrapers/ScraperError.cpp \
     src/scrapers/ScraperUtils.cpp \
+    src/scrapers/MultiScrapeQueue.cpp \
     src/scrapers/imdb/ImdbReferencePage.cpp \
     src/scrapers/music/AllMusic.cpp \
     src/scrapers/music/Discogs.cpp \
@@ -153,10 +154,13 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertProxyModel.cpp \
     src/data/Database.cpp \
     src/data/ImageCache.cpp \
+    src/data/ImportCacheIndex.cpp \
     src/data/ResumeTime.cpp \
     src/movies/Movie.cpp \
     src/movies/file_searcher/MovieFileSearcher.cpp \
     src/movies/file_searcher/MovieDirectorySearcher.cpp \
+    src/movies/file_searcher/ParallelDirectoryWalker.cpp \
+    src/movies/MovieDuplicateFinder.cpp \
     src/movies/MovieFilesOrganizer.cpp \
     src/movies/MovieImages.cpp \
     src/movies/MovieModel.cpp \
@@ -165,6 +169,8 @@ SOURCES += src/main.cpp \
     src/data/Rating.cpp \
     src/data/Storage.cpp \
     src/data/StreamDetails.cpp \
+    src/data/StreamDetailsCache.cpp \
+    src/data/StreamDetailsLoader.cpp \
     src/data/Subtitle.cpp \
     src/tv_shows/TvShow.cpp \
     src/tv_shows/TvShowEpisode.cpp \
@@ -177,11 +183,13 @@ SOURCES += src/main.cpp \
     src/ui/export/ExportDialog.cpp \
     src/ui/imports/UnpackButtons.cpp \
     src/imports/MakeMkvCon.cpp \
-    src/imports/MyFile.cpp \
+    src/imports/FileTransfer.cpp \
     src/imports/Extractor.cpp \
     src/imports/FileWorker.cpp \
     src/imports/DownloadFileSearcher.cpp \
     src/log/Log.cpp \
+    src/export/CompiledTemplate.cpp \
+    src/export/ExportImageQueue.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
     src/export/MediaExport.cpp \
@@ -193,9 +201,13 @@ SOURCES += src/main.cpp \
     src/globals/ComboDelegate.cpp \
     src/globals/DownloadManager.cpp \
     src/globals/DownloadManagerElement.cpp \
+    src/globals/DownloadSlots.cpp \
     src/globals/Filter.cpp \
+    src/globals/FilterIndex.cpp \
     src/globals/Globals.cpp \
     src/globals/Helper.cpp \
+    src/globals/LibraryWatcher.cpp \
+    src/globals/LocaleSortKey.cpp \
     src/globals/ImageDialog.cpp \
     src/globals/ImagePreviewDialog.cpp \
     src/globals/Manager.cpp \
@@ -237,6 +249,7 @@ SOURCES += src/main.cpp \
     src/media_centers/kodi/EpisodeXmlReader.cpp \
     src/media_centers/kodi/MovieXmlReader.cpp \
     src/media_centers/kodi/MovieXmlWriter.cpp \
+    src/media_centers/kodi/StreamDetailsXmlReader.cpp \
     src/media_centers/kodi/TvShowXmlReader.cpp \
     src/media_centers/kodi/TvShowXmlWriter.cpp \
     src/media_centers/KodiVersion.cpp \
@@ -444,6 +457,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/TvDbId.cpp \
     src/tv_shows/TvMazeId.cpp \
     src/tv_shows/EpisodeNumber.cpp \
+    src/tv_shows/EpisodeNumberParser.cpp \
     src/tv_shows/SeasonNumber.cpp \
     src/tv_shows/SeasonOrder.cpp \
     src/data/Certification.cpp \
@@ -473,6 +487,7 @@ HEADERS  += Version.h \
     src/network/NetworkManager.h \
     src/scrapers/ScraperError.h \
     src/scrapers/ScraperUtils.h \
+    src/scrapers/MultiScrapeQueue.h \
     src/scrapers/imdb/ImdbReferencePage.h \
     src/scrapers/music/AllMusic.h \
     src/scrapers/music/Discogs.h \
@@ -491,11 +506,14 @@ HEADERS  += Version.h \
     src/ui/concerts/ConcertStreamDetailsWidget.h \
     src/data/Database.h \
     src/data/ImageCache.h \
+    src/data/ImportCacheIndex.h \
     src/data/ResumeTime.h \
     src/media_centers/MediaCenterInterface.h \
     src/movies/Movie.h \
     src/movies/file_searcher/MovieFileSearcher.h \
     src/movies/file_searcher/MovieDirectorySearcher.h \
+    src/movies/file_searcher/ParallelDirectoryWalker.h \
+    src/movies/MovieDuplicateFinder.h \
     src/movies/MovieFilesOrganizer.h \
     src/movies/MovieImages.h \
     src/movies/MovieModel.h \
@@ -511,6 +529,8 @@ HEADERS  += Version.h \
     src/data/Rating.h \
     src/data/Storage.h \
     src/data/StreamDetails.h \
+    src/data/StreamDetailsCache.h \
+    src/data/StreamDetailsLoader.h \
     src/data/Subtitle.h \
     src/tv_shows/TvShow.h \
     src/tv_shows/TvShowEpisode.h \
@@ -519,7 +539,7 @@ HEADERS  += Version.h \
     src/imports/Extractor.h \
     src/imports/FileWorker.h \
     src/imports/MakeMkvCon.h \
-    src/imports/MyFile.h \
+    src/imports/FileTransfer.h \
     src/log/Log.h \
     src/ui/export/CsvExportDialog.h \
     src/ui/export/ExportDialog.h \
@@ -528,6 +548,8 @@ HEADERS  += Version.h \
     src/ui/imports/ImportDialog.h \
     src/ui/imports/MakeMkvDialog.h \
     src/ui/imports/UnpackButtons.h \
+    src/export/CompiledTemplate.h \
+    src/export/ExportImageQueue.h \
     src/export/ExportTemplate.h \
     src/export/ExportTemplateLoader.h \
     src/export/MediaExport.h \
@@ -539,11 +561,15 @@ HEADERS  += Version.h \
     src/globals/ComboDelegate.h \
     src/globals/DownloadManager.h \
     src/globals/DownloadManagerElement.h \
+    src/globals/DownloadSlots.h \
     src/globals/Filter.h \
+    src/globals/FilterIndex.h \
     src/globals/Globals.h \
     src/globals/Helper.h \
+    src/globals/LibraryWatcher.h \
     src/globals/ImageDialog.h \
     src/globals/ImagePreviewDialog.h \
+    src/globals/LocaleSortKey.h \
     src/globals/LocaleStringCompare.h \
     src/globals/Manager.h \
     src/globals/MessageIds.h \
@@ -589,6 +615,7 @@ HEADERS  += Version.h \
     src/media_centers/kodi/EpisodeXmlReader.h \
     src/media_centers/kodi/MovieXmlReader.h \
     src/media_centers/kodi/MovieXmlWriter.h \
+    src/media_centers/kodi/StreamDetailsXmlReader.h \
     src/media_centers/kodi/TvShowXmlReader.h \
     src/media_centers/kodi/TvShowXmlWriter.h \
     src/media_centers/KodiVersion.h \
@@ -788,6 +815,7 @@ HEADERS  += Version.h \
     src/tv_shows/TvDbId.h \
     src/tv_shows/TvMazeId.h \
     src/tv_shows/EpisodeNumber.h \
+    src/tv_shows/EpisodeNumberParser.h \
     src/tv_shows/SeasonNumber.h \
     src/tv_shows/SeasonOrder.h \
     src/data/Certification.h \
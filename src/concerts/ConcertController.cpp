@@ -132,17 +132,28 @@ void ConcertController::loadData(TmdbId id,
 
 bool ConcertController::loadStreamDetailsFromFile()
 {
-    using namespace std::chrono;
     const bool success = m_concert->streamDetails()->loadStreamDetails();
     if (!success) {
         return false;
     }
+    onStreamDetailsLoaded();
+    return true;
+}
+
+void ConcertController::setStreamDetails(const StreamDetails::Values& details)
+{
+    m_concert->streamDetails()->setValues(details);
+    onStreamDetailsLoaded();
+}
+
+void ConcertController::onStreamDetailsLoaded()
+{
+    using namespace std::chrono;
     seconds runtime(
         m_concert->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     m_concert->setRuntime(duration_cast<minutes>(runtime));
     m_concert->setStreamDetailsLoaded(true);
     m_concert->setChanged(true);
-    return true;
 }
 
 QSet<ConcertScraperInfo> ConcertController::infosToLoad()
@@ -251,6 +262,7 @@ void ConcertController::onDownloadFinished(DownloadManagerElement elem)
 void ConcertController::loadImage(ImageType type, QUrl url)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.concert = m_concert;
     d.imageType = type;
     d.url = url;
@@ -262,6 +274,7 @@ void ConcertController::loadImages(ImageType type, QVector<QUrl> urls)
 {
     for (const QUrl& url : urls) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.concert = m_concert;
         d.imageType = type;
         d.url = url;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/StreamDetails.h"
 #include "data/TmdbId.h"
 #include "globals/DownloadManagerElement.h"
 #include "globals/Poster.h"
@@ -31,6 +32,8 @@ public:
     void loadData(TmdbId id, mediaelch::scraper::ConcertScraper* scraperInterface, QSet<ConcertScraperInfo> infos);
 
     ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    /// \brief Sets stream details that were loaded in the background, see mediaelch::StreamDetailsLoader.
+    void setStreamDetails(const StreamDetails::Values& details);
 
     void scraperLoadDone(mediaelch::scraper::ConcertScraper* scraper);
     QSet<ConcertScraperInfo> infosToLoad();
@@ -57,6 +60,9 @@ private slots:
     void onDownloadFinished(DownloadManagerElement elem);
 
 private:
+    /// \brief Updates the runtime and marks the concert as changed.
+    void onStreamDetailsLoaded();
+
     Concert* m_concert = nullptr;
     bool m_infoLoaded = false;
     bool m_infoFromNfoLoaded = false;
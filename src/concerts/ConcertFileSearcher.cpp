@@ -1,12 +1,13 @@
 #include "ConcertFileSearcher.h"
 
+#include "file/FilenameUtils.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "log/Log.h"
 
 #include <QApplication>
-#include <QRegularExpression>
+#include <QScopedValueRollback>
 #include <QSqlQuery>
 #include <QSqlRecord>
 
@@ -44,6 +45,7 @@ void ConcertFileSearcher::setConcertDirectories(QVector<SettingsDir> directories
 ///  3. Load all entries from the database
 void ConcertFileSearcher::reload(bool force)
 {
+    QScopedValueRollback<bool> running(m_running, true);
     m_aborted = false;
 
     clearOldConcerts(force);
@@ -129,7 +131,7 @@ void ConcertFileSearcher::scanDir(QString startPath,
         }
 
         // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+        if (mediaelch::file::isTrailerOrSampleFile(file)) {
             continue;
         }
         files.append(file);
@@ -147,39 +149,17 @@ void ConcertFileSearcher::scanDir(QString startPath,
         return;
     }
 
-    QRegularExpression rx("((part|cd)[\\s_]*)(\\d+)");
-    rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    for (elch_size_t i = 0, n = files.size(); i < n; i++) {
+    const QVector<QStringList> stackedFiles =
+        mediaelch::file::groupStackedFiles(files, mediaelch::file::StackingPattern::Parts);
+    for (const QStringList& stack : stackedFiles) {
         if (m_aborted) {
             return;
         }
-
         QStringList concertFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
-        }
-
-        concertFiles << QDir(path + QDir::separator() + file).path();
-
-        QRegularExpressionMatch match = rx.match(file);
-        const elch_size_t pos = match.capturedStart();
-        if (pos != -1) {
-            QString left = file.left(pos) + match.captured(1);
-            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
-            for (int x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        concertFiles << QDir(path + QDir::separator() + subFile).path();
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
-                    }
-                }
-            }
-        }
-        if (concertFiles.count() > 0) {
-            contents.append(concertFiles);
+        for (const QString& file : stack) {
+            concertFiles << QDir(path + QDir::separator() + file).path();
         }
+        contents.append(concertFiles);
     }
 }
 
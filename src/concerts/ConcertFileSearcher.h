@@ -14,6 +14,9 @@ public:
     explicit ConcertFileSearcher(QObject* parent = nullptr);
     void setConcertDirectories(QVector<SettingsDir> directories);
 
+    /// \brief Whether concerts are currently (re-)loaded.
+    bool isRunning() const { return m_running; }
+
 public slots:
     void reload(bool force);
     void abort();
@@ -28,6 +31,7 @@ private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     bool m_aborted = false;
+    bool m_running = false;
 
 private:
     Database& database();
@@ -26,6 +26,7 @@ void ConcertModel::addConcert(Concert* concert)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_concerts.append(concert);
+    updateFilterIndex(concert);
     endInsertRows();
     connect(concert, &Concert::sigChanged, this, &ConcertModel::onConcertChanged, Qt::UniqueConnection);
 }
@@ -37,6 +38,8 @@ void ConcertModel::addConcert(Concert* concert)
  */
 void ConcertModel::onConcertChanged(Concert* concert)
 {
+    // Must be updated before proxy models filter the changed row again.
+    updateFilterIndex(concert);
     QModelIndex index = createIndex(qsizetype_to_int(m_concerts.indexOf(concert)), 0);
     emit dataChanged(index, index);
 }
@@ -60,6 +63,16 @@ Concert* ConcertModel::concert(int row)
     return m_concerts.at(row);
 }
 
+mediaelch::FilterIndex& ConcertModel::filterIndex()
+{
+    return m_filterIndex;
+}
+
+void ConcertModel::updateFilterIndex(Concert* concert)
+{
+    m_filterIndex.setText(concert, static_cast<int>(ConcertFilters::Title), concert->title());
+}
+
 int ConcertModel::rowCount(const QModelIndex& parent) const
 {
     if (parent.isValid()) {
@@ -175,6 +188,7 @@ void ConcertModel::clear()
         concert->deleteLater();
     }
     m_concerts.clear();
+    m_filterIndex.clear();
     endRemoveRows();
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "globals/FilterIndex.h"
+
 #include <QAbstractItemModel>
 #include <QIcon>
 
@@ -22,6 +24,8 @@ public:
     void clear();
     QVector<Concert*> concerts();
     Concert* concert(int row);
+    /// \brief Index of the values that concerts are filtered by, see Filter::compileConcertFilter().
+    mediaelch::FilterIndex& filterIndex();
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
@@ -34,7 +38,10 @@ private slots:
     void onConcertChanged(Concert* concert);
 
 private:
+    void updateFilterIndex(Concert* concert);
+
     QVector<Concert*> m_concerts;
+    mediaelch::FilterIndex m_filterIndex;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -1,8 +1,8 @@
 #include "ConcertProxyModel.h"
 
+#include "concerts/ConcertModel.h"
 #include "globals/Filter.h"
 #include "globals/Globals.h"
-#include "globals/Manager.h"
 #include "log/Log.h"
 
 /**
@@ -13,20 +13,19 @@ ConcertProxyModel::ConcertProxyModel(QObject* parent) : QSortFilterProxyModel(pa
 }
 
 /**
- * \brief Checks if a row accepts the filter. Checks the first two "columns" of our model (Concert name and folder name)
+ * \brief Checks if a row accepts the filter. Uses the filters compiled in setFilter().
  * \return Filter is accepted or not
  */
 bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Concert*> concerts = Manager::instance()->concertModel()->concerts();
-    if (sourceRow < 0 || sourceRow >= concerts.count()) {
+    Concert* concert = (m_concertModel != nullptr) ? m_concertModel->concert(sourceRow) : nullptr;
+    if (concert == nullptr) {
         return true;
     }
 
-    Concert* concert = concerts.at(sourceRow);
-    for (Filter* filter : m_filters) {
-        if (!filter->accepts(concert)) {
+    for (const Filter::ConcertPredicate& accepts : m_predicates) {
+        if (!accepts(concert)) {
             return false;
         }
     }
@@ -34,6 +33,13 @@ bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourc
     return true;
 }
 
+void ConcertProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    m_concertModel = qobject_cast<ConcertModel*>(sourceModel);
+    compileFilters();
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
 /**
  * \brief Sort function for the concert model. Sorts concerts by name and new files to top.
  */
@@ -56,6 +62,20 @@ bool ConcertProxyModel::lessThan(const QModelIndex& left, const QModelIndex& rig
  */
 void ConcertProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
-    m_filters = filters;
-    m_filterText = text;
+    m_filters = std::move(filters);
+    m_filterText = std::move(text);
+    compileFilters();
+    invalidateFilter();
+}
+
+void ConcertProxyModel::compileFilters()
+{
+    m_predicates.clear();
+    if (m_concertModel == nullptr) {
+        return;
+    }
+    m_predicates.reserve(m_filters.size());
+    for (const Filter* filter : asConst(m_filters)) {
+        m_predicates.append(filter->compileConcertFilter(m_concertModel->filterIndex()));
+    }
 }
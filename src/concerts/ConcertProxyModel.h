@@ -1,14 +1,18 @@
 #pragma once
 
+#include "globals/Filter.h"
+
 #include <QSortFilterProxyModel>
 
-class Filter;
+class ConcertModel;
 
 class ConcertProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
 public:
     explicit ConcertProxyModel(QObject* parent = nullptr);
+    /// \brief Sets the source model, which must be a ConcertModel.
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
     void setFilter(QVector<Filter*> filters, QString text);
 
 protected:
@@ -16,6 +20,11 @@ protected:
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
 private:
+    void compileFilters();
+
+    ConcertModel* m_concertModel = nullptr;
     QVector<Filter*> m_filters;
+    /// \brief m_filters compiled against the concert model's filter index.
+    QVector<Filter::ConcertPredicate> m_predicates;
     QString m_filterText;
 };
@@ -2,7 +2,6 @@
 
 #include "concerts/Concert.h"
 #include "data/Subtitle.h"
-#include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/Meta.h"
 #include "log/Log.h"
@@ -29,22 +28,32 @@ static QMutex s_initializingDatabaseMutex;
 /// \brief Used for creating a new connection name.
 static size_t s_connectionCount = 0;
 
-Database::Database(QObject* parent) : QObject(parent)
+/// \brief Path to MediaElch's cache database. Creates its directory if it does not exist.
+static QString defaultDatabaseFile()
+{
+    QMutexLocker lock(&s_initializingDatabaseMutex);
+    const DirectoryPath dataLocation = Settings::instance()->databaseDir();
+    QDir dir(dataLocation.dir());
+    if (!dir.exists()) {
+        dir.mkpath(dataLocation.toString());
+    }
+    return dataLocation.filePath("MediaElch.sqlite");
+}
+
+Database::Database(QObject* parent) : Database(defaultDatabaseFile(), parent)
+{
+}
+
+Database::Database(const QString& databaseFile, QObject* parent) : QObject(parent)
 {
     // This lock is required to ensure that multithreaded access only initializes
     // the database once.  Each instance of this class has its own connection name.
     QMutexLocker lock(&s_initializingDatabaseMutex);
     ++s_connectionCount;
 
-    m_dataLocation = Settings::instance()->databaseDir();
-    QDir dir(m_dataLocation.dir());
-    if (!dir.exists()) {
-        dir.mkpath(m_dataLocation.toString());
-    }
-
     QString connectionName = QStringLiteral("mediaDb_%1").arg(s_connectionCount);
     m_db = new QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", connectionName));
-    m_db->setDatabaseName(m_dataLocation.filePath("MediaElch.sqlite"));
+    m_db->setDatabaseName(databaseFile);
     if (!m_db->open()) {
         qCWarning(generic) << "Could not open cache database";
     } else {
@@ -126,6 +135,10 @@ void Database::clearAllMovies()
     query.exec();
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
     query.exec();
+    query.prepare("DELETE FROM movieDirectories");
+    query.exec();
+    query.prepare("DELETE FROM sqlite_sequence WHERE name='movieDirectories'");
+    query.exec();
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
@@ -140,15 +153,81 @@ void Database::clearMoviesInDirectory(DirectoryPath path)
     query.prepare("DELETE FROM movies WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    query.prepare("DELETE FROM movieDirectories WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
 }
 
-void Database::addMovie(Movie* movie, DirectoryPath path)
+void Database::removeMovies(const QVector<int>& movieIds)
+{
+    if (movieIds.isEmpty()) {
+        return;
+    }
+
+    QSqlQuery filesQuery(db());
+    QSqlQuery subtitlesQuery(db());
+    QSqlQuery movieQuery(db());
+    filesQuery.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+    subtitlesQuery.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    movieQuery.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+
+    transaction();
+    for (int idMovie : movieIds) {
+        filesQuery.bindValue(":idMovie", idMovie);
+        filesQuery.exec();
+        subtitlesQuery.bindValue(":idMovie", idMovie);
+        subtitlesQuery.exec();
+        movieQuery.bindValue(":idMovie", idMovie);
+        movieQuery.exec();
+    }
+    commit();
+}
+
+QHash<QString, qint64> Database::movieDirectorySnapshot(DirectoryPath path)
 {
+    QHash<QString, qint64> snapshot;
     QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
-                  "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
-                  "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
-                  ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
+    query.prepare("SELECT dir, lastModified FROM movieDirectories WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+    while (query.next()) {
+        snapshot.insert(QString::fromUtf8(query.value(0).toByteArray()), query.value(1).toLongLong());
+    }
+    return snapshot;
+}
+
+void Database::setMovieDirectorySnapshot(DirectoryPath path, const QHash<QString, qint64>& snapshot)
+{
+    const QByteArray pathUtf8 = path.toString().toUtf8();
+
+    QSqlQuery query(db());
+    transaction();
+    query.prepare("DELETE FROM movieDirectories WHERE path=:path");
+    query.bindValue(":path", pathUtf8);
+    query.exec();
+
+    query.prepare("INSERT INTO movieDirectories(path, dir, lastModified) VALUES(:path, :dir, :lastModified)");
+    for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+        query.bindValue(":path", pathUtf8);
+        query.bindValue(":dir", it.key().toUtf8());
+        query.bindValue(":lastModified", it.value());
+        query.exec();
+    }
+    commit();
+}
+
+static const char* const s_insertMovieSql =
+    "INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
+    "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
+    "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
+    ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)";
+static const char* const s_insertMovieFileSql = "INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)";
+static const char* const s_insertMovieSubtitleSql =
+    "INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, :language, :forced)";
+
+/// \brief Bind all values of the given movie to a query prepared with s_insertMovieSql.
+static void bindMovieInsertValues(QSqlQuery& query, Movie* movie, const QByteArray& path)
+{
     query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
     query.bindValue(
         ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
@@ -162,24 +241,36 @@ void Database::addMovie(Movie* movie, DirectoryPath path)
     query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
     query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
     query.bindValue(":discType", static_cast<int>(movie->discType()));
-    query.bindValue(":path", path.toString().toUtf8());
+    query.bindValue(":path", path);
+}
+
+/// \brief Bind all values of the given subtitle to a query prepared with s_insertMovieSubtitleSql.
+static void bindSubtitleInsertValues(QSqlQuery& query, const Subtitle* subtitle, int idMovie)
+{
+    query.bindValue(":idMovie", idMovie);
+    query.bindValue(":files", subtitle->files().join("%§%"));
+    query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
+    query.bindValue(":forced", subtitle->forced() ? 1 : 0);
+}
+
+void Database::addMovie(Movie* movie, DirectoryPath path)
+{
+    QSqlQuery query(db());
+    query.prepare(s_insertMovieSql);
+    bindMovieInsertValues(query, movie, path.toString().toUtf8());
     query.exec();
     int insertId = query.lastInsertId().toInt();
 
     for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
+        query.prepare(s_insertMovieFileSql);
         query.bindValue(":idMovie", insertId);
         query.bindValue(":file", file.toString().toUtf8());
         query.exec();
     }
 
     for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
+        query.prepare(s_insertMovieSubtitleSql);
+        bindSubtitleInsertValues(query, subtitle, insertId);
         query.exec();
     }
 
@@ -188,8 +279,101 @@ void Database::addMovie(Movie* movie, DirectoryPath path)
     movie->setDatabaseId(insertId);
 }
 
+bool Database::addMovies(const QVector<Movie*>& movies, DirectoryPath path)
+{
+    if (movies.isEmpty()) {
+        return true;
+    }
+
+    // All statements are prepared only once and reused for every row.
+    // SQLite re-parses a statement on each prepare() which is noticeable
+    // for large directories with several thousand movies.
+    QSqlQuery movieQuery(db());
+    QSqlQuery fileQuery(db());
+    QSqlQuery subtitleQuery(db());
+    QSqlQuery labelSelectQuery(db());
+    QSqlQuery labelUpdateQuery(db());
+    QSqlQuery labelInsertQuery(db());
+
+    movieQuery.prepare(s_insertMovieSql);
+    fileQuery.prepare(s_insertMovieFileSql);
+    subtitleQuery.prepare(s_insertMovieSubtitleSql);
+    labelSelectQuery.prepare("SELECT idLabel, color FROM labels WHERE fileName=:fileName");
+    labelUpdateQuery.prepare("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
+    labelInsertQuery.prepare("INSERT INTO labels(color, fileName) VALUES(:color, :fileName)");
+
+    const QByteArray pathUtf8 = path.toString().toUtf8();
+    // Database IDs are only set once the transaction is committed.
+    QVector<int> insertIds;
+    insertIds.reserve(movies.size());
+
+    transaction();
+    for (Movie* movie : movies) {
+        bindMovieInsertValues(movieQuery, movie, pathUtf8);
+        if (!movieQuery.exec()) {
+            qCWarning(generic) << "[Database] Could not add movie to database:" << movieQuery.lastError().text();
+            db().rollback();
+            return false;
+        }
+        const int insertId = movieQuery.lastInsertId().toInt();
+        insertIds << insertId;
+
+        bool isFirstFile = true;
+        for (const mediaelch::FilePath& file : movie->files()) {
+            const QByteArray fileUtf8 = file.toString().toUtf8();
+            fileQuery.bindValue(":idMovie", insertId);
+            fileQuery.bindValue(":file", fileUtf8);
+            if (!fileQuery.exec()) {
+                qCWarning(generic) << "[Database] Could not add movie file to database:"
+                                   << fileQuery.lastError().text();
+                db().rollback();
+                return false;
+            }
+
+            labelSelectQuery.bindValue(":fileName", fileUtf8);
+            labelSelectQuery.exec();
+            const bool hasLabel = labelSelectQuery.next();
+            if (isFirstFile) {
+                // Same as getLabel(): The label of the first file is the movie's label.
+                movie->setLabel(
+                    hasLabel ? static_cast<ColorLabel>(labelSelectQuery.value(1).toInt()) : ColorLabel::NoLabel);
+                isFirstFile = false;
+            }
+
+            const int color = static_cast<int>(movie->label());
+            if (hasLabel) {
+                labelUpdateQuery.bindValue(":idLabel", labelSelectQuery.value(0).toInt());
+                labelUpdateQuery.bindValue(":color", color);
+                labelUpdateQuery.exec();
+            } else {
+                labelInsertQuery.bindValue(":color", color);
+                labelInsertQuery.bindValue(":fileName", fileUtf8);
+                labelInsertQuery.exec();
+            }
+            labelSelectQuery.finish();
+        }
+
+        for (const Subtitle* subtitle : movie->subtitles()) {
+            bindSubtitleInsertValues(subtitleQuery, subtitle, insertId);
+            subtitleQuery.exec();
+        }
+    }
+    commit();
+
+    for (int i = 0; i < movies.size(); ++i) {
+        movies[i]->setDatabaseId(insertIds[i]);
+    }
+    return true;
+}
+
 void Database::update(Movie* movie)
 {
+    if (movie->databaseId() < 0) {
+        qCWarning(generic) << "[Database] Can't update movie that is not stored in the database:"
+                           << movie->files().toStringList();
+        return;
+    }
+
     QSqlQuery query(db());
     query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
     query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
@@ -200,7 +384,7 @@ void Database::update(Movie* movie)
     query.bindValue(":idMovie", movie->databaseId());
     query.exec();
     for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
+        query.prepare(s_insertMovieFileSql);
         query.bindValue(":idMovie", movie->databaseId());
         query.bindValue(":file", file.toString().toUtf8());
         query.exec();
@@ -210,16 +394,79 @@ void Database::update(Movie* movie)
     query.bindValue(":idMovie", movie->databaseId());
     query.exec();
     for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
+        query.prepare(s_insertMovieSubtitleSql);
+        bindSubtitleInsertValues(query, subtitle, movie->databaseId());
         query.exec();
     }
 }
 
+namespace {
+
+/// \brief   Column indices of the movie query in Database::moviesInDirectory().
+/// \details Indices are resolved once per query. Looking them up via
+///          query.record().indexOf() for each field of each row is expensive
+///          because it creates a new QSqlRecord every time.
+struct MovieRowMapper
+{
+    explicit MovieRowMapper(const QSqlRecord& record) :
+        idMovie{record.indexOf("idMovie")},
+        content{record.indexOf("content")},
+        lastModified{record.indexOf("lastModified")},
+        inSeparateFolder{record.indexOf("inSeparateFolder")},
+        hasPoster{record.indexOf("hasPoster")},
+        hasBackdrop{record.indexOf("hasBackdrop")},
+        hasLogo{record.indexOf("hasLogo")},
+        hasClearArt{record.indexOf("hasClearArt")},
+        hasCdArt{record.indexOf("hasCdArt")},
+        hasBanner{record.indexOf("hasBanner")},
+        hasThumb{record.indexOf("hasThumb")},
+        hasExtraFanarts{record.indexOf("hasExtraFanarts")},
+        discType{record.indexOf("discType")},
+        file{record.indexOf("file")},
+        color{record.indexOf("color")}
+    {
+    }
+
+    /// \brief Set all movie attributes that are stored in the current row.
+    void apply(const QSqlQuery& query, Movie* movie) const
+    {
+        const auto flag = [&query](int column) { return query.value(column).toInt() == 1; };
+
+        movie->setDatabaseId(query.value(idMovie).toInt());
+        movie->setFileLastModified(query.value(lastModified).toDateTime());
+        movie->setInSeparateFolder(flag(inSeparateFolder));
+        movie->setNfoContent(QString::fromUtf8(query.value(content).toByteArray()));
+        movie->images().setHasImage(ImageType::MoviePoster, flag(hasPoster));
+        movie->images().setHasImage(ImageType::MovieBackdrop, flag(hasBackdrop));
+        movie->images().setHasImage(ImageType::MovieLogo, flag(hasLogo));
+        movie->images().setHasImage(ImageType::MovieClearArt, flag(hasClearArt));
+        movie->images().setHasImage(ImageType::MovieCdArt, flag(hasCdArt));
+        movie->images().setHasImage(ImageType::MovieBanner, flag(hasBanner));
+        movie->images().setHasImage(ImageType::MovieThumb, flag(hasThumb));
+        movie->images().setHasExtraFanarts(flag(hasExtraFanarts));
+        movie->setDiscType(static_cast<DiscType>(query.value(discType).toInt()));
+        movie->setLabel(static_cast<ColorLabel>(query.value(color).toInt()));
+    }
+
+    int idMovie;
+    int content;
+    int lastModified;
+    int inSeparateFolder;
+    int hasPoster;
+    int hasBackdrop;
+    int hasLogo;
+    int hasClearArt;
+    int hasCdArt;
+    int hasBanner;
+    int hasThumb;
+    int hasExtraFanarts;
+    int discType;
+    int file;
+    int color;
+};
+
+} // namespace
+
 QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* movieParent)
 {
     transaction();
@@ -235,62 +482,47 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
 
+    const MovieRowMapper movieRow(query.record());
+
     QMap<int, Movie*> movies;
     while (query.next()) {
-        Movie* movie = nullptr;
-        if (movies.contains(query.value(query.record().indexOf("idMovie")).toInt())) {
-            movie = movies.value(query.value(query.record().indexOf("idMovie")).toInt());
-            if (movie == nullptr) {
-                // This *must* not happen because we just inserted it.
-                qCCritical(generic) << "[Database] Movie is undefined but should exist!";
-                continue;
-            }
-
-        } else {
-            ColorLabel label = static_cast<ColorLabel>(query.value(query.record().indexOf("color")).toInt());
+        const int idMovie = query.value(movieRow.idMovie).toInt();
+        Movie* movie = movies.value(idMovie, nullptr);
+        if (movie == nullptr) {
             movie = new Movie(QStringList(), movieParent);
-            movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
-            movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
-            movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-            movie->images().setHasImage(
-                ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieBackdrop, query.value(query.record().indexOf("hasBackdrop")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieLogo, query.value(query.record().indexOf("hasLogo")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieClearArt, query.value(query.record().indexOf("hasClearArt")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieCdArt, query.value(query.record().indexOf("hasCdArt")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieBanner, query.value(query.record().indexOf("hasBanner")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieThumb, query.value(query.record().indexOf("hasThumb")).toInt() == 1);
-            movie->images().setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
-            movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
-            movie->setLabel(label);
+            movieRow.apply(query, movie);
             movie->setChanged(false);
-            movies.insert(query.value(query.record().indexOf("idMovie")).toInt(), movie);
+            movies.insert(idMovie, movie);
         }
 
         mediaelch::FileList files = movie->files();
-        files << mediaelch::FilePath(query.value(query.record().indexOf("file")).toByteArray());
+        files << mediaelch::FilePath(query.value(movieRow.file).toByteArray());
         movie->setFiles(files);
     }
 
-    query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
+    // Only load subtitles of movies in this directory. Otherwise the whole
+    // table would be read for each movie directory.
+    query.prepare("SELECT S.idMovie, S.files, S.language, S.forced "
+                  "FROM movieSubtitles S "
+                  "INNER JOIN movies M ON M.idMovie=S.idMovie "
+                  "WHERE M.path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    const QSqlRecord subtitleRecord = query.record();
+    const int subtitleIdMovieCol = subtitleRecord.indexOf("idMovie");
+    const int subtitleForcedCol = subtitleRecord.indexOf("forced");
+    const int subtitleLanguageCol = subtitleRecord.indexOf("language");
+    const int subtitleFilesCol = subtitleRecord.indexOf("files");
     while (query.next()) {
-        int movieId = query.value(query.record().indexOf("idMovie")).toInt();
+        int movieId = query.value(subtitleIdMovieCol).toInt();
         Movie* movie = movies.value(movieId, nullptr);
         if (movie == nullptr) {
             continue;
         }
         auto* subtitle = new Subtitle(movie);
-        subtitle->setForced(query.value(query.record().indexOf("forced")).toInt() == 1);
-        subtitle->setLanguage(query.value(query.record().indexOf("language")).toString());
-        subtitle->setFiles(query.value(query.record().indexOf("files")).toString().split("%§%"));
+        subtitle->setForced(query.value(subtitleForcedCol).toInt() == 1);
+        subtitle->setLanguage(query.value(subtitleLanguageCol).toString());
+        subtitle->setFiles(query.value(subtitleFilesCol).toString().split("%§%"));
         subtitle->setChanged(false);
         movie->addSubtitle(subtitle, true);
     }
@@ -371,19 +603,26 @@ QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
     query.prepare("SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
+
+    const QSqlRecord record = query.record();
+    const int idConcertCol = record.indexOf("idConcert");
+    const int contentCol = record.indexOf("content");
+    const int inSeparateFolderCol = record.indexOf("inSeparateFolder");
+
     while (query.next()) {
+        const int idConcert = query.value(idConcertCol).toInt();
         QStringList files;
-        queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
-        queryFiles.bindValue(":idConcert", query.value(query.record().indexOf("idConcert")).toInt());
+        queryFiles.bindValue(":idConcert", idConcert);
         queryFiles.exec();
         while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
+            files << QString::fromUtf8(queryFiles.value(0).toByteArray());
         }
 
         auto* concert = new Concert(files, Manager::instance()->concertFileSearcher());
-        concert->setDatabaseId(query.value(query.record().indexOf("idConcert")).toInt());
-        concert->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-        concert->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        concert->setDatabaseId(idConcert);
+        concert->setInSeparateFolder(query.value(inSeparateFolderCol).toInt() == 1);
+        concert->setNfoContent(QString::fromUtf8(query.value(contentCol).toByteArray()));
         concerts.append(concert);
     }
     return concerts;
@@ -552,24 +791,30 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
     query.prepare("SELECT idShow, dir, content, path FROM shows WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
-    while (query.next()) {
-        mediaelch::DirectoryPath dir(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()));
-        auto* show = new TvShow(dir, Manager::instance()->tvShowFileSearcher());
-        show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
-        show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        shows.append(show);
+    {
+        const QSqlRecord record = query.record();
+        const int idShowCol = record.indexOf("idShow");
+        const int dirCol = record.indexOf("dir");
+        const int contentCol = record.indexOf("content");
+        while (query.next()) {
+            mediaelch::DirectoryPath dir(QString::fromUtf8(query.value(dirCol).toByteArray()));
+            auto* show = new TvShow(dir, Manager::instance()->tvShowFileSearcher());
+            show->setDatabaseId(query.value(idShowCol).toInt());
+            show->setNfoContent(QString::fromUtf8(query.value(contentCol).toByteArray()));
+            shows.append(show);
+        }
     }
 
+    // Column order is fixed by the SELECT statement.
+    query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
     for (TvShow* show : shows) {
-        query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
         query.bindValue(":dir", show->dir().toString().toUtf8());
         query.exec();
         if (query.next()) {
-            show->setShowMissingEpisodes(
-                query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1, false);
-            show->setHideSpecialsInMissingEpisodes(
-                query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1, false);
+            show->setShowMissingEpisodes(query.value(0).toInt() == 1, false);
+            show->setHideSpecialsInMissingEpisodes(query.value(1).toInt() == 1, false);
         }
+        query.finish();
     }
 
     return shows;
@@ -583,20 +828,28 @@ QVector<TvShowEpisode*> Database::episodes(int idShow)
     query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
     query.bindValue(":idShow", idShow);
     query.exec();
+    queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
+
+    const QSqlRecord record = query.record();
+    const int idEpisodeCol = record.indexOf("idEpisode");
+    const int contentCol = record.indexOf("content");
+    const int seasonNumberCol = record.indexOf("seasonNumber");
+    const int episodeNumberCol = record.indexOf("episodeNumber");
+
     while (query.next()) {
+        const int idEpisode = query.value(idEpisodeCol).toInt();
         QStringList files;
-        queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
-        queryFiles.bindValue(":idEpisode", query.value(query.record().indexOf("idEpisode")).toInt());
+        queryFiles.bindValue(":idEpisode", idEpisode);
         queryFiles.exec();
         while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
+            files << QString::fromUtf8(queryFiles.value(0).toByteArray());
         }
 
         auto* episode = new TvShowEpisode(files);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        episode->setSeason(SeasonNumber(query.value(seasonNumberCol).toInt()));
+        episode->setEpisode(EpisodeNumber(query.value(episodeNumberCol).toInt()));
+        episode->setDatabaseId(idEpisode);
+        episode->setNfoContent(QString::fromUtf8(query.value(contentCol).toByteArray()));
         episodes.append(episode);
     }
     return episodes;
@@ -765,25 +1018,38 @@ void Database::addImport(QString fileName, QString type, DirectoryPath path)
     query.bindValue(":type", type);
     query.bindValue(":path", path.toString());
     query.exec();
+
+    if (m_importCacheLoaded) {
+        m_importCache.add({fileName, type, path.toString()});
+    }
 }
 
 bool Database::guessImport(QString fileName, QString& type, QString& path)
 {
-    qreal bestMatch = 0;
+    loadImportCache();
+    const mediaelch::ImportCacheIndex::Entry* entry = m_importCache.bestMatch(fileName, 0.7);
+    if (entry == nullptr) {
+        return false;
+    }
+    type = entry->type;
+    path = entry->path;
+    return true;
+}
+
+void Database::loadImportCache()
+{
+    if (m_importCacheLoaded) {
+        return;
+    }
+    m_importCacheLoaded = true;
+    m_importCache.clear();
 
     QSqlQuery query(db());
-    query.prepare("SELECT filename, type, path FROM importCache");
+    query.prepare("SELECT filename, type, path FROM importCache ORDER BY id");
     query.exec();
     while (query.next()) {
-        qreal p = helper::similarity(fileName, query.value(query.record().indexOf("filename")).toString());
-        if (p > 0.7 && p > bestMatch) {
-            bestMatch = p;
-            type = query.value(query.record().indexOf("type")).toString();
-            path = query.value(query.record().indexOf("path")).toString();
-        }
+        m_importCache.add({query.value(0).toString(), query.value(1).toString(), query.value(2).toString()});
     }
-
-    return (bestMatch != 0);
 }
 
 void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel)
@@ -1054,10 +1320,54 @@ void Database::setupDatabase()
         query.exec();
 
         myDbVersion = 17;
-        Q_UNUSED(myDbVersion);
         updateDbVersion(17);
     }
 
+    if (myDbVersion < 18) {
+        // Indices for columns that are used in WHERE clauses when loading
+        // media from the database. Note that in version 14, the index for
+        // labels was created on a non-existing table.
+        const QStringList indices = {
+            "CREATE INDEX IF NOT EXISTS movies_path_idx ON movies(path);",
+            "CREATE INDEX IF NOT EXISTS labels_filename_idx ON labels(fileName);",
+            "CREATE INDEX IF NOT EXISTS concerts_path_idx ON concerts(path);",
+            "CREATE INDEX IF NOT EXISTS shows_path_idx ON shows(path);",
+            "CREATE INDEX IF NOT EXISTS shows_dir_idx ON shows(dir);",
+            "CREATE INDEX IF NOT EXISTS shows_settings_dir_idx ON showsSettings(dir);",
+            "CREATE INDEX IF NOT EXISTS shows_episodes_id_show_idx ON showsEpisodes(idShow);",
+            "CREATE INDEX IF NOT EXISTS episodes_id_show_idx ON episodes(idShow);",
+            "CREATE INDEX IF NOT EXISTS episodes_path_idx ON episodes(path);",
+            "CREATE INDEX IF NOT EXISTS artists_path_idx ON artists(path);",
+            "CREATE INDEX IF NOT EXISTS albums_path_idx ON albums(path);",
+            "CREATE INDEX IF NOT EXISTS albums_id_artist_idx ON albums(idArtist);",
+        };
+        for (const QString& index : indices) {
+            query.prepare(index);
+            query.exec();
+        }
+
+        myDbVersion = 18;
+        updateDbVersion(18);
+    }
+
+    if (myDbVersion < 19) {
+        // Modification times of all directories inside a movie directory.
+        // Used for incremental reloads; see MovieDiskLoader.
+        query.prepare(R"sql(CREATE TABLE IF NOT EXISTS movieDirectories (
+                      "idDirectory" integer NOT NULL PRIMARY KEY AUTOINCREMENT,
+                      "path" text NOT NULL,
+                      "dir" text NOT NULL,
+                      "lastModified" integer NOT NULL);
+        )sql");
+        query.exec();
+        query.prepare("CREATE INDEX IF NOT EXISTS movie_directories_path_idx ON movieDirectories(path);");
+        query.exec();
+
+        myDbVersion = 19;
+        Q_UNUSED(myDbVersion);
+        updateDbVersion(19);
+    }
+
     query.prepare("PRAGMA synchronous=0;");
     query.exec();
 
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "data/ImportCacheIndex.h"
 #include "data/TmdbId.h"
 #include "file/Path.h"
 #include "globals/Globals.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
@@ -22,6 +24,8 @@ class Database : public QObject
     Q_OBJECT
 public:
     explicit Database(QObject* parent = nullptr);
+    /// \brief Open the given SQLite database file, e.g. ":memory:" for an in-memory database.
+    Database(const QString& databaseFile, QObject* parent);
     ~Database() override;
 
     /// \brief Create a new connection for the calling thread.
@@ -33,7 +37,23 @@ public:
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void addMovie(Movie* movie, mediaelch::DirectoryPath path);
+    /// \brief   Add all given movies to the database in one transaction.
+    /// \details Prepared statements are reused for all movies, which is much faster
+    ///          than calling addMovie() for each movie. The label of each movie is
+    ///          restored from its first file (see getLabel()) and stored for all files.
+    ///          If any movie can't be stored, the transaction is rolled back, no movie
+    ///          gets a database ID and false is returned.
+    ///          Must not be called inside another transaction.
+    bool addMovies(const QVector<Movie*>& movies, mediaelch::DirectoryPath path);
+    /// \brief Remove the movies with the given database IDs in one transaction.
+    void removeMovies(const QVector<int>& movieIds);
     void update(Movie* movie);
+    /// \brief   Modification times of all directories inside the given movie directory.
+    /// \details Keys are directory paths, values are milliseconds since epoch.
+    ///          Returns an empty hash if the directory was never scanned.
+    QHash<QString, qint64> movieDirectorySnapshot(mediaelch::DirectoryPath path);
+    /// \brief Replace the directory snapshot of the given movie directory.
+    void setMovieDirectorySnapshot(mediaelch::DirectoryPath path, const QHash<QString, qint64>& snapshot);
     QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path, QObject* movieParent);
 
     void clearAllConcerts();
@@ -75,6 +95,8 @@ public:
     QVector<Album*> albums(Artist* artist);
 
     void addImport(QString fileName, QString type, mediaelch::DirectoryPath path);
+    /// \brief   Finds the import type and path of the most similar previously imported file name.
+    /// \details The import cache is loaded into an index on first use.
     bool guessImport(QString fileName, QString& type, QString& path);
 
     void setLabel(const mediaelch::FileList& fileNames, ColorLabel color);
@@ -82,9 +104,11 @@ public:
 
 private:
     void setupDatabase();
+    void loadImportCache();
 
 private:
-    mediaelch::DirectoryPath m_dataLocation;
     QSqlDatabase* m_db;
+    mediaelch::ImportCacheIndex m_importCache;
+    bool m_importCacheLoaded = false;
     void updateDbVersion(int version);
 };
@@ -1,16 +1,43 @@
 #include "ImageCache.h"
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
 
 #include "globals/Globals.h"
-#include "globals/Helper.h"
 #include "log/Log.h"
 #include "settings/Settings.h"
 
-ImageCache::ImageCache(QObject* parent) : QObject(parent)
+/// \brief Shared by a decode and its task.
+struct ImageDecodeTaskState
+{
+    QMutex lock;
+    /// \brief Set under lock when the task starts. Afterwards, the thread pool may delete the task.
+    bool started = false;
+};
+
+namespace {
+
+constexpr quint32 indexMagic = 0x4d454943; // "MEIC"
+constexpr quint32 indexVersion = 1;
+constexpr int saveIndexDelayMs = 3000;
+constexpr int jpegQuality = 90;
+
+const char* const indexFileName = "thumbnails.index";
+
+mediaelch::DirectoryPath defaultCacheDir()
 {
     mediaelch::DirectoryPath location = Settings::instance()->imageCacheDir();
     QDir dir(location.dir());
@@ -23,12 +50,204 @@ ImageCache::ImageCache(QObject* parent) : QObject(parent)
     if (!exists) {
         exists = dir.mkdir(location.toString());
     }
-    if (exists) {
-        m_cacheDir = location;
+    return exists ? location : mediaelch::DirectoryPath{};
+}
+
+QString pathHash(const mediaelch::FilePath& path)
+{
+    return QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+/// \brief Size that an image is decoded at, so that it can still be scaled to the thumbnail
+///        size without loss of quality. Invalid if the image should be decoded at full size.
+QSize decodeSize(const QSize& originalSize, int width, int height)
+{
+    if (!originalSize.isValid() || originalSize.isEmpty()) {
+        return {};
+    }
+    double factor = 1.0;
+    if (width > 0) {
+        factor = qMin(factor, 2.0 * width / originalSize.width());
     }
+    if (height > 0) {
+        factor = qMin(factor, 2.0 * height / originalSize.height());
+    }
+    if (factor >= 1.0) {
+        return {};
+    }
+    return {static_cast<int>(std::ceil(originalSize.width() * factor)),
+        static_cast<int>(std::ceil(originalSize.height() * factor))};
+}
+
+QImage scaledImage(const QImage& img, int width, int height)
+{
+    if (img.isNull()) {
+        return img;
+    }
+    if (width != 0 && height != 0) {
+        return img.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    if (width != 0) {
+        return img.scaledToWidth(width, Qt::SmoothTransformation);
+    }
+    if (height != 0) {
+        return img.scaledToHeight(height, Qt::SmoothTransformation);
+    }
+    return img;
+}
+
+/// \brief Reads the image at a reduced size, which is a lot faster for large JPEG images
+///        because libjpeg can downscale while decoding. Thread safe.
+/// \param originalSize Set to the size of the original image.
+QImage readImage(const QString& fileName, int width, int height, QSize& originalSize)
+{
+    QImageReader reader(fileName);
+    // Some images, e.g. downloaded ones, have the wrong file extension.
+    reader.setDecideFormatFromContent(true);
+    originalSize = reader.size();
+    const QSize scaledSize = decodeSize(originalSize, width, height);
+    if (scaledSize.isValid()) {
+        reader.setScaledSize(scaledSize);
+    }
+    QImage img = reader.read();
+    if (!originalSize.isValid()) {
+        originalSize = img.size();
+    }
+    return img;
+}
+
+/// \brief Reads only the image header if the image format supports it.
+QSize readImageSize(const QString& fileName)
+{
+    QImageReader reader(fileName);
+    reader.setDecideFormatFromContent(true);
+    const QSize size = reader.size();
+    return size.isValid() ? size : reader.read().size();
+}
+
+/// \brief Writes the thumbnail as JPEG or as PNG if the image is transparent. Thread safe.
+/// \param basePath Path without file extension.
+/// \returns The path of the written file or an empty string on error.
+QString writeThumbnail(const QImage& img, const QString& basePath)
+{
+    // JPEG is a lot faster to write and smaller than PNG but does not support transparency,
+    // which is required e.g. for logos and clear arts.
+    if (!img.hasAlphaChannel() && img.save(basePath + ".jpg", "jpg", jpegQuality)) {
+        return basePath + ".jpg";
+    }
+    if (img.save(basePath + ".png", "png")) {
+        return basePath + ".png";
+    }
+    return {};
+}
+
+/// \brief Reads (and scales) an image in the thread pool and passes the result to the cache.
+class DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(ImageCache* cache,
+        quint64 decodeId,
+        std::shared_ptr<QAtomicInt> cancelled,
+        std::shared_ptr<ImageDecodeTaskState> state) :
+        m_cache{cache}, m_decodeId{decodeId}, m_cancelled{std::move(cancelled)}, m_state{std::move(state)}
+    {
+    }
+
+    /// \brief Thumbnail to read. If it can't be read, the original image is used instead.
+    QString thumbnailFile;
+    QSize originalSize;
+    QString sourceFile;
+    int width = 0;
+    int height = 0;
+    /// \brief Where to write a new thumbnail (without extension). No thumbnail is written if empty.
+    QString thumbnailBasePath;
+
+    void run() override
+    {
+        {
+            QMutexLocker locker(&m_state->lock);
+            m_state->started = true;
+        }
+        if (isCancelled()) {
+            return;
+        }
+        QImage img;
+        QString writtenFile;
+        if (!thumbnailFile.isEmpty()) {
+            QSize thumbnailSize;
+            img = readImage(thumbnailFile, 0, 0, thumbnailSize);
+        }
+        if (img.isNull()) {
+            img = readImage(sourceFile, width, height, originalSize);
+            img = scaledImage(img, width, height);
+            if (!img.isNull() && !thumbnailBasePath.isEmpty() && !isCancelled()) {
+                QDir().mkpath(QFileInfo(thumbnailBasePath).path());
+                writtenFile = writeThumbnail(img, thumbnailBasePath);
+                if (writtenFile.isEmpty()) {
+                    qCWarning(generic) << "[ImageCache] Could not write thumbnail:" << thumbnailBasePath;
+                }
+            }
+        }
+        if (!isCancelled()) {
+            QMetaObject::invokeMethod(m_cache,
+                "onImageDecoded",
+                Qt::QueuedConnection,
+                Q_ARG(quint64, m_decodeId),
+                Q_ARG(QImage, img),
+                Q_ARG(QSize, originalSize),
+                Q_ARG(QString, writtenFile));
+        }
+    }
+
+private:
+    bool isCancelled() const { return m_cancelled->loadAcquire() != 0; }
+
+    ImageCache* m_cache;
+    quint64 m_decodeId;
+    std::shared_ptr<QAtomicInt> m_cancelled;
+    std::shared_ptr<ImageDecodeTaskState> m_state;
+};
+
+} // namespace
+
+ImageCache::ImageCache(QObject* parent) :
+    ImageCache(defaultCacheDir(),
+        qint64(Settings::instance()->advanced()->imageCacheMaxSize()) * 1024 * 1024,
+        Settings::instance()->advanced()->forceCache(),
+        parent)
+{
+}
+
+ImageCache::ImageCache(mediaelch::DirectoryPath cacheDir, qint64 maxSizeBytes, bool forceCache, QObject* parent) :
+    QObject(parent), m_cacheDir{std::move(cacheDir)}, m_maxSizeBytes{maxSizeBytes}, m_forceCache{forceCache}
+{
     qCDebug(generic) << "[ImageCache] Using cache dir:" << m_cacheDir;
 
-    m_forceCache = Settings::instance()->advanced()->forceCache();
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(saveIndexDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &ImageCache::saveIndex);
+    if (QCoreApplication::instance() != nullptr) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ImageCache::saveIndex);
+    }
+
+    if (m_cacheDir.isValid()) {
+        loadIndex();
+        // The maximum size may have been reduced since the last start.
+        if (m_totalSize > m_maxSizeBytes) {
+            evict();
+        }
+    }
+}
+
+ImageCache::~ImageCache()
+{
+    // Tasks must not access the cache after it is destroyed.
+    for (const Decode& decode : asConst(m_decodes)) {
+        decode.cancelled->storeRelease(1);
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+    saveIndex();
 }
 
 ImageCache* ImageCache::instance(QObject* parent)
@@ -39,96 +258,241 @@ ImageCache* ImageCache::instance(QObject* parent)
 
 QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight)
 {
+    QSize originalSize;
     if (!m_cacheDir.isValid()) {
-        return scaledImage(helper::getImage(path), width, height);
-    }
-
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_%2_%3_").arg(md5).arg(width).arg(height);
-
-    bool update = true;
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (!files.isEmpty()) {
-        QString fileName = files.first();
-        QStringList parts = fileName.split("_");
-        if (parts.count() > 6) {
-            origWidth = parts.at(3).toInt();
-            origHeight = parts.at(4).toInt();
-            if (m_forceCache || (parts.at(5).toInt() > 0 && parts.at(5).toUInt() == getLastModified(path))) {
-                update = false;
-            }
+        QImage img = scaledImage(readImage(path.toString(), width, height, originalSize), width, height);
+        origWidth = originalSize.width();
+        origHeight = originalSize.height();
+        return img;
+    }
+
+    const QString hash = pathHash(path);
+    Thumbnail* thumbnail = findThumbnail(hash, width, height);
+    if (thumbnail != nullptr && isUpToDate(*thumbnail, path)) {
+        QSize thumbnailSize;
+        QImage img = readImage(thumbnailFilePath(hash, *thumbnail), 0, 0, thumbnailSize);
+        // The file may have been removed by the user; create it again in that case.
+        if (!img.isNull()) {
+            origWidth = thumbnail->origWidth;
+            origHeight = thumbnail->origHeight;
+            thumbnail->lastUsed = ++m_useCounter;
+            scheduleSave();
+            return img;
         }
     }
 
-    if (update) {
-        QImage origImg = helper::getImage(path);
-        origWidth = origImg.width();
-        origHeight = origImg.height();
-        QImage img = scaledImage(origImg, width, height);
-        QString fileName = QString("%1_%2_%3_%4_%5_%6_.png")
-                               .arg(md5)
-                               .arg(width)
-                               .arg(height)
-                               .arg(origWidth)
-                               .arg(origHeight)
-                               .arg(getLastModified(path));
-        img.save(m_cacheDir.filePath(fileName), "png", -1);
-        return img;
+    QImage img = scaledImage(readImage(path.toString(), width, height, originalSize), width, height);
+    origWidth = originalSize.width();
+    origHeight = originalSize.height();
+
+    Thumbnail newThumbnail;
+    newThumbnail.width = width;
+    newThumbnail.height = height;
+    newThumbnail.origWidth = origWidth;
+    newThumbnail.origHeight = origHeight;
+    newThumbnail.lastModified = getLastModified(path);
+    storeThumbnail(hash, img, newThumbnail);
+
+    return img;
+}
+
+ImageCache::RequestId ImageCache::requestImage(mediaelch::FilePath path,
+    int width,
+    int height,
+    Priority priority,
+    QObject* receiver,
+    ImageCallback callback)
+{
+    const QString hash = pathHash(path);
+    const RequestId requestId = ++m_nextId;
+    Request request;
+    request.id = requestId;
+    request.receiver = receiver;
+    request.callback = std::move(callback);
+
+    // Another widget may already wait for the same thumbnail, e.g. after switching back and forth.
+    for (auto it = m_decodes.begin(); it != m_decodes.end(); ++it) {
+        if (it->hash == hash && it->width == width && it->height == height && !it->invalidated) {
+            it->requests.append(request);
+            m_requestDecodes.insert(requestId, it.key());
+            setRequestPriority(requestId, priority);
+            return requestId;
+        }
     }
 
-    return helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(files.first())));
+    const quint64 decodeId = ++m_nextId;
+    Decode decode;
+    decode.hash = hash;
+    decode.width = width;
+    decode.height = height;
+    decode.priority = priority;
+    decode.cancelled = std::make_shared<QAtomicInt>(0);
+    decode.taskState = std::make_shared<ImageDecodeTaskState>();
+    decode.requests.append(request);
+
+    auto* task = new DecodeTask(this, decodeId, decode.cancelled, decode.taskState);
+    task->sourceFile = path.toString();
+    task->width = width;
+    task->height = height;
+    if (m_cacheDir.isValid()) {
+        Thumbnail* thumbnail = findThumbnail(hash, width, height);
+        if (thumbnail != nullptr && isUpToDate(*thumbnail, path)) {
+            thumbnail->lastUsed = ++m_useCounter;
+            scheduleSave();
+            decode.thumbnail = *thumbnail;
+            task->thumbnailFile = thumbnailFilePath(hash, *thumbnail);
+            task->originalSize = QSize(thumbnail->origWidth, thumbnail->origHeight);
+        } else if (thumbnail != nullptr) {
+            removeThumbnail(hash, width, height);
+        }
+        decode.thumbnail.width = width;
+        decode.thumbnail.height = height;
+        decode.thumbnail.lastModified = getLastModified(path);
+        task->thumbnailBasePath = thumbnailBasePath(hash, width, height);
+        m_thumbnailWriters.insert(task->thumbnailBasePath, decodeId);
+    }
+    decode.task = task;
+    m_decodes.insert(decodeId, decode);
+    m_requestDecodes.insert(requestId, decodeId);
+    m_pool.start(task, static_cast<int>(priority));
+    return requestId;
 }
 
-QImage ImageCache::scaledImage(QImage img, int width, int height)
+void ImageCache::setRequestPriority(RequestId id, Priority priority)
 {
-    if (width != 0 && height != 0) {
-        return img.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    const auto it = m_decodes.find(m_requestDecodes.value(id, 0));
+    if (it == m_decodes.end() || it->priority >= priority) {
+        return;
     }
-    if (width != 0) {
-        return img.scaledToWidth(width, Qt::SmoothTransformation);
+    it->priority = priority;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    // Only queued tasks can be restarted; running ones are finished soon anyway.
+    // The lock keeps the task from starting, and being deleted, in the meantime.
+    if (it->task != nullptr) {
+        QMutexLocker locker(&it->taskState->lock);
+        if (!it->taskState->started && m_pool.tryTake(it->task)) {
+            m_pool.start(it->task, static_cast<int>(priority));
+        }
     }
-    if (height != 0) {
-        return img.scaledToHeight(height, Qt::SmoothTransformation);
+#endif
+}
+
+void ImageCache::cancelRequest(RequestId id)
+{
+    const quint64 decodeId = m_requestDecodes.take(id);
+    const auto it = m_decodes.find(decodeId);
+    if (it == m_decodes.end()) {
+        return;
     }
-    return img;
+    for (elch_size_t i = 0; i < it->requests.size(); ++i) {
+        if (it->requests[i].id == id) {
+            it->requests.remove(i);
+            break;
+        }
+    }
+    if (!it->requests.isEmpty()) {
+        return;
+    }
+    // Nobody waits for the image anymore, e.g. because another movie was selected.
+    // Queued tasks return immediately once they are started.
+    it->cancelled->storeRelease(1);
+    {
+        // Tasks that have not started yet never write a thumbnail. Running ones may still
+        // report a written file, which is removed in onImageDecoded().
+        QMutexLocker locker(&it->taskState->lock);
+        if (!it->taskState->started && m_cacheDir.isValid()) {
+            takeThumbnailWriter(decodeId, thumbnailBasePath(it->hash, it->width, it->height));
+        }
+    }
+    m_decodes.erase(it);
 }
 
-void ImageCache::invalidateImages(mediaelch::FilePath path)
+int ImageCache::pendingRequestCount() const
 {
-    if (!m_cacheDir.isValid()) {
+    return qsizetype_to_int(m_requestDecodes.size());
+}
+
+void ImageCache::onImageDecoded(quint64 decodeId, QImage image, QSize originalSize, QString thumbnailFile)
+{
+    // A newer decode or image() may have written the same file in the meantime.
+    // It must neither be removed nor indexed by this decode then.
+    const bool isLatestWriter =
+        !thumbnailFile.isEmpty() && takeThumbnailWriter(decodeId, thumbnailFile.left(thumbnailFile.lastIndexOf('.')));
+
+    const auto it = m_decodes.find(decodeId);
+    if (it == m_decodes.end()) {
+        // Cancelled after the image was decoded.
+        if (isLatestWriter) {
+            QFile::remove(thumbnailFile);
+        }
         return;
     }
+    // Callbacks may request other images, which changes m_decodes.
+    const Decode decode = *it;
+    m_decodes.erase(it);
+    for (const Request& request : decode.requests) {
+        m_requestDecodes.remove(request.id);
+    }
+    if (thumbnailFile.isEmpty() && m_cacheDir.isValid()) {
+        // No thumbnail was written, e.g. because the existing one could be read.
+        takeThumbnailWriter(decodeId, thumbnailBasePath(decode.hash, decode.width, decode.height));
+    }
+
+    if (isLatestWriter) {
+        if (decode.invalidated || !m_cacheDir.isValid()) {
+            QFile::remove(thumbnailFile);
+        } else {
+            Thumbnail thumbnail = decode.thumbnail;
+            thumbnail.origWidth = originalSize.width();
+            thumbnail.origHeight = originalSize.height();
+            addThumbnail(decode.hash, thumbnail, thumbnailFile);
+        }
+    }
 
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QDir dir = m_cacheDir.dir();
-    const QStringList entries = dir.entryList(QStringList() << md5 + "*");
-    for (const QString& file : entries) {
-        QFile f(dir.absolutePath() + "/" + file);
-        f.remove();
+    for (const Request& request : decode.requests) {
+        if (!request.receiver.isNull() && request.callback) {
+            request.callback(image, originalSize);
+        }
     }
 }
 
-QSize ImageCache::imageSize(mediaelch::FilePath path)
+void ImageCache::invalidateImages(mediaelch::FilePath path)
 {
+    const QString hash = pathHash(path);
+    for (Decode& decode : m_decodes) {
+        if (decode.hash == hash) {
+            decode.invalidated = true;
+        }
+    }
+
     if (!m_cacheDir.isValid()) {
-        return helper::getImage(path).size();
+        return;
     }
 
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_").arg(md5);
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (files.isEmpty() || files.first().split("_").count() < 7) {
-        return helper::getImage(path).size();
+    const auto it = m_thumbnails.constFind(hash);
+    if (it == m_thumbnails.constEnd()) {
+        return;
+    }
+    for (const Thumbnail& thumbnail : *it) {
+        QFile::remove(thumbnailFilePath(hash, thumbnail));
+        m_totalSize -= thumbnail.fileSize;
     }
+    m_thumbnails.remove(hash);
+    scheduleSave();
+}
 
-    QStringList parts = files.first().split("_");
-    if (!m_forceCache && parts.at(5).toInt() > 0 && getLastModified(path) != parts.at(5).toUInt()) {
-        return helper::getImage(path).size();
+QSize ImageCache::imageSize(mediaelch::FilePath path)
+{
+    if (!m_cacheDir.isValid()) {
+        return readImageSize(path.toString());
     }
 
-    return {parts.at(3).toInt(), parts.at(4).toInt()};
+    // All thumbnails of an image store the size of the original image.
+    const auto it = m_thumbnails.constFind(pathHash(path));
+    if (it == m_thumbnails.constEnd() || it->isEmpty() || !isUpToDate(it->first(), path)) {
+        return readImageSize(path.toString());
+    }
+    return {it->first().origWidth, it->first().origHeight};
 }
 
 qint64 ImageCache::getLastModified(const mediaelch::FilePath& fileName)
@@ -144,11 +508,253 @@ qint64 ImageCache::getLastModified(const mediaelch::FilePath& fileName)
 
 void ImageCache::clearCache()
 {
-    if (!m_cacheDir.isValid() || !Settings::instance()->advanced()->forceCache()) {
+    if (!m_cacheDir.isValid() || !m_forceCache) {
+        return;
+    }
+    for (Decode& decode : m_decodes) {
+        decode.invalidated = true;
+    }
+    removeAllFiles();
+    m_thumbnails.clear();
+    m_totalSize = 0;
+    m_indexChanged = false;
+}
+
+void ImageCache::saveIndex()
+{
+    m_saveTimer.stop();
+    if (!m_indexChanged || !m_cacheDir.isValid()) {
         return;
     }
-    const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
-    for (const QFileInfo& file : entries) {
-        QFile(file.absoluteFilePath()).remove();
+
+    QSaveFile file(m_cacheDir.filePath(indexFileName));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[ImageCache] Could not write index file:" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << indexMagic << indexVersion << quint32(thumbnailCount());
+    for (auto it = m_thumbnails.cbegin(); it != m_thumbnails.cend(); ++it) {
+        for (const Thumbnail& thumbnail : it.value()) {
+            out << it.key() << thumbnail.width << thumbnail.height << thumbnail.origWidth << thumbnail.origHeight
+                << thumbnail.lastModified << thumbnail.fileSize << thumbnail.lastUsed << thumbnail.isPng;
+        }
+    }
+    if (!file.commit()) {
+        qCWarning(generic) << "[ImageCache] Could not write index file:" << file.fileName();
+        return;
+    }
+    m_indexChanged = false;
+}
+
+int ImageCache::thumbnailCount() const
+{
+    int count = 0;
+    for (const QVector<Thumbnail>& thumbnails : m_thumbnails) {
+        count += qsizetype_to_int(thumbnails.size());
+    }
+    return count;
+}
+
+qint64 ImageCache::cacheSize() const
+{
+    return m_totalSize;
+}
+
+void ImageCache::loadIndex()
+{
+    QFile file(m_cacheDir.filePath(indexFileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Either a new cache or one of an older MediaElch version, which stored all
+        // metadata in file names in a single directory. Remove these thumbnails once.
+        removeAllFiles();
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != indexMagic || version != indexVersion) {
+        qCInfo(generic) << "[ImageCache] Unknown index format, removing all thumbnails";
+        file.close();
+        removeAllFiles();
+        return;
+    }
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString hash;
+        Thumbnail thumbnail;
+        in >> hash >> thumbnail.width >> thumbnail.height >> thumbnail.origWidth >> thumbnail.origHeight
+            >> thumbnail.lastModified >> thumbnail.fileSize >> thumbnail.lastUsed >> thumbnail.isPng;
+        m_thumbnails[hash].append(thumbnail);
+        m_totalSize += thumbnail.fileSize;
+        m_useCounter = qMax(m_useCounter, thumbnail.lastUsed);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(generic) << "[ImageCache] Index file is corrupt, removing all thumbnails";
+        file.close();
+        m_thumbnails.clear();
+        m_totalSize = 0;
+        removeAllFiles();
+        return;
+    }
+    qCDebug(generic) << "[ImageCache] Loaded index with" << count << "thumbnails," << m_totalSize << "bytes";
+}
+
+void ImageCache::scheduleSave()
+{
+    m_indexChanged = true;
+    if (!m_saveTimer.isActive()) {
+        m_saveTimer.start();
+    }
+}
+
+ImageCache::Thumbnail* ImageCache::findThumbnail(const QString& hash, int width, int height)
+{
+    auto it = m_thumbnails.find(hash);
+    if (it == m_thumbnails.end()) {
+        return nullptr;
+    }
+    for (Thumbnail& thumbnail : *it) {
+        if (thumbnail.width == width && thumbnail.height == height) {
+            return &thumbnail;
+        }
+    }
+    return nullptr;
+}
+
+bool ImageCache::isUpToDate(const Thumbnail& thumbnail, const mediaelch::FilePath& path)
+{
+    return m_forceCache || (thumbnail.lastModified > 0 && thumbnail.lastModified == getLastModified(path));
+}
+
+void ImageCache::storeThumbnail(const QString& hash, const QImage& img, Thumbnail thumbnail)
+{
+    if (img.isNull()) {
+        return;
+    }
+    removeThumbnail(hash, thumbnail.width, thumbnail.height);
+
+    QDir().mkpath(m_cacheDir.subDir(hash.left(2)).toString());
+    const QString basePath = thumbnailBasePath(hash, thumbnail.width, thumbnail.height);
+    if (m_thumbnailWriters.contains(basePath)) {
+        // Running decodes of the same thumbnail must not remove or index this file.
+        m_thumbnailWriters.insert(basePath, 0);
+    }
+    const QString fileName = writeThumbnail(img, basePath);
+    if (fileName.isEmpty()) {
+        qCWarning(generic) << "[ImageCache] Could not write thumbnail:" << basePath;
+        return;
+    }
+    addThumbnail(hash, thumbnail, fileName);
+}
+
+void ImageCache::addThumbnail(const QString& hash, Thumbnail thumbnail, const QString& fileName)
+{
+    thumbnail.isPng = fileName.endsWith(".png");
+    thumbnail.fileSize = QFileInfo(fileName).size();
+    thumbnail.lastUsed = ++m_useCounter;
+
+    QVector<Thumbnail>& thumbnails = m_thumbnails[hash];
+    for (elch_size_t i = 0; i < thumbnails.size(); ++i) {
+        if (thumbnails[i].width == thumbnail.width && thumbnails[i].height == thumbnail.height) {
+            // The new file may have overwritten the old one.
+            const QString oldFileName = thumbnailFilePath(hash, thumbnails[i]);
+            if (oldFileName != fileName) {
+                QFile::remove(oldFileName);
+            }
+            m_totalSize -= thumbnails[i].fileSize;
+            thumbnails.remove(i);
+            break;
+        }
+    }
+    thumbnails.append(thumbnail);
+    m_totalSize += thumbnail.fileSize;
+    scheduleSave();
+
+    if (m_totalSize > m_maxSizeBytes) {
+        evict();
+    }
+}
+
+void ImageCache::removeThumbnail(const QString& hash, int width, int height)
+{
+    auto it = m_thumbnails.find(hash);
+    if (it == m_thumbnails.end()) {
+        return;
+    }
+    QVector<Thumbnail>& thumbnails = it.value();
+    for (elch_size_t i = 0; i < thumbnails.size(); ++i) {
+        if (thumbnails[i].width == width && thumbnails[i].height == height) {
+            QFile::remove(thumbnailFilePath(hash, thumbnails[i]));
+            m_totalSize -= thumbnails[i].fileSize;
+            thumbnails.remove(i);
+            break;
+        }
+    }
+    if (thumbnails.isEmpty()) {
+        m_thumbnails.erase(it);
+    }
+    scheduleSave();
+}
+
+void ImageCache::evict()
+{
+    // Last use, hash, width and height of all thumbnails
+    QVector<std::tuple<quint64, QString, int, int>> byLastUse;
+    byLastUse.reserve(thumbnailCount());
+    for (auto it = m_thumbnails.cbegin(); it != m_thumbnails.cend(); ++it) {
+        for (const Thumbnail& thumbnail : it.value()) {
+            byLastUse.append(std::make_tuple(thumbnail.lastUsed, it.key(), thumbnail.width, thumbnail.height));
+        }
+    }
+    std::sort(byLastUse.begin(), byLastUse.end());
+
+    const qint64 targetSize = m_maxSizeBytes / 10 * 9;
+    for (const auto& entry : asConst(byLastUse)) {
+        if (m_totalSize <= targetSize) {
+            break;
+        }
+        removeThumbnail(std::get<1>(entry), std::get<2>(entry), std::get<3>(entry));
+    }
+    qCDebug(generic) << "[ImageCache] Cache size after cleanup:" << m_totalSize << "bytes";
+}
+
+QString ImageCache::thumbnailFilePath(const QString& hash, const Thumbnail& thumbnail) const
+{
+    return thumbnailBasePath(hash, thumbnail.width, thumbnail.height) + (thumbnail.isPng ? ".png" : ".jpg");
+}
+
+QString ImageCache::thumbnailBasePath(const QString& hash, int width, int height) const
+{
+    // Two levels so that directories don't end up with hundreds of thousands of files.
+    return m_cacheDir.subDir(hash.left(2)).filePath(QStringLiteral("%1_%2_%3").arg(hash).arg(width).arg(height));
+}
+
+void ImageCache::removeAllFiles()
+{
+    QDir dir(m_cacheDir.toString());
+    const auto entries = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo& entry : entries) {
+        if (entry.isDir()) {
+            QDir(entry.absoluteFilePath()).removeRecursively();
+        } else {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
+
+bool ImageCache::takeThumbnailWriter(quint64 decodeId, const QString& basePath)
+{
+    const auto it = m_thumbnailWriters.find(basePath);
+    if (it == m_thumbnailWriters.end() || it.value() != decodeId) {
+        return false;
     }
+    m_thumbnailWriters.erase(it);
+    return true;
 }
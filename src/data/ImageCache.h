@@ -2,27 +2,176 @@
 
 #include "file/Path.h"
 
+#include <QAtomicInt>
 #include <QHash>
 #include <QImage>
+#include <QObject>
+#include <QPointer>
 #include <QSize>
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
 #include <QVector>
+#include <functional>
+#include <memory>
 
+class QRunnable;
+struct ImageDecodeTaskState;
+
+/// \brief Cache for scaled images (thumbnails) that are shown in the UI.
+///
+/// Thumbnails are stored in subdirectories of the cache directory that are named after
+/// the first two characters of the MD5 hash of the original image's path. The size and
+/// modification time of each original image are stored in an index file that is loaded
+/// into memory once, so that lookups never list the cache directory.
+///
+/// Thumbnails are stored as JPEG unless they are transparent. If all thumbnails exceed
+/// the maximum size, the least recently used ones are removed.
+///
+/// Widgets should use requestImage(), which decodes and scales images in a thread pool.
+/// Apart from that, the cache is not thread safe and must only be used from the GUI thread.
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
+    /// \brief Id of an asynchronous request, see requestImage(). Zero is never a valid id.
+    using RequestId = quint64;
+    /// \brief Called with the scaled image and the size of the original image.
+    /// \details The image is null if the file could not be read.
+    using ImageCallback = std::function<void(QImage image, QSize originalSize)>;
+    /// \brief Requests with a higher priority are decoded first, e.g. images that are on screen.
+    enum class Priority : int
+    {
+        Low = 0,
+        High = 1
+    };
+
     explicit ImageCache(QObject* parent = nullptr);
+    /// \brief Creates a cache that stores thumbnails in the given directory.
+    /// \param cacheDir Existing directory. If invalid, nothing is cached.
+    /// \param maxSizeBytes Maximum size of all thumbnails.
+    /// \param forceCache If true, thumbnails are used even if the original image has changed.
+    ImageCache(mediaelch::DirectoryPath cacheDir, qint64 maxSizeBytes, bool forceCache, QObject* parent = nullptr);
+    ~ImageCache() override;
+
     static ImageCache* instance(QObject* parent = nullptr);
     QImage image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight);
     QSize imageSize(mediaelch::FilePath path);
+
+    /// \brief Loads the scaled image in a background thread.
+    /// \details Same as image() but the callback is called later on in the GUI thread, unless the
+    ///          request is cancelled or the receiver is destroyed. Requests for the same thumbnail
+    ///          are only decoded once.
+    RequestId requestImage(mediaelch::FilePath path,
+        int width,
+        int height,
+        Priority priority,
+        QObject* receiver,
+        ImageCallback callback);
+    /// \brief Raises the priority of a pending request, e.g. if the image is now on screen.
+    void setRequestPriority(RequestId id, Priority priority);
+    /// \brief Cancels a pending request. Does nothing if the request has finished already.
+    void cancelRequest(RequestId id);
+    int pendingRequestCount() const;
+
     void invalidateImages(mediaelch::FilePath path);
     void clearCache();
 
+    /// \brief Writes the index to disk if it has changed.
+    /// \details Called automatically a few seconds after the index has changed and on exit.
+    void saveIndex();
+    int thumbnailCount() const;
+    /// \brief Size of all thumbnails in bytes.
+    qint64 cacheSize() const;
+
 private:
+    struct Thumbnail
+    {
+        int width = 0;
+        int height = 0;
+        int origWidth = 0;
+        int origHeight = 0;
+        /// \brief Modification time of the original image in seconds since epoch.
+        qint64 lastModified = 0;
+        qint64 fileSize = 0;
+        /// \brief Larger values were used more recently.
+        quint64 lastUsed = 0;
+        bool isPng = false;
+    };
+
+    struct Request
+    {
+        RequestId id = 0;
+        QPointer<QObject> receiver;
+        ImageCallback callback;
+    };
+
+    /// \brief An image that is decoded in the thread pool, for one or more requests.
+    struct Decode
+    {
+        QString hash;
+        int width = 0;
+        int height = 0;
+        /// \brief Index entry for a new thumbnail.
+        Thumbnail thumbnail;
+        /// \brief The original image has changed while decoding, so the result is not cached.
+        bool invalidated = false;
+        Priority priority = Priority::Low;
+        /// \brief Owned by the thread pool. Only used to raise the priority of queued tasks.
+        /// \details Must only be accessed while the task has not started, see taskState.
+        QRunnable* task = nullptr;
+        std::shared_ptr<ImageDecodeTaskState> taskState;
+        std::shared_ptr<QAtomicInt> cancelled;
+        QVector<Request> requests;
+    };
+
+    qint64 getLastModified(const mediaelch::FilePath& fileName);
+
+    void loadIndex();
+    void scheduleSave();
+    Thumbnail* findThumbnail(const QString& hash, int width, int height);
+    bool isUpToDate(const Thumbnail& thumbnail, const mediaelch::FilePath& path);
+    void storeThumbnail(const QString& hash, const QImage& img, Thumbnail thumbnail);
+    /// \brief Adds an already written thumbnail file to the index and replaces the one with the same size.
+    void addThumbnail(const QString& hash, Thumbnail thumbnail, const QString& fileName);
+    void removeThumbnail(const QString& hash, int width, int height);
+    /// \brief Removes the least recently used thumbnails until the cache uses at most 90% of its maximum size.
+    void evict();
+    QString thumbnailFilePath(const QString& hash, const Thumbnail& thumbnail) const;
+    /// \brief Thumbnail file path without extension, see thumbnailFilePath().
+    QString thumbnailBasePath(const QString& hash, int width, int height) const;
+    /// \brief Removes all thumbnail files, including ones that are not in the index.
+    void removeAllFiles();
+    /// \brief   Whether the given decode is the latest one that writes the thumbnail file.
+    /// \details Forgets the decode if it is, i.e. must only be called once per decode.
+    /// \param basePath Thumbnail file path without extension, see thumbnailBasePath().
+    bool takeThumbnailWriter(quint64 decodeId, const QString& basePath);
+
+private slots:
+    /// \brief Called by decode tasks in the GUI thread.
+    /// \param thumbnailFile Newly written thumbnail or empty if none was written.
+    void onImageDecoded(quint64 decodeId, QImage image, QSize originalSize, QString thumbnailFile);
+
+private:
+
     mediaelch::DirectoryPath m_cacheDir;
     QHash<mediaelch::FilePath, QVector<qint64>> m_lastModifiedTimes;
-    QImage scaledImage(QImage img, int width, int height);
-    qint64 getLastModified(const mediaelch::FilePath& fileName);
-    bool m_forceCache;
+    /// \brief Thumbnails by MD5 hash of the original image's path.
+    QHash<QString, QVector<Thumbnail>> m_thumbnails;
+    qint64 m_totalSize = 0;
+    qint64 m_maxSizeBytes = 0;
+    quint64 m_useCounter = 0;
+    QTimer m_saveTimer;
+    bool m_indexChanged = false;
+    bool m_forceCache = false;
+
+    QThreadPool m_pool;
+    QHash<quint64, Decode> m_decodes;
+    /// \brief Decode id of each pending request.
+    QHash<RequestId, quint64> m_requestDecodes;
+    /// \brief   Generation token of each thumbnail file (by path without extension) that is written.
+    /// \details The id of the decode that wrote or writes it last, or 0 for synchronous writes.
+    ///          Decodes only remove or index a file if they are still its latest writer.
+    QHash<QString, quint64> m_thumbnailWriters;
+    quint64 m_nextId = 0;
 };
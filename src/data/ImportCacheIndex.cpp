@@ -0,0 +1,95 @@
+#include "data/ImportCacheIndex.h"
+
+#include "globals/Helper.h"
+#include "globals/Meta.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace mediaelch {
+
+void ImportCacheIndex::clear()
+{
+    m_entries.clear();
+    m_postings.clear();
+}
+
+void ImportCacheIndex::add(Entry entry)
+{
+    const int index = qsizetype_to_int(m_entries.size());
+    const TrigramCounts counts = trigrams(entry.fileName);
+    for (auto it = counts.cbegin(); it != counts.cend(); ++it) {
+        m_postings[it.key()].append({index, it.value()});
+    }
+    m_entries.append(std::move(entry));
+}
+
+int ImportCacheIndex::size() const
+{
+    return qsizetype_to_int(m_entries.size());
+}
+
+const ImportCacheIndex::Entry* ImportCacheIndex::bestMatch(const QString& fileName, double minSimilarity) const
+{
+    if (fileName.isEmpty() || m_entries.isEmpty()) {
+        return nullptr;
+    }
+
+    // Number of trigrams that each entry shares with the file name.
+    QVector<int> shared(m_entries.size(), 0);
+    QVector<int> candidates;
+    const TrigramCounts counts = trigrams(fileName);
+    for (auto it = counts.cbegin(); it != counts.cend(); ++it) {
+        const auto postings = m_postings.constFind(it.key());
+        if (postings == m_postings.constEnd()) {
+            continue;
+        }
+        for (const QPair<int, int>& posting : *postings) {
+            if (shared[posting.first] == 0) {
+                candidates.append(posting.first);
+            }
+            shared[posting.first] += qMin(it.value(), posting.second);
+        }
+    }
+    if (minSimilarity < 2.0 / 3.0) {
+        // Entries without a common trigram may be similar enough, see below.
+        candidates.resize(m_entries.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    } else {
+        std::sort(candidates.begin(), candidates.end());
+    }
+
+    const Entry* best = nullptr;
+    qreal bestSimilarity = minSimilarity;
+    for (int index : asConst(candidates)) {
+        const Entry& entry = m_entries[index];
+        const int maxLength = qsizetype_to_int(qMax(fileName.length(), entry.fileName.length()));
+        const int maxDistance = static_cast<int>(std::floor((1 - bestSimilarity) * maxLength + 1e-9));
+        // Each edit changes at most three trigrams. Strings of length n have n + 2 padded trigrams.
+        if (shared[index] < maxLength + 2 - 3 * maxDistance) {
+            continue;
+        }
+        const qreal similarity = helper::similarity(fileName, entry.fileName, bestSimilarity);
+        if (similarity > bestSimilarity) {
+            bestSimilarity = similarity;
+            best = &entry;
+        }
+    }
+    return best;
+}
+
+ImportCacheIndex::TrigramCounts ImportCacheIndex::trigrams(const QString& str)
+{
+    // Padding ensures that edits at the start and end of the string change three trigrams as well.
+    const QString padded = QString(2, QChar(0)) + str + QString(2, QChar(0));
+    TrigramCounts counts;
+    for (elch_size_t i = 0; i + 2 < padded.size(); ++i) {
+        const quint64 key = (quint64(padded[i].unicode()) << 32) | (quint64(padded[i + 1].unicode()) << 16)
+                            | quint64(padded[i + 2].unicode());
+        ++counts[key];
+    }
+    return counts;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief In-memory index of the import cache, i.e. of previously imported downloads.
+///
+/// Finds the most similar file name (see helper::similarity()) without comparing
+/// the file name to all entries: Two strings with a small edit distance share most
+/// of their trigrams, so only entries that share enough trigrams are compared.
+class ImportCacheIndex
+{
+public:
+    struct Entry
+    {
+        QString fileName;
+        QString type;
+        QString path;
+    };
+
+    void clear();
+    void add(Entry entry);
+    int size() const;
+
+    /// \brief Returns the entry whose file name is the most similar one to the given file name
+    ///        or nullptr if no file name has a similarity greater than minSimilarity.
+    /// \details If several entries are equally similar, the one that was added first is returned.
+    const Entry* bestMatch(const QString& fileName, double minSimilarity) const;
+
+private:
+    /// \brief Trigrams and how often they occur in a string.
+    using TrigramCounts = QHash<quint64, int>;
+    static TrigramCounts trigrams(const QString& str);
+
+    QVector<Entry> m_entries;
+    /// \brief Entry indices and trigram counts by trigram.
+    QHash<quint64, QVector<QPair<int, int>>> m_postings;
+};
+
+} // namespace mediaelch
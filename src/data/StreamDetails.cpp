@@ -1,6 +1,7 @@
 #include "StreamDetails.h"
 
 #include "data/MediaInfoFile.h"
+#include "data/StreamDetailsCache.h"
 #include "log/Log.h"
 
 #include <QApplication>
@@ -76,6 +77,15 @@ bool StreamDetails::loadStreamDetails()
         return false;
     }
 
+    // The key is created before m_files is changed for DVDs below.
+    mediaelch::StreamDetailsCache& cache = mediaelch::StreamDetailsCache::instance();
+    const QString cacheKey = mediaelch::StreamDetailsCache::key(m_files);
+    Values cached;
+    if (cache.find(cacheKey, cached)) {
+        setValues(cached);
+        return true;
+    }
+
     // If it's a DVD structure, compute the biggest part (main movie) and use this IFO file
     if (firstFile.endsWith("VIDEO_TS.IFO")) {
         QMap<QString, qint64> sizes;
@@ -106,7 +116,11 @@ bool StreamDetails::loadStreamDetails()
         }
     }
 
-    return loadWithLibrary();
+    const bool success = loadWithLibrary();
+    if (success) {
+        cache.insert(cacheKey, values());
+    }
+    return success;
 }
 
 bool StreamDetails::loadWithLibrary()
@@ -224,6 +238,28 @@ void StreamDetails::setSubtitleDetail(int streamNumber, SubtitleDetails key, QSt
     m_subtitles[streamNumber].insert(key, value);
 }
 
+StreamDetails::Values StreamDetails::values() const
+{
+    return {m_videoDetails, m_audioDetails, m_subtitles};
+}
+
+void StreamDetails::setValues(const Values& values)
+{
+    clear();
+    m_videoDetails = values.videoDetails;
+    // Use the setters so that available channels and qualities are updated as well.
+    for (int i = 0; i < values.audioDetails.size(); ++i) {
+        for (auto it = values.audioDetails[i].constBegin(); it != values.audioDetails[i].constEnd(); ++it) {
+            setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    for (int i = 0; i < values.subtitleDetails.size(); ++i) {
+        for (auto it = values.subtitleDetails[i].constBegin(); it != values.subtitleDetails[i].constEnd(); ++it) {
+            setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+}
+
 /**
  * \brief Access video details
  */
@@ -35,13 +35,27 @@ public:
         Language
     };
 
+    /// \brief All details as a plain value, e.g. to pass them between threads.
+    struct Values
+    {
+        QMap<VideoDetails, QString> videoDetails;
+        QVector<QMap<AudioDetails, QString>> audioDetails;
+        QVector<QMap<SubtitleDetails, QString>> subtitleDetails;
+    };
+
     static QString detailToString(VideoDetails details);
     static QString detailToString(AudioDetails details);
     static QString detailToString(SubtitleDetails details);
 
     /// \brief Loads stream details from the file. Returns true if successful.
+    /// \details Results are cached, see mediaelch::StreamDetailsCache. This function
+    ///          is thread safe as long as this object is only used by one thread.
     ELCH_NODISCARD bool loadStreamDetails();
 
+    Values values() const;
+    /// \brief Replaces all details with the given ones.
+    void setValues(const Values& values);
+
     void setVideoDetail(VideoDetails key, QString value);
     void setAudioDetail(int streamNumber, AudioDetails key, QString value);
     void setSubtitleDetail(int streamNumber, SubtitleDetails key, QString value);
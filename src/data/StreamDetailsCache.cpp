@@ -0,0 +1,70 @@
+#include "data/StreamDetailsCache.h"
+
+#include "globals/Meta.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStringList>
+
+namespace mediaelch {
+
+StreamDetailsCache& StreamDetailsCache::instance()
+{
+    static StreamDetailsCache s_instance;
+    return s_instance;
+}
+
+QString StreamDetailsCache::key(const FileList& files)
+{
+    QStringList parts;
+    for (const FilePath& file : files) {
+        const QFileInfo fi(file.toString());
+        if (!fi.exists()) {
+            return {};
+        }
+        parts << fi.absoluteFilePath() << QString::number(fi.size())
+              << QString::number(fi.lastModified().toMSecsSinceEpoch());
+    }
+    return parts.join('\n');
+}
+
+bool StreamDetailsCache::find(const QString& key, StreamDetails::Values& details) const
+{
+    if (key.isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&m_lock);
+    const auto it = m_cache.constFind(key);
+    if (it == m_cache.constEnd()) {
+        return false;
+    }
+    details = it.value();
+    return true;
+}
+
+void StreamDetailsCache::insert(const QString& key, const StreamDetails::Values& details)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_lock);
+    if (m_cache.size() >= maxCacheSize) {
+        m_cache.clear();
+    }
+    m_cache.insert(key, details);
+}
+
+int StreamDetailsCache::size() const
+{
+    QMutexLocker locker(&m_lock);
+    return qsizetype_to_int(m_cache.size());
+}
+
+void StreamDetailsCache::clear()
+{
+    QMutexLocker locker(&m_lock);
+    m_cache.clear();
+}
+
+} // namespace mediaelch
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+namespace mediaelch {
+
+/// \brief In-memory cache for stream details of media files.
+///
+/// Entries are identified by the paths, sizes and modification times of all files,
+/// so that changed files are probed again. Probing a file with MediaInfo is slow,
+/// especially on network shares, and stream details are loaded repeatedly, e.g. when
+/// a movie is saved after its stream details were loaded for the whole library.
+/// This class is thread safe.
+class StreamDetailsCache
+{
+public:
+    /// \brief Maximum number of entries. The cache is cleared if it is full.
+    static constexpr int maxCacheSize = 50000;
+
+    static StreamDetailsCache& instance();
+
+    /// \brief Returns the cache key for the given files or an empty string if a file does not exist.
+    static QString key(const FileList& files);
+
+    /// \brief Looks up the details for the given key. Returns false if there are none.
+    bool find(const QString& key, StreamDetails::Values& details) const;
+    /// \brief Stores the details for the given key. Does nothing if the key is empty.
+    void insert(const QString& key, const StreamDetails::Values& details);
+
+    int size() const;
+    void clear();
+
+private:
+    mutable QMutex m_lock;
+    QHash<QString, StreamDetails::Values> m_cache;
+};
+
+} // namespace mediaelch
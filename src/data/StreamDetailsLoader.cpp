@@ -0,0 +1,148 @@
+#include "data/StreamDetailsLoader.h"
+
+#include "data/MediaInfoFile.h"
+
+#include <QMutexLocker>
+#include <QRunnable>
+
+namespace mediaelch {
+
+class StreamDetailsLoader::ProbeTask : public QRunnable
+{
+public:
+    ProbeTask(StreamDetailsLoader* loader, int generation, int index, FileList files) :
+        m_loader{loader}, m_generation{generation}, m_index{index}, m_files{std::move(files)}
+    {
+    }
+
+    void run() override
+    {
+        {
+            QMutexLocker locker(&m_loader->m_lock);
+            if (m_generation != m_loader->m_generation) {
+                return;
+            }
+        }
+        // Created and destroyed in this worker thread.
+        StreamDetails details(nullptr, m_files);
+        Result result;
+        result.index = m_index;
+        result.success = details.loadStreamDetails();
+        if (result.success) {
+            result.details = details.values();
+        }
+        m_loader->addResult(m_generation, std::move(result));
+    }
+
+private:
+    StreamDetailsLoader* m_loader;
+    int m_generation;
+    int m_index;
+    FileList m_files;
+};
+
+StreamDetailsLoader::StreamDetailsLoader(QObject* parent) : QObject(parent)
+{
+    // Probing is mostly waiting for the disk or network, so use more threads than cores.
+    m_pool.setMaxThreadCount(4);
+}
+
+StreamDetailsLoader::~StreamDetailsLoader()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+void StreamDetailsLoader::setWorkerCount(int count)
+{
+    m_pool.setMaxThreadCount(qMax(1, count));
+}
+
+int StreamDetailsLoader::workerCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+bool StreamDetailsLoader::load(QVector<mediaelch::FileList> items)
+{
+    cancel();
+    // Load the library on this thread; loading it from several workers at once is not safe.
+    if (!MediaInfoFile::hasMediaInfo()) {
+        return false;
+    }
+
+    int generation = 0;
+    {
+        QMutexLocker locker(&m_lock);
+        generation = m_generation;
+    }
+    m_pending = qsizetype_to_int(items.size());
+    m_isRunning = true;
+
+    for (int i = 0; i < m_pending; ++i) {
+        m_pool.start(new ProbeTask(this, generation, i, std::move(items[i])));
+    }
+    if (m_pending == 0) {
+        QMetaObject::invokeMethod(this, "onResultsAvailable", Qt::QueuedConnection);
+    }
+    return true;
+}
+
+void StreamDetailsLoader::cancel()
+{
+    m_isRunning = false;
+    m_pending = 0;
+    // Tasks that have not started, yet, are removed. Running tasks drop their results.
+    m_pool.clear();
+    QMutexLocker locker(&m_lock);
+    ++m_generation;
+    m_results.clear();
+}
+
+bool StreamDetailsLoader::isRunning() const
+{
+    return m_isRunning;
+}
+
+void StreamDetailsLoader::addResult(int generation, Result result)
+{
+    QMutexLocker locker(&m_lock);
+    if (generation != m_generation) {
+        return;
+    }
+    // Results are reported in batches: Only notify if there is no pending notification.
+    const bool notify = m_results.isEmpty();
+    m_results.append(std::move(result));
+    if (notify) {
+        QMetaObject::invokeMethod(this, "onResultsAvailable", Qt::QueuedConnection);
+    }
+}
+
+void StreamDetailsLoader::onResultsAvailable()
+{
+    if (!m_isRunning) {
+        return;
+    }
+
+    QVector<Result> results;
+    {
+        QMutexLocker locker(&m_lock);
+        results.swap(m_results);
+    }
+
+    for (const Result& result : asConst(results)) {
+        --m_pending;
+        emit sigLoaded(result.index, result.success, result.details);
+        // A receiver may have cancelled loading.
+        if (!m_isRunning) {
+            return;
+        }
+    }
+
+    if (m_pending <= 0) {
+        m_isRunning = false;
+        emit sigFinished();
+    }
+}
+
+} // namespace mediaelch
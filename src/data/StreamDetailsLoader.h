@@ -0,0 +1,73 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+#include "globals/Meta.h"
+
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief Loads the stream details of many items in a thread pool.
+///
+/// Each item is a list of files, e.g. the files of a movie. The files are probed
+/// with MediaInfo by several workers at once, because MediaInfo instances are
+/// independent of each other. Results are reported on the loader's thread in the
+/// order in which they finish, so that they can be applied to the models while
+/// other files are still probed.
+class StreamDetailsLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StreamDetailsLoader(QObject* parent = nullptr);
+    /// \brief Cancels loading and waits for files that are probed right now.
+    ~StreamDetailsLoader() override;
+
+    /// \brief Number of files that are probed at the same time.
+    void setWorkerCount(int count);
+    int workerCount() const;
+
+    /// \brief Probe the files of all items in the background. Cancels a previous run.
+    /// \return False if MediaInfo is not available. No signal is emitted in that case.
+    ELCH_NODISCARD bool load(QVector<mediaelch::FileList> items);
+    /// \brief Don't report any further results.
+    /// \details Files that are probed right now are finished in the background.
+    void cancel();
+    bool isRunning() const;
+
+signals:
+    /// \brief Stream details of the item with the given index. Empty if success is false.
+    void sigLoaded(int index, bool success, StreamDetails::Values details);
+    /// \brief Emitted once all items are loaded. Not emitted if loading was cancelled.
+    void sigFinished();
+
+private slots:
+    void onResultsAvailable();
+
+private:
+    class ProbeTask;
+
+    struct Result
+    {
+        int index = 0;
+        bool success = false;
+        StreamDetails::Values details;
+    };
+
+    void addResult(int generation, Result result);
+
+    QThreadPool m_pool;
+    /// \brief Guards m_results and m_generation.
+    QMutex m_lock;
+    QVector<Result> m_results;
+    /// \brief Incremented for each run, so that results of cancelled runs are dropped.
+    int m_generation = 0;
+    int m_pending = 0;
+    bool m_isRunning = false;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,307 @@
+#include "export/CompiledTemplate.h"
+
+#include <QRegularExpression>
+
+namespace {
+
+const QString openToken = QStringLiteral("{{ ");
+const QString closeToken = QStringLiteral(" }}");
+const QString beginBlockPrefix = QStringLiteral("BEGIN_BLOCK_");
+const QString endBlockPrefix = QStringLiteral("END_BLOCK_");
+
+} // namespace
+
+namespace mediaelch {
+
+struct TemplateValues::Block
+{
+    QVector<TemplateValues> items;
+    QString separator;
+    QString content;
+    bool isRendered = false;
+};
+
+struct CompiledTemplate::Node
+{
+    enum class Type
+    {
+        Text,
+        Value,
+        Image,
+        Block
+    };
+
+    Type type = Type::Text;
+    /// \brief The text for text nodes, the placeholder's or block's name otherwise.
+    QString text;
+    /// \brief Template source of placeholders and blocks. Used if there is no value.
+    QString raw;
+    QString imageType;
+    QSize imageSize;
+    /// \brief The block's content that is repeated for each item.
+    CompiledTemplate children;
+};
+
+void TemplateValues::set(const QString& name, QString value)
+{
+    m_values.insert(name, std::move(value));
+}
+
+void TemplateValues::setBlock(const QString& blockName, QVector<TemplateValues> items, QString separator)
+{
+    auto block = std::make_shared<Block>();
+    block->items = std::move(items);
+    block->separator = std::move(separator);
+    m_blocks.insert(blockName, std::move(block));
+}
+
+void TemplateValues::setBlockContent(const QString& blockName, QString content)
+{
+    auto block = std::make_shared<Block>();
+    block->content = std::move(content);
+    block->isRendered = true;
+    m_blocks.insert(blockName, std::move(block));
+}
+
+void TemplateValues::setImageResolver(ImageResolver resolver)
+{
+    m_imageResolver = std::move(resolver);
+}
+
+CompiledTemplate::CompiledTemplate() : m_nodes{std::make_shared<const QVector<Node>>()}
+{
+}
+
+CompiledTemplate::CompiledTemplate(const QString& source)
+{
+    QVector<Node> nodes;
+    elch_size_t pos = 0;
+    bool foundEnd = false;
+    parse(source, pos, QString(), nodes, foundEnd);
+    m_nodes = std::make_shared<const QVector<Node>>(std::move(nodes));
+    m_sourceSize = source.size();
+}
+
+QString CompiledTemplate::render(const TemplateValues& values) const
+{
+    QString out;
+    out.reserve(m_sourceSize);
+    Scopes scopes{&values};
+    renderNodes(*m_nodes, scopes, out);
+    return out;
+}
+
+CompiledTemplate CompiledTemplate::block(const QString& blockName) const
+{
+    const Node* node = findBlock(*m_nodes, blockName);
+    return (node != nullptr) ? node->children : CompiledTemplate();
+}
+
+bool CompiledTemplate::containsBlock(const QString& blockName) const
+{
+    return findBlock(*m_nodes, blockName) != nullptr;
+}
+
+bool CompiledTemplate::isEmpty() const
+{
+    return m_nodes->isEmpty();
+}
+
+void CompiledTemplate::parse(const QString& source,
+    elch_size_t& pos,
+    const QString& endToken,
+    QVector<Node>& nodes,
+    bool& foundEnd)
+{
+    // Same syntax as the regular expression that was used before templates were compiled.
+    static const QRegularExpression imageRx(R"(^IMAGE\.(.*)\[(\d*), ?(\d*)\]$)",
+        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
+
+    const auto appendText = [&nodes](const QString& text) {
+        if (text.isEmpty()) {
+            return;
+        }
+        if (!nodes.isEmpty() && nodes.last().type == Node::Type::Text) {
+            nodes.last().text += text;
+        } else {
+            Node node;
+            node.text = text;
+            nodes.append(node);
+        }
+    };
+
+    foundEnd = false;
+    // Placeholders without special meaning stay part of the text.
+    elch_size_t textStart = pos;
+    while (true) {
+        const elch_size_t start = source.indexOf(openToken, pos);
+        if (start < 0) {
+            break;
+        }
+        const elch_size_t end = source.indexOf(closeToken, start + openToken.size());
+        if (end < 0) {
+            break;
+        }
+        const QString name = source.mid(start + openToken.size(), end - start - openToken.size());
+        if (name.contains(openToken)) {
+            // e.g. "{{ {{ MOVIE.TITLE }}": Only the inner one is a placeholder.
+            pos = start + 1;
+            continue;
+        }
+        const elch_size_t tokenEnd = end + closeToken.size();
+        pos = tokenEnd;
+
+        if (!endToken.isEmpty() && name == endToken) {
+            appendText(source.mid(textStart, start - textStart));
+            foundEnd = true;
+            return;
+        }
+
+        Node node;
+        if (name.startsWith(beginBlockPrefix)) {
+            const QString blockName = name.mid(beginBlockPrefix.size());
+            elch_size_t blockEnd = tokenEnd;
+            QVector<Node> children;
+            bool isBlock = false;
+            parse(source, blockEnd, endBlockPrefix + blockName, children, isBlock);
+            if (!isBlock) {
+                // Blocks without end are kept as they are.
+                continue;
+            }
+            trim(children);
+            node.type = Node::Type::Block;
+            node.text = blockName;
+            node.raw = source.mid(start, blockEnd - start);
+            node.children.m_nodes = std::make_shared<const QVector<Node>>(std::move(children));
+            node.children.m_sourceSize = blockEnd - tokenEnd;
+            pos = blockEnd;
+
+        } else {
+            node.raw = source.mid(start, tokenEnd - start);
+            node.text = name;
+            node.type = Node::Type::Value;
+            const QRegularExpressionMatch match = imageRx.match(name);
+            if (match.hasMatch()) {
+                node.imageType = match.captured(1).toLower();
+                node.imageSize = QSize(match.captured(2).toInt(), match.captured(3).toInt());
+                if (node.imageSize.isEmpty()) {
+                    continue;
+                }
+                node.type = Node::Type::Image;
+            }
+        }
+
+        appendText(source.mid(textStart, start - textStart));
+        nodes.append(node);
+        textStart = pos;
+    }
+
+    appendText(source.mid(textStart));
+    pos = source.size();
+}
+
+void CompiledTemplate::trim(QVector<Node>& nodes)
+{
+    // Block contents are trimmed, so that items can be joined without additional whitespace.
+    if (!nodes.isEmpty() && nodes.first().type == Node::Type::Text) {
+        QString& text = nodes.first().text;
+        elch_size_t i = 0;
+        while (i < text.size() && text.at(i).isSpace()) {
+            ++i;
+        }
+        text.remove(0, i);
+        if (text.isEmpty()) {
+            nodes.removeFirst();
+        }
+    }
+    if (!nodes.isEmpty() && nodes.last().type == Node::Type::Text) {
+        QString& text = nodes.last().text;
+        elch_size_t i = text.size();
+        while (i > 0 && text.at(i - 1).isSpace()) {
+            --i;
+        }
+        text.truncate(i);
+        if (text.isEmpty()) {
+            nodes.removeLast();
+        }
+    }
+}
+
+void CompiledTemplate::renderNodes(const QVector<Node>& nodes, Scopes& scopes, QString& out)
+{
+    for (const Node& node : nodes) {
+        switch (node.type) {
+        case Node::Type::Text: {
+            out += node.text;
+            break;
+        }
+        case Node::Type::Value: {
+            bool found = false;
+            for (elch_size_t i = scopes.size() - 1; i >= 0 && !found; --i) {
+                const auto it = scopes.at(i)->m_values.constFind(node.text);
+                if (it != scopes.at(i)->m_values.constEnd()) {
+                    out += it.value();
+                    found = true;
+                }
+            }
+            if (!found) {
+                out += node.raw;
+            }
+            break;
+        }
+        case Node::Type::Image: {
+            bool found = false;
+            QString replacement;
+            for (elch_size_t i = scopes.size() - 1; i >= 0 && !found; --i) {
+                const TemplateValues::ImageResolver& resolver = scopes.at(i)->m_imageResolver;
+                found = resolver && resolver(node.imageType, node.imageSize, replacement);
+            }
+            out += found ? replacement : node.raw;
+            break;
+        }
+        case Node::Type::Block: {
+            const TemplateValues::Block* block = nullptr;
+            for (elch_size_t i = scopes.size() - 1; i >= 0 && block == nullptr; --i) {
+                const auto it = scopes.at(i)->m_blocks.constFind(node.text);
+                if (it != scopes.at(i)->m_blocks.constEnd()) {
+                    block = it.value().get();
+                }
+            }
+            if (block == nullptr) {
+                out += node.raw;
+            } else if (block->isRendered) {
+                out += block->content;
+            } else {
+                for (elch_size_t i = 0; i < block->items.size(); ++i) {
+                    if (i > 0) {
+                        out += block->separator;
+                    }
+                    scopes.append(&block->items.at(i));
+                    renderNodes(*node.children.m_nodes, scopes, out);
+                    scopes.removeLast();
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+const CompiledTemplate::Node* CompiledTemplate::findBlock(const QVector<Node>& nodes, const QString& blockName)
+{
+    for (const Node& node : nodes) {
+        if (node.type != Node::Type::Block) {
+            continue;
+        }
+        if (node.text == blockName) {
+            return &node;
+        }
+        const Node* child = findBlock(*node.children.m_nodes, blockName);
+        if (child != nullptr) {
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace mediaelch
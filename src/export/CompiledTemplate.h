@@ -0,0 +1,83 @@
+#pragma once
+
+#include "globals/Meta.h"
+
+#include <QHash>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief Values for the placeholders of a CompiledTemplate.
+///
+/// Placeholders are written as "{{ NAME }}" in templates, e.g. "{{ MOVIE.TITLE }}".
+/// Blocks "{{ BEGIN_BLOCK_NAME }} ... {{ END_BLOCK_NAME }}" are repeated for each
+/// item of the block. If a value is not set for a block item, the values of the
+/// enclosing block are used, e.g. "{{ MOVIE.TITLE }}" inside of an actor block.
+class TemplateValues
+{
+public:
+    /// \brief Returns the replacement for an image placeholder "{{ IMAGE.type[width, height] }}".
+    /// \details Returns false if the image type is unknown. The enclosing values are
+    ///          asked in that case and the placeholder is kept if no one knows it.
+    using ImageResolver = std::function<bool(const QString& type, const QSize& size, QString& replacement)>;
+
+    /// \brief Sets the value of the placeholder "{{ name }}". The value is not escaped.
+    void set(const QString& name, QString value);
+    /// \brief Repeat the block for each item. Rendered items are joined with the separator.
+    void setBlock(const QString& blockName, QVector<TemplateValues> items, QString separator = " ");
+    /// \brief Replace the block with already rendered content.
+    void setBlockContent(const QString& blockName, QString content);
+    void setImageResolver(ImageResolver resolver);
+
+private:
+    friend class CompiledTemplate;
+    struct Block;
+
+    QHash<QString, QString> m_values;
+    /// \brief Blocks are immutable once set, so copies share them.
+    QHash<QString, std::shared_ptr<const Block>> m_blocks;
+    ImageResolver m_imageResolver;
+};
+
+/// \brief A template of the simple export engine that is parsed only once.
+///
+/// Rendering writes the template's text and the placeholders' values in a single
+/// pass instead of searching the whole template for each placeholder. Placeholders
+/// and blocks without values are kept as they are. Compiled templates are
+/// immutable and can be rendered by multiple threads at once.
+class CompiledTemplate
+{
+public:
+    CompiledTemplate();
+    explicit CompiledTemplate(const QString& source);
+
+    QString render(const TemplateValues& values) const;
+
+    /// \brief The content of the first block with the given name, e.g. to render list items separately.
+    /// \details Returns an empty template if there is no such block.
+    CompiledTemplate block(const QString& blockName) const;
+    bool containsBlock(const QString& blockName) const;
+    bool isEmpty() const;
+
+private:
+    struct Node;
+    using Scopes = QVector<const TemplateValues*>;
+
+    static void parse(const QString& source,
+        elch_size_t& pos,
+        const QString& endToken,
+        QVector<Node>& nodes,
+        bool& foundEnd);
+    static void trim(QVector<Node>& nodes);
+    static void renderNodes(const QVector<Node>& nodes, Scopes& scopes, QString& out);
+    static const Node* findBlock(const QVector<Node>& nodes, const QString& blockName);
+
+    std::shared_ptr<const QVector<Node>> m_nodes;
+    elch_size_t m_sourceSize = 0;
+};
+
+} // namespace mediaelch
@@ -8,6 +8,8 @@
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
+#include <cmath>
+
 static QString ratingsToString(const Ratings& ratings)
 {
     QStringList out;
@@ -98,6 +100,70 @@ static QString getStreamDetails(const StreamDetails* streamDetails, StreamDetail
 
 namespace mediaelch {
 
+static void writeMovieField(CsvExport& csv, CsvMovieExport::Field field, Movie& movie, const StreamDetails* st)
+{
+    using Field = CsvMovieExport::Field;
+    switch (field) {
+    case Field::Imdbid: csv.writeValue(movie.imdbId().toString()); return;
+    case Field::Tmdbid: csv.writeValue(movie.tmdbId().toString()); return;
+    case Field::Title: csv.writeValue(movie.name()); return;
+    case Field::OriginalTitle: csv.writeValue(movie.originalName()); return;
+    case Field::SortTitle: csv.writeValue(movie.sortTitle()); return;
+    case Field::Overview: csv.writeValue(movie.overview()); return;
+    case Field::Outline: csv.writeValue(movie.outline()); return;
+    case Field::Ratings: csv.writeValue(ratingsToString(movie.ratings())); return;
+    case Field::UserRating: csv.writeValue(movie.userRating()); return;
+    case Field::IsImdbTop250: csv.writeValue(movie.top250()); return;
+    case Field::ReleaseDate:
+        csv.writeValue(movie.released().isValid() ? movie.released().toString(Qt::ISODate) : QString{});
+        return;
+    case Field::Tagline: csv.writeValue(movie.tagline()); return;
+    case Field::Runtime: csv.writeValue(static_cast<int>(movie.runtime().count())); return;
+    case Field::Certification: csv.writeValue(movie.certification().toString()); return;
+    case Field::Writers: csv.writeValue(movie.writer()); return;
+    case Field::Directors: csv.writeValue(movie.director()); return;
+    case Field::Genres: csv.writeValue(movie.genres()); return;
+    case Field::Countries: csv.writeValue(movie.countries()); return;
+    case Field::Studios: csv.writeValue(movie.studios()); return;
+    case Field::Tags: csv.writeValue(movie.tags()); return;
+    case Field::Trailer: csv.writeValue(movie.trailer().toString()); return;
+    case Field::Actors: csv.writeValue(actorsToString(movie.actors())); return;
+    case Field::PlayCount: csv.writeValue(movie.playcount()); return;
+    case Field::LastPlayed: csv.writeValue(movie.lastPlayed().toString(Qt::ISODate)); return;
+    case Field::MovieSet: csv.writeValue(movie.set().name); return;
+    case Field::Directory: csv.writeValue(dirFromFileList(movie.files())); return;
+    case Field::Filenames: csv.writeValue(filesToString(movie.files())); return;
+    case Field::StreamDetails_Video_DurationInSeconds:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds));
+        return;
+    case Field::StreamDetails_Video_Aspect:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Aspect));
+        return;
+    case Field::StreamDetails_Video_Width:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Width));
+        return;
+    case Field::StreamDetails_Video_Height:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Height));
+        return;
+    case Field::StreamDetails_Video_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Codec));
+        return;
+    case Field::StreamDetails_Audio_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Language));
+        return;
+    case Field::StreamDetails_Audio_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Codec));
+        return;
+    case Field::StreamDetails_Audio_Channels:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Channels));
+        return;
+    case Field::StreamDetails_Subtitle_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::SubtitleDetails::Language));
+        return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -105,57 +171,21 @@ CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::F
 
 void CsvMovieExport::exportMovies(const QVector<Movie*>& movies, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
+    csv.writeHeader(fieldsToStrings());
 
     for (Movie* movie : asConst(movies)) {
-        const auto* st = movie->streamDetails();
-        csv.addRow({
-            {s(Field::Imdbid), movie->imdbId().toString()},
-            {s(Field::Tmdbid), movie->tmdbId().toString()},
-            {s(Field::Title), movie->name()},
-            {s(Field::OriginalTitle), movie->originalName()},
-            {s(Field::SortTitle), movie->sortTitle()},
-            {s(Field::Overview), movie->overview()},
-            {s(Field::Outline), movie->outline()},
-            {s(Field::Ratings), ratingsToString(movie->ratings())},
-            {s(Field::UserRating), QString::number(movie->userRating())},
-            {s(Field::IsImdbTop250), QString::number(movie->top250())},
-            {s(Field::ReleaseDate), movie->released().isValid() ? movie->released().toString(Qt::ISODate) : ""},
-            {s(Field::Tagline), movie->tagline()},
-            {s(Field::Runtime), QString::number(movie->runtime().count())},
-            {s(Field::Certification), movie->certification().toString()},
-            {s(Field::Writers), movie->writer()},
-            {s(Field::Directors), movie->director()},
-            {s(Field::Genres), movie->genres().join(", ")},
-            {s(Field::Countries), movie->countries().join(", ")},
-            {s(Field::Studios), movie->studios().join(", ")},
-            {s(Field::Tags), movie->tags().join(", ")},
-            {s(Field::Trailer), movie->trailer().toString()},
-            {s(Field::Actors), actorsToString(movie->actors())},
-            {s(Field::PlayCount), QString::number(movie->playcount())},
-            {s(Field::LastPlayed), movie->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::MovieSet), movie->set().name},
-            {s(Field::Directory), dirFromFileList(movie->files())},
-            {s(Field::Filenames), filesToString(movie->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-        });
+        if (isCanceled()) {
+            return;
+        }
+        const StreamDetails* st = movie->streamDetails();
+        csv.writeRow(m_fields, [&](Field field) { writeMovieField(csv, field, *movie, st); });
         callback();
     }
 }
@@ -212,6 +242,33 @@ QString CsvMovieExport::fieldToString(Field field)
     return "unknown";
 }
 
+static void writeTvShowField(CsvExport& csv, CsvTvShowExport::Field field, const TvShow& show)
+{
+    using Field = CsvTvShowExport::Field;
+    switch (field) {
+    case Field::ShowImdbId: csv.writeValue(show.imdbId().toString()); return;
+    case Field::ShowTmdbId: csv.writeValue(show.tmdbId().toString()); return;
+    case Field::ShowTvDbId: csv.writeValue(show.tvdbId().toString()); return;
+    case Field::ShowTvMazeId: csv.writeValue(show.tvmazeId().toString()); return;
+    case Field::ShowTitle: csv.writeValue(show.title()); return;
+    case Field::ShowSortTitle: csv.writeValue(show.sortTitle()); return;
+    case Field::ShowOriginalTitle: csv.writeValue(show.originalTitle()); return;
+    case Field::ShowFirstAired: csv.writeValue(show.firstAired().toString(Qt::ISODate)); return;
+    case Field::ShowNetwork: csv.writeValue(show.network()); return;
+    case Field::ShowGenres: csv.writeValue(show.genres()); return;
+    case Field::ShowCertification: csv.writeValue(show.certification().toString()); return;
+    case Field::ShowActors: csv.writeValue(actorsToString(show.actors())); return;
+    case Field::ShowTags: csv.writeValue(show.tags()); return;
+    case Field::ShowRuntime: csv.writeValue(static_cast<int>(show.runtime().count())); return;
+    case Field::ShowRatings: csv.writeValue(ratingsToString(show.ratings())); return;
+    case Field::ShowUserRating: csv.writeValue(show.userRating()); return;
+    case Field::ShowIsImdbTop250: csv.writeValue(show.top250()); return;
+    case Field::ShowOverview: csv.writeValue(show.overview()); return;
+    case Field::ShowDirectory: csv.writeValue(show.dir().toNativePathString()); return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -219,38 +276,20 @@ CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport
 
 void CsvTvShowExport::exportTvShows(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (TvShow* show : shows) {
-        csv.addRow({
-            {s(Field::ShowTmdbId), show->tmdbId().toString()},
-            {s(Field::ShowImdbId), show->imdbId().toString()},
-            {s(Field::ShowTvDbId), show->tvdbId().toString()},
-            {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-            {s(Field::ShowTitle), show->title()},
-            {s(Field::ShowSortTitle), show->sortTitle()},
-            {s(Field::ShowOriginalTitle), show->originalTitle()},
-            {s(Field::ShowFirstAired), show->firstAired().toString(Qt::ISODate)},
-            {s(Field::ShowNetwork), show->network()},
-            {s(Field::ShowCertification), show->certification().toString()},
-            {s(Field::ShowGenres), show->genres().join(", ")},
-            {s(Field::ShowTags), show->tags().join(", ")},
-            {s(Field::ShowRuntime), QString::number(show->runtime().count())},
-            {s(Field::ShowRatings), ratingsToString(show->ratings())},
-            {s(Field::ShowUserRating), QString::number(show->userRating())},
-            {s(Field::ShowActors), actorsToString(show->actors())},
-            {s(Field::ShowOverview), show->overview()},
-            {s(Field::ShowIsImdbTop250), QString::number(show->top250())},
-            {s(Field::ShowDirectory), show->dir().toNativePathString()} //
-        });
-
+    for (const TvShow* show : shows) {
+        if (isCanceled()) {
+            return;
+        }
+        csv.writeRow(m_fields, [&](Field field) { writeTvShowField(csv, field, *show); });
         callback();
     }
 }
@@ -291,6 +330,65 @@ QString CsvTvShowExport::fieldToString(CsvTvShowExport::Field field)
 }
 
 
+static void writeTvEpisodeField(CsvExport& csv,
+    CsvTvEpisodeExport::Field field,
+    const TvShow& show,
+    const TvShowEpisode& episode,
+    const StreamDetails* st)
+{
+    using Field = CsvTvEpisodeExport::Field;
+    switch (field) {
+    case Field::ShowImdbId: csv.writeValue(show.imdbId().toString()); return;
+    case Field::ShowTmdbId: csv.writeValue(show.tmdbId().toString()); return;
+    case Field::ShowTvDbId: csv.writeValue(show.tvdbId().toString()); return;
+    case Field::ShowTvMazeId: csv.writeValue(show.tvmazeId().toString()); return;
+    case Field::ShowTitle: csv.writeValue(show.title()); return;
+    case Field::EpisodeSeason: csv.writeValue(episode.seasonNumber().toString()); return;
+    case Field::EpisodeNumber: csv.writeValue(episode.episodeNumber().toString()); return;
+    case Field::EpisodeImdbId: csv.writeValue(episode.imdbId().toString()); return;
+    case Field::EpisodeTmdbId: csv.writeValue(episode.tmdbId().toString()); return;
+    case Field::EpisodeTvDbId: csv.writeValue(episode.tvdbId().toString()); return;
+    case Field::EpisodeTvMazeId: csv.writeValue(episode.tvmazeId().toString()); return;
+    case Field::EpisodeFirstAired: csv.writeValue(episode.firstAired().toString(Qt::ISODate)); return;
+    case Field::EpisodeTitle: csv.writeValue(episode.title()); return;
+    case Field::EpisodeOverview: csv.writeValue(episode.overview()); return;
+    case Field::EpisodeUserRating: csv.writeValue(episode.userRating()); return;
+    case Field::EpisodeWriters: csv.writeValue(episode.writers()); return;
+    case Field::EpisodeDirectors: csv.writeValue(episode.directors()); return;
+    case Field::EpisodeActors: csv.writeValue(actorsToString(episode.actors())); return;
+    case Field::EpisodeFilenames: csv.writeValue(filesToString(episode.files())); return;
+    case Field::EpisodeDirectory: csv.writeValue(dirFromFileList(episode.files())); return;
+    case Field::EpisodeStreamDetails_Video_DurationInSeconds:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds));
+        return;
+    case Field::EpisodeStreamDetails_Video_Aspect:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Aspect));
+        return;
+    case Field::EpisodeStreamDetails_Video_Width:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Width));
+        return;
+    case Field::EpisodeStreamDetails_Video_Height:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Height));
+        return;
+    case Field::EpisodeStreamDetails_Video_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Codec));
+        return;
+    case Field::EpisodeStreamDetails_Audio_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Language));
+        return;
+    case Field::EpisodeStreamDetails_Audio_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Codec));
+        return;
+    case Field::EpisodeStreamDetails_Audio_Channels:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Channels));
+        return;
+    case Field::EpisodeStreamDetails_Subtitle_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::SubtitleDetails::Language));
+        return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
     QVector<CsvTvEpisodeExport::Field> fields,
     QObject* parent) :
@@ -300,54 +398,22 @@ CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
 
 void CsvTvEpisodeExport::exportEpisodes(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (TvShow* show : shows) {
-        for (TvShowEpisode* episode : asConst(show->episodes())) {
-            const auto* st = episode->streamDetails();
-            csv.addRow({
-                {s(Field::ShowTmdbId), show->tmdbId().toString()},
-                {s(Field::ShowImdbId), show->imdbId().toString()},
-                {s(Field::ShowTvDbId), show->tvdbId().toString()},
-                {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-                {s(Field::ShowTitle), show->title()},
-                {s(Field::EpisodeSeason), episode->seasonNumber().toString()},
-                {s(Field::EpisodeNumber), episode->episodeNumber().toString()},
-                {s(Field::EpisodeTmdbId), episode->tmdbId().toString()},
-                {s(Field::EpisodeImdbId), episode->imdbId().toString()},
-                {s(Field::EpisodeTvDbId), episode->tvdbId().toString()},
-                {s(Field::EpisodeTvMazeId), episode->tvmazeId().toString()},
-                {s(Field::EpisodeFirstAired), episode->firstAired().toString(Qt::ISODate)},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeOverview), episode->overview()},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeUserRating), QString::number(episode->userRating())},
-                {s(Field::EpisodeActors), actorsToString(episode->actors())},
-                {s(Field::EpisodeDirectory), dirFromFileList(episode->files())},
-                {s(Field::EpisodeFilenames), filesToString(episode->files())},
-                {s(Field::EpisodeStreamDetails_Video_DurationInSeconds),
-                    getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-                {s(Field::EpisodeStreamDetails_Video_Aspect),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-                {s(Field::EpisodeStreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-                {s(Field::EpisodeStreamDetails_Video_Height),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-                {s(Field::EpisodeStreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Language),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-                {s(Field::EpisodeStreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Channels),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-                {s(Field::EpisodeStreamDetails_Subtitle_Language),
-                    getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-            });
+    csv.writeHeader(fieldsToStrings());
+
+    for (const TvShow* show : shows) {
+        for (const TvShowEpisode* episode : show->episodes()) {
+            if (isCanceled()) {
+                return;
+            }
+            const StreamDetails* st = episode->streamDetails();
+            csv.writeRow(m_fields, [&](Field field) { writeTvEpisodeField(csv, field, *show, *episode, st); });
         }
         callback();
     }
@@ -376,7 +442,7 @@ QString CsvTvEpisodeExport::fieldToString(CsvTvEpisodeExport::Field field)
     case Field::EpisodeTmdbId: return "episode_tmdb_id";
     case Field::EpisodeTvDbId: return "episode_tvdb_id";
     case Field::EpisodeTvMazeId: return "episode_tvmaze_id";
-    case Field::EpisodeFirstAired: return "episode_actors";
+    case Field::EpisodeFirstAired: return "episode_first_aired";
     case Field::EpisodeTitle: return "episode_title";
     case Field::EpisodeOverview: return "episode_overview";
     case Field::EpisodeUserRating: return "episode_user_rating";
@@ -398,6 +464,64 @@ QString CsvTvEpisodeExport::fieldToString(CsvTvEpisodeExport::Field field)
     return "unknown";
 }
 
+static void writeConcertField(CsvExport& csv,
+    CsvConcertExport::Field field,
+    const Concert& concert,
+    const StreamDetails* st)
+{
+    using Field = CsvConcertExport::Field;
+    switch (field) {
+    case Field::TmdbId: csv.writeValue(concert.tmdbId().toString()); return;
+    case Field::ImdbId: csv.writeValue(concert.imdbId().toString()); return;
+    case Field::Title: csv.writeValue(concert.title()); return;
+    case Field::OriginalTitle: csv.writeValue(concert.originalTitle()); return;
+    case Field::Artist: csv.writeValue(concert.artist()); return;
+    case Field::Album: csv.writeValue(concert.album()); return;
+    case Field::Overview: csv.writeValue(concert.overview()); return;
+    case Field::Ratings: csv.writeValue(ratingsToString(concert.ratings())); return;
+    case Field::UserRating: csv.writeValue(concert.userRating()); return;
+    case Field::ReleaseDate: csv.writeValue(concert.released().toString(Qt::ISODate)); return;
+    case Field::Tagline: csv.writeValue(concert.tagline()); return;
+    case Field::Runtime: csv.writeValue(static_cast<int>(concert.runtime().count())); return;
+    case Field::Certification: csv.writeValue(concert.certification().toString()); return;
+    case Field::Genres: csv.writeValue(concert.genres()); return;
+    case Field::Tags: csv.writeValue(concert.tags()); return;
+    case Field::TrailerUrl: csv.writeValue(concert.trailer().toString()); return;
+    case Field::Playcount: csv.writeValue(concert.playcount()); return;
+    case Field::LastPlayed: csv.writeValue(concert.lastPlayed().toString(Qt::ISODate)); return;
+    case Field::Filenames: csv.writeValue(filesToString(concert.files())); return;
+    case Field::Directory: csv.writeValue(dirFromFileList(concert.files())); return;
+    case Field::StreamDetails_Video_DurationInSeconds:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds));
+        return;
+    case Field::StreamDetails_Video_Aspect:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Aspect));
+        return;
+    case Field::StreamDetails_Video_Width:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Width));
+        return;
+    case Field::StreamDetails_Video_Height:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Height));
+        return;
+    case Field::StreamDetails_Video_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::VideoDetails::Codec));
+        return;
+    case Field::StreamDetails_Audio_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Language));
+        return;
+    case Field::StreamDetails_Audio_Codec:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Codec));
+        return;
+    case Field::StreamDetails_Audio_Channels:
+        csv.writeValue(getStreamDetails(st, StreamDetails::AudioDetails::Channels));
+        return;
+    case Field::StreamDetails_Subtitle_Language:
+        csv.writeValue(getStreamDetails(st, StreamDetails::SubtitleDetails::Language));
+        return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -405,51 +529,21 @@ CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExp
 
 void CsvConcertExport::exportConcerts(const QVector<Concert*>& concerts, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Concert* concert : asConst(concerts)) {
-        const auto* st = concert->streamDetails();
-        csv.addRow({
-            {s(Field::TmdbId), concert->tmdbId().toString()},
-            {s(Field::ImdbId), concert->imdbId().toString()},
-            {s(Field::Title), concert->title()},
-            {s(Field::OriginalTitle), concert->originalTitle()},
-            {s(Field::Artist), concert->artist()},
-            {s(Field::Album), concert->album()},
-            {s(Field::Overview), concert->overview()},
-            {s(Field::Ratings), ratingsToString(concert->ratings())},
-            {s(Field::UserRating), QString::number(concert->userRating())},
-            {s(Field::ReleaseDate), concert->released().toString(Qt::ISODate)},
-            {s(Field::Tagline), concert->tagline()},
-            {s(Field::Runtime), QString::number(concert->runtime().count())},
-            {s(Field::Certification), concert->certification().toString()},
-            {s(Field::Genres), concert->genres().join(", ")},
-            {s(Field::Tags), concert->tags().join(", ")},
-            {s(Field::TrailerUrl), concert->trailer().toString()},
-            {s(Field::Playcount), QString::number(concert->playcount())},
-            {s(Field::LastPlayed), concert->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::Directory), dirFromFileList(concert->files())},
-            {s(Field::Filenames), filesToString(concert->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-
-        });
+    for (const Concert* concert : asConst(concerts)) {
+        if (isCanceled()) {
+            return;
+        }
+        const StreamDetails* st = concert->streamDetails();
+        csv.writeRow(m_fields, [&](Field field) { writeConcertField(csv, field, *concert, st); });
         callback();
     }
 }
@@ -499,6 +593,27 @@ QString CsvConcertExport::fieldToString(CsvConcertExport::Field field)
     return "unknown";
 }
 
+static void writeArtistField(CsvExport& csv, CsvArtistExport::Field field, const Artist& artist)
+{
+    using Field = CsvArtistExport::Field;
+    switch (field) {
+    case Field::ArtistName: csv.writeValue(artist.name()); return;
+    case Field::ArtistGenres: csv.writeValue(artist.genres()); return;
+    case Field::ArtistStyles: csv.writeValue(artist.styles()); return;
+    case Field::ArtistMoods: csv.writeValue(artist.moods()); return;
+    case Field::ArtistYearsActive: csv.writeValue(artist.yearsActive()); return;
+    case Field::ArtistFormed: csv.writeValue(artist.formed()); return;
+    case Field::ArtistBiography: csv.writeValue(artist.biography()); return;
+    case Field::ArtistBorn: csv.writeValue(artist.born()); return;
+    case Field::ArtistDied: csv.writeValue(artist.died()); return;
+    case Field::ArtistDisbanded: csv.writeValue(artist.disbanded()); return;
+    case Field::ArtistMusicBrainzId: csv.writeValue(artist.mbId().toString()); return;
+    case Field::ArtistAllMusicId: csv.writeValue(artist.allMusicId().toString()); return;
+    case Field::ArtistDirectory: csv.writeValue(artist.path().toNativePathString()); return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -506,31 +621,20 @@ CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport
 
 void CsvArtistExport::exportArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
-        csv.addRow({
-            {s(Field::ArtistName), artist->name()},
-            {s(Field::ArtistGenres), artist->genres().join(", ")},
-            {s(Field::ArtistStyles), artist->styles().join(", ")},
-            {s(Field::ArtistMoods), artist->moods().join(", ")},
-            {s(Field::ArtistYearsActive), artist->yearsActive()},
-            {s(Field::ArtistFormed), artist->formed()},
-            {s(Field::ArtistBiography), artist->biography()},
-            {s(Field::ArtistBorn), artist->born()},
-            {s(Field::ArtistDied), artist->died()},
-            {s(Field::ArtistDisbanded), artist->disbanded()},
-            {s(Field::ArtistMusicBrainzId), artist->mbId().toString()},
-            {s(Field::ArtistAllMusicId), artist->allMusicId().toString()},
-            {s(Field::ArtistDirectory), artist->path().toNativePathString()} //
-        });
+    for (const Artist* artist : asConst(artists)) {
+        if (isCanceled()) {
+            return;
+        }
+        csv.writeRow(m_fields, [&](Field field) { writeArtistField(csv, field, *artist); });
         callback();
     }
 }
@@ -565,6 +669,29 @@ QString CsvArtistExport::fieldToString(CsvArtistExport::Field field)
 }
 
 
+static void writeAlbumField(CsvExport& csv, CsvAlbumExport::Field field, const Artist& artist, const Album& album)
+{
+    using Field = CsvAlbumExport::Field;
+    switch (field) {
+    case Field::ArtistName: csv.writeValue(artist.name()); return;
+    case Field::AlbumTitle: csv.writeValue(album.title()); return;
+    case Field::AlbumArtistName: csv.writeValue(album.artist()); return;
+    case Field::AlbumGenres: csv.writeValue(album.genres()); return;
+    case Field::AlbumStyles: csv.writeValue(album.styles()); return;
+    case Field::AlbumMoods: csv.writeValue(album.moods()); return;
+    case Field::AlbumReview: csv.writeValue(album.review()); return;
+    case Field::AlbumReleaseDate: csv.writeValue(album.releaseDate()); return;
+    case Field::AlbumLabel: csv.writeValue(album.label()); return;
+    case Field::AlbumRating: csv.writeValue(static_cast<double>(album.rating())); return;
+    case Field::AlbumYear: csv.writeValue(album.year()); return;
+    case Field::AlbumMusicBrainzId: csv.writeValue(album.mbAlbumId().toString()); return;
+    case Field::AlbumMusicBrainzReleaseGroupId: csv.writeValue(album.mbReleaseGroupId().toString()); return;
+    case Field::AlbumAllMusicId: csv.writeValue(album.allMusicId().toString()); return;
+    case Field::AlbumDirectory: csv.writeValue(album.path().toNativePathString()); return;
+    }
+    csv.writeValue(QString{});
+}
+
 CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -572,35 +699,22 @@ CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::F
 
 void CsvAlbumExport::exportAlbumsOfArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
+    if (m_fields.isEmpty()) {
+        return;
+    }
+
     CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
+    for (const Artist* artist : asConst(artists)) {
         const auto albums = artist->albums();
-        for (Album* album : albums) {
-            csv.addRow({
-                {s(Field::ArtistName), artist->name()},
-                {s(Field::AlbumTitle), album->title()},
-                {s(Field::AlbumArtistName), album->artist()},
-                {s(Field::AlbumGenres), album->genres().join(", ")},
-                {s(Field::AlbumStyles), album->styles().join(", ")},
-                {s(Field::AlbumMoods), album->moods().join(", ")},
-                {s(Field::AlbumReview), album->review()},
-                {s(Field::AlbumReleaseDate), album->releaseDate()},
-                {s(Field::AlbumLabel), album->label()},
-                {s(Field::AlbumRating), QString::number(album->rating())},
-                {s(Field::AlbumYear), QString::number(album->year())},
-                {s(Field::AlbumMusicBrainzId), album->mbAlbumId().toString()},
-                {s(Field::AlbumMusicBrainzReleaseGroupId), album->mbReleaseGroupId().toString()},
-                {s(Field::AlbumAllMusicId), album->allMusicId().toString()},
-                {s(Field::AlbumDirectory), album->path().toNativePathString()} //
-            });
+        for (const Album* album : albums) {
+            if (isCanceled()) {
+                return;
+            }
+            csv.writeRow(m_fields, [&](Field field) { writeAlbumField(csv, field, *artist, *album); });
         }
         callback();
     }
@@ -637,34 +751,36 @@ QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
     return "unknown";
 }
 
-void CsvExport::writeHeader()
+void CsvExport::writeHeader(const QVector<QString>& fieldNames)
 {
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(*i);
-    ++i;
+    writeRow(fieldNames, [this](const QString& name) { writeEscaped(name); });
+}
 
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(*i);
-    }
-    m_out << "\n";
+void CsvExport::writeValue(const QString& value)
+{
+    writeEscaped(value);
 }
 
-void CsvExport::addRow(const QMap<QString, QString>& values)
+void CsvExport::writeValue(const QStringList& values)
 {
-    if (m_fieldsInOrder.isEmpty()) {
-        return;
-    }
+    writeEscaped(values.join(", "));
+}
 
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(values.value(*i));
-    ++i;
+void CsvExport::writeValue(int value)
+{
+    // Numbers can't contain the separator, but negative ones start with '-'; see writeEscaped().
+    if (value < 0) {
+        m_out << "'";
+    }
+    m_out << value;
+}
 
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(values.value(*i));
+void CsvExport::writeValue(double value)
+{
+    if (std::signbit(value)) {
+        m_out << "'";
     }
-    m_out << "\n";
+    m_out << value;
 }
 
 void CsvExport::writeEscaped(const QString& text)
@@ -3,12 +3,12 @@
 #include "data/Rating.h"
 #include "globals/Meta.h"
 
-#include <QMap>
 #include <QObject>
-#include <QRegularExpression>
 #include <QString>
+#include <QStringList>
 #include <QTextStream>
 #include <QVector>
+#include <atomic>
 #include <functional>
 
 struct Actor;
@@ -29,11 +29,18 @@ public:
 public:
     void setSeparator(QString separator) { m_separator = std::move(separator); }
     void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
+    /// \brief If the given flag becomes true, the export stops after the current item.
+    /// \details The export may run in a worker thread, so the flag can be set from any thread.
+    void setCancelFlag(const std::atomic_bool* cancelFlag) { m_cancelFlag = cancelFlag; }
+
+protected:
+    bool isCanceled() const { return m_cancelFlag != nullptr && m_cancelFlag->load(); }
 
 protected:
     QTextStream& m_out;
     QString m_separator = "\t";
     QString m_replacement = " ";
+    const std::atomic_bool* m_cancelFlag = nullptr;
 };
 
 class CsvMovieExport final : public CsvMediaExport
@@ -341,6 +348,10 @@ private:
 };
 
 
+/// \brief Writes CSV rows directly into a text stream.
+/// \details Rows are not collected in memory. Each row is written field by
+///          field in the order of the header, so that the memory usage does
+///          not depend on the number of exported items.
 class CsvExport : public QObject
 {
     Q_OBJECT
@@ -348,20 +359,37 @@ class CsvExport : public QObject
 public:
     explicit CsvExport(QTextStream& outStream, QObject* parent = nullptr) : QObject(parent), m_out{outStream} {}
 
-    void setFieldsInOrder(QVector<QString> fieldsInOrder) { m_fieldsInOrder = std::move(fieldsInOrder); }
     void setSeparator(QString separator) { m_separator = std::move(separator); }
     void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
 
-    /// \brief Writes a CSV header using the given fieldsInOrder
-    void writeHeader();
-    void addRow(const QMap<QString, QString>& values);
+    /// \brief Writes a CSV header using the given field names.
+    void writeHeader(const QVector<QString>& fieldNames);
+
+    /// \brief Writes a single row. For each field, writeField(field) is called,
+    ///        which has to write exactly one value using writeValue().
+    template<class Field, class WriteField>
+    void writeRow(const QVector<Field>& fields, WriteField&& writeField)
+    {
+        for (elch_size_t i = 0; i < fields.size(); ++i) {
+            if (i > 0) {
+                m_out << m_separator;
+            }
+            writeField(fields.at(i));
+        }
+        m_out << '\n';
+    }
+
+    void writeValue(const QString& value);
+    /// \brief Writes the list joined by ", ".
+    void writeValue(const QStringList& values);
+    void writeValue(int value);
+    void writeValue(double value);
 
 private:
     void writeEscaped(const QString& text);
 
 private:
     QTextStream& m_out;
-    QVector<QString> m_fieldsInOrder;
     QString m_separator;
     QString m_replacement;
 };
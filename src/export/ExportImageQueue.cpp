@@ -0,0 +1,195 @@
+#include "export/ExportImageQueue.h"
+
+#include "globals/Meta.h"
+#include "log/Log.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMutexLocker>
+#include <QRunnable>
+
+namespace mediaelch {
+
+struct ExportImageQueue::Job
+{
+    QString sourceFile;
+    QSize size;
+    QDateTime sourceLastModified;
+    /// \brief Destinations that were added while the image is not written, yet.
+    QStringList pendingDestinations;
+    /// \brief Destination that contains the scaled image, set once done.
+    QString writtenFile;
+    bool isDone = false;
+};
+
+class ExportImageQueue::SaveTask : public QRunnable
+{
+public:
+    SaveTask(ExportImageQueue* queue, std::shared_ptr<Job> job) : m_queue{queue}, m_job{std::move(job)} {}
+    void run() override { m_queue->save(m_job); }
+
+private:
+    ExportImageQueue* m_queue;
+    std::shared_ptr<Job> m_job;
+};
+
+ExportImageQueue::ExportImageQueue(const std::atomic_bool& cancelFlag) : m_cancelFlag{cancelFlag}
+{
+}
+
+ExportImageQueue::~ExportImageQueue()
+{
+    m_pool.waitForDone();
+}
+
+void ExportImageQueue::add(const QString& sourceFile, const QString& destinationFile, const QSize& size)
+{
+    if (sourceFile.isEmpty() || destinationFile.isEmpty() || m_cancelFlag.load()) {
+        return;
+    }
+
+    const QString key = QStringLiteral("%1\n%2x%3\n%4")
+                            .arg(sourceFile)
+                            .arg(size.width())
+                            .arg(size.height())
+                            .arg(QFileInfo(destinationFile).suffix().toLower());
+
+    std::shared_ptr<Job> job;
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_destinations.contains(destinationFile)) {
+            return;
+        }
+        m_destinations.insert(destinationFile);
+
+        const auto it = m_jobs.constFind(key);
+        if (it == m_jobs.constEnd()) {
+            auto newJob = std::make_shared<Job>();
+            newJob->sourceFile = sourceFile;
+            newJob->size = size;
+            newJob->pendingDestinations << destinationFile;
+            m_jobs.insert(key, newJob);
+            m_pool.start(new SaveTask(this, newJob));
+            return;
+        }
+
+        job = it.value();
+        if (!job->isDone) {
+            job->pendingDestinations << destinationFile;
+            return;
+        }
+    }
+    // The image was already scaled, so copying it is cheap enough for the caller's thread.
+    copy(*job, job->writtenFile, destinationFile);
+}
+
+bool ExportImageQueue::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+int ExportImageQueue::scaledCount() const
+{
+    return m_scaledCount.load();
+}
+
+int ExportImageQueue::skippedCount() const
+{
+    return m_skippedCount.load();
+}
+
+void ExportImageQueue::save(const std::shared_ptr<Job>& job)
+{
+    // Only this task writes the job's data until it is done.
+    job->sourceLastModified = QFileInfo(job->sourceFile).lastModified();
+
+    QStringList destinations;
+    {
+        QMutexLocker locker(&m_lock);
+        destinations.swap(job->pendingDestinations);
+    }
+    const QString writtenFile = write(*job, destinations);
+
+    QStringList lateDestinations;
+    {
+        QMutexLocker locker(&m_lock);
+        job->writtenFile = writtenFile;
+        job->isDone = true;
+        lateDestinations.swap(job->pendingDestinations);
+    }
+    for (const QString& destination : asConst(lateDestinations)) {
+        copy(*job, writtenFile, destination);
+    }
+}
+
+QString ExportImageQueue::write(const Job& job, const QStringList& destinations)
+{
+    if (m_cancelFlag.load() || destinations.isEmpty()) {
+        return {};
+    }
+
+    QStringList outdated;
+    QString upToDate;
+    for (const QString& destination : destinations) {
+        if (isUpToDate(job, destination)) {
+            ++m_skippedCount;
+            upToDate = destination;
+        } else {
+            outdated << destination;
+        }
+    }
+    if (outdated.isEmpty()) {
+        return upToDate;
+    }
+
+    QString writtenFile = upToDate;
+    if (writtenFile.isEmpty()) {
+        QImage img(job.sourceFile);
+        if (img.isNull()) {
+            qCWarning(generic) << "[Export][SimpleEngine] Cannot load image:" << job.sourceFile;
+            return {};
+        }
+        img = img.scaled(job.size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        if (img.isNull()) {
+            qCWarning(generic) << "[Export][SimpleEngine] Could not scale (result was empty):" << job.sourceFile;
+            return {};
+        }
+        writtenFile = outdated.takeFirst();
+        if (!img.save(writtenFile)) {
+            qCWarning(generic) << "[Export][SimpleEngine] Could not save image:" << writtenFile;
+            return {};
+        }
+        ++m_scaledCount;
+    }
+
+    for (const QString& destination : asConst(outdated)) {
+        copy(job, writtenFile, destination);
+    }
+    return writtenFile;
+}
+
+void ExportImageQueue::copy(const Job& job, const QString& from, const QString& to)
+{
+    if (from.isEmpty() || m_cancelFlag.load()) {
+        return;
+    }
+    if (isUpToDate(job, to)) {
+        ++m_skippedCount;
+        return;
+    }
+    QFile::remove(to);
+    if (!QFile::copy(from, to)) {
+        qCWarning(generic) << "[Export][SimpleEngine] Could not copy image:" << from << "to" << to;
+    }
+}
+
+bool ExportImageQueue::isUpToDate(const Job& job, const QString& destination) const
+{
+    const QFileInfo destinationInfo(destination);
+    return destinationInfo.exists() && job.sourceLastModified.isValid()
+           && destinationInfo.lastModified() >= job.sourceLastModified;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief Saves scaled copies of images for the HTML export in a thread pool.
+///
+/// An image is identified by its source file, target size and target format.
+/// Each image is decoded and scaled only once, even if several pages request it.
+/// Further destinations get a copy of the scaled file. Destinations that exist
+/// and are not older than their source are not written again, so that
+/// exporting into the same directory again only processes changed images.
+/// This class is thread safe.
+class ExportImageQueue
+{
+public:
+    /// \param cancelFlag If it becomes true, no further images are saved.
+    explicit ExportImageQueue(const std::atomic_bool& cancelFlag);
+    /// \brief Waits until all images are saved.
+    ~ExportImageQueue();
+
+    /// \brief Save the source image scaled to the given size at the destination.
+    /// \details The image is saved in the background. The destination's format
+    ///          is derived from its file extension.
+    void add(const QString& sourceFile, const QString& destinationFile, const QSize& size);
+    /// \brief Returns true if all images were saved. Waits at most msecs milliseconds.
+    bool waitForDone(int msecs = -1);
+
+    /// \brief Number of images that were decoded and scaled.
+    int scaledCount() const;
+    /// \brief Number of destinations that were up to date.
+    int skippedCount() const;
+
+private:
+    struct Job;
+    class SaveTask;
+
+    void save(const std::shared_ptr<Job>& job);
+    /// \brief Writes the job's image to all destinations.
+    /// \return A destination that contains the image or an empty string on error.
+    QString write(const Job& job, const QStringList& destinations);
+    void copy(const Job& job, const QString& from, const QString& to);
+    bool isUpToDate(const Job& job, const QString& destination) const;
+
+    const std::atomic_bool& m_cancelFlag;
+    QThreadPool m_pool;
+    /// \brief Guards m_jobs, m_destinations and the jobs' pending destinations.
+    QMutex m_lock;
+    QHash<QString, std::shared_ptr<Job>> m_jobs;
+    QSet<QString> m_destinations;
+    std::atomic_int m_scaledCount{0};
+    std::atomic_int m_skippedCount{0};
+};
+
+} // namespace mediaelch
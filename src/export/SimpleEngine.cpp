@@ -1,6 +1,7 @@
 #include "export/SimpleEngine.h"
 
 #include "concerts/Concert.h"
+#include "data/Actor.h"
 #include "data/StreamDetails.h"
 #include "globals/Manager.h"
 #include "movies/Movie.h"
@@ -9,6 +10,8 @@
 
 #include <QApplication>
 #include <QEventLoop>
+#include <QRunnable>
+#include <QThreadPool>
 
 static QString colorLabelToString(ColorLabel label)
 {
@@ -25,13 +28,44 @@ static QString colorLabelToString(ColorLabel label)
     return "white";
 }
 
+namespace {
+
+class RenderTask : public QRunnable
+{
+public:
+    explicit RenderTask(std::function<void()> task) : m_task{std::move(task)} {}
+    void run() override { m_task(); }
+
+private:
+    std::function<void()> m_task;
+};
+
+QString joinItems(const QVector<QString>& items, const QString& separator)
+{
+    QString joined;
+    for (elch_size_t i = 0; i < items.size(); ++i) {
+        if (i > 0) {
+            joined += separator;
+        }
+        joined += items.at(i);
+    }
+    return joined;
+}
+
+QString dateTimeString(const QDateTime& dateTime)
+{
+    return dateTime.isValid() ? dateTime.toString("yyyy-MM-dd hh:mm") : "";
+}
+
+} // namespace
+
 namespace mediaelch {
 
 SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
     QDir directory,
     std::atomic_bool& cancelFlag,
     QObject* parent) :
-    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}
+    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}, m_images{cancelFlag}
 {
     // Create the base structure
     m_template->copyTo(mediaelch::DirectoryPath(m_dir));
@@ -40,441 +74,333 @@ SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
 void SimpleEngine::exportMovies(QVector<Movie*> movies)
 {
     std::sort(movies.begin(), movies.end(), Movie::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Movies);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Movie);
-
-    QString listMovieItem;
-    QString listMovieBlock;
-    QStringList movieList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_MOVIE \}\}(.*)\{\{ END_BLOCK_MOVIE \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listMovieBlock = match.captured(0);
-        listMovieItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::Movies));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::Movie));
+    const CompiledTemplate listMovieItem = listContent.block("MOVIE");
 
     m_dir.mkdir("movies");
     m_dir.mkdir("movie_images");
 
-    for (Movie* movie : movies) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
+    QVector<QString> movieList(movies.size());
+    QString* movieListItems = movieList.data();
+    renderInParallel(qsizetype_to_int(movies.size()), [&](int i) {
+        Movie* movie = movies.at(i);
+        TemplateValues values = movieValues(movie);
 
         // We can't replace an empty block...
         if (!listMovieItem.isEmpty()) {
-            QString m = listMovieItem;
-            replaceVars(m, movie);
-            movieList << m;
+            values.setImageResolver(imageResolver(movie, "movie", false));
+            movieListItems[i] = listMovieItem.render(values);
         }
 
         if (!itemContent.isEmpty()) {
-            QString movieTemplate = itemContent;
-            replaceVars(movieTemplate, movie, true);
-            QFile file(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(movieTemplate.toUtf8());
-                file.close();
-            }
+            values.setImageResolver(imageResolver(movie, "movie", true));
+            const QString fileName = m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId());
+            writeFile(fileName, itemContent.render(values));
         }
+    });
 
-        emit sigItemExported();
-        QApplication::processEvents();
-    }
-
-    // If the movie block is empty, replacing it would result in add a line break after each character
-    if (!listMovieBlock.isEmpty()) {
-        listContent.replace(listMovieBlock, movieList.join("\n"));
+    if (m_cancelFlag.load()) {
+        return;
     }
 
-    QFile file(m_dir.path() + "/movies.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
-    }
+    TemplateValues listValues;
+    listValues.setBlockContent("MOVIE", listMovieItem.isEmpty() ? QString() : joinItems(movieList, "\n"));
+    writeFile(m_dir.path() + "/movies.html", listContent.render(listValues));
 }
 
-void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
+TemplateValues SimpleEngine::movieValues(Movie* movie)
 {
-    m.replace("{{ MOVIE.ID }}", QString::number(movie->movieId(), 'f', 0));
-    m.replace("{{ MOVIE.LINK }}", QString("movies/%1.html").arg(movie->movieId()));
-    m.replace("{{ MOVIE.IMDB_ID }}", movie->imdbId().toString());
-    m.replace("{{ MOVIE.TMDB_ID }}", movie->tmdbId().toString());
-    m.replace("{{ MOVIE.TITLE }}", movie->name().toHtmlEscaped());
-    m.replace("{{ MOVIE.YEAR }}", movie->released().isValid() ? movie->released().toString("yyyy") : "");
-    m.replace("{{ MOVIE.ORIGINAL_TITLE }}", movie->originalName().toHtmlEscaped());
-    m.replace("{{ MOVIE.PLOT }}", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.PLOT_SIMPLE }}", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.SET }}", movie->set().name.toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGLINE }}", movie->tagline().toHtmlEscaped());
-    m.replace("{{ MOVIE.GENRES }}", movie->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.COUNTRIES }}", movie->countries().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.STUDIOS }}", movie->studios().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGS }}", movie->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.WRITER }}", movie->writer().toHtmlEscaped());
-    m.replace("{{ MOVIE.DIRECTOR }}", movie->director().toHtmlEscaped());
-    m.replace("{{ MOVIE.CERTIFICATION }}", movie->certification().toString().toHtmlEscaped());
-    m.replace("{{ MOVIE.TRAILER }}", movie->trailer().toString());
-    m.replace("{{ MOVIE.LABEL }}", colorLabelToString(movie->label()));
+    TemplateValues values;
+    values.set("MOVIE.ID", QString::number(movie->movieId(), 'f', 0));
+    values.set("MOVIE.LINK", QString("movies/%1.html").arg(movie->movieId()));
+    values.set("MOVIE.IMDB_ID", movie->imdbId().toString());
+    values.set("MOVIE.TMDB_ID", movie->tmdbId().toString());
+    values.set("MOVIE.TITLE", movie->name().toHtmlEscaped());
+    values.set("MOVIE.YEAR", movie->released().isValid() ? movie->released().toString("yyyy") : "");
+    values.set("MOVIE.ORIGINAL_TITLE", movie->originalName().toHtmlEscaped());
+    values.set("MOVIE.PLOT", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("MOVIE.PLOT_SIMPLE", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("MOVIE.SET", movie->set().name.toHtmlEscaped());
+    values.set("MOVIE.TAGLINE", movie->tagline().toHtmlEscaped());
+    values.set("MOVIE.GENRES", movie->genres().join(", ").toHtmlEscaped());
+    values.set("MOVIE.COUNTRIES", movie->countries().join(", ").toHtmlEscaped());
+    values.set("MOVIE.STUDIOS", movie->studios().join(", ").toHtmlEscaped());
+    values.set("MOVIE.TAGS", movie->tags().join(", ").toHtmlEscaped());
+    values.set("MOVIE.WRITER", movie->writer().toHtmlEscaped());
+    values.set("MOVIE.DIRECTOR", movie->director().toHtmlEscaped());
+    values.set("MOVIE.CERTIFICATION", movie->certification().toString().toHtmlEscaped());
+    values.set("MOVIE.TRAILER", movie->trailer().toString());
+    values.set("MOVIE.LABEL", colorLabelToString(movie->label()));
 
     // \todo multiple ratings
     if (!movie->ratings().isEmpty()) {
         double rating = movie->ratings().first().rating;
         int voteCount = movie->ratings().first().voteCount;
-        m.replace("{{ MOVIE.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ MOVIE.VOTES }}", QString::number(voteCount, 'f', 0));
+        values.set("MOVIE.RATING", QString::number(rating, 'f', 1));
+        values.set("MOVIE.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ MOVIE.RATING }}", "n/a");
-        m.replace("{{ MOVIE.VOTES }}", "n/a");
+        values.set("MOVIE.RATING", "n/a");
+        values.set("MOVIE.VOTES", "n/a");
     }
 
-    m.replace("{{ MOVIE.RUNTIME }}", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
-    m.replace("{{ MOVIE.PLAY_COUNT }}", QString::number(movie->playcount(), 'f', 0));
-    m.replace("{{ MOVIE.LAST_PLAYED }}",
-        movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace(
-        "{{ MOVIE.DATE_ADDED }}", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILE_LAST_MODIFIED }}",
-        movie->fileLastModified().isValid() ? movie->fileLastModified().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILENAME }}", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
+    values.set("MOVIE.RUNTIME", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
+    values.set("MOVIE.PLAY_COUNT", QString::number(movie->playcount(), 'f', 0));
+    values.set("MOVIE.LAST_PLAYED", dateTimeString(movie->lastPlayed()));
+    values.set("MOVIE.DATE_ADDED", dateTimeString(movie->dateAdded()));
+    values.set("MOVIE.FILE_LAST_MODIFIED", dateTimeString(movie->fileLastModified()));
     if (!movie->files().isEmpty()) {
         QFileInfo fi(movie->files().first().toString());
-        m.replace("{{ MOVIE.DIR }}", fi.absolutePath());
+        values.set("MOVIE.FILENAME", movie->files().first().toString());
+        values.set("MOVIE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ MOVIE.DIR }}", "");
-    }
-
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", movie->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", movie->genres());
-    replaceSingleBlock(m, "COUNTRIES", "COUNTRY.NAME", movie->countries());
-    replaceSingleBlock(m, "STUDIOS", "STUDIO.NAME", movie->studios());
-
-    QStringList actorNames;
-    QStringList actorRoles;
-    for (const Actor* actor : movie->actors()) {
-        actorNames << actor->name;
-        actorRoles << actor->role;
+        values.set("MOVIE.FILENAME", "");
+        values.set("MOVIE.DIR", "");
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
 
-    replaceStreamDetailsVars(m, movie->streamDetails());
-    replaceImages(m, subDir, movie, nullptr, nullptr, nullptr);
+    setSingleBlock(values, "TAGS", "TAG.NAME", movie->tags());
+    setSingleBlock(values, "GENRES", "GENRE.NAME", movie->genres());
+    setSingleBlock(values, "COUNTRIES", "COUNTRY.NAME", movie->countries());
+    setSingleBlock(values, "STUDIOS", "STUDIO.NAME", movie->studios());
+    setActorsBlock(values, movie->actors());
+    setStreamDetailsValues(values, movie->streamDetails());
+    return values;
 }
 
 void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
 {
     std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Concerts);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Concert);
-
-    QString listConcertItem;
-    QString listConcertBlock;
-    QStringList concertList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_CONCERT \}\}(.*)\{\{ END_BLOCK_CONCERT \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listConcertBlock = match.captured(0);
-        listConcertItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::Concerts));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::Concert));
+    const CompiledTemplate listConcertItem = listContent.block("CONCERT");
 
     m_dir.mkdir("concerts");
     m_dir.mkdir("concert_images");
 
-    for (const Concert* concert : concerts) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
-
-        QString concertTemplate = itemContent;
-        replaceVars(concertTemplate, concert, true);
-        QFile file(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()));
-        if (file.open(QFile::WriteOnly | QFile::Text)) {
-            file.write(concertTemplate.toUtf8());
-            file.close();
-        }
+    QVector<QString> concertList(concerts.size());
+    QString* concertListItems = concertList.data();
+    renderInParallel(qsizetype_to_int(concerts.size()), [&](int i) {
+        const Concert* concert = concerts.at(i);
+        TemplateValues values = concertValues(concert);
 
-        QString c = listConcertItem;
-        replaceVars(c, concert);
-        concertList << c;
-        emit sigItemExported();
-        QApplication::processEvents();
-    }
+        values.setImageResolver(imageResolver(concert, "concert", true));
+        writeFile(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()), itemContent.render(values));
 
-    listContent.replace(listConcertBlock, concertList.join("\n"));
+        values.setImageResolver(imageResolver(concert, "concert", false));
+        concertListItems[i] = listConcertItem.render(values);
+    });
 
-    QFile file(m_dir.path() + "/concerts.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (m_cancelFlag.load()) {
+        return;
     }
+
+    TemplateValues listValues;
+    listValues.setBlockContent("CONCERT", listConcertItem.isEmpty() ? QString() : joinItems(concertList, "\n"));
+    writeFile(m_dir.path() + "/concerts.html", listContent.render(listValues));
 }
 
-void SimpleEngine::replaceVars(QString& m, const Concert* concert, bool subDir)
+TemplateValues SimpleEngine::concertValues(const Concert* concert)
 {
-    m.replace("{{ CONCERT.ID }}", QString::number(concert->concertId(), 'f', 0));
-    m.replace("{{ CONCERT.LINK }}", QString("concerts/%1.html").arg(concert->concertId()));
-    m.replace("{{ CONCERT.TITLE }}", concert->title().toHtmlEscaped());
-    m.replace("{{ CONCERT.ARTIST }}", concert->artist().toHtmlEscaped());
-    m.replace("{{ CONCERT.ALBUM }}", concert->album().toHtmlEscaped());
-    m.replace("{{ CONCERT.TAGLINE }}", concert->tagline().toHtmlEscaped());
+    TemplateValues values;
+    values.set("CONCERT.ID", QString::number(concert->concertId(), 'f', 0));
+    values.set("CONCERT.LINK", QString("concerts/%1.html").arg(concert->concertId()));
+    values.set("CONCERT.TITLE", concert->title().toHtmlEscaped());
+    values.set("CONCERT.ARTIST", concert->artist().toHtmlEscaped());
+    values.set("CONCERT.ALBUM", concert->album().toHtmlEscaped());
+    values.set("CONCERT.TAGLINE", concert->tagline().toHtmlEscaped());
 
     if (concert->ratings().isEmpty()) {
-        m.replace("{{ CONCERT.RATING }}", "n/a");
+        values.set("CONCERT.RATING", "n/a");
     } else {
-        m.replace("{{ CONCERT.RATING }}", QString::number(concert->ratings().first().rating, 'f', 1));
+        values.set("CONCERT.RATING", QString::number(concert->ratings().first().rating, 'f', 1));
     }
 
-    m.replace("{{ CONCERT.YEAR }}", concert->released().isValid() ? concert->released().toString("yyyy") : "");
-    m.replace("{{ CONCERT.RUNTIME }}", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
-    m.replace("{{ CONCERT.CERTIFICATION }}", concert->certification().toString().toHtmlEscaped());
-    m.replace("{{ CONCERT.TRAILER }}", concert->trailer().toString());
-    m.replace("{{ CONCERT.PLAY_COUNT }}", QString::number(concert->playcount(), 'f', 0));
-    m.replace("{{ CONCERT.LAST_PLAYED }}",
-        concert->lastPlayed().isValid() ? concert->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
+    values.set("CONCERT.YEAR", concert->released().isValid() ? concert->released().toString("yyyy") : "");
+    values.set("CONCERT.RUNTIME", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
+    values.set("CONCERT.CERTIFICATION", concert->certification().toString().toHtmlEscaped());
+    values.set("CONCERT.TRAILER", concert->trailer().toString());
+    values.set("CONCERT.PLAY_COUNT", QString::number(concert->playcount(), 'f', 0));
+    values.set("CONCERT.LAST_PLAYED", dateTimeString(concert->lastPlayed()));
 
-    m.replace("{{ CONCERT.FILENAME }}", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
     if (!concert->files().isEmpty()) {
         QFileInfo fi(concert->files().first().toString());
-        m.replace("{{ CONCERT.DIR }}", fi.absolutePath());
+        values.set("CONCERT.FILENAME", concert->files().first().toString());
+        values.set("CONCERT.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ CONCERT.DIR }}", "");
+        values.set("CONCERT.FILENAME", "");
+        values.set("CONCERT.DIR", "");
     }
 
-    m.replace("{{ CONCERT.PLOT }}", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ CONCERT.TAGS }}", concert->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ CONCERT.GENRES }}", concert->genres().join(", ").toHtmlEscaped());
+    values.set("CONCERT.PLOT", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("CONCERT.TAGS", concert->tags().join(", ").toHtmlEscaped());
+    values.set("CONCERT.GENRES", concert->genres().join(", ").toHtmlEscaped());
 
-    replaceStreamDetailsVars(m, concert->streamDetails());
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", concert->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", concert->genres());
-    replaceImages(m, subDir, nullptr, concert, nullptr, nullptr);
+    setStreamDetailsValues(values, concert->streamDetails());
+    setSingleBlock(values, "TAGS", "TAG.NAME", concert->tags());
+    setSingleBlock(values, "GENRES", "GENRE.NAME", concert->genres());
+    return values;
 }
 
 void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
 {
     std::sort(shows.begin(), shows.end(), TvShow::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShows);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShow);
-    QString episodeContent = m_template->getTemplate(ExportTemplate::ExportSection::Episode);
-
-    QString listTvShowItem;
-    QString listTvShowBlock;
-    QStringList tvShowList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_TVSHOW \}\}(.*)\{\{ END_BLOCK_TVSHOW \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listTvShowBlock = match.captured(0);
-        listTvShowItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::TvShows));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::TvShow));
+    const CompiledTemplate episodeContent(m_template->getTemplate(ExportTemplate::ExportSection::Episode));
+    const CompiledTemplate listTvShowItem = listContent.block("TVSHOW");
 
     m_dir.mkdir("tvshows");
     m_dir.mkdir("tvshow_images");
     m_dir.mkdir("episodes");
     m_dir.mkdir("episode_images");
 
-    for (TvShow* show : shows) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
-
-        // tvshow.html - Single TV show
-        {
-            QString showTemplate = itemContent;
-            replaceVars(showTemplate, show, true);
-            QFile file(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(showTemplate.toUtf8());
-                file.close();
-            }
-            QApplication::processEvents();
-        }
-
-        // tvshows.html - All TV shows listed
-        {
-            QString showBlock = listTvShowItem;
-            replaceVars(showBlock, show, false);
-            tvShowList << showBlock;
-            emit sigItemExported();
-            QApplication::processEvents();
-        }
-
-        // episode.html - Single episode
+    // tvshow.html - Single TV show and tvshows.html - All TV shows listed
+    QVector<QString> tvShowList(shows.size());
+    QString* tvShowListItems = tvShowList.data();
+    renderInParallel(qsizetype_to_int(shows.size()), [&](int i) {
+        const TvShow* show = shows.at(i);
+        const TemplateValues showValues = tvShowValues(show, true, itemContent.containsBlock("SEASON"));
+        writeFile(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()), itemContent.render(showValues));
+
+        const TemplateValues listValues = tvShowValues(show, false, listTvShowItem.containsBlock("SEASON"));
+        tvShowListItems[i] = listTvShowItem.render(listValues);
+    });
+
+    // episode.html - Single episode
+    QVector<TvShowEpisode*> episodes;
+    for (TvShow* show : asConst(shows)) {
         for (TvShowEpisode* episode : show->episodes()) {
-            if (episode->isDummy()) {
-                continue;
+            if (!episode->isDummy()) {
+                episodes << episode;
             }
-            QString episodeTemplate = episodeContent;
-            replaceVars(episodeTemplate, episode, true);
-            QFile file(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(episodeTemplate.toUtf8());
-                file.close();
-            }
-            emit sigItemExported();
-            QApplication::processEvents();
         }
     }
+    renderInParallel(qsizetype_to_int(episodes.size()), [&](int i) {
+        const TvShowEpisode* episode = episodes.at(i);
+        TemplateValues values = episodeValues(episode);
+        values.setImageResolver(imageResolver(episode, "episode", true));
+        writeFile(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()), episodeContent.render(values));
+    });
 
-    listContent.replace(listTvShowBlock, tvShowList.join("\n"));
-
-    QFile file(m_dir.path() + "/tvshows.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (m_cancelFlag.load()) {
+        return;
     }
+
+    TemplateValues listValues;
+    listValues.setBlockContent("TVSHOW", listTvShowItem.isEmpty() ? QString() : joinItems(tvShowList, "\n"));
+    writeFile(m_dir.path() + "/tvshows.html", listContent.render(listValues));
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
+TemplateValues SimpleEngine::tvShowValues(const TvShow* show, bool subDir, bool withSeasons)
 {
-    m.replace("{{ TVSHOW.ID }}", QString::number(show->showId(), 'f', 0));
-    m.replace("{{ TVSHOW.LINK }}", QString("tvshows/%1.html").arg(show->showId()));
-    m.replace("{{ TVSHOW.IMDB_ID }}", show->imdbId().toString());
-    m.replace("{{ TVSHOW.TITLE }}", show->title().toHtmlEscaped());
-    m.replace("{{ TVSHOW.SORTTITLE }}", show->sortTitle().toHtmlEscaped());
-    m.replace("{{ TVSHOW.ORIGINALTITLE }}", show->originalTitle().toHtmlEscaped());
+    TemplateValues values;
+    values.set("TVSHOW.ID", QString::number(show->showId(), 'f', 0));
+    values.set("TVSHOW.LINK", QString("tvshows/%1.html").arg(show->showId()));
+    values.set("TVSHOW.IMDB_ID", show->imdbId().toString());
+    values.set("TVSHOW.TITLE", show->title().toHtmlEscaped());
+    values.set("TVSHOW.SORTTITLE", show->sortTitle().toHtmlEscaped());
+    values.set("TVSHOW.ORIGINALTITLE", show->originalTitle().toHtmlEscaped());
 
     // \todo multiple ratings
     if (!show->ratings().isEmpty()) {
         double rating = show->ratings().first().rating;
         int voteCount = show->ratings().first().voteCount;
-        m.replace("{{ TVSHOW.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ TVSHOW.VOTES }}", QString::number(voteCount, 'f', 0));
+        values.set("TVSHOW.RATING", QString::number(rating, 'f', 1));
+        values.set("TVSHOW.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ TVSHOW.RATING }}", "n/a");
-        m.replace("{{ TVSHOW.VOTES }}", "n/a");
+        values.set("TVSHOW.RATING", "n/a");
+        values.set("TVSHOW.VOTES", "n/a");
     }
 
-    m.replace("{{ TVSHOW.CERTIFICATION }}", show->certification().toString().toHtmlEscaped());
-    m.replace(
-        "{{ TVSHOW.FIRST_AIRED }}", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ TVSHOW.STUDIO }}", show->network().toHtmlEscaped());
-    m.replace("{{ TVSHOW.PLOT }}", show->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ TVSHOW.TAGS }}", show->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.GENRES }}", show->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.SEASONS_AMOUNT }}", QString::number(show->seasons(false).size()));
-
-    QStringList actorNames;
-    QStringList actorRoles;
-    for (const Actor* actor : show->actors()) {
-        actorNames << actor->name;
-        actorRoles << actor->role;
-    }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", show->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", show->genres());
-
-    QString listSeasonItem;
-    QString listSeasonBlock;
-    QStringList seasonList;
-
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_SEASON \}\}(.*)\{\{ END_BLOCK_SEASON \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    {
-        QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listSeasonBlock = match.captured(0);
-            listSeasonItem = match.captured(1).trimmed();
-        }
-    }
+    values.set("TVSHOW.CERTIFICATION", show->certification().toString().toHtmlEscaped());
+    values.set("TVSHOW.FIRST_AIRED", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
+    values.set("TVSHOW.STUDIO", show->network().toHtmlEscaped());
+    values.set("TVSHOW.PLOT", show->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("TVSHOW.TAGS", show->tags().join(", ").toHtmlEscaped());
+    values.set("TVSHOW.GENRES", show->genres().join(", ").toHtmlEscaped());
+    values.set("TVSHOW.SEASONS_AMOUNT", QString::number(show->seasons(false).size()));
 
-    if (listSeasonBlock.isEmpty() || listSeasonItem.isEmpty()) {
-        replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
-        return;
+    setActorsBlock(values, show->actors());
+    setSingleBlock(values, "TAGS", "TAG.NAME", show->tags());
+    setSingleBlock(values, "GENRES", "GENRE.NAME", show->genres());
+    values.setImageResolver(imageResolver(show, "tvshow", subDir));
+
+    if (!withSeasons) {
+        return values;
     }
 
+    QVector<TemplateValues> seasonItems;
     QVector<SeasonNumber> seasons = show->seasons(false);
     std::sort(seasons.begin(), seasons.end());
     for (const SeasonNumber& season : asConst(seasons)) {
         QVector<TvShowEpisode*> episodes = show->episodes(season);
         std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
-        QString s = listSeasonItem;
-        s.replace("{{ SEASON }}", season.toString());
-
-        QString listEpisodeItem;
-        QString listEpisodeBlock;
-        QStringList episodeList;
-
-        rx.setPattern(R"(\{\{ BEGIN_BLOCK_EPISODE \}\}(.*)\{\{ END_BLOCK_EPISODE \}\})");
-        QRegularExpressionMatchIterator matches = rx.globalMatch(s);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listEpisodeBlock = match.captured(0);
-            listEpisodeItem = match.captured(1).trimmed();
-        }
 
-        if (!listEpisodeItem.isEmpty()) {
-            for (TvShowEpisode* episode : asConst(episodes)) {
-                QString e = listEpisodeItem;
-                replaceVars(e, episode, subDir);
-                episodeList << e;
-            }
+        QVector<TemplateValues> episodeItems;
+        for (const TvShowEpisode* episode : asConst(episodes)) {
+            TemplateValues episodeItem = episodeValues(episode);
+            // Images that are unknown for episodes are resolved by the TV show.
+            episodeItem.setImageResolver(imageResolver(episode, "episode", subDir));
+            episodeItems << episodeItem;
         }
-        s.replace(listEpisodeBlock, episodeList.join("\n"));
-        seasonList << s;
-    }
 
-    m.replace(listSeasonBlock, seasonList.join("\n"));
-    replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
+        TemplateValues seasonItem;
+        seasonItem.set("SEASON", season.toString());
+        seasonItem.setBlock("EPISODE", episodeItems, "\n");
+        seasonItems << seasonItem;
+    }
+    values.setBlock("SEASON", seasonItems, "\n");
+    return values;
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShowEpisode* episode, bool subDir)
+TemplateValues SimpleEngine::episodeValues(const TvShowEpisode* episode)
 {
-    m.replace("{{ SHOW.TITLE }}", episode->tvShow()->title().toHtmlEscaped());
-    m.replace("{{ SHOW.LINK }}", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
-    m.replace("{{ EPISODE.LINK }}", QString("../episodes/%1.html").arg(episode->episodeId()));
-    m.replace("{{ EPISODE.TITLE }}", episode->title().toHtmlEscaped());
-    m.replace("{{ EPISODE.SEASON }}", episode->seasonString().toHtmlEscaped());
-    m.replace("{{ EPISODE.EPISODE }}", episode->episodeString().toHtmlEscaped());
+    TemplateValues values;
+    values.set("SHOW.TITLE", episode->tvShow()->title().toHtmlEscaped());
+    values.set("SHOW.LINK", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
+    values.set("EPISODE.LINK", QString("../episodes/%1.html").arg(episode->episodeId()));
+    values.set("EPISODE.TITLE", episode->title().toHtmlEscaped());
+    values.set("EPISODE.SEASON", episode->seasonString().toHtmlEscaped());
+    values.set("EPISODE.EPISODE", episode->episodeString().toHtmlEscaped());
     if (episode->ratings().isEmpty()) {
-        m.replace("{{ EPISODE.RATING }}", "n/a");
+        values.set("EPISODE.RATING", "n/a");
     } else {
-        m.replace("{{ EPISODE.RATING }}", QString::number(episode->ratings().first().rating, 'f', 1));
+        values.set("EPISODE.RATING", QString::number(episode->ratings().first().rating, 'f', 1));
     }
-    m.replace("{{ EPISODE.CERTIFICATION }}", episode->certification().toString().toHtmlEscaped());
-    m.replace("{{ EPISODE.FIRST_AIRED }}",
-        episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ EPISODE.LAST_PLAYED }}",
-        episode->lastPlayed().isValid() ? episode->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ EPISODE.STUDIO }}", episode->network().toHtmlEscaped());
-    m.replace("{{ EPISODE.PLOT }}", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ EPISODE.WRITERS }}", episode->writers().join(", ").toHtmlEscaped());
-    m.replace("{{ EPISODE.DIRECTORS }}", episode->directors().join(", ").toHtmlEscaped());
+    values.set("EPISODE.CERTIFICATION", episode->certification().toString().toHtmlEscaped());
+    values.set(
+        "EPISODE.FIRST_AIRED", episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
+    values.set("EPISODE.LAST_PLAYED", dateTimeString(episode->lastPlayed()));
+    values.set("EPISODE.STUDIO", episode->network().toHtmlEscaped());
+    values.set("EPISODE.PLOT", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("EPISODE.WRITERS", episode->writers().join(", ").toHtmlEscaped());
+    values.set("EPISODE.DIRECTORS", episode->directors().join(", ").toHtmlEscaped());
 
     if (!episode->files().isEmpty()) {
         QFileInfo fi(episode->files().first().toString());
-        m.replace("{{ EPISODE.DIR }}", fi.absolutePath());
+        values.set("EPISODE.DIR", fi.absolutePath());
+        values.set("EPISODE.FILENAME", episode->files().first().toString());
     } else {
-        m.replace("{{ EPISODE.DIR }}", "");
+        values.set("EPISODE.DIR", "");
+        values.set("EPISODE.FILENAME", "");
     }
-    m.replace("{{ EPISODE.FILENAME }}", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
 
-    replaceStreamDetailsVars(m, episode->streamDetails());
-    replaceSingleBlock(m, "WRITERS", "WRITER.NAME", episode->writers());
-    replaceSingleBlock(m, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
-    replaceImages(m, subDir, nullptr, nullptr, nullptr, episode);
+    setStreamDetailsValues(values, episode->streamDetails());
+    setSingleBlock(values, "WRITERS", "WRITER.NAME", episode->writers());
+    setSingleBlock(values, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
+    return values;
 }
 
-void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* details)
+void SimpleEngine::setStreamDetailsValues(TemplateValues& values, const StreamDetails* details)
 {
     const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
     const auto audioDetails = (details != nullptr) ? details->audioDetails() : decltype(details->audioDetails()){};
 
-    m.replace("{{ FILEINFO.WIDTH }}", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
-    m.replace("{{ FILEINFO.HEIGHT }}", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
-    m.replace("{{ FILEINFO.ASPECT }}", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
-    m.replace("{{ FILEINFO.CODEC }}", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
-    m.replace("{{ FILEINFO.DURATION }}", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
+    values.set("FILEINFO.WIDTH", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
+    values.set("FILEINFO.HEIGHT", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
+    values.set("FILEINFO.ASPECT", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
+    values.set("FILEINFO.CODEC", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
+    values.set("FILEINFO.DURATION", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
 
     QStringList audioCodecs;
     QStringList audioChannels;
@@ -484,9 +410,9 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
         audioChannels << audioDetails.at(i).value(StreamDetails::AudioDetails::Channels);
         audioLanguages << audioDetails.at(i).value(StreamDetails::AudioDetails::Language);
     }
-    m.replace("{{ FILEINFO.AUDIO.CODEC }}", audioCodecs.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.CHANNELS }}", audioChannels.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.LANGUAGE }}", audioLanguages.join("|"));
+    values.set("FILEINFO.AUDIO.CODEC", audioCodecs.join("|"));
+    values.set("FILEINFO.AUDIO.CHANNELS", audioChannels.join("|"));
+    values.set("FILEINFO.AUDIO.LANGUAGE", audioLanguages.join("|"));
 
     QStringList subtitleLanguages;
     if (details != nullptr) {
@@ -494,113 +420,103 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
             subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
         }
     }
-    m.replace("{{ FILEINFO.SUBTITLES.LANGUAGE }}", subtitleLanguages.join("|"));
+    values.set("FILEINFO.SUBTITLES.LANGUAGE", subtitleLanguages.join("|"));
 }
 
-void SimpleEngine::replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces)
+void SimpleEngine::setSingleBlock(TemplateValues& values,
+    const QString& blockName,
+    const QString& itemName,
+    QStringList items)
 {
-    replaceMultiBlock(m, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
+    QVector<TemplateValues> blockItems;
+    blockItems.reserve(items.size());
+    for (const QString& item : asConst(items)) {
+        TemplateValues blockItem;
+        blockItem.set(itemName, item.toHtmlEscaped());
+        blockItems << blockItem;
+    }
+    values.setBlock(blockName, blockItems);
 }
 
-void SimpleEngine::replaceMultiBlock(QString& m,
-    QString blockName,
-    QStringList itemNames,
-    QVector<QStringList> replaces)
+void SimpleEngine::setActorsBlock(TemplateValues& values, const Actors& actors)
 {
-    QRegularExpression rx("\\{\\{ BEGIN_BLOCK_" + blockName + R"( \}\}(.*)\{\{ END_BLOCK_)" + blockName + " \\}\\}", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatch match = rx.match(m);
-    if (match.hasMatch()) {
-        QString block = match.captured(0);
-        QString item = match.captured(1).trimmed();
-        QStringList list;
-        for (elch_size_t i = 0, n = replaces.at(0).count(); i < n; ++i) {
-            QString subItem = item;
-            for (elch_size_t x = 0, y = itemNames.count(); x < y; ++x) {
-                subItem.replace("{{ " + itemNames.at(x) + " }}", replaces.at(x).at(i).toHtmlEscaped());
-            }
-            list << subItem;
-        }
-        m.replace(block, list.join(" "));
-    }
+    QVector<TemplateValues> blockItems;
+    for (const Actor* actor : actors) {
+        TemplateValues blockItem;
+        blockItem.set("ACTOR.NAME", actor->name.toHtmlEscaped());
+        blockItem.set("ACTOR.ROLE", actor->role.toHtmlEscaped());
+        blockItems << blockItem;
+    }
+    values.setBlock("ACTORS", blockItems);
 }
 
-void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
+void SimpleEngine::renderInParallel(int count, const std::function<void(int)>& render)
 {
-    Q_UNUSED(format)
-    Q_UNUSED(quality)
+    QThreadPool pool;
+    std::atomic_int renderedCount{0};
+    for (int i = 0; i < count; ++i) {
+        pool.start(new RenderTask([this, i, &render, &renderedCount]() {
+            if (!m_cancelFlag.load()) {
+                render(i);
+                ++renderedCount;
+            }
+        }));
+    }
 
-    QImage img(imageFile);
-    if (img.isNull()) {
-        qCWarning(generic) << "[Export][SimpleEngine] Cannot load image:" << imageFile;
-        return;
+    int reportedCount = 0;
+    const auto reportProgress = [&]() {
+        for (const int rendered = renderedCount.load(); reportedCount < rendered; ++reportedCount) {
+            emit sigItemExported();
+        }
+    };
+    while (!pool.waitForDone(50)) {
+        reportProgress();
+        QApplication::processEvents();
     }
+    reportProgress();
 
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    // Images are saved while items are rendered, but some may still be pending.
+    while (!m_images.waitForDone(50)) {
+        QApplication::processEvents();
+    }
+}
 
-    if (!img.isNull()) {
-        img.save(destinationFile);
-    } else {
-        qCWarning(generic) << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
+void SimpleEngine::writeFile(const QString& fileName, const QString& content)
+{
+    QFile file(fileName);
+    if (file.open(QFile::WriteOnly | QFile::Text)) {
+        file.write(content.toUtf8());
+        file.close();
     }
 }
 
-void SimpleEngine::replaceImages(QString& m,
-    const bool& subDir,
-    const Movie* movie,
-    const Concert* concert,
-    const TvShow* tvShow,
-    const TvShowEpisode* episode)
+void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
 {
-    QString item;
-    QSize size;
-    QRegularExpression rx(R"(\{\{ IMAGE.(.*)\[(\d*), ?(\d*)\] \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        item = match.captured(0);
-        QString type = match.captured(1).toLower();
-        size.setWidth(match.captured(2).toInt());
-        size.setHeight(match.captured(3).toInt());
-
-        if (item.isEmpty() || size.isEmpty()) {
-            continue;
-        }
+    Q_UNUSED(format)
+    Q_UNUSED(quality)
+    // The format is derived from the destination's extension.
+    m_images.add(imageFile, destinationFile, size);
+}
 
+template<class T>
+TemplateValues::ImageResolver SimpleEngine::imageResolver(const T* item, const QString& typeName, bool subDir)
+{
+    return [this, item, typeName, subDir](const QString& type, const QSize& size, QString& replacement) {
         QString destFile;
-        bool imageSaved = false;
         bool isPlaceholderUsed = true;
-        QString typeName;
-        if (movie != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
-            typeName = "movie";
-
-        } else if (concert != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, concert, &isPlaceholderUsed);
-            typeName = "concert";
-
-        } else if (tvShow != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
-            typeName = "tvshow";
-
-        } else if (episode != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
-            typeName = "episode";
-        }
-
+        const bool imageSaved = saveImageForType(type, size, destFile, item, &isPlaceholderUsed);
         if (!isPlaceholderUsed) {
-            continue;
+            return false;
         }
-
         if (imageSaved) {
-            m.replace(item, (subDir ? "../" : "") + destFile);
+            replacement = (subDir ? "../" : "") + destFile;
         } else {
-            m.replace(item,
+            replacement =
                 (subDir ? "../" : "")
-                    + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height()));
+                + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height());
         }
-    }
+        return true;
+    };
 }
 
 bool SimpleEngine::saveImageForType(const QString& type,
@@ -680,7 +596,7 @@ bool SimpleEngine::saveImageForType(const QString& type,
     *isPlaceHolderUsed = true;
 
     QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
+    destFile = "concert_images/"
                + QString("%1-%2_%3x%4.%5")
                      .arg(concert->concertId())
                      .arg(type)
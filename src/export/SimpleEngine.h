@@ -1,21 +1,27 @@
 #pragma once
 
+#include "export/CompiledTemplate.h"
+#include "export/ExportImageQueue.h"
 #include "export/ExportTemplate.h"
 
 #include <QDir>
 #include <QObject>
 #include <atomic>
+#include <functional>
 
 class Concert;
 class Movie;
 class TvShow;
 class TvShowEpisode;
 class StreamDetails;
+class Actors;
 
 namespace mediaelch {
 
-/// Default export engine for MediaElch. Simple find&replace semantics,
-/// only basic functionality (e.g. condintional block)
+/// Default export engine for MediaElch. Each template file is compiled once
+/// per export into a CompiledTemplate that supports placeholders and
+/// (repeated) blocks. The pages of all items are rendered by multiple threads
+/// and images are scaled in the background, see ExportImageQueue.
 class SimpleEngine : public QObject
 {
     Q_OBJECT
@@ -36,13 +42,15 @@ public:
     void exportTvShows(QVector<TvShow*> shows);
 
 private:
+    /// \brief Calls render(i) for each i in [0, count) in a thread pool.
+    /// \details Waits until all items are rendered and their images are saved while
+    ///          keeping the UI responsive. Emits sigItemExported() for each rendered item.
+    void renderInParallel(int count, const std::function<void(int)>& render);
+    void writeFile(const QString& fileName, const QString& content);
+
     void saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality);
-    void replaceImages(QString& m,
-        const bool& subDir,
-        const Movie* movie,
-        const Concert* concert,
-        const TvShow* tvShow,
-        const TvShowEpisode* episode);
+    template<class T>
+    TemplateValues::ImageResolver imageResolver(const T* item, const QString& typeName, bool subDir);
     bool saveImageForType(const QString& type,
         const QSize& size,
         QString& destFile,
@@ -63,18 +71,21 @@ private:
         QString& destFile,
         const TvShowEpisode* episode,
         bool* isPlaceHolderUsed);
-    void replaceVars(QString& m, Movie* movie, bool subDir = false);
-    void replaceVars(QString& m, const Concert* concert, bool subDir = false);
-    void replaceVars(QString& m, const TvShow* show, bool subDir = false);
-    void replaceVars(QString& m, const TvShowEpisode* episode, bool subDir = false);
-    void replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces);
-    void replaceMultiBlock(QString& m, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
-    void replaceStreamDetailsVars(QString& m, const StreamDetails* details);
+
+    // The values don't contain images, see imageResolver().
+    TemplateValues movieValues(Movie* movie);
+    TemplateValues concertValues(const Concert* concert);
+    TemplateValues tvShowValues(const TvShow* show, bool subDir, bool withSeasons);
+    TemplateValues episodeValues(const TvShowEpisode* episode);
+    void setSingleBlock(TemplateValues& values, const QString& blockName, const QString& itemName, QStringList items);
+    void setActorsBlock(TemplateValues& values, const Actors& actors);
+    void setStreamDetailsValues(TemplateValues& values, const StreamDetails* details);
 
 private:
     std::atomic_bool& m_cancelFlag;
     ExportTemplate* m_template = nullptr;
     QDir m_dir;
+    ExportImageQueue m_images;
 };
 
 } // namespace mediaelch
@@ -1,7 +1,21 @@
 #include "file/FileFilter.h"
 
+#include <algorithm>
+
 namespace mediaelch {
 
+FileFilter::FileFilter(QStringList filters) : m_filters(std::move(filters))
+{
+    for (const QString& filter : m_filters) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+        m_patterns << QRegExp(filter, Qt::CaseInsensitive, QRegExp::Wildcard);
+#else
+        m_patterns << QRegularExpression(
+            QRegularExpression::wildcardToRegularExpression(filter), QRegularExpression::CaseInsensitiveOption);
+#endif
+    }
+}
+
 QStringList FileFilter::files(QDir directory) const
 {
     if (m_filters.isEmpty() || !directory.exists()) {
@@ -10,6 +24,19 @@ QStringList FileFilter::files(QDir directory) const
     return directory.entryList(m_filters, QDir::Files | QDir::System);
 }
 
+bool FileFilter::matches(const QString& fileName) const
+{
+    return std::any_of(m_patterns.cbegin(), m_patterns.cend(), [&fileName](const Pattern& pattern) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+        // QRegExp stores the state of the last match, so a copy is used per call.
+        Pattern rx = pattern;
+        return rx.exactMatch(fileName);
+#else
+        return pattern.match(fileName).hasMatch();
+#endif
+    });
+}
+
 bool FileFilter::hasFilter() const
 {
     return !m_filters.isEmpty();
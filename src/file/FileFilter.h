@@ -1,8 +1,13 @@
 #pragma once
 
 #include <QDir>
+#include <QRegularExpression>
 #include <QString>
 #include <QStringList>
+#include <QVector>
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+#    include <QRegExp>
+#endif
 
 namespace mediaelch {
 
@@ -10,14 +15,26 @@ class FileFilter
 {
 public:
     FileFilter() = default;
-    explicit FileFilter(QStringList filters) : m_filters(std::move(filters)) {}
+    explicit FileFilter(QStringList filters);
 
     QStringList files(QDir directory) const;
+    /// \brief   Whether the given file name matches any of the filters.
+    /// \details Same as QDir's name filters, i.e. wildcards and case insensitive.
+    ///          Thread safe, e.g. for matching already listed files in worker threads.
+    bool matches(const QString& fileName) const;
     bool hasFilter() const;
     QStringList filters() const;
 
 private:
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+    using Pattern = QRegExp;
+#else
+    using Pattern = QRegularExpression;
+#endif
+
     QStringList m_filters;
+    /// Compiled once because the same filters are matched against whole libraries.
+    QVector<Pattern> m_patterns;
 };
 
 } // namespace mediaelch
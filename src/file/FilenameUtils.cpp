@@ -2,54 +2,38 @@
 
 #include "globals/Meta.h"
 
+#include <QHash>
 #include <QRegularExpression>
 #include <QStringList>
 #include <QVector>
+#include <array>
 
 namespace mediaelch {
 namespace file {
 
 QString stackedBaseName(const QString& fileName)
 {
-    // TODO: Rework: The variable "volume" is not used. Why was is set in the first place?
-
-    QString baseName = fileName;
     // Assumes that there aren't more parts that 'a' through 'f'.
-    static QRegularExpression rx1a(R"(^(.*)([ _.-]+(?:cd|dvd|pt|part|dis[ck])[ _.-]*[0-9a-f]+)(.*)(\.[^.]+)$)",
+    static const QRegularExpression rx1a(
+        R"(^(.*)([ _.-]+(?:cd|dvd|pt|part|dis[ck])[ _.-]*[0-9a-f]+)(.*)(\.[^.]+)$)",
         QRegularExpression::CaseInsensitiveOption);
-    static QRegularExpression rx1b("^(.*)([ _.-]+)$");
+    static const QRegularExpression rx1b("^(.*)([ _.-]+)$");
     // TODO: DO NOT remove the file extension, see https://github.com/Komet/MediaElch/issues/1175
     // The file extension is removed elsewhere if there is only one file per movie directory.
     // Removing the extension here would mean that many movies are no longer identified!
-    // In case that the first does not match, just remove the extension.
-    // QRegularExpression rx2a(R"((.*)(\.[^.]+)$)", Qt::CaseInsensitive);
-    // QRegularExpression rx2b("(.*)([ _.-]+)$");
-
-    QVector<QVector<QRegularExpression>> regex;
-    regex << (QVector<QRegularExpression>() << rx1a << rx1b);
-    // regex << (QVector<QRegularExpression>() << rx2a << rx2b);
-
-    for (const QVector<QRegularExpression>& rx : asConst(regex)) {
-        QRegularExpressionMatch match = rx.at(0).match(fileName);
-        if (!match.hasMatch()) {
-            continue;
-        }
 
-        QString title = match.captured(1);
-        QString volume = match.captured(2);
-        /*QString ignore = rx.at(0).cap(3);
-        QString extension = rx.at(0).cap(4);*/
-
-        QRegularExpressionMatch titleMatch = rx.at(1).match(title);
-        while (titleMatch.hasMatch()) {
-            title = titleMatch.captured(1);
-            volume.prepend(titleMatch.captured(2));
-            titleMatch = rx.at(1).match(title);
-        }
-        return title;
+    QRegularExpressionMatch match = rx1a.match(fileName);
+    if (!match.hasMatch()) {
+        return fileName;
     }
 
-    return baseName;
+    QString title = match.captured(1);
+    QRegularExpressionMatch titleMatch = rx1b.match(title);
+    while (titleMatch.hasMatch()) {
+        title = titleMatch.captured(1);
+        titleMatch = rx1b.match(title);
+    }
+    return title;
 }
 
 QString withoutExtension(const QString& fileName)
@@ -67,5 +51,94 @@ void sortFilenameList(QStringList& fileNames)
     });
 }
 
+/// \brief Checks whether any of the given words follows a dash in the filename.
+/// \details Words must be lower case. Avoids a QString::contains() call per word,
+///          which would scan the whole filename for each of them.
+template<std::size_t N>
+static bool containsDashedWord(const QString& fileName, const std::array<QLatin1String, N>& words)
+{
+    const elch_size_t length = fileName.length();
+    for (elch_size_t dash = fileName.indexOf('-'); dash != -1; dash = fileName.indexOf('-', dash + 1)) {
+        for (const QLatin1String& word : words) {
+            const elch_size_t wordLength = word.size();
+            if (dash + 1 + wordLength > length) {
+                continue;
+            }
+            elch_size_t i = 0;
+            while (i < wordLength && fileName.at(dash + 1 + i).toLower() == QLatin1Char(word.latin1()[i])) {
+                ++i;
+            }
+            if (i == wordLength) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool isTrailerOrSampleFile(const QString& fileName)
+{
+    static const std::array<QLatin1String, 2> words{QLatin1String("trailer"), QLatin1String("sample")};
+    return containsDashedWord(fileName, words);
+}
+
+bool isExtraFile(const QString& fileName)
+{
+    static const std::array<QLatin1String, 8> words{QLatin1String("trailer"),
+        QLatin1String("sample"),
+        QLatin1String("behindthescenes"),
+        QLatin1String("deleted"),
+        QLatin1String("featurette"),
+        QLatin1String("interview"),
+        QLatin1String("scene"),
+        QLatin1String("short")};
+    return containsDashedWord(fileName, words);
+}
+
+/// \brief Returns the name of the stacked file without its part number or an empty string.
+static QString stackingKey(const QString& fileName, StackingPattern pattern)
+{
+    // Separators around the part marker are not part of the key, so that e.g.
+    // "movie cd1.mkv" and "movie.cd2.mkv" are stacked. The greedy prefix
+    // ensures that the last marker is used.
+    static const QRegularExpression partsAndLetters(
+        R"(^(.*)[-_\s.()]+(?:[a-f]|(?:part|cd|xvid)[-_\s.()]*\d+)[-_\s.()]+(.*)$)",
+        QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression parts(
+        R"(^(.*?(?:part|cd)[\s_]*)\d+(.*)$)", QRegularExpression::CaseInsensitiveOption);
+
+    const QRegularExpressionMatch match =
+        (pattern == StackingPattern::PartsAndLetters ? partsAndLetters : parts).match(fileName);
+    if (!match.hasMatch()) {
+        return {};
+    }
+    // '/' can't be part of a filename, so different splits can't result in the same key.
+    return match.captured(1) + '/' + match.captured(2);
+}
+
+QVector<QStringList> groupStackedFiles(const QStringList& fileNames, StackingPattern pattern)
+{
+    QVector<QStringList> groups;
+    QHash<QString, elch_size_t> groupIndex;
+    groups.reserve(fileNames.size());
+
+    for (const QString& fileName : fileNames) {
+        const QString key = stackingKey(fileName, pattern);
+        if (key.isEmpty()) {
+            groups.append({fileName});
+            continue;
+        }
+        auto existing = groupIndex.constFind(key);
+        if (existing != groupIndex.constEnd()) {
+            groups[existing.value()].append(fileName);
+        } else {
+            groupIndex.insert(key, groups.size());
+            groups.append({fileName});
+        }
+    }
+
+    return groups;
+}
+
 } // namespace file
 } // namespace mediaelch
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 namespace mediaelch {
 namespace file {
@@ -20,5 +22,30 @@ QString withoutExtension(const QString& fileName);
 /// \details Sort without requiring QFileInfo. Uses withoutExtension() for sorting.
 void sortFilenameList(QStringList& fileNames);
 
+/// \brief Returns true if the file is a trailer or sample, e.g. "movie-trailer.mkv".
+bool isTrailerOrSampleFile(const QString& fileName);
+
+/// \brief   Returns true if the file is an extra of a movie, e.g. "movie-featurette.mkv".
+/// \details Checks for all of Kodi's extras suffixes: "-trailer", "-sample", "-behindthescenes",
+///          "-deleted", "-featurette", "-interview", "-scene" and "-short".
+bool isExtraFile(const QString& fileName);
+
+/// \brief Patterns that mark parts of a stacked file, e.g. "movie-cd1.mkv" and "movie-cd2.mkv".
+enum class StackingPattern
+{
+    /// "part1", "cd1", "xvid1" or a single letter from "a" to "f", surrounded by
+    /// separators, e.g. "movie.part1.mkv" or "movie (a).mkv". The last occurrence is used.
+    PartsAndLetters,
+    /// "part1" or "cd1" anywhere in the filename. The first occurrence is used.
+    Parts
+};
+
+/// \brief   Groups the given files by the stacked file they belong to.
+/// \details Files belong to the same stacked file if their names are equal except for
+///          the part number, e.g. "movie.cd1.mkv" and "movie.cd2.mkv". Files without a
+///          part marker are not stacked. Groups are ordered by their first file and files
+///          inside a group keep their order. Runs in linear time.
+QVector<QStringList> groupStackedFiles(const QStringList& fileNames, StackingPattern pattern);
+
 } // namespace file
 } // namespace mediaelch
@@ -1,22 +1,67 @@
 #include "globals/DownloadManager.h"
 
 #include "globals/DownloadManagerElement.h"
+#include "globals/DownloadSlots.h"
 #include "log/Log.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "network/HttpStatusCodes.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
 #include "tv_shows/TvShow.h"
 
+#include <QDateTime>
 #include <QFile>
 #include <QTimer>
+#include <algorithm>
 
 static constexpr char PROP_DOWNLOAD_ELEMENT[] = "downloadElement";
 
+namespace {
+
+QString hostOf(const DownloadManagerElement& download)
+{
+    return download.url.host().toLower();
+}
+
+qint64 now()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+bool isTransientError(const QNetworkReply* reply)
+{
+    using mediaelch::HttpStatusCode;
+    if (reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
+        return true;
+    }
+    const auto status = static_cast<HttpStatusCode>(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+    if (status == HttpStatusCode::TooManyRequests || status == HttpStatusCode::BadGateway
+        || status == HttpStatusCode::ServiceUnavailable || status == HttpStatusCode::GatewayTimeout) {
+        return true;
+    }
+    switch (reply->error()) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError: return true;
+    default: return false;
+    }
+}
+
+} // namespace
+
 DownloadManager::DownloadManager(QObject* parent) : QObject(parent)
 {
 }
 
+DownloadManager::~DownloadManager()
+{
+    // Running downloads must free their slots, otherwise other managers would starve.
+    abortDownloads();
+}
+
 mediaelch::network::NetworkManager* DownloadManager::network()
 {
     static auto* s_network = new mediaelch::network::NetworkManager();
@@ -45,42 +90,44 @@ void DownloadManager::setDownloads(QVector<DownloadManagerElement> elements)
 
 void DownloadManager::addDownload(DownloadManagerElement elem)
 {
-    // TODO: Refactor
-    //
-    // I previously assumed that we had a threading issue.  But this is not
-    // the case because connect() calls methods of DownloadManager only in one
-    // thread, DownloadManager's thread.
-    // But I forgot that signals (e.g. "emit sigFinished") call their slots
-    // _immediately_ by default. This means we could end up in inconsistent
-    // states because member variables are changed while we are still inside a
-    // method that depends on them or has a previous state.  For example:
-    //
-    //  addDownload()
-    //    startNextDownload();
-    //     on finished: downloadFinished()
-    //       emit sigDownloadFinished(elem);
-    //         some slot calls addDownload, m_currentDownloadElement changes
-    //       emit sigElemDownloaded(elem);
-    //         may emit wrong element
-    //
-    // To avoid this, I've adapted all places where a connect() to this
-    // download manager is used.  Those places now all used a queued connection.
-    //
-    // But to be more robust, we should refactor this class and get rid of
-    // all member variables that may change state.
-    // Also, this would allow parallel downloads.
-    //
-    // The mutexes have been removed but the code still needs to be refactored.
-    //
+    // Note: Signals call their slots _immediately_ by default. Slots connected
+    // to this download manager may call addDownload() again while we are still
+    // inside a method that depends on the current state.  To avoid this, all
+    // places that connect() to this download manager use a queued connection.
+    // Methods of this class must not rely on the queue being unchanged after
+    // emitting a signal.
 
     qCDebug(generic) << "[DownloadManager] Enqueue download at pos " << downloadQueueSize() << "|" << elem.url;
 
-    m_queue.enqueue(elem);
+    QueuedDownload download;
+    download.element = std::move(elem);
+    enqueue(download);
+    startNextDownloads();
+}
 
-    const bool shouldStartDownloading = m_currentReplies.size() <= numberOfParellelDownloads;
-    if (shouldStartDownloading) {
-        startNextDownload();
+void DownloadManager::enqueue(QueuedDownload download, bool asFirst)
+{
+    const DownloadPriority priority = download.element.priority;
+    const auto hasPrecedence = [priority, asFirst](const QueuedDownload& queued) {
+        return asFirst ? queued.element.priority > priority : queued.element.priority >= priority;
+    };
+    // The queue is ordered by priority, so find the first element that is ranked lower.
+    const auto pos = std::find_if_not(m_queue.begin(), m_queue.end(), hasPrecedence);
+    m_queue.insert(pos, std::move(download));
+    updateWaiting();
+}
+
+void DownloadManager::updateWaiting()
+{
+    if (m_queue.isEmpty()) {
+        DownloadSlots::instance().removeWaiting(this);
+        return;
     }
+    // Queued, so that the slot is handled in the manager's thread and not while
+    // the releasing manager is still changing its state.
+    DownloadSlots::instance().setWaiting(this, highestQueuedPriority(), [this]() { //
+        QMetaObject::invokeMethod(this, "onDownloadSlotAvailable", Qt::QueuedConnection);
+    });
 }
 
 template<class T>
@@ -89,7 +136,7 @@ bool DownloadManager::hasDownloadsLeft(T*& elementToCheck)
     // Note: This code looks similar to numberOfDownloadsLeft() but does not require
     // to run through all downloads.
     for (elch_size_t i = 0, n = m_queue.size(); i < n; ++i) {
-        if (m_queue[i].getElement<T>() == elementToCheck) {
+        if (m_queue[i].element.getElement<T>() == elementToCheck) {
             return true;
         }
     }
@@ -109,7 +156,7 @@ int DownloadManager::numberOfDownloadsLeft(T*& elementToCheck)
 {
     int count = 0;
     for (elch_size_t i = 0, n = m_queue.size(); i < n; ++i) {
-        if (m_queue[i].getElement<T>() == elementToCheck) {
+        if (m_queue[i].element.getElement<T>() == elementToCheck) {
             ++count;
         }
     }
@@ -129,9 +176,12 @@ void DownloadManager::abortDownloads()
     qCInfo(generic) << "[DownloadsManager] Abort Downloads";
 
     m_queue.clear();
+    updateWaiting();
 
     // Abort all currently running jobs. Disconnect the finished() signal first!
-    for (auto* reply : asConst(m_currentReplies)) {
+    const QVector<QNetworkReply*> replies = m_currentReplies;
+    m_currentReplies.clear();
+    for (auto* reply : replies) {
         // We know that the replies in m_currentReplies aren't finished, because
         // as soon as they are, they're removed from the list.
         disconnect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
@@ -139,22 +189,69 @@ void DownloadManager::abortDownloads()
 
         reply->abort();
         reply->deleteLater();
+        releaseSlot(reply);
     }
-    m_currentReplies.clear();
 }
 
-void DownloadManager::startNextDownload()
+void DownloadManager::onDownloadSlotAvailable()
 {
-    if (m_queue.isEmpty()) {
-        if (m_currentReplies.isEmpty()) {
-            qCInfo(generic) << "[DownloadManager] All downloads finished";
-            emit allDownloadsFinished();
+    // Only continue if there is something left to do. Otherwise we would
+    // emit allDownloadsFinished() for idle managers.
+    if (!m_queue.isEmpty()) {
+        startNextDownloads();
+    }
+}
+
+int DownloadManager::takeNextStartableDownload(qint64& nextRetryIn)
+{
+    const qint64 currentTime = now();
+    nextRetryIn = -1;
+    for (elch_size_t i = 0, n = m_queue.size(); i < n; ++i) {
+        const QueuedDownload& queued = m_queue[i];
+        if (queued.notBefore > currentTime) {
+            const qint64 delay = queued.notBefore - currentTime;
+            nextRetryIn = (nextRetryIn < 0) ? delay : qMin(nextRetryIn, delay);
+            continue;
         }
-        return;
+        if (DownloadManager::isLocalFile(queued.element.url)
+            || DownloadSlots::instance().tryAcquire(hostOf(queued.element))) {
+            return qsizetype_to_int(i);
+        }
+    }
+    return -1;
+}
+
+void DownloadManager::startNextDownloads()
+{
+    qint64 nextRetryIn = -1;
+    int index = takeNextStartableDownload(nextRetryIn);
+    while (index >= 0) {
+        DownloadManagerElement download = m_queue.takeAt(index).element;
+        updateWaiting();
+        startDownload(download);
+        // startDownload() emits signals which may have changed the queue.
+        index = takeNextStartableDownload(nextRetryIn);
+    }
+
+    const qint64 retryDue = now() + nextRetryIn;
+    if (nextRetryIn >= 0 && (m_retryDue == 0 || retryDue < m_retryDue)) {
+        m_retryDue = retryDue;
+        QTimer::singleShot(static_cast<int>(nextRetryIn), this, [this, retryDue]() {
+            if (m_retryDue == retryDue) {
+                m_retryDue = 0;
+            }
+            onDownloadSlotAvailable();
+        });
     }
 
-    DownloadManagerElement download = m_queue.dequeue();
+    if (m_queue.isEmpty() && m_currentReplies.isEmpty()) {
+        qCInfo(generic) << "[DownloadManager] All downloads finished";
+        emit allDownloadsFinished();
+    }
+}
 
+void DownloadManager::startDownload(DownloadManagerElement download)
+{
     if (download.imageType == ImageType::Actor || download.imageType == ImageType::TvShowEpisodeThumb) {
         if (download.movie != nullptr) {
             emit movieDownloadsLeft(numberOfDownloadsLeft<Movie>(download.movie), download);
@@ -170,35 +267,43 @@ void DownloadManager::startNextDownload()
     qCDebug(generic) << "[DownloadManager] Start next download | Files left:" << m_queue.size();
 
     if (DownloadManager::isLocalFile(download.url)) {
-        QFile file(download.url.toString());
-        QByteArray data;
-        if (file.open(QIODevice::ReadOnly)) {
-            data = file.readAll();
-            file.close();
-        }
+        loadLocalFile(download);
+        return;
+    }
 
-        download.data = data;
+    QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
+    reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
+    m_currentReplies.push_back(reply);
 
-        if (download.actor != nullptr && download.imageType == ImageType::Actor && (download.movie == nullptr)) {
-            download.actor->image = data;
+    connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
+    connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+}
 
-        } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
-            download.episode->setThumbnailImage(data);
+void DownloadManager::loadLocalFile(DownloadManagerElement download)
+{
+    QFile file(download.url.toString());
+    QByteArray data;
+    if (file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+        file.close();
+    }
 
-        } else {
-            emit sigDownloadFinished(download);
-        }
-        startNextDownload();
-        // TODO: Also emit allXXXFinished() signal
+    download.data = data;
+    finishDownload(download);
+}
 
-    } else {
-        QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
-        reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
-        m_currentReplies.push_back(reply);
+void DownloadManager::releaseSlot(QNetworkReply* reply)
+{
+    const auto download = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
+    DownloadSlots::instance().release(hostOf(download));
+    // Let other managers use the free slot. Managers with more important downloads are notified first.
+    DownloadSlots::instance().notifyWaiting(this);
+}
 
-        connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
-        connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
-    }
+DownloadPriority DownloadManager::highestQueuedPriority() const
+{
+    // The queue is ordered by priority.
+    return m_queue.isEmpty() ? DownloadPriority::Background : m_queue.first().element.priority;
 }
 
 void DownloadManager::downloadProgress(qint64 received, qint64 total)
@@ -216,27 +321,36 @@ void DownloadManager::downloadProgress(qint64 received, qint64 total)
     emit sigDownloadProgress(element);
 }
 
-void DownloadManager::restartDownloadAfterTimeout(QNetworkReply* reply)
+bool DownloadManager::retryLater(QNetworkReply* reply, DownloadManagerElement download)
 {
-    auto download = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    ++download.retries;
-    reply->deleteLater();
-
-    qCWarning(generic) << "[DownloadManager] Download timed out:" << download.url;
-
-    if (download.retries < 3) {
-        qCDebug(generic) << "[DownloadManager] Re-enqueuing the download, tries:" << download.retries << "/ 3";
-        m_queue.prepend(download);
+    static constexpr int maxRetries = 3;
+    if (!isTransientError(reply)) {
+        return false;
+    }
 
-    } else {
-        qCDebug(generic) << "[DownloadManager] Giving up on this file, tried 3 times";
+    ++download.retries;
+    if (download.retries > maxRetries) {
+        qCWarning(generic) << "[DownloadManager] Giving up on this file, tried" << download.retries << "times:"
+                           << download.url;
+        return false;
     }
 
-    // Should always be true because we're replacing the previous request
-    // but just to be sure, we still check this.
-    if (m_currentReplies.size() <= numberOfParellelDownloads) {
-        startNextDownload();
+    // Exponential backoff: 1s, 2s, 4s, ... unless the server tells us how long to wait.
+    qint64 delayMs = 1000LL << (download.retries - 1);
+    bool ok = false;
+    const int retryAfter = reply->rawHeader("Retry-After").trimmed().toInt(&ok);
+    if (ok && retryAfter > 0) {
+        delayMs = qMin<qint64>(retryAfter, 60) * 1000;
     }
+
+    qCDebug(generic) << "[DownloadManager] Retrying download in" << delayMs << "ms, tries:" << download.retries << "/"
+                     << maxRetries << "|" << download.url;
+
+    QueuedDownload queued;
+    queued.element = std::move(download);
+    queued.notBefore = now() + delayMs;
+    enqueue(queued, true);
+    return true;
 }
 
 void DownloadManager::downloadFinished()
@@ -250,12 +364,17 @@ void DownloadManager::downloadFinished()
     bool wasRemoved = m_currentReplies.removeOne(reply);
     if (!wasRemoved) {
         qCCritical(generic) << "[DownloadManager] downloadFinished() called for reply which wasn't tracked";
+    } else {
+        releaseSlot(reply);
     }
 
+    DownloadManagerElement downloadElelement = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
+    reply->deleteLater();
+
     QByteArray data;
     if (reply->error() != QNetworkReply::NoError) {
-        if (reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
-            restartDownloadAfterTimeout(reply); // also deletes the reply
+        if (retryLater(reply, downloadElelement)) {
+            startNextDownloads();
             return;
         }
         qCWarning(generic) << "[DownloadManager] Network Error:" << reply->errorString() << "|" << reply->url();
@@ -264,42 +383,40 @@ void DownloadManager::downloadFinished()
         data = reply->readAll();
     }
 
-
-    DownloadManagerElement downloadElelement = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    reply->deleteLater();
-
     downloadElelement.data = data;
+    finishDownload(downloadElelement);
+    startNextDownloads();
+}
 
-    if (downloadElelement.actor != nullptr && downloadElelement.imageType == ImageType::Actor
-        && downloadElelement.movie == nullptr) {
-        downloadElelement.actor->image = data;
+void DownloadManager::finishDownload(DownloadManagerElement download)
+{
+    if (download.actor != nullptr && download.imageType == ImageType::Actor && download.movie == nullptr) {
+        download.actor->image = download.data;
 
-    } else if (downloadElelement.imageType == ImageType::TvShowEpisodeThumb && !downloadElelement.directDownload) {
-        downloadElelement.episode->setThumbnailImage(data);
+    } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
+        download.episode->setThumbnailImage(download.data);
 
     } else {
-        emit sigDownloadFinished(downloadElelement);
+        emit sigDownloadFinished(download);
     }
 
-    emit sigElemDownloaded(downloadElelement);
+    emit sigElemDownloaded(download);
 
-    if (downloadElelement.movie != nullptr && !hasDownloadsLeft<Movie>(downloadElelement.movie)) {
-        emit allMovieDownloadsFinished(downloadElelement.movie);
+    if (download.movie != nullptr && !hasDownloadsLeft<Movie>(download.movie)) {
+        emit allMovieDownloadsFinished(download.movie);
     }
-    if (downloadElelement.show != nullptr && !hasDownloadsLeft<TvShow>(downloadElelement.show)) {
-        emit allTvShowDownloadsFinished(downloadElelement.show);
+    if (download.show != nullptr && !hasDownloadsLeft<TvShow>(download.show)) {
+        emit allTvShowDownloadsFinished(download.show);
     }
-    if (downloadElelement.concert != nullptr && !hasDownloadsLeft<Concert>(downloadElelement.concert)) {
-        emit allConcertDownloadsFinished(downloadElelement.concert);
+    if (download.concert != nullptr && !hasDownloadsLeft<Concert>(download.concert)) {
+        emit allConcertDownloadsFinished(download.concert);
     }
-    if (downloadElelement.artist != nullptr && !hasDownloadsLeft<Artist>(downloadElelement.artist)) {
-        emit allArtistDownloadsFinished(downloadElelement.artist);
+    if (download.artist != nullptr && !hasDownloadsLeft<Artist>(download.artist)) {
+        emit allArtistDownloadsFinished(download.artist);
     }
-    if (downloadElelement.album != nullptr && !hasDownloadsLeft<Album>(downloadElelement.album)) {
-        emit allAlbumDownloadsFinished(downloadElelement.album);
+    if (download.album != nullptr && !hasDownloadsLeft<Album>(download.album)) {
+        emit allAlbumDownloadsFinished(download.album);
     }
-
-    startNextDownload();
 }
 
 bool DownloadManager::isDownloading() const
@@ -7,7 +7,6 @@
 #include <QMutex>
 #include <QNetworkReply>
 #include <QObject>
-#include <QQueue>
 #include <QTimer>
 #include <QUrl>
 #include <QVector>
@@ -20,8 +19,12 @@ class DownloadManager : public QObject
     Q_OBJECT
 public:
     explicit DownloadManager(QObject* parent = nullptr);
-    /// \brief Add the given download element and start downloading it if the
-    ///        download progress hasn't started, yet.
+    ~DownloadManager() override;
+    /// \brief Add the given download element and start downloading it if a
+    ///        download slot is free.
+    /// \details All download managers share a global limit of parallel downloads
+    ///          as well as per-host limits. Elements with a higher priority are
+    ///          started first, see DownloadManagerElement::priority.
     /// \param elem Element to download
     /// \see   DownloadManagerElement
     void addDownload(DownloadManagerElement elem);
@@ -62,11 +65,42 @@ private slots:
     void downloadProgress(qint64 received, qint64 total);
     /// \brief Starts the next download if there is one.
     void downloadFinished();
-    void startNextDownload();
-    /// \brief Stops the current download and prepends it to the queue
-    void restartDownloadAfterTimeout(QNetworkReply* reply);
+    /// \brief Starts as many queued downloads as there are free download slots.
+    /// \details Emits allDownloadsFinished() if there is nothing left to do.
+    void startNextDownloads();
+    /// \brief Called if a download slot of another download manager became free
+    ///        or if a retry is due.
+    void onDownloadSlotAvailable();
 
 private:
+    struct QueuedDownload
+    {
+        DownloadManagerElement element;
+        /// \brief Time in ms since epoch before which the download must not be started (retry backoff).
+        qint64 notBefore{0};
+    };
+
+    /// \brief Inserts the element after all queued elements with the same or a higher priority.
+    /// \param asFirst If true, insert the element before all elements with the same priority.
+    void enqueue(QueuedDownload download, bool asFirst = false);
+    /// \brief Lets other download managers know whether we wait for a free download slot.
+    void updateWaiting();
+    /// \brief   Returns the index of the next element that can be started right now or -1.
+    /// \details Takes a download slot for the element, see DownloadSlots.
+    /// \param nextRetryIn Set to the time in ms until the next delayed element is due, if any.
+    int takeNextStartableDownload(qint64& nextRetryIn);
+    void startDownload(DownloadManagerElement download);
+    void loadLocalFile(DownloadManagerElement download);
+    /// \brief Stores the downloaded data or emits sigDownloadFinished() and emits all related "finished" signals.
+    void finishDownload(DownloadManagerElement download);
+    /// \brief Re-enqueues the download with an exponential backoff if it failed due to a
+    ///        transient error, e.g. a timeout or "429 Too Many Requests".
+    /// \return True if the download will be retried.
+    bool retryLater(QNetworkReply* reply, DownloadManagerElement download);
+    /// \brief Releases the download slot of the given reply and lets other download managers know.
+    void releaseSlot(QNetworkReply* reply);
+    DownloadPriority highestQueuedPriority() const;
+
     /// \brief Checks if all downloads of the given movie/tvshow/... have finished.
     template<class T>
     bool hasDownloadsLeft(T*& elementToCheck);
@@ -80,7 +114,8 @@ private:
     static bool isLocalFile(const QUrl& url);
 
     QVector<QNetworkReply*> m_currentReplies;
-    QQueue<DownloadManagerElement> m_queue;
-
-    int numberOfParellelDownloads = 5;
+    /// \brief Queued downloads, ordered by priority (highest first).
+    QVector<QueuedDownload> m_queue;
+    /// \brief Time in ms since epoch at which the retry timer fires or 0 if there is none.
+    qint64 m_retryDue = 0;
 };
@@ -11,6 +11,16 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+/// \brief Order in which queued downloads are started.
+/// \details Downloads for the item that is currently shown are started before
+///          downloads of e.g. multi-scrape batches.
+enum class DownloadPriority
+{
+    Background = 0,
+    Normal = 1,
+    Visible = 2
+};
+
 class DownloadManagerElement
 {
 public:
@@ -23,6 +33,7 @@ public:
     qint64 bytesTotal{0};
     /// \brief How often did the download manager try to download this element?
     int retries{0};
+    DownloadPriority priority{DownloadPriority::Normal};
 
     Actor* actor{nullptr};
     TvShowEpisode* episode{nullptr};
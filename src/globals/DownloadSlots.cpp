@@ -0,0 +1,90 @@
+#include "globals/DownloadSlots.h"
+
+#include "globals/Meta.h"
+
+#include <QMutexLocker>
+#include <QVector>
+#include <algorithm>
+
+DownloadSlots& DownloadSlots::instance()
+{
+    // Never deleted: download managers may be destroyed during static destruction.
+    static auto* s_slots = new DownloadSlots();
+    return *s_slots;
+}
+
+int DownloadSlots::maxParallelDownloads()
+{
+    return 12;
+}
+
+int DownloadSlots::maxDownloadsForHost(const QString& host)
+{
+    // TMDb's image CDN handles many parallel requests while fanart.tv
+    // throttles its asset server quickly.
+    if (host == QLatin1String("image.tmdb.org")) {
+        return 8;
+    }
+    if (host == QLatin1String("assets.fanart.tv")) {
+        return 2;
+    }
+    return 4;
+}
+
+bool DownloadSlots::tryAcquire(const QString& host)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_running >= maxParallelDownloads() || m_runningPerHost.value(host, 0) >= maxDownloadsForHost(host)) {
+        return false;
+    }
+    ++m_running;
+    ++m_runningPerHost[host];
+    return true;
+}
+
+void DownloadSlots::release(const QString& host)
+{
+    QMutexLocker locker(&m_lock);
+    --m_running;
+    auto it = m_runningPerHost.find(host);
+    if (it != m_runningPerHost.end() && --it.value() <= 0) {
+        m_runningPerHost.erase(it);
+    }
+}
+
+void DownloadSlots::setWaiting(const QObject* manager, DownloadPriority priority, const NotifyCallback& notify)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = m_waiting.find(manager);
+    if (it == m_waiting.end()) {
+        m_waiting.insert(manager, {priority, notify});
+    } else {
+        it->priority = priority;
+    }
+}
+
+void DownloadSlots::removeWaiting(const QObject* manager)
+{
+    QMutexLocker locker(&m_lock);
+    m_waiting.remove(manager);
+}
+
+void DownloadSlots::notifyWaiting(const QObject* except)
+{
+    // The callbacks are called while locked. Managers remove themselves before they
+    // are destroyed, which waits for the lock, so none of them can be destroyed meanwhile.
+    QMutexLocker locker(&m_lock);
+    QVector<const Waiting*> waiting;
+    waiting.reserve(m_waiting.size());
+    for (auto it = m_waiting.cbegin(); it != m_waiting.cend(); ++it) {
+        if (it.key() != except) {
+            waiting.push_back(&it.value());
+        }
+    }
+    std::stable_sort(waiting.begin(), waiting.end(), [](const Waiting* a, const Waiting* b) { //
+        return a->priority > b->priority;
+    });
+    for (const Waiting* manager : asConst(waiting)) {
+        manager->notify();
+    }
+}
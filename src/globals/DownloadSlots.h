@@ -0,0 +1,61 @@
+#pragma once
+
+#include "globals/DownloadManagerElement.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <functional>
+
+/// \brief   Download slots shared by all download managers.
+/// \details Limits the number of parallel downloads in total and per host so that we
+///          don't run into rate limits of image hosts. Managers that wait for a free
+///          slot are notified in the order of their most important queued download.
+///          Downloads only run in the GUI thread, but download managers of movies etc.
+///          may be destroyed by loader threads, which is why all state is locked.
+class DownloadSlots
+{
+public:
+    /// \brief Callback that lets a waiting download manager know about a free slot.
+    /// \details Called while the slots are locked, i.e. it must only post an event,
+    ///          e.g. using a queued QMetaObject::invokeMethod().
+    using NotifyCallback = std::function<void()>;
+
+    DownloadSlots() = default;
+
+    /// \brief Slots of all download managers.
+    static DownloadSlots& instance();
+
+    static int maxParallelDownloads();
+    static int maxDownloadsForHost(const QString& host);
+
+    /// \brief Takes a slot for the given host if one is free.
+    /// \return True if the download can be started.
+    bool tryAcquire(const QString& host);
+    void release(const QString& host);
+
+    /// \brief   Marks the manager as waiting for a free slot, i.e. its queue is not empty.
+    /// \details priority is the one of its most important queued download.
+    ///          The callback is only stored the first time.
+    void setWaiting(const QObject* manager, DownloadPriority priority, const NotifyCallback& notify);
+    /// \brief   The manager does not wait anymore, e.g. because its queue is empty.
+    /// \details Must be called before the manager is destroyed. Afterwards, it is guaranteed
+    ///          that its callback is not called anymore.
+    void removeWaiting(const QObject* manager);
+    /// \brief Calls the callbacks of all waiting managers except the given one,
+    ///        most important downloads first.
+    void notifyWaiting(const QObject* except);
+
+private:
+    struct Waiting
+    {
+        DownloadPriority priority = DownloadPriority::Normal;
+        NotifyCallback notify;
+    };
+
+    QMutex m_lock;
+    int m_running = 0;
+    QHash<QString, int> m_runningPerHost;
+    QHash<const QObject*, Waiting> m_waiting;
+};
@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "concerts/Concert.h"
+#include "globals/FilterIndex.h"
 #include "movies/Movie.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
@@ -322,6 +323,128 @@ bool Filter::accepts(Movie* movie)
     return true;
 }
 
+Filter::MoviePredicate Filter::compileMovieFilter(mediaelch::FilterIndex& index) const
+{
+    if (m_type != FilterType::Movie) {
+        return [](Movie* /*movie*/) { return true; };
+    }
+
+    const mediaelch::FilterIndex* filterIndex = &index;
+    const int field = static_cast<int>(m_movieInfo);
+    const bool hasInfo = m_hasInfo;
+
+    switch (m_movieInfo) {
+    case MovieFilters::Certification:
+    case MovieFilters::Genres:
+    case MovieFilters::Studio:
+    case MovieFilters::Set:
+    case MovieFilters::Country:
+    case MovieFilters::Tags:
+    case MovieFilters::Director:
+    case MovieFilters::VideoCodec: {
+        if (!hasInfo || m_shortText.isEmpty()) {
+            // Empty values are not indexed, e.g. a filter for the director "" matches all movies without one.
+            return [filterIndex, field](Movie* movie) { return !filterIndex->hasValues(movie, field); };
+        }
+        const int termId = index.termId(field, m_shortText);
+        return [filterIndex, termId](Movie* movie) { return filterIndex->hasTerm(movie, termId); };
+    }
+
+    case MovieFilters::Title:
+    case MovieFilters::OriginalTitle:
+    case MovieFilters::Path: {
+        const QString needle = mediaelch::FilterIndex::folded(m_shortText);
+        return [filterIndex, field, needle](Movie* movie) { return filterIndex->text(movie, field).contains(needle); };
+    }
+
+    case MovieFilters::Released: {
+        const int year = m_shortText.toInt();
+        return [year](Movie* movie) { return movie->released().isValid() && movie->released().year() == year; };
+    }
+
+    case MovieFilters::ImdbId: {
+        const ImdbId id(m_shortText);
+        return [hasInfo, id](Movie* movie) { return hasInfo ? movie->imdbId() == id : !movie->imdbId().isValid(); };
+    }
+
+    case MovieFilters::TmdbId: {
+        const TmdbId id(m_shortText);
+        return [hasInfo, id](Movie* movie) { return hasInfo ? movie->tmdbId() == id : !movie->tmdbId().isValid(); };
+    }
+
+    case MovieFilters::Label: {
+        const ColorLabel label = m_data;
+        return [label](Movie* movie) { return movie->label() == label; };
+    }
+
+    case MovieFilters::Quality: {
+        const auto hasWidth = [](Movie* movie, int width) {
+            return movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Width).toInt() == width;
+        };
+        if (m_shortText == "2160p") {
+            return [hasWidth](Movie* movie) { return hasWidth(movie, 3840); };
+        }
+        if (m_shortText == "1080p") {
+            return [hasWidth](Movie* movie) { return hasWidth(movie, 1920); };
+        }
+        if (m_shortText == "720p") {
+            return [hasWidth](Movie* movie) { return hasWidth(movie, 1280); };
+        }
+        if (m_shortText == "SD") {
+            return [](Movie* movie) {
+                const int width =
+                    movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Width).toInt();
+                return width > 0 && width <= 720;
+            };
+        }
+        if (m_shortText == "BluRay") {
+            return [](Movie* movie) { return movie->discType() == DiscType::BluRay; };
+        }
+        if (m_shortText == "DVD") {
+            return [](Movie* movie) { return movie->discType() == DiscType::Dvd; };
+        }
+        return [](Movie* /*movie*/) { return true; };
+    }
+
+    case MovieFilters::AudioChannels: {
+        const QMap<QString, int> channels{{"2.0", 2}, {"5.1", 6}, {"7.1", 8}};
+        if (!channels.contains(m_shortText)) {
+            return [](Movie* /*movie*/) { return true; };
+        }
+        const int count = channels.value(m_shortText);
+        return [count](Movie* movie) { return movie->streamDetails()->hasAudioChannels(count); };
+    }
+
+    case MovieFilters::AudioQuality: {
+        const QMap<QString, QString> qualities{{"HD Audio", "hd"}, {"Normal Audio", "normal"}, {"SD Audio", "sd"}};
+        if (!qualities.contains(m_shortText)) {
+            return [](Movie* /*movie*/) { return true; };
+        }
+        const QString quality = qualities.value(m_shortText);
+        return [quality](Movie* movie) { return movie->streamDetails()->hasAudioQuality(quality); };
+    }
+
+    default: break;
+    }
+
+    // Remaining filters only check a single property of the movie.
+    Filter filter = *this;
+    return [filter](Movie* movie) mutable { return filter.accepts(movie); };
+}
+
+Filter::ConcertPredicate Filter::compileConcertFilter(mediaelch::FilterIndex& index) const
+{
+    if (!isInfo(ConcertFilters::Title)) {
+        return [](Concert* /*concert*/) { return true; };
+    }
+    const mediaelch::FilterIndex* filterIndex = &index;
+    const int field = static_cast<int>(ConcertFilters::Title);
+    const QString needle = mediaelch::FilterIndex::folded(m_shortText);
+    return [filterIndex, field, needle](Concert* concert) {
+        return filterIndex->text(concert, field).contains(needle);
+    };
+}
+
 /**
  * \brief Checks if the filter accepts a TV show object
  * \param show Tv Show to check
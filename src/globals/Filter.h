@@ -5,15 +5,23 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <functional>
 
 class Concert;
 class Movie;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+class FilterIndex;
+}
+
 class Filter
 {
 public:
+    using MoviePredicate = std::function<bool(Movie*)>;
+    using ConcertPredicate = std::function<bool(Concert*)>;
+
     Filter(QString text,
         QString shortText,
         QStringList filterText,
@@ -51,6 +59,16 @@ public:
     bool accepts(Concert* concert);
     bool accepts(TvShow* show);
     bool accepts(TvShowEpisode* episode);
+
+    /// \brief Compiles the filter into a predicate that gives the same results as accepts(Movie*).
+    /// \details The filter type and text are only evaluated once. Genres, tags, titles, etc. are
+    ///          looked up in the given index, which must be the one of the model the movies belong to.
+    ///          The index must outlive the predicate.
+    MoviePredicate compileMovieFilter(mediaelch::FilterIndex& index) const;
+    /// \brief Compiles the filter into a predicate that gives the same results as accepts(Concert*).
+    /// \see compileMovieFilter()
+    ConcertPredicate compileConcertFilter(mediaelch::FilterIndex& index) const;
+
     QString text() const;
     QString shortText() const;
     void setShortText(QString shortText);
@@ -0,0 +1,125 @@
+#include "globals/FilterIndex.h"
+
+#include "globals/Meta.h"
+
+namespace mediaelch {
+
+void FilterIndex::setValues(Item item, int field, const QStringList& values)
+{
+    QVector<int> ids;
+    ids.reserve(values.size());
+    for (const QString& value : values) {
+        if (value.isEmpty()) {
+            continue;
+        }
+        const int id = termId(field, value);
+        if (!ids.contains(id)) {
+            ids.append(id);
+        }
+    }
+
+    ItemData& data = m_items[item];
+    auto it = data.termIds.find(field);
+    if (it != data.termIds.end()) {
+        if (it.value() == ids) {
+            return;
+        }
+        removeTerms(item, it.value());
+    }
+    for (int id : asConst(ids)) {
+        m_postings[id].insert(item);
+    }
+    data.termIds.insert(field, ids);
+}
+
+void FilterIndex::setText(Item item, int field, const QString& text)
+{
+    m_items[item].texts.insert(field, folded(text));
+}
+
+void FilterIndex::removeItem(Item item)
+{
+    const auto it = m_items.constFind(item);
+    if (it == m_items.constEnd()) {
+        return;
+    }
+    for (const QVector<int>& ids : it->termIds) {
+        removeTerms(item, ids);
+    }
+    m_items.remove(item);
+}
+
+void FilterIndex::clear()
+{
+    // Terms are kept so that ids of compiled filters stay valid.
+    m_items.clear();
+    for (QSet<Item>& items : m_postings) {
+        items.clear();
+    }
+}
+
+bool FilterIndex::containsItem(Item item) const
+{
+    return m_items.contains(item);
+}
+
+int FilterIndex::itemCount() const
+{
+    return qsizetype_to_int(m_items.size());
+}
+
+int FilterIndex::termId(int field, const QString& value)
+{
+    const QPair<int, QString> term(field, value);
+    const auto it = m_termIds.constFind(term);
+    if (it != m_termIds.constEnd()) {
+        return it.value();
+    }
+    const int id = qsizetype_to_int(m_terms.size());
+    m_termIds.insert(term, id);
+    m_terms.append(term);
+    m_postings.append({});
+    return id;
+}
+
+bool FilterIndex::hasTerm(Item item, int termId) const
+{
+    return termId >= 0 && termId < m_postings.size() && m_postings[termId].contains(item);
+}
+
+bool FilterIndex::hasValues(Item item, int field) const
+{
+    const auto it = m_items.constFind(item);
+    return it != m_items.constEnd() && !it->termIds.value(field).isEmpty();
+}
+
+QString FilterIndex::text(Item item, int field) const
+{
+    const auto it = m_items.constFind(item);
+    return it != m_items.constEnd() ? it->texts.value(field) : QString{};
+}
+
+QStringList FilterIndex::values(int field) const
+{
+    QStringList result;
+    for (elch_size_t id = 0; id < m_terms.size(); ++id) {
+        if (m_terms[id].first == field && !m_postings[id].isEmpty()) {
+            result.append(m_terms[id].second);
+        }
+    }
+    return result;
+}
+
+QString FilterIndex::folded(const QString& text)
+{
+    return text.toCaseFolded();
+}
+
+void FilterIndex::removeTerms(Item item, const QVector<int>& termIds)
+{
+    for (int id : termIds) {
+        m_postings[id].remove(item);
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QObject;
+
+namespace mediaelch {
+
+/// \brief Inverted index of the values that items of a model are filtered by.
+///
+/// Models add their items (movies, concerts, ...) and update them whenever an item
+/// changes. Compiled filters (see Filter::compileMovieFilter()) then look up a single
+/// term instead of searching all genres, tags, etc. of each item.
+///
+/// Fields are the values of the filter enums, e.g. MovieFilters::Genres, which are
+/// unique across all media types. Each field either stores exact values, e.g. genres,
+/// or a case folded text for "contains" filters, e.g. the title.
+class FilterIndex
+{
+public:
+    using Item = const QObject*;
+
+    /// \brief Replaces the values of the item's field. Empty and duplicate values are ignored.
+    void setValues(Item item, int field, const QStringList& values);
+    /// \brief Replaces the text of the item's field. The text is stored case folded.
+    void setText(Item item, int field, const QString& text);
+    void removeItem(Item item);
+    /// \brief Removes all items. Term ids stay valid.
+    void clear();
+
+    bool containsItem(Item item) const;
+    int itemCount() const;
+
+    /// \brief Returns the id of the given value. Values that no item has get a new id,
+    ///        so that the id stays valid if items change later on.
+    int termId(int field, const QString& value);
+    bool hasTerm(Item item, int termId) const;
+    /// \brief Returns true if the item has at least one value in the given field.
+    bool hasValues(Item item, int field) const;
+    /// \brief Case folded text of the item's field, see setText().
+    QString text(Item item, int field) const;
+    /// \brief Distinct values of the given field that at least one item has. Unsorted.
+    QStringList values(int field) const;
+
+    static QString folded(const QString& text);
+
+private:
+    struct ItemData
+    {
+        /// \brief Ids of the item's values by field.
+        QHash<int, QVector<int>> termIds;
+        QHash<int, QString> texts;
+    };
+
+    void removeTerms(Item item, const QVector<int>& termIds);
+
+    QHash<Item, ItemData> m_items;
+    /// \brief Term ids by field and value.
+    QHash<QPair<int, QString>, int> m_termIds;
+    /// \brief Field and value of each term id.
+    QVector<QPair<int, QString>> m_terms;
+    /// \brief Items that have a term, by term id.
+    QVector<QSet<Item>> m_postings;
+};
+
+} // namespace mediaelch
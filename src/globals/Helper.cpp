@@ -11,6 +11,7 @@
 #include <QDoubleSpinBox>
 #include <QFile>
 #include <QGraphicsDropShadowEffect>
+#include <QHash>
 #include <QLabel>
 #include <QLineEdit>
 #include <QListWidget>
@@ -19,6 +20,8 @@
 #include <QRegularExpression>
 #include <QSpinBox>
 #include <QWidget>
+#include <array>
+#include <cmath>
 
 namespace helper {
 
@@ -574,40 +577,124 @@ void applyEffect(QWidget* parent)
     }
 }
 
-qreal similarity(const QString& s1, const QString& s2)
+namespace {
+
+/// \brief Bit-parallel Levenshtein distance (Myers/Hyyrö) for patterns of at most 64 characters.
+/// \details Stops early and returns maxDistance + 1 as soon as the distance must exceed maxDistance.
+int boundedEditDistanceBitParallel(const QString& pattern, const QString& text, int maxDistance)
 {
-    const elch_size_t len1 = s1.length();
-    const elch_size_t len2 = s2.length();
+    const int m = qsizetype_to_int(pattern.length());
+    const int n = qsizetype_to_int(text.length());
 
-    if (s1 == s2) {
-        return 1;
+    // Bit masks of all pattern positions per character. Most characters are Latin-1.
+    std::array<quint64, 256> latin1Masks{};
+    QHash<ushort, quint64> otherMasks;
+    for (int i = 0; i < m; ++i) {
+        const ushort c = pattern.at(i).unicode();
+        if (c < 256) {
+            latin1Masks[c] |= quint64(1) << i;
+        } else {
+            otherMasks[c] |= quint64(1) << i;
+        }
     }
 
-    if (len1 == 0 || len2 == 0) {
-        return 0;
-    }
+    const quint64 lastBit = quint64(1) << (m - 1);
+    quint64 positiveVertical = ~quint64(0);
+    quint64 negativeVertical = 0;
+    int distance = m;
 
-    QVector<QVector<int>> d(len1);
+    for (int j = 0; j < n; ++j) {
+        const ushort c = text.at(j).unicode();
+        const quint64 equal = c < 256 ? latin1Masks[c] : otherMasks.value(c, 0);
+        const quint64 xVertical = equal | negativeVertical;
+        const quint64 xHorizontal = (((equal & positiveVertical) + positiveVertical) ^ positiveVertical) | equal;
+        quint64 positiveHorizontal = negativeVertical | ~(xHorizontal | positiveVertical);
+        quint64 negativeHorizontal = positiveVertical & xHorizontal;
 
-    d.insert(0, QVector<int>(len1));
-    d[0].insert(0, 0);
-    for (int i = 1; i <= len1; ++i) {
-        d.insert(i, QVector<int>());
-        d[i].insert(0, i);
+        if ((positiveHorizontal & lastBit) != 0) {
+            ++distance;
+        } else if ((negativeHorizontal & lastBit) != 0) {
+            --distance;
+        }
+        // The remaining characters can reduce the distance by at most one each.
+        if (distance - (n - j - 1) > maxDistance) {
+            return maxDistance + 1;
+        }
+
+        // Global alignment: The first row of the distance matrix increases by one per column.
+        positiveHorizontal = (positiveHorizontal << 1) | 1;
+        negativeHorizontal <<= 1;
+        positiveVertical = negativeHorizontal | ~(xVertical | positiveHorizontal);
+        negativeVertical = positiveHorizontal & xVertical;
     }
-    for (int i = 1; i <= len2; ++i) {
-        d[0].insert(i, i);
+    return distance;
+}
+
+/// \brief Levenshtein distance using two rows of the distance matrix.
+/// \details Stops early and returns maxDistance + 1 as soon as the distance must exceed maxDistance.
+int boundedEditDistanceTwoRows(const QString& s1, const QString& s2, int maxDistance)
+{
+    const int len1 = qsizetype_to_int(s1.length());
+    const int len2 = qsizetype_to_int(s2.length());
+
+    QVector<int> previous(len2 + 1);
+    QVector<int> current(len2 + 1);
+    for (int j = 0; j <= len2; ++j) {
+        previous[j] = j;
     }
 
     for (int i = 1; i <= len1; ++i) {
+        current[0] = i;
+        int rowMinimum = i;
+        const QChar c = s1.at(i - 1);
         for (int j = 1; j <= len2; ++j) {
-            d[i].insert(j,
-                qMin(qMin(d[i - 1][j] + 1, d[i][j - 1] + 1), d[i - 1][j - 1] + (s1.at(i - 1) == s2.at(j - 1) ? 0 : 1)));
+            const int substitution = previous[j - 1] + (c == s2.at(j - 1) ? 0 : 1);
+            current[j] = qMin(qMin(previous[j] + 1, current[j - 1] + 1), substitution);
+            rowMinimum = qMin(rowMinimum, current[j]);
+        }
+        // The minimum of a row never decreases in the following rows.
+        if (rowMinimum > maxDistance) {
+            return maxDistance + 1;
         }
+        std::swap(previous, current);
     }
+    return previous[len2];
+}
+
+} // namespace
 
-    qreal dist = d[len1][len2];
-    return 1 - (dist / static_cast<qreal>(qMax(len1, len2)));
+qreal similarity(const QString& s1, const QString& s2)
+{
+    return similarity(s1, s2, 0);
+}
+
+qreal similarity(const QString& s1, const QString& s2, qreal minSimilarity)
+{
+    if (s1 == s2) {
+        return 1;
+    }
+
+    const int len1 = qsizetype_to_int(s1.length());
+    const int len2 = qsizetype_to_int(s2.length());
+    if (len1 == 0 || len2 == 0) {
+        return 0;
+    }
+
+    const int maxLength = qMax(len1, len2);
+    // Small epsilon so that rounding errors don't exclude strings that are exactly at the limit.
+    const int maxDistance = static_cast<int>(std::floor((1 - minSimilarity) * maxLength + 1e-9));
+    if (qAbs(len1 - len2) > maxDistance) {
+        return 0;
+    }
+
+    const QString& shorter = len1 <= len2 ? s1 : s2;
+    const QString& longer = len1 <= len2 ? s2 : s1;
+    const int distance = shorter.length() <= 64 ? boundedEditDistanceBitParallel(shorter, longer, maxDistance)
+                                                : boundedEditDistanceTwoRows(shorter, longer, maxDistance);
+    if (distance > maxDistance) {
+        return 0;
+    }
+    return 1 - (distance / static_cast<qreal>(maxLength));
 }
 
 QMap<ColorLabel, QString> labels()
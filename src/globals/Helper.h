@@ -59,7 +59,10 @@ QString formatFileSize(int64_t size, const QLocale& locale);
 void removeFocusRect(QWidget* widget);
 void applyStyle(QWidget* widget, bool removeFocus = true, bool isTable = false);
 void applyEffect(QWidget* parent);
+/// \brief Similarity of two strings based on their Levenshtein distance, from 0 (different) to 1 (equal).
 qreal similarity(const QString& s1, const QString& s2);
+/// \brief Like similarity(s1, s2) but returns 0 early if the similarity is below minSimilarity.
+qreal similarity(const QString& s1, const QString& s2, qreal minSimilarity);
 QMap<ColorLabel, QString> labels();
 QColor colorForLabel(ColorLabel label);
 QIcon iconForLabel(ColorLabel label);
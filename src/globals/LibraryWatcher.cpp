@@ -0,0 +1,330 @@
+#include "globals/LibraryWatcher.h"
+
+#include "log/Log.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent>
+
+namespace mediaelch {
+
+/// \brief Number of directories that are watched per event loop iteration by rewatch().
+static constexpr int s_watchBatchSize = 1000;
+
+static QString cleanDirectoryPath(const QString& path)
+{
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+LibraryWatcher::LibraryWatcher(QObject* parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(5000);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &LibraryWatcher::onDirectoryChanged);
+    connect(&m_timer, &QTimer::timeout, this, &LibraryWatcher::onTimeout);
+    connect(&m_walkWatcher, &QFutureWatcher<DirectoryWalk>::finished, this, &LibraryWatcher::onWalkFinished);
+}
+
+LibraryWatcher::~LibraryWatcher()
+{
+    // The walk only uses copies of this object's data; it just needs to stop early.
+    if (m_walkAborted) {
+        m_walkAborted->store(true);
+    }
+}
+
+void LibraryWatcher::setDirectories(SettingsDirType type, const QVector<SettingsDir>& directories)
+{
+    QStringList paths;
+    for (const SettingsDir& dir : directories) {
+        if (!dir.disabled && dir.path.exists()) {
+            paths << cleanDirectoryPath(dir.path.path());
+        }
+    }
+    m_directories[type] = paths;
+    m_pending.remove(type);
+}
+
+void LibraryWatcher::setMaxWatchedDirectories(int max)
+{
+    m_maxWatchedDirectories = max;
+}
+
+void LibraryWatcher::setDelay(int milliseconds)
+{
+    m_timer.setInterval(milliseconds);
+}
+
+int LibraryWatcher::defaultMaxWatchedDirectories()
+{
+#ifdef Q_OS_LINUX
+    QFile file("/proc/sys/fs/inotify/max_user_watches");
+    if (file.open(QIODevice::ReadOnly)) {
+        bool ok = false;
+        const int maxUserWatches = QString::fromLatin1(file.readAll()).trimmed().toInt(&ok);
+        if (ok && maxUserWatches > 0) {
+            return qMax(10, maxUserWatches / 2);
+        }
+    }
+#endif
+    return 8000;
+}
+
+void LibraryWatcher::postpone(SettingsDirType type, const QVector<DirectoryPath>& directories)
+{
+    for (const DirectoryPath& dir : directories) {
+        addPending(type, cleanDirectoryPath(dir.toString()));
+    }
+    m_timer.start();
+}
+
+void LibraryWatcher::rewatch()
+{
+    if (m_walkAborted) {
+        m_walkAborted->store(true);
+    }
+    if (!m_watched.isEmpty()) {
+        m_watcher.removePaths(m_watched.values());
+    }
+    m_watched.clear();
+    m_skipped.clear();
+    m_roots.clear();
+    m_queued.clear();
+    m_queuedIndex = 0;
+    m_limit = m_maxWatchedDirectories > 0 ? m_maxWatchedDirectories : defaultMaxWatchedDirectories();
+    m_limitReached = false;
+    m_rewatching = true;
+    ++m_generation;
+
+    // Media directories first so that they are watched even if the limit is reached.
+    QStringList roots;
+    for (auto it = m_directories.cbegin(); it != m_directories.cend(); ++it) {
+        for (const QString& root : it.value()) {
+            if (!m_watched.contains(root)) {
+                watchDirectories({root});
+            }
+            if (m_watched.contains(root)) {
+                m_roots.append({it.key(), root});
+                roots << root;
+            }
+        }
+    }
+
+    // Listing all subdirectories of large libraries takes a while, especially on network shares.
+    const QSet<QString> known = m_watched;
+    const int limit = qMax(0, m_limit - qsizetype_to_int(m_watched.size()));
+    m_walkAborted = std::make_shared<std::atomic_bool>(false);
+    std::shared_ptr<std::atomic_bool> aborted = m_walkAborted;
+    m_walkWatcher.setFuture(QtConcurrent::run([roots, known, limit, aborted]() {
+        return walkDirectories(roots, [&known](const QString& path) { return known.contains(path); }, limit, *aborted);
+    }));
+}
+
+LibraryWatcher::DirectoryWalk LibraryWatcher::walkDirectories(QStringList level,
+    const std::function<bool(const QString&)>& isKnown,
+    int limit,
+    const std::atomic_bool& aborted)
+{
+    DirectoryWalk walk;
+    // Breadth-first so that the limit is reached in the most deeply nested directories.
+    while (!level.isEmpty() && !aborted) {
+        QStringList nextLevel;
+        for (const QString& dir : asConst(level)) {
+            const QStringList entries = QDir(dir).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+            for (const QString& entry : entries) {
+                const QString path = dir + "/" + entry;
+                if (isKnown(path)) {
+                    // Its subdirectories are known as well.
+                    continue;
+                }
+                if (walk.watch.size() < limit) {
+                    walk.watch << path;
+                    nextLevel << path;
+                } else {
+                    walk.skipped << path;
+                }
+            }
+        }
+        level = std::move(nextLevel);
+    }
+    return walk;
+}
+
+void LibraryWatcher::onWalkFinished()
+{
+    if (m_walkWatcher.isCanceled() || !m_rewatching) {
+        return;
+    }
+    const DirectoryWalk walk = m_walkWatcher.result();
+    skipDirectories(walk.skipped);
+    m_queued = walk.watch;
+    m_queuedIndex = 0;
+    watchNextBatch(m_generation);
+}
+
+void LibraryWatcher::watchNextBatch(int generation)
+{
+    if (generation != m_generation) {
+        // rewatch() was called again in the meantime.
+        return;
+    }
+
+    const int count = qMin(s_watchBatchSize, qsizetype_to_int(m_queued.size()) - m_queuedIndex);
+    watchDirectories(m_queued.mid(m_queuedIndex, count));
+    m_queuedIndex += count;
+    if (m_queuedIndex < m_queued.size()) {
+        QTimer::singleShot(0, this, [this, generation]() { watchNextBatch(generation); });
+        return;
+    }
+
+    m_queued.clear();
+    m_queuedIndex = 0;
+    m_rewatching = false;
+    qCDebug(generic) << "[LibraryWatcher] Watching" << m_watched.size() << "directories";
+
+    const QSet<QString> deferredChanges = std::move(m_deferredChanges);
+    m_deferredChanges = {};
+    for (const QString& path : deferredChanges) {
+        onDirectoryChanged(path);
+    }
+}
+
+void LibraryWatcher::watchDirectories(const QStringList& directories)
+{
+    if (directories.isEmpty()) {
+        return;
+    }
+    // addPaths() is a lot faster than calling addPath() for each directory.
+    const QStringList failed = m_watcher.addPaths(directories);
+    if (!failed.isEmpty()) {
+        qCWarning(generic) << "[LibraryWatcher] Could not watch" << failed.size()
+                           << "directories, e.g.:" << failed.first();
+    }
+    for (const QString& dir : directories) {
+        if (!failed.isEmpty() && failed.contains(dir)) {
+            m_skipped.insert(dir);
+        } else {
+            m_watched.insert(dir);
+        }
+    }
+}
+
+void LibraryWatcher::skipDirectories(const QStringList& directories)
+{
+    if (directories.isEmpty()) {
+        return;
+    }
+    if (!m_limitReached) {
+        qCWarning(generic) << "[LibraryWatcher] Limit of watched directories reached:" << m_limit
+                           << "| Changes in other directories are not detected";
+        m_limitReached = true;
+    }
+    for (const QString& dir : directories) {
+        m_skipped.insert(dir);
+    }
+}
+
+const LibraryWatcher::WatchedRoot* LibraryWatcher::rootOf(const QString& path) const
+{
+    const WatchedRoot* result = nullptr;
+    for (const WatchedRoot& root : m_roots) {
+        const bool contains = (path == root.path || path.startsWith(root.path + "/"));
+        if (contains && (result == nullptr || root.path.length() > result->path.length())) {
+            result = &root;
+        }
+    }
+    return result;
+}
+
+QString LibraryWatcher::itemDirectoryOf(const WatchedRoot& root, const QString& path)
+{
+    if (path == root.path) {
+        return path;
+    }
+    const int end = path.indexOf('/', root.path.length() + 1);
+    return end < 0 ? path : path.left(end);
+}
+
+void LibraryWatcher::addPending(SettingsDirType type, const QString& path)
+{
+    m_pending[type].insert(path);
+}
+
+void LibraryWatcher::onDirectoryChanged(const QString& path)
+{
+    if (m_rewatching) {
+        // Not all directories are known yet, i.e. new ones can't be detected.
+        m_deferredChanges.insert(path);
+        return;
+    }
+
+    const WatchedRoot* root = rootOf(path);
+    if (root == nullptr) {
+        return;
+    }
+
+    // Subdirectories may have been added or removed.
+    QStringList changed;
+    const bool exists = QFileInfo::exists(path);
+    if (exists) {
+        // Known directories are never reported as new, even if they are not watched.
+        const auto isKnown = [this](const QString& dir) { return m_watched.contains(dir) || m_skipped.contains(dir); };
+        const int limit = qMax(0, m_limit - qsizetype_to_int(m_watched.size()));
+        const std::atomic_bool notAborted{false};
+        const DirectoryWalk walk = walkDirectories({path}, isKnown, limit, notAborted);
+        watchDirectories(walk.watch);
+        skipDirectories(walk.skipped);
+        changed << walk.watch << walk.skipped;
+    }
+
+    const QString prefix = path + "/";
+    QStringList removed;
+    for (const QSet<QString>* known : {&m_watched, &m_skipped}) {
+        for (const QString& dir : *known) {
+            if (dir.startsWith(prefix) && !QFileInfo::exists(dir)) {
+                removed << dir;
+            }
+        }
+    }
+    if (!exists) {
+        removed << path;
+    }
+    for (const QString& dir : asConst(removed)) {
+        // QFileSystemWatcher stops watching removed directories on its own.
+        m_watched.remove(dir);
+        m_skipped.remove(dir);
+    }
+    changed << removed;
+
+    if (path == root->path && changed.isEmpty()) {
+        // Files directly inside the media directory changed.
+        addPending(root->type, root->path);
+    } else if (path != root->path) {
+        changed << path;
+    }
+    // Items are reloaded as a whole, e.g. a TV show if one of its seasons changed.
+    for (const QString& dir : asConst(changed)) {
+        addPending(root->type, itemDirectoryOf(*root, dir));
+    }
+
+    // Restart the timer to coalesce bursts of events, e.g. while copying files.
+    m_timer.start();
+}
+
+void LibraryWatcher::onTimeout()
+{
+    const QMap<SettingsDirType, QSet<QString>> pending = std::move(m_pending);
+    m_pending = {};
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        QVector<DirectoryPath> directories;
+        for (const QString& dir : it.value()) {
+            directories << DirectoryPath(dir);
+        }
+        qCInfo(generic) << "[LibraryWatcher] Directories changed:" << directories.size();
+        emit directoriesChanged(it.key(), directories);
+    }
+}
+
+} // namespace mediaelch
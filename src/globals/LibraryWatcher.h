@@ -0,0 +1,148 @@
+#pragma once
+
+#include "file/Path.h"
+#include "globals/Globals.h"
+
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief   Watches media directories for changes, e.g. new downloads.
+/// \details Only directories are watched, never single files: Each media directory
+///          itself and all of its subdirectories, e.g. season folders of TV shows.
+///          The total number of watched directories is limited so that the
+///          operating system's limit (e.g. inotify's max_user_watches) is not hit.
+///          Directories are watched level by level, so that the limit only affects
+///          the most deeply nested directories.  Changes inside directories that
+///          are not watched are not detected.
+///          Changes are collected and reported after a delay so that copying a movie
+///          with all its files only results in one notification.
+///
+/// \par Example
+/// \code{cpp}
+///   LibraryWatcher watcher;
+///   watcher.setDirectories(SettingsDirType::Movies, directories);
+///   watcher.rewatch();
+///   connect(&watcher, &LibraryWatcher::directoriesChanged, ...);
+/// \endcode
+class LibraryWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LibraryWatcher(QObject* parent = nullptr);
+    ~LibraryWatcher() override;
+
+    /// \brief   Replace all watched directories of the given type. Disabled directories are ignored.
+    /// \details Only takes effect after rewatch() is called.
+    void setDirectories(SettingsDirType type, const QVector<SettingsDir>& directories);
+    /// \brief   Maximum number of directories that are watched in total.
+    /// \details 0 uses defaultMaxWatchedDirectories(). Only takes effect after rewatch() is called.
+    void setMaxWatchedDirectories(int max);
+    /// \brief Time in milliseconds that changes are collected before they are reported.
+    void setDelay(int milliseconds);
+    /// \brief   Remove all watches and watch all media directories again.
+    /// \details Subdirectories are listed in a background thread and watched in batches,
+    ///          so that large libraries don't block the user interface. Changes that are
+    ///          detected in the meantime are handled once all directories are watched.
+    void rewatch();
+    /// \brief Report the given directories again after the delay, e.g. because they can't be reloaded right now.
+    void postpone(SettingsDirType type, const QVector<mediaelch::DirectoryPath>& directories);
+
+    int watchedDirectoryCount() const { return m_watched.size(); }
+
+    /// \brief   Default for the maximum number of watched directories.
+    /// \details On Linux, half of inotify's per-user limit (max_user_watches) so that other
+    ///          applications still have watches left.  Elsewhere 8000.
+    static int defaultMaxWatchedDirectories();
+
+signals:
+    /// \brief   Emitted after the delay with all changed directories of the given type.
+    /// \details Directories are either a media directory itself, e.g. if a file was
+    ///          added to it, or one of its direct subdirectories, e.g. a TV show directory,
+    ///          if anything inside of it changed. Subdirectories may not exist anymore if
+    ///          they were removed.
+    void directoriesChanged(SettingsDirType type, QVector<mediaelch::DirectoryPath> directories);
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+    void onTimeout();
+
+private:
+    struct WatchedRoot
+    {
+        SettingsDirType type;
+        QString path;
+    };
+
+    /// \brief Subdirectories found by walkDirectories().
+    struct DirectoryWalk
+    {
+        /// Directories that shall be watched.
+        QStringList watch;
+        /// Directories that are not watched because the limit is reached.
+        QStringList skipped;
+    };
+
+    /// \brief   Lists the given directories and all new subdirectories, level by level.
+    /// \details Directories for which isKnown() returns true are neither returned nor listed.
+    ///          Only directories that are watched are listed, so that the limit is reached
+    ///          in the most deeply nested directories and all other new directories are
+    ///          known as skipped. Thread safe.
+    static DirectoryWalk walkDirectories(QStringList level,
+        const std::function<bool(const QString&)>& isKnown,
+        int limit,
+        const std::atomic_bool& aborted);
+
+    void onWalkFinished();
+    void watchNextBatch(int generation);
+    /// \brief   Watch the given directories.
+    /// \details Directories that can't be watched are remembered as skipped.
+    void watchDirectories(const QStringList& directories);
+    void skipDirectories(const QStringList& directories);
+    /// \brief Returns the media directory that contains the given path or nullptr.
+    const WatchedRoot* rootOf(const QString& path) const;
+    /// \brief Returns the direct subdirectory of the media directory that contains the given path.
+    static QString itemDirectoryOf(const WatchedRoot& root, const QString& path);
+    void addPending(SettingsDirType type, const QString& path);
+
+private:
+    QFileSystemWatcher m_watcher;
+    QTimer m_timer;
+    QMap<SettingsDirType, QStringList> m_directories;
+    QVector<WatchedRoot> m_roots;
+    /// \brief All watched directories. Faster lookup than QFileSystemWatcher::directories().
+    QSet<QString> m_watched;
+    /// \brief   Directories that are known but not watched, e.g. because the limit is reached.
+    /// \details They are never reported as new directories.
+    QSet<QString> m_skipped;
+    QMap<SettingsDirType, QSet<QString>> m_pending;
+    int m_maxWatchedDirectories = 0;
+    /// \brief Maximum number of watched directories of the current rewatch().
+    int m_limit = 8000;
+    bool m_limitReached = false;
+
+    // State of rewatch()
+    QFutureWatcher<DirectoryWalk> m_walkWatcher;
+    std::shared_ptr<std::atomic_bool> m_walkAborted;
+    /// \brief Directories of the finished walk that are watched in batches.
+    QStringList m_queued;
+    int m_queuedIndex = 0;
+    /// \brief Incremented by each rewatch() so that batches of a previous call are ignored.
+    int m_generation = 0;
+    bool m_rewatching = false;
+    /// \brief Directories that changed while rewatching.
+    QSet<QString> m_deferredChanges;
+};
+
+} // namespace mediaelch
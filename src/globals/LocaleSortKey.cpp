@@ -0,0 +1,30 @@
+#include "globals/LocaleSortKey.h"
+
+#include <QCollator>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace mediaelch {
+
+LocaleSortKey::LocaleSortKey(const QString& str)
+{
+    if (str.isEmpty()) {
+        return;
+    }
+    // Creating a collator is expensive, so one is shared by all keys.
+    static QMutex mutex;
+    static QCollator collator;
+    QMutexLocker locker(&mutex);
+    m_key = std::make_shared<const QCollatorSortKey>(collator.sortKey(str));
+}
+
+int LocaleSortKey::compare(const LocaleSortKey& other) const
+{
+    if (m_key == nullptr || other.m_key == nullptr) {
+        // Empty strings are sorted first.
+        return (m_key != nullptr ? 1 : 0) - (other.m_key != nullptr ? 1 : 0);
+    }
+    return m_key->compare(*other.m_key);
+}
+
+} // namespace mediaelch
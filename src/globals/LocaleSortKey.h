@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QCollatorSortKey>
+#include <QString>
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief Precomputed key for sorting strings in a locale aware way.
+///
+/// Comparing two keys yields the same order as QString::localeAwareCompare()
+/// but is a lot faster, because the locale's collation rules are only applied
+/// once per string.  Unlike QCollatorSortKey, keys are default constructible
+/// and cheap to copy so that they can be stored alongside model items.
+class LocaleSortKey
+{
+public:
+    /// \brief Key of an empty string.
+    LocaleSortKey() = default;
+    explicit LocaleSortKey(const QString& str);
+
+    /// \brief Returns a negative value if this key is less than other, 0 if both are equal
+    ///        and a positive value otherwise.
+    int compare(const LocaleSortKey& other) const;
+    bool operator<(const LocaleSortKey& other) const { return compare(other) < 0; }
+
+private:
+    /// \brief nullptr for empty strings.
+    std::shared_ptr<const QCollatorSortKey> m_key;
+};
+
+} // namespace mediaelch
@@ -210,6 +210,22 @@ void Manager::setFileScannerDialog(FileScannerDialog* dialog)
     m_fileScannerDialog = dialog;
 }
 
+bool Manager::isLoadingMedia()
+{
+    return m_movieFileSearcher->isRunning() || m_tvShowFileSearcher->isRunning()
+           || m_concertFileSearcher->isRunning() || m_musicFileSearcher->isRunning();
+}
+
+bool Manager::isExporting() const
+{
+    return m_exporting;
+}
+
+void Manager::setExporting(bool exporting)
+{
+    m_exporting = exporting;
+}
+
 QVector<mediaelch::scraper::TrailerProvider*> Manager::trailerProviders()
 {
     return m_trailerProviders;
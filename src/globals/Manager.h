@@ -62,6 +62,14 @@ public:
     void setMusicFilesWidget(MusicFilesWidget* widget);
     void setFileScannerDialog(FileScannerDialog* dialog);
 
+    /// \brief Whether any file searcher is currently (re-)loading media.
+    ELCH_NODISCARD bool isLoadingMedia();
+    /// \brief Whether an HTML or CSV export is running.
+    /// \details Exports read the loaded media in worker threads while events are processed,
+    ///          so media must neither be reloaded nor be exported while it is loaded.
+    ELCH_NODISCARD bool isExporting() const;
+    void setExporting(bool exporting);
+
 private:
     QVector<MediaCenterInterface*> m_mediaCenters;
     QVector<MediaCenterInterface*> m_mediaCentersTvShow;
@@ -83,4 +91,5 @@ private:
     FileScannerDialog* m_fileScannerDialog = nullptr;
     MusicFileSearcher* m_musicFileSearcher = nullptr;
     MyIconFont* m_iconFont = nullptr;
+    bool m_exporting = false;
 };
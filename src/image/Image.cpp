@@ -1,8 +1,10 @@
 #include "Image.h"
 
 #include <QFile>
+#include <atomic>
 
-static int s_idCounter = 0;
+// Booklets are loaded by the music file searcher's worker threads.
+static std::atomic<int> s_idCounter{0};
 
 Image::Image(QObject* parent) : QObject(parent), m_deletion{false}
 {
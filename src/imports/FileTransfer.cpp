@@ -0,0 +1,239 @@
+#include "imports/FileTransfer.h"
+
+#include "log/Log.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+
+#ifdef Q_OS_LINUX
+#    include <cerrno>
+#    include <cstring>
+#    include <linux/fs.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace {
+
+/// \brief Bytes that are copied at once. Progress is reported after each chunk.
+constexpr qint64 copyChunkSize = 8 * 1024 * 1024;
+constexpr int bufferSize = 1024 * 1024;
+
+QByteArray checksum(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return {};
+    }
+    return hash.result();
+}
+
+} // namespace
+
+namespace mediaelch {
+
+FileTransfer::FileTransfer(QString sourceFile, QString destinationFile) :
+    m_sourceFile{std::move(sourceFile)}, m_destinationFile{std::move(destinationFile)}
+{
+}
+
+QString FileTransfer::partFileName(const QString& destinationFile)
+{
+    return destinationFile + QStringLiteral(".part");
+}
+
+bool FileTransfer::copy()
+{
+    m_errorString.clear();
+    m_wasResumed = false;
+
+    if (QFileInfo::exists(m_destinationFile)) {
+        return fail(QStringLiteral("Destination already exists"));
+    }
+
+    const QString partFile = partFileName(m_destinationFile);
+    // A resumed copy that does not match the source is copied once more from scratch.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!copyToPartFile()) {
+            // The part file is kept so that the copy can be resumed later.
+            return false;
+        }
+        if ((m_verifyChecksum || m_wasResumed) && !hasSameContent(m_sourceFile, partFile)) {
+            QFile::remove(partFile);
+            if (m_wasResumed) {
+                qCWarning(generic) << "[FileTransfer] Resumed copy differs from source, copying again:" << m_sourceFile;
+                continue;
+            }
+            return fail(QStringLiteral("Checksums of source and copy differ"));
+        }
+
+        QFile::setPermissions(partFile, QFileInfo(m_sourceFile).permissions());
+        if (!QFile::rename(partFile, m_destinationFile)) {
+            return fail(QStringLiteral("Could not rename %1").arg(partFile));
+        }
+        return true;
+    }
+    return fail(QStringLiteral("Checksums of source and copy differ"));
+}
+
+bool FileTransfer::move()
+{
+    m_errorString.clear();
+    m_wasResumed = false;
+
+    if (QFileInfo::exists(m_destinationFile)) {
+        return fail(QStringLiteral("Destination already exists"));
+    }
+
+    // Unlike QFile::rename(), QDir::rename() does not fall back to copying the file,
+    // i.e. it only succeeds if source and destination are on the same device.
+    if (QDir().rename(m_sourceFile, m_destinationFile)) {
+        reportProgress(QFileInfo(m_destinationFile).size());
+        return true;
+    }
+
+    if (!copy()) {
+        return false;
+    }
+    if (!QFile::remove(m_sourceFile)) {
+        qCWarning(generic) << "[FileTransfer] Could not remove source after copying:" << m_sourceFile;
+    }
+    return true;
+}
+
+bool FileTransfer::copyToPartFile()
+{
+    QFile source(m_sourceFile);
+    if (!source.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        return fail(source.errorString());
+    }
+    // ReadWrite does not truncate existing part files.
+    QFile part(partFileName(m_destinationFile));
+    if (!part.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        return fail(part.errorString());
+    }
+
+    const qint64 size = source.size();
+    qint64 offset = part.size();
+    if (offset > size) {
+        // The part file can't belong to this source.
+        if (!part.resize(0)) {
+            return fail(part.errorString());
+        }
+        offset = 0;
+    }
+    m_wasResumed = offset > 0;
+    if (m_wasResumed) {
+        qCInfo(generic) << "[FileTransfer] Resuming copy of" << m_sourceFile << "at byte" << offset << "of" << size;
+    }
+    reportProgress(offset);
+
+    bool success = false;
+    if (offset == 0 && cloneFile(source, part)) {
+        reportProgress(size);
+        success = true;
+    } else {
+        success = copyData(source, part, offset, size);
+    }
+    part.close();
+
+    if (success && QFileInfo(part.fileName()).size() != size) {
+        return fail(QStringLiteral("Copy has a different size than the source"));
+    }
+    return success;
+}
+
+bool FileTransfer::cloneFile(QFile& source, QFile& part)
+{
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+    return ::ioctl(part.handle(), FICLONE, source.handle()) == 0;
+#else
+    Q_UNUSED(source)
+    Q_UNUSED(part)
+    return false;
+#endif
+}
+
+bool FileTransfer::copyData(QFile& source, QFile& part, qint64 offset, qint64 size)
+{
+#if defined(Q_OS_LINUX) && defined(SYS_copy_file_range)
+    // The kernel copies the data without passing it through user space. It is not supported
+    // across filesystems on older kernels and by some filesystems, e.g. network shares.
+    qint64 inOffset = offset;
+    qint64 outOffset = offset;
+    while (inOffset < size) {
+        const auto length = static_cast<size_t>(qMin(copyChunkSize, size - inOffset));
+        const auto copied =
+            ::syscall(SYS_copy_file_range, source.handle(), &inOffset, part.handle(), &outOffset, length, 0U);
+        if (copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP || errno == EBADF) {
+                break;
+            }
+            return fail(QString::fromLocal8Bit(std::strerror(errno)));
+        }
+        if (copied == 0) {
+            // The source became smaller; the buffered copy reports the error.
+            break;
+        }
+        reportProgress(inOffset);
+    }
+    offset = inOffset;
+    if (offset >= size) {
+        return true;
+    }
+#endif
+    return copyBuffered(source, part, offset, size);
+}
+
+bool FileTransfer::copyBuffered(QFile& source, QFile& part, qint64 offset, qint64 size)
+{
+    if (!source.seek(offset) || !part.seek(offset)) {
+        return fail(QStringLiteral("Could not seek to byte %1").arg(offset));
+    }
+
+    QByteArray buffer(bufferSize, Qt::Uninitialized);
+    while (offset < size) {
+        const qint64 bytesRead = source.read(buffer.data(), qMin<qint64>(buffer.size(), size - offset));
+        if (bytesRead <= 0) {
+            return fail(source.errorString());
+        }
+        if (part.write(buffer.constData(), bytesRead) != bytesRead) {
+            return fail(part.errorString());
+        }
+        offset += bytesRead;
+        reportProgress(offset);
+    }
+    return true;
+}
+
+bool FileTransfer::hasSameContent(const QString& first, const QString& second) const
+{
+    const QByteArray firstChecksum = checksum(first);
+    return !firstChecksum.isEmpty() && firstChecksum == checksum(second);
+}
+
+void FileTransfer::reportProgress(qint64 bytesDone)
+{
+    if (m_progressCallback) {
+        m_progressCallback(bytesDone);
+    }
+}
+
+bool FileTransfer::fail(QString errorString)
+{
+    m_errorString = std::move(errorString);
+    qCWarning(generic) << "[FileTransfer] Transfer of" << m_sourceFile << "failed:" << m_errorString;
+    return false;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "globals/Meta.h"
+
+#include <QFile>
+#include <QString>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Copies or moves a single file, e.g. when importing downloads.
+///
+/// Files are written to "<destination>.part" first and renamed once they are
+/// complete. If a previous transfer was interrupted, the partial file is
+/// continued and the result is verified using checksums.
+/// On Linux, the data is copied by the kernel: as a reflink if the filesystem
+/// supports it, otherwise using copy_file_range().  Other systems and
+/// filesystems without support use a buffered copy.
+class FileTransfer
+{
+public:
+    /// \param bytesDone Number of bytes of the file that are transferred.
+    using ProgressCallback = std::function<void(qint64 bytesDone)>;
+
+    FileTransfer(QString sourceFile, QString destinationFile);
+
+    /// \brief Compare checksums of source and destination after copying.
+    /// \details Resumed copies are always verified.
+    void setVerifyChecksum(bool verify) { m_verifyChecksum = verify; }
+    void setProgressCallback(ProgressCallback callback) { m_progressCallback = std::move(callback); }
+
+    /// \brief Copies the source file. Fails if the destination already exists.
+    ELCH_NODISCARD bool copy();
+    /// \brief Renames the source file if source and destination are on the same
+    ///        device. Otherwise the file is copied and the source is removed.
+    ELCH_NODISCARD bool move();
+
+    /// \brief Description of the last error.
+    QString errorString() const { return m_errorString; }
+    /// \brief Whether the last copy continued a partial file of an earlier transfer.
+    bool wasResumed() const { return m_wasResumed; }
+
+    static QString partFileName(const QString& destinationFile);
+
+private:
+    /// \brief Copies or continues copying the source file into the part file.
+    bool copyToPartFile();
+    /// \brief Copies the source file using a reflink. Only works for empty part files.
+    bool cloneFile(QFile& source, QFile& part);
+    bool copyData(QFile& source, QFile& part, qint64 offset, qint64 size);
+    bool copyBuffered(QFile& source, QFile& part, qint64 offset, qint64 size);
+    bool hasSameContent(const QString& first, const QString& second) const;
+    void reportProgress(qint64 bytesDone);
+    bool fail(QString errorString);
+
+private:
+    QString m_sourceFile;
+    QString m_destinationFile;
+    ProgressCallback m_progressCallback;
+    QString m_errorString;
+    bool m_verifyChecksum = false;
+    bool m_wasResumed = false;
+};
+
+} // namespace mediaelch
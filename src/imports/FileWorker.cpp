@@ -1,8 +1,10 @@
 #include "FileWorker.h"
 
+#include "imports/FileTransfer.h"
 #include "log/Log.h"
 
-#include <QFile>
+#include <QElapsedTimer>
+#include <QFileInfo>
 
 FileWorker::FileWorker(QObject* parent) : QObject(parent)
 {
@@ -18,24 +20,54 @@ QMap<QString, QString> FileWorker::files()
     return m_files;
 }
 
+void FileWorker::setVerifyChecksums(bool verify)
+{
+    m_verifyChecksums = verify;
+}
+
 void FileWorker::copyFiles()
 {
-    QMapIterator<QString, QString> it(files());
-    while (it.hasNext()) {
-        it.next();
-        MyFile file(it.key());
-        file.copy(it.value());
-    }
-    emit sigFinished();
+    transferFiles(true);
 }
 
 void FileWorker::moveFiles()
 {
-    QMapIterator<QString, QString> it(files());
+    transferFiles(false);
+}
+
+void FileWorker::transferFiles(bool keepSourceFiles)
+{
+    qint64 bytesTotal = 0;
+    for (auto it = m_files.constBegin(); it != m_files.constEnd(); ++it) {
+        bytesTotal += QFileInfo(it.key()).size();
+    }
+
+    // Signals are queued to the GUI thread, so don't emit one for each chunk.
+    QElapsedTimer timer;
+    timer.start();
+    qint64 bytesOfPreviousFiles = 0;
+    emit sigProgress(0, bytesTotal);
+
+    QMapIterator<QString, QString> it(m_files);
     while (it.hasNext()) {
         it.next();
-        MyFile file(it.key());
-        file.rename(it.value());
+        const qint64 fileSize = QFileInfo(it.key()).size();
+
+        mediaelch::FileTransfer transfer(it.key(), it.value());
+        transfer.setVerifyChecksum(m_verifyChecksums);
+        transfer.setProgressCallback([&](qint64 bytesDone) {
+            if (timer.elapsed() >= 100) {
+                timer.restart();
+                emit sigProgress(bytesOfPreviousFiles + bytesDone, bytesTotal);
+            }
+        });
+
+        const bool success = keepSourceFiles ? transfer.copy() : transfer.move();
+        if (!success) {
+            qCWarning(generic) << "[FileWorker] Could not import" << it.key() << "to" << it.value();
+        }
+        bytesOfPreviousFiles += fileSize;
+        emit sigProgress(bytesOfPreviousFiles, bytesTotal);
     }
     emit sigFinished();
 }
@@ -1,10 +1,9 @@
 #pragma once
 
-#include "imports/MyFile.h"
-
 #include <QMap>
 #include <QObject>
 
+/// \brief Copies or moves imported files in a worker thread.
 class FileWorker : public QObject
 {
     Q_OBJECT
@@ -12,6 +11,8 @@ public:
     explicit FileWorker(QObject* parent = nullptr);
     void setFiles(QMap<QString, QString> files);
     QMap<QString, QString> files();
+    /// \brief Compare checksums of source and destination after copying.
+    void setVerifyChecksums(bool verify);
 
 public slots:
     void copyFiles();
@@ -19,7 +20,13 @@ public slots:
 
 signals:
     void sigFinished();
+    /// \brief Emitted regularly while files are transferred.
+    void sigProgress(qint64 bytesDone, qint64 bytesTotal);
+
+private:
+    void transferFiles(bool keepSourceFiles);
 
 private:
     QMap<QString, QString> m_files;
+    bool m_verifyChecksums = false;
 };
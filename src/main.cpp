@@ -10,6 +10,7 @@
 
 #include "Version.h"
 #include "log/Log.h"
+#include "network/WebsiteCache.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
 
@@ -127,6 +128,14 @@ int main(int argc, char* argv[])
     Settings::instance()->loadSettings();
 
     initLogFile();
+
+    if (Settings::instance()->advanced()->websiteCacheEnabled()) {
+        const auto* advanced = Settings::instance()->advanced();
+        mediaelch::scraper::WebsiteCache::setupPersistentCache(
+            Settings::instance()->imageCacheDir().subDir("website_cache").toString(),
+            advanced->websiteCacheTimeout() * 60 * 60,
+            static_cast<qint64>(advanced->websiteCacheMaxSize()) * 1024 * 1024);
+    }
     loadStylesheet(app, Settings::instance()->advanced()->customStylesheet());
 
     MainWindow window;
@@ -321,13 +321,17 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
+    if (movie->streamDetails() != nullptr) {
+        movie->streamDetails()->clear();
+    }
+    movie->setStreamDetailsLoaded(false);
 
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::MovieXmlReader reader(*movie);
-    reader.parseNfoDom(domDoc);
-
-    movie->setStreamDetailsLoaded(loadStreamDetails(movie->streamDetails(), domDoc));
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error parsing NFO file" << xml.errorString();
+    }
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -340,80 +344,6 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
     return true;
 }
 
-/// \brief Loads the stream details from the dom document
-/// \param streamDetails StreamDetails object
-/// \param domDoc Nfo document
-/// \return Infos loaded
-bool KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc)
-{
-    streamDetails->clear();
-    QDomNodeList elements = domDoc.elementsByTagName("streamdetails");
-    if (elements.isEmpty()) {
-        return false;
-    }
-    QDomElement elem = elements.at(0).toElement();
-    loadStreamDetails(streamDetails, elem);
-    return true;
-}
-
-void KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
-{
-    if (!elem.elementsByTagName("video").isEmpty()) {
-        QDomElement videoElem = elem.elementsByTagName("video").at(0).toElement();
-
-        std::array<StreamDetails::VideoDetails, 7> details{StreamDetails::VideoDetails::Codec,
-            StreamDetails::VideoDetails::Aspect,
-            StreamDetails::VideoDetails::Width,
-            StreamDetails::VideoDetails::Height,
-            StreamDetails::VideoDetails::DurationInSeconds,
-            StreamDetails::VideoDetails::ScanType,
-            StreamDetails::VideoDetails::StereoMode};
-
-        for (const auto detail : details) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList elements = videoElem.elementsByTagName(detailStr);
-            if (!elements.isEmpty()) {
-                streamDetails->setVideoDetail(detail, elements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList audioElements = elem.elementsByTagName("audio");
-    std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
-        StreamDetails::AudioDetails::Language,
-        StreamDetails::AudioDetails::Channels};
-
-    for (int i = 0, n = audioElements.count(); i < n; ++i) {
-        QDomElement audioElem = audioElements.at(i).toElement();
-
-        for (const auto detail : audioDetails) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList detailElements = audioElem.elementsByTagName(detailStr);
-
-            if (!detailElements.isEmpty()) {
-                streamDetails->setAudioDetail(i, detail, detailElements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList subtitleElements = elem.elementsByTagName("subtitle");
-    std::array<StreamDetails::SubtitleDetails, 1> subtitleDetails{StreamDetails::SubtitleDetails::Language};
-
-    for (int i = 0, n = subtitleElements.count(); i < n; ++i) {
-        QDomElement subtitleElem = subtitleElements.at(i).toElement();
-        if (!subtitleElem.elementsByTagName("file").isEmpty()) {
-            continue;
-        }
-        for (const auto detail : subtitleDetails) {
-            const auto detailStr = StreamDetails::detailToString(detail);
-            if (!subtitleElem.elementsByTagName(detailStr).isEmpty()) {
-                streamDetails->setSubtitleDetail(
-                    i, detail, subtitleElem.elementsByTagName(detailStr).at(0).toElement().text());
-            }
-        }
-    }
-}
-
 /// \brief Writes streamdetails to xml stream
 /// \param xml XML Stream
 /// \param streamDetails Stream Details object
@@ -797,49 +727,17 @@ bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoConten
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent));
-
-    QDomNodeList episodeDetailsList = domDoc.elementsByTagName("episodedetails");
-    if (episodeDetailsList.isEmpty()) {
+    using mediaelch::kodi::EpisodeXmlReader;
+    const QString episodesXml = EpisodeXmlReader::makeValidEpisodeXml(nfoContent);
+    const int index =
+        EpisodeXmlReader::findEpisodeDetails(episodesXml, episode->seasonNumber(), episode->episodeNumber());
+    if (index < 0) {
         return false;
     }
 
-    QDomElement episodeDetails;
-    if (episodeDetailsList.count() > 1) {
-        bool found = false;
-        for (int i = 0, n = episodeDetailsList.count(); i < n; ++i) {
-            episodeDetails = episodeDetailsList.at(i).toElement();
-            if (!episodeDetails.elementsByTagName("season").isEmpty()
-                && episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()
-                       == episode->seasonNumber().toInt()
-                && !episodeDetails.elementsByTagName("episode").isEmpty()
-                && episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()
-                       == episode->episodeNumber().toInt()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return false;
-        }
-
-    } else {
-        episodeDetails = episodeDetailsList.at(0).toElement();
-    }
-
-    mediaelch::kodi::EpisodeXmlReader reader(*episode);
-    reader.parseNfoDom(episodeDetails);
-
-    if (episodeDetails.elementsByTagName("streamdetails").count() > 0) {
-        loadStreamDetails(
-            episode->streamDetails(), episodeDetails.elementsByTagName("streamdetails").at(0).toElement());
-        episode->setStreamDetailsLoaded(true);
-    } else {
-        episode->setStreamDetailsLoaded(false);
-    }
-
-    return true;
+    episode->setStreamDetailsLoaded(false);
+    EpisodeXmlReader reader(*episode);
+    return reader.parse(episodesXml, index);
 }
 
 /**
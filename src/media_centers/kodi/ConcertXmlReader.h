@@ -3,7 +3,6 @@
 #include <QXmlStreamReader>
 
 class Concert;
-class StreamDetails;
 
 namespace mediaelch {
 namespace kodi {
@@ -20,11 +19,7 @@ private:
     void parseRatings(QXmlStreamReader& reader);
     void parseFanart(QXmlStreamReader& reader);
     void parsePoster(QXmlStreamReader& reader);
-
     void parseStreamDetails(QXmlStreamReader& reader);
-    void parseVideoStreamDetails(QXmlStreamReader& reader, StreamDetails* streamDetails);
-    void parseAudioStreamDetails(QXmlStreamReader& reader, int streamNumber, StreamDetails* streamDetails);
-    void parseSubtitleStreamDetails(QXmlStreamReader& reader, int streamNumber, StreamDetails* streamDetails);
 
 private:
     Concert& m_concert;
@@ -2,13 +2,14 @@
 
 #include "globals/Globals.h"
 #include "log/Log.h"
+#include "media_centers/kodi/StreamDetailsXmlReader.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
+#include <QStringList>
 #include <QTime>
 #include <QUrl>
+#include <array>
 
 namespace mediaelch {
 namespace kodi {
@@ -17,33 +18,142 @@ EpisodeXmlReader::EpisodeXmlReader(TvShowEpisode& episode) : m_episode{episode}
 {
 }
 
-void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
+/// \brief Moves the reader to the next <episodedetails> start element, regardless of its depth.
+static bool readNextEpisodeDetails(QXmlStreamReader& reader)
 {
-    // v17/v18 TvDbId
-    if (!episodeDetails.elementsByTagName("id").isEmpty()) {
-        m_episode.setTvdbId(TvDbId(episodeDetails.elementsByTagName("id").at(0).toElement().text()));
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement && reader.name() == QLatin1String("episodedetails")) {
+            return true;
+        }
     }
+    return false;
+}
 
-    // v16 TvDbId/ImdbId
-    if (!episodeDetails.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setTvdbId(TvDbId(value));
+bool EpisodeXmlReader::parse(const QString& episodesXml, int index)
+{
+    QXmlStreamReader reader(episodesXml);
+    for (int current = 0; readNextEpisodeDetails(reader); ++current) {
+        if (current != index) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        parseEpisodeDetails(reader);
+        if (reader.hasError()) {
+            qCWarning(generic) << "[EpisodeXmlReader] Error parsing NFO file:" << reader.errorString();
         }
+        return true;
     }
-    if (!episodeDetails.elementsByTagName("imdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setImdbId(ImdbId(value));
+    return false;
+}
+
+int EpisodeXmlReader::findEpisodeDetails(const QString& episodesXml, SeasonNumber season, EpisodeNumber episode)
+{
+    const QString tag = QStringLiteral("<episodedetails");
+    const elch_size_t first = episodesXml.indexOf(tag);
+    if (first < 0) {
+        return -1;
+    }
+    if (episodesXml.indexOf(tag, first + 1) < 0) {
+        // Only one episode: No need to read the whole document twice.
+        return 0;
+    }
+
+    QXmlStreamReader reader(episodesXml);
+    for (int index = 0; readNextEpisodeDetails(reader); ++index) {
+        int seasonNumber = -1;
+        int episodeNumber = -1;
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("season") && seasonNumber < 0) {
+                seasonNumber = reader.readElementText().toInt();
+            } else if (reader.name() == QLatin1String("episode") && episodeNumber < 0) {
+                episodeNumber = reader.readElementText().toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+        if (seasonNumber == season.toInt() && episodeNumber == episode.toInt()) {
+            return index;
         }
     }
+    return -1;
+}
+
+void EpisodeXmlReader::parseEpisodeDetails(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        const TagParser parser = tagParser(reader);
+        if (parser != nullptr) {
+            (this->*parser)(reader);
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+    storeCollectedValues();
+}
+
+EpisodeXmlReader::TagParser EpisodeXmlReader::tagParser(const QXmlStreamReader& reader)
+{
+    // Built once and shared by all readers. Ordered by how common the tags are.
+    // clang-format off
+    static const std::array<TagParserEntry, 27> tagParsers{{
+        {QLatin1String("actor"),          &EpisodeXmlReader::episodeActor},
+        {QLatin1String("credits"),        &EpisodeXmlReader::episodeCredits},
+        {QLatin1String("director"),       &EpisodeXmlReader::episodeDirector},
+        {QLatin1String("uniqueid"),       &EpisodeXmlReader::episodeUniqueId},
+        {QLatin1String("tag"),            &EpisodeXmlReader::episodeTag},
+        {QLatin1String("title"),          &EpisodeXmlReader::episodeTitle},
+        {QLatin1String("showtitle"),      &EpisodeXmlReader::episodeShowTitle},
+        {QLatin1String("season"),         &EpisodeXmlReader::episodeSeason},
+        {QLatin1String("episode"),        &EpisodeXmlReader::episodeEpisode},
+        {QLatin1String("displayseason"),  &EpisodeXmlReader::episodeDisplaySeason},
+        {QLatin1String("displayepisode"), &EpisodeXmlReader::episodeDisplayEpisode},
+        {QLatin1String("ratings"),        &EpisodeXmlReader::episodeRatingsV17},
+        {QLatin1String("rating"),         &EpisodeXmlReader::episodeRatingV16},
+        {QLatin1String("votes"),          &EpisodeXmlReader::episodeVotesV16},
+        {QLatin1String("top250"),         &EpisodeXmlReader::episodeTop250},
+        {QLatin1String("plot"),           &EpisodeXmlReader::episodePlot},
+        {QLatin1String("mpaa"),           &EpisodeXmlReader::episodeCertification},
+        {QLatin1String("aired"),          &EpisodeXmlReader::episodeFirstAired},
+        {QLatin1String("playcount"),      &EpisodeXmlReader::episodePlayCount},
+        {QLatin1String("epbookmark"),     &EpisodeXmlReader::episodeBookmark},
+        {QLatin1String("lastplayed"),     &EpisodeXmlReader::episodeLastPlayed},
+        {QLatin1String("studio"),         &EpisodeXmlReader::episodeNetwork},
+        {QLatin1String("thumb"),          &EpisodeXmlReader::episodeThumbnail},
+        {QLatin1String("id"),             &EpisodeXmlReader::episodeTvDbIdV17},
+        {QLatin1String("tvdbid"),         &EpisodeXmlReader::episodeTvDbIdV16},
+        {QLatin1String("imdbid"),         &EpisodeXmlReader::episodeImdbIdV16},
+        {QLatin1String("fileinfo"),       &EpisodeXmlReader::episodeFileInfo},
+    }};
+    // clang-format on
+
+    const auto name = reader.name();
+    for (const TagParserEntry& entry : tagParsers) {
+        if (name == entry.tag) {
+            return entry.parser;
+        }
+    }
+    return nullptr;
+}
+
+void EpisodeXmlReader::storeCollectedValues()
+{
+    // v17/v18 TvDbId
+    if (!m_tvdbIdV17.isNull()) {
+        m_episode.setTvdbId(TvDbId(m_tvdbIdV17));
+    }
+
+    // v16 TvDbId/ImdbId
+    if (!m_tvdbIdV16.isEmpty()) {
+        m_episode.setTvdbId(TvDbId(m_tvdbIdV16));
+    }
+    if (!m_imdbIdV16.isEmpty()) {
+        m_episode.setImdbId(ImdbId(m_imdbIdV16));
+    }
 
     // v17 ids
-    auto uniqueIds = episodeDetails.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        const QString& type = uniqueId.first;
+        const QString& value = uniqueId.second;
 
         if (value.isEmpty()) {
             // Silently skip empty values; we wouldn't get any benefit from them
@@ -63,160 +173,255 @@ void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
         }
     }
 
-    if (!episodeDetails.elementsByTagName("title").isEmpty()) {
-        m_episode.setTitle(episodeDetails.elementsByTagName("title").at(0).toElement().text());
-    }
-    if (!episodeDetails.elementsByTagName("showtitle").isEmpty()) {
-        m_episode.setShowTitle(episodeDetails.elementsByTagName("showtitle").at(0).toElement().text());
+    // The new ratings syntax takes precedence over the "old" one:
+    // <rating>10.0</rating>
+    // <votes>10.0</votes>
+    if (!m_hasRatingsV17 && !m_ratingV16.isEmpty()) {
+        Rating rating;
+        rating.rating = m_ratingV16.replace(",", ".").toDouble();
+        rating.voteCount = m_votesV16.replace(",", "").replace(".", "").toInt();
+        // Note: We clear exiting ratings because there can only be one v16 rating tag.
+        m_episode.ratings().clear();
+        m_episode.ratings().setOrAddRating(rating);
+        m_episode.setChanged(true);
     }
-    if (!episodeDetails.elementsByTagName("season").isEmpty()) {
-        m_episode.setSeason(SeasonNumber(episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()));
+}
+
+void EpisodeXmlReader::episodeTitle(QXmlStreamReader& reader)
+{
+    m_episode.setTitle(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeShowTitle(QXmlStreamReader& reader)
+{
+    m_episode.setShowTitle(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeSeason(QXmlStreamReader& reader)
+{
+    m_episode.setSeason(SeasonNumber(reader.readElementText().toInt()));
+}
+
+void EpisodeXmlReader::episodeEpisode(QXmlStreamReader& reader)
+{
+    m_episode.setEpisode(EpisodeNumber(reader.readElementText().toInt()));
+}
+
+void EpisodeXmlReader::episodeDisplaySeason(QXmlStreamReader& reader)
+{
+    m_episode.setDisplaySeason(SeasonNumber(reader.readElementText().toInt()));
+}
+
+void EpisodeXmlReader::episodeDisplayEpisode(QXmlStreamReader& reader)
+{
+    m_episode.setDisplayEpisode(EpisodeNumber(reader.readElementText().toInt()));
+}
+
+void EpisodeXmlReader::episodeTop250(QXmlStreamReader& reader)
+{
+    m_episode.setTop250(reader.readElementText().toInt());
+}
+
+void EpisodeXmlReader::episodePlot(QXmlStreamReader& reader)
+{
+    m_episode.setOverview(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeCertification(QXmlStreamReader& reader)
+{
+    m_episode.setCertification(Certification(reader.readElementText()));
+}
+
+void EpisodeXmlReader::episodeFirstAired(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (!value.isEmpty()) {
+        const QDate date = QDate::fromString(value, "yyyy-MM-dd");
+        if (date.isValid()) {
+            m_episode.setFirstAired(date);
+        }
     }
-    if (!episodeDetails.elementsByTagName("episode").isEmpty()) {
-        m_episode.setEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()));
+}
+
+void EpisodeXmlReader::episodePlayCount(QXmlStreamReader& reader)
+{
+    m_episode.setPlayCount(reader.readElementText().toInt());
+}
+
+void EpisodeXmlReader::episodeBookmark(QXmlStreamReader& reader)
+{
+    m_episode.setEpBookmark(QTime(0, 0, 0).addSecs(reader.readElementText().toInt()));
+}
+
+void EpisodeXmlReader::episodeLastPlayed(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (value.isEmpty()) {
+        return;
     }
-    if (!episodeDetails.elementsByTagName("displayseason").isEmpty()) {
-        m_episode.setDisplaySeason(
-            SeasonNumber(episodeDetails.elementsByTagName("displayseason").at(0).toElement().text().toInt()));
+    const QDateTime dateTime = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
+    if (dateTime.isValid()) {
+        m_episode.setLastPlayed(dateTime);
+    } else {
+        const QDateTime date = QDateTime::fromString(value, "yyyy-MM-dd");
+        if (date.isValid()) {
+            m_episode.setLastPlayed(date);
+        }
     }
-    if (!episodeDetails.elementsByTagName("displayepisode").isEmpty()) {
-        m_episode.setDisplayEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("displayepisode").at(0).toElement().text().toInt()));
+}
+
+void EpisodeXmlReader::episodeNetwork(QXmlStreamReader& reader)
+{
+    m_episode.setNetwork(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeTag(QXmlStreamReader& reader)
+{
+    // tags are officially not yet supported, even by Kodi 19 but scraper providers start
+    // to support them
+    m_episode.addTag(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeThumbnail(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (!m_hasThumbnail) {
+        m_episode.setThumbnail(QUrl(value));
+        m_hasThumbnail = true;
     }
+}
 
-    // check for new ratings syntax
-    if (!episodeDetails.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = episodeDetails.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_episode.ratings().clear();
+void EpisodeXmlReader::episodeCredits(QXmlStreamReader& reader)
+{
+    m_episode.addWriter(reader.readElementText());
+}
 
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_episode.ratings().setOrAddRating(rating);
-            m_episode.setChanged(true);
-        }
-
-    } else if (!episodeDetails.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = episodeDetails.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!episodeDetails.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = episodeDetails.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
-            }
-            // Note: We clear exiting ratings because there can only be one v16 rating tag.
-            m_episode.ratings().clear();
-            m_episode.ratings().setOrAddRating(rating);
-            m_episode.setChanged(true);
+void EpisodeXmlReader::episodeDirector(QXmlStreamReader& reader)
+{
+    m_episode.addDirector(reader.readElementText());
+}
+
+void EpisodeXmlReader::episodeActor(QXmlStreamReader& reader)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("name")) {
+            a.name = reader.readElementText();
+        } else if (reader.name() == QLatin1String("role")) {
+            a.role = reader.readElementText();
+        } else if (reader.name() == QLatin1String("thumb")) {
+            a.thumb = reader.readElementText();
+        } else if (reader.name() == QLatin1String("order")) {
+            a.order = reader.readElementText().toInt();
+        } else {
+            reader.skipCurrentElement();
         }
     }
+    m_episode.addActor(a);
+}
 
-    if (!episodeDetails.elementsByTagName("top250").isEmpty()) {
-        m_episode.setTop250(episodeDetails.elementsByTagName("top250").at(0).toElement().text().toInt());
-    }
-    if (!episodeDetails.elementsByTagName("plot").isEmpty()) {
-        m_episode.setOverview(episodeDetails.elementsByTagName("plot").at(0).toElement().text());
-    }
-    if (!episodeDetails.elementsByTagName("mpaa").isEmpty()) {
-        m_episode.setCertification(Certification(episodeDetails.elementsByTagName("mpaa").at(0).toElement().text()));
+void EpisodeXmlReader::episodeTvDbIdV17(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_tvdbIdV17.isNull()) {
+        m_tvdbIdV17 = value;
     }
-    if (!episodeDetails.elementsByTagName("aired").isEmpty()) {
-        const QDomElement aired = episodeDetails.elementsByTagName("aired").at(0).toElement();
-        if (!aired.isNull() && !aired.text().isEmpty()) {
-            const QDate date = QDate::fromString(aired.text(), "yyyy-MM-dd");
-            if (date.isValid()) {
-                m_episode.setFirstAired(date);
-            }
-        }
+}
+
+void EpisodeXmlReader::episodeTvDbIdV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_tvdbIdV16.isEmpty()) {
+        m_tvdbIdV16 = value;
     }
-    if (!episodeDetails.elementsByTagName("playcount").isEmpty()) {
-        m_episode.setPlayCount(episodeDetails.elementsByTagName("playcount").at(0).toElement().text().toInt());
+}
+
+void EpisodeXmlReader::episodeImdbIdV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_imdbIdV16.isEmpty()) {
+        m_imdbIdV16 = value;
     }
-    if (!episodeDetails.elementsByTagName("epbookmark").isEmpty()) {
-        m_episode.setEpBookmark(
-            QTime(0, 0, 0).addSecs(episodeDetails.elementsByTagName("epbookmark").at(0).toElement().text().toInt()));
+}
+
+void EpisodeXmlReader::episodeUniqueId(QXmlStreamReader& reader)
+{
+    const QString type = reader.attributes().value("type").toString();
+    m_uniqueIds.append({type, reader.readElementText().trimmed()});
+}
+
+void EpisodeXmlReader::episodeRatingsV17(QXmlStreamReader& reader)
+{
+    if (m_hasRatingsV17) {
+        reader.skipCurrentElement();
+        return;
     }
-    if (!episodeDetails.elementsByTagName("lastplayed").isEmpty()) {
-        const QDomElement lastplayed = episodeDetails.elementsByTagName("lastplayed").at(0).toElement();
-        if (!lastplayed.isNull() && !lastplayed.text().isEmpty()) {
-            const QDateTime dateTime = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd HH:mm:ss");
-            if (dateTime.isValid()) {
-                m_episode.setLastPlayed(dateTime);
+    m_hasRatingsV17 = true;
+
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    m_episode.ratings().clear();
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        Rating rating;
+        const QXmlStreamAttributes attributes = reader.attributes();
+        rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : "default";
+        bool ok = false;
+        const int max = attributes.value("max").toString().toInt(&ok);
+        if (ok && max > 0) {
+            rating.maxRating = max;
+        }
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+            } else if (reader.name() == QLatin1String("votes")) {
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
             } else {
-                const QDateTime date = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd");
-                if (date.isValid()) {
-                    m_episode.setLastPlayed(date);
-                }
+                reader.skipCurrentElement();
             }
         }
-    }
-    if (!episodeDetails.elementsByTagName("studio").isEmpty()) {
-        m_episode.setNetwork(episodeDetails.elementsByTagName("studio").at(0).toElement().text());
-    }
 
-    // tags are officially not yet supported, even by Kodi 19 but scraper providers start
-    // to support them
-    for (int i = 0, n = episodeDetails.elementsByTagName("tag").size(); i < n; i++) {
-        m_episode.addTag(episodeDetails.elementsByTagName("tag").at(i).toElement().text());
+        m_episode.ratings().setOrAddRating(rating);
+        m_episode.setChanged(true);
     }
+}
 
-    if (!episodeDetails.elementsByTagName("thumb").isEmpty()) {
-        m_episode.setThumbnail(QUrl(episodeDetails.elementsByTagName("thumb").at(0).toElement().text()));
-    }
-    for (int i = 0, n = episodeDetails.elementsByTagName("credits").size(); i < n; i++) {
-        m_episode.addWriter(episodeDetails.elementsByTagName("credits").at(i).toElement().text());
+void EpisodeXmlReader::episodeRatingV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_ratingV16.isEmpty()) {
+        m_ratingV16 = value;
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("director").size(); i < n; i++) {
-        m_episode.addDirector(episodeDetails.elementsByTagName("director").at(i).toElement().text());
+}
+
+void EpisodeXmlReader::episodeVotesV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_votesV16.isEmpty()) {
+        m_votesV16 = value;
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = episodeDetails.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+}
+
+void EpisodeXmlReader::episodeFileInfo(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("streamdetails") && m_episode.streamDetails() != nullptr) {
+            StreamDetailsXmlReader(*m_episode.streamDetails()).parse(reader);
+            m_episode.setStreamDetailsLoaded(true);
+        } else {
+            reader.skipCurrentElement();
         }
-        m_episode.addActor(a);
     }
 }
 
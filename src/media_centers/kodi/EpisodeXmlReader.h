@@ -1,23 +1,86 @@
 #pragma once
 
-#include <QDomElement>
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class TvShowEpisode;
 
 namespace mediaelch {
 namespace kodi {
 
+/// \brief Reads Kodi episode NFO files in a single pass without building a DOM.
 class EpisodeXmlReader
 {
 public:
     explicit EpisodeXmlReader(TvShowEpisode& episode);
-    void parseNfoDom(QDomElement episodeDetails);
+    /// \brief Parses the <episodedetails> element at the reader's current position, including stream details.
+    void parseEpisodeDetails(QXmlStreamReader& reader);
+    /// \brief Parses the index-th <episodedetails> element of a document created by makeValidEpisodeXml().
+    /// \return False if there is no such element.
+    bool parse(const QString& episodesXml, int index);
 
     static QString makeValidEpisodeXml(const QString& nfoContent);
+    /// \brief Returns the index of the <episodedetails> element for the given episode or -1 if there is none.
+    /// \details NFO files of multi-episode files contain multiple <episodedetails> elements.  If there is only
+    ///          one, it is used regardless of its season and episode number.
+    static int findEpisodeDetails(const QString& episodesXml, SeasonNumber season, EpisodeNumber episode);
+
+private:
+    using TagParser = void (EpisodeXmlReader::*)(QXmlStreamReader&);
+    struct TagParserEntry
+    {
+        QLatin1String tag;
+        TagParser parser;
+    };
+    static TagParser tagParser(const QXmlStreamReader& reader);
+    /// \brief Stores all values whose tags depend on each other, e.g. <uniqueid> overrides <id>.
+    void storeCollectedValues();
+
+    void episodeTitle(QXmlStreamReader& reader);
+    void episodeShowTitle(QXmlStreamReader& reader);
+    void episodeSeason(QXmlStreamReader& reader);
+    void episodeEpisode(QXmlStreamReader& reader);
+    void episodeDisplaySeason(QXmlStreamReader& reader);
+    void episodeDisplayEpisode(QXmlStreamReader& reader);
+    void episodeTop250(QXmlStreamReader& reader);
+    void episodePlot(QXmlStreamReader& reader);
+    void episodeCertification(QXmlStreamReader& reader);
+    void episodeFirstAired(QXmlStreamReader& reader);
+    void episodePlayCount(QXmlStreamReader& reader);
+    void episodeBookmark(QXmlStreamReader& reader);
+    void episodeLastPlayed(QXmlStreamReader& reader);
+    void episodeNetwork(QXmlStreamReader& reader);
+    void episodeTag(QXmlStreamReader& reader);
+    void episodeThumbnail(QXmlStreamReader& reader);
+    void episodeCredits(QXmlStreamReader& reader);
+    void episodeDirector(QXmlStreamReader& reader);
+    void episodeActor(QXmlStreamReader& reader);
+    void episodeTvDbIdV17(QXmlStreamReader& reader);
+    void episodeTvDbIdV16(QXmlStreamReader& reader);
+    void episodeImdbIdV16(QXmlStreamReader& reader);
+    void episodeUniqueId(QXmlStreamReader& reader);
+    void episodeRatingsV17(QXmlStreamReader& reader);
+    void episodeRatingV16(QXmlStreamReader& reader);
+    void episodeVotesV16(QXmlStreamReader& reader);
+    void episodeFileInfo(QXmlStreamReader& reader);
 
 private:
     TvShowEpisode& m_episode;
+
+    // Values that are stored after the whole <episodedetails> element was read.
+    QString m_tvdbIdV17;
+    QString m_tvdbIdV16;
+    QString m_imdbIdV16;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    bool m_hasRatingsV17 = false;
+    bool m_hasThumbnail = false;
+    QString m_ratingV16;
+    QString m_votesV16;
 };
 
 } // namespace kodi
@@ -1,15 +1,14 @@
 #include "media_centers/kodi/MovieXmlReader.h"
 
 #include "log/Log.h"
-#include "media_centers/kodi/KodiXmlWriter.h"
+#include "media_centers/kodi/StreamDetailsXmlReader.h"
 #include "movies/Movie.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
 #include <QStringList>
 #include <QTextDocument>
 #include <QUrl>
+#include <array>
 
 namespace mediaelch {
 namespace kodi {
@@ -25,129 +24,116 @@ MovieXmlReader::MovieXmlReader(Movie& movie) : m_movie{movie}
 {
 }
 
-void MovieXmlReader::parseNfoDom(QDomDocument domDoc)
+void MovieXmlReader::parse(QXmlStreamReader& reader)
 {
-    if (domDoc.elementsByTagName("movie").isEmpty()) {
+    if (!reader.readNextStartElement()) {
+        return;
+    }
+    if (reader.name() != QLatin1String("movie")) {
         qCWarning(generic) << "[MovieXmlReader] No <movie> tag in the document";
         return;
     }
-    QDomElement movieElement = domDoc.elementsByTagName("movie").at(0).toElement();
-    QMap<QString, void (MovieXmlReader::*)(const QDomElement&)> tagParsers;
+    parseMovie(reader);
+}
+
+MovieXmlReader::TagParser MovieXmlReader::tagParser(const QXmlStreamReader& reader)
+{
+    // Built once and shared by all readers. Ordered by how common the tags are.
     // clang-format off
-    tagParsers.insert("title",         &MovieXmlReader::simpleString<&Movie::setName>);
-    tagParsers.insert("originaltitle", &MovieXmlReader::simpleString<&Movie::setOriginalName>);
-    tagParsers.insert("sorttitle",     &MovieXmlReader::simpleString<&Movie::setSortTitle>);
-    tagParsers.insert("plot",          &MovieXmlReader::simpleString<&Movie::setOverview>);
-    tagParsers.insert("outline",       &MovieXmlReader::simpleString<&Movie::setOutline>);
-    tagParsers.insert("tagline",       &MovieXmlReader::simpleString<&Movie::setTagline>);
-    tagParsers.insert("set",           &MovieXmlReader::movieSet);
-    tagParsers.insert("actor",         &MovieXmlReader::movieActor);
-    tagParsers.insert("thumb",         &MovieXmlReader::movieThumbnail);
-    tagParsers.insert("fanart",        &MovieXmlReader::movieFanart);
-    tagParsers.insert("playcount",     &MovieXmlReader::simpleInt<&Movie::setPlayCount>);
-    tagParsers.insert("top250",        &MovieXmlReader::simpleInt<&Movie::setTop250>);
-    tagParsers.insert("tag",           &MovieXmlReader::simpleString<&Movie::addTag>);
-    tagParsers.insert("studio",        &MovieXmlReader::stringList<&Movie::addStudio, '/'>);
-    tagParsers.insert("genre",         &MovieXmlReader::stringList<&Movie::addGenre, '/'>);
-    tagParsers.insert("country",       &MovieXmlReader::stringList<&Movie::addCountry, '/'>);
-    tagParsers.insert("ratings",       &MovieXmlReader::movieRatingV17);
-    tagParsers.insert("rating",        &MovieXmlReader::movieRatingV16);
-    tagParsers.insert("userrating",    &MovieXmlReader::simpleDouble<&Movie::setUserRating>);
-    tagParsers.insert("votes",         &MovieXmlReader::movieVoteCountV16);
-    tagParsers.insert("dateadded",     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>);
-    tagParsers.insert("resume",        &MovieXmlReader::movieResumeTime);
+    static const std::array<TagParserEntry, 34> tagParsers{{
+        {QLatin1String("thumb"),         &MovieXmlReader::movieThumbnail},
+        {QLatin1String("actor"),         &MovieXmlReader::movieActor},
+        {QLatin1String("fanart"),        &MovieXmlReader::movieFanart},
+        {QLatin1String("genre"),         &MovieXmlReader::stringList<&Movie::addGenre, '/'>},
+        {QLatin1String("studio"),        &MovieXmlReader::stringList<&Movie::addStudio, '/'>},
+        {QLatin1String("country"),       &MovieXmlReader::stringList<&Movie::addCountry, '/'>},
+        {QLatin1String("tag"),           &MovieXmlReader::simpleString<&Movie::addTag>},
+        {QLatin1String("credits"),       &MovieXmlReader::movieCredits},
+        {QLatin1String("director"),      &MovieXmlReader::movieDirector},
+        {QLatin1String("uniqueid"),      &MovieXmlReader::movieUniqueId},
+        {QLatin1String("title"),         &MovieXmlReader::simpleString<&Movie::setName>},
+        {QLatin1String("originaltitle"), &MovieXmlReader::simpleString<&Movie::setOriginalName>},
+        {QLatin1String("sorttitle"),     &MovieXmlReader::simpleString<&Movie::setSortTitle>},
+        {QLatin1String("plot"),          &MovieXmlReader::simpleString<&Movie::setOverview>},
+        {QLatin1String("outline"),       &MovieXmlReader::simpleString<&Movie::setOutline>},
+        {QLatin1String("tagline"),       &MovieXmlReader::simpleString<&Movie::setTagline>},
+        {QLatin1String("set"),           &MovieXmlReader::movieSet},
+        {QLatin1String("playcount"),     &MovieXmlReader::simpleInt<&Movie::setPlayCount>},
+        {QLatin1String("top250"),        &MovieXmlReader::simpleInt<&Movie::setTop250>},
+        {QLatin1String("ratings"),       &MovieXmlReader::movieRatingV17},
+        {QLatin1String("rating"),        &MovieXmlReader::movieRatingV16},
+        {QLatin1String("userrating"),    &MovieXmlReader::simpleDouble<&Movie::setUserRating>},
+        {QLatin1String("votes"),         &MovieXmlReader::movieVoteCountV16},
+        {QLatin1String("dateadded"),     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>},
+        {QLatin1String("resume"),        &MovieXmlReader::movieResumeTime},
+        {QLatin1String("runtime"),       &MovieXmlReader::movieRuntime},
+        {QLatin1String("mpaa"),          &MovieXmlReader::movieCertification},
+        {QLatin1String("lastplayed"),    &MovieXmlReader::movieLastPlayed},
+        {QLatin1String("trailer"),       &MovieXmlReader::movieTrailer},
+        {QLatin1String("year"),          &MovieXmlReader::movieYear},
+        {QLatin1String("premiered"),     &MovieXmlReader::moviePremiered},
+        {QLatin1String("id"),            &MovieXmlReader::movieImdbIdV16},
+        {QLatin1String("tmdbid"),        &MovieXmlReader::movieTmdbIdV16},
+        {QLatin1String("fileinfo"),      &MovieXmlReader::movieFileInfo},
+    }};
     // clang-format on
 
-    QDomNodeList nodes = movieElement.childNodes();
-    for (int i = 0; i < nodes.size(); ++i) {
-        if (nodes.at(i).isElement()) {
-            QDomElement element = nodes.at(i).toElement();
-            if (tagParsers.contains(element.tagName())) {
-                // call the stored method pointer
-                (this->*tagParsers[element.tagName()])(element);
-            }
+    const auto name = reader.name();
+    for (const TagParserEntry& entry : tagParsers) {
+        if (name == entry.tag) {
+            return entry.parser;
         }
     }
+    return nullptr;
+}
 
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_movie.setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
-    }
-    // will overwrite the release date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
-        if (released.isValid()) {
-            m_movie.setReleased(released);
+void MovieXmlReader::parseMovie(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        const TagParser parser = tagParser(reader);
+        if (parser != nullptr) {
+            (this->*parser)(reader);
+        } else {
+            reader.skipCurrentElement();
         }
     }
+    storeCollectedValues();
+}
 
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_movie.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
-    }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_movie.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+void MovieXmlReader::storeCollectedValues()
+{
+    if (!m_year.isEmpty()) {
+        m_movie.setReleased(QDate::fromString(m_year, "yyyy"));
     }
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        QDateTime lastPlayed = QDateTime::fromString(
-            domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss");
-        if (!lastPlayed.isValid()) {
-            lastPlayed =
-                QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd");
+    // will overwrite the release date set by <year>
+    if (!m_premiered.isEmpty()) {
+        QDate released = QDate::fromString(m_premiered.trimmed(), "yyyy-MM-dd");
+        if (released.isValid()) {
+            m_movie.setReleased(released);
         }
-        m_movie.setLastPlayed(lastPlayed);
     }
 
-    // v16 imdbid
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_movie.setImdbId(ImdbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    // v16 ids; overwritten by >v17 ids
+    if (!m_imdbIdV16.isNull()) {
+        m_movie.setImdbId(ImdbId(m_imdbIdV16));
     }
-    // v16 tmdbid
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty()) {
-        m_movie.setTmdbId(TmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text()));
+    if (!m_tmdbIdV16.isNull()) {
+        m_movie.setTmdbId(TmdbId(m_tmdbIdV16));
     }
-    // >v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-        if (type == "imdb") {
-            m_movie.setImdbId(ImdbId(value));
-        } else if (type == "tmdb") {
-            m_movie.setTmdbId(TmdbId(value));
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        if (uniqueId.first == "imdb") {
+            m_movie.setImdbId(ImdbId(uniqueId.second));
+        } else if (uniqueId.first == "tmdb") {
+            m_movie.setTmdbId(TmdbId(uniqueId.second));
         }
     }
 
-    if (!domDoc.elementsByTagName("trailer").isEmpty()) {
-        m_movie.setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
-    }
-
-    QStringList writers;
-    for (int i = 0, n = domDoc.elementsByTagName("credits").size(); i < n; i++) {
-        const auto credits =
-            domDoc.elementsByTagName("credits").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& writer : credits) {
-            writers.append(writer.trimmed());
-        }
-    }
-    m_movie.setWriter(writers.join(", "));
-
-    QStringList directors;
-    for (int i = 0, n = domDoc.elementsByTagName("director").size(); i < n; i++) {
-        const auto directorsFound =
-            domDoc.elementsByTagName("director").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& director : directorsFound) {
-            directors.append(director.trimmed());
-        }
-    }
-    m_movie.setDirector(directors.join(", "));
+    m_movie.setWriter(m_writers.join(", "));
+    m_movie.setDirector(m_directors.join(", "));
 }
 
-void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
+void MovieXmlReader::movieSet(QXmlStreamReader& reader)
 {
-    const QDomNodeList setNameElements = movieSetElement.elementsByTagName("name");
-    const QDomNodeList setOverviewElements = movieSetElement.elementsByTagName("overview");
-
     // We need to support both the old and new XML syntax.
     //
     // New Kodi v17 XML Syntax:
@@ -160,60 +146,84 @@ void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
     //   <set>Movie Set Name</set>
     //
     MovieSet set;
-    if (!setNameElements.isEmpty()) {
-        set.name = setNameElements.at(0).toElement().text();
-    } else {
-        set.name = movieSetElement.text();
+    QString text;
+    bool hasNameElement = false;
+
+    while (!reader.atEnd()) {
+        const QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::EndElement) {
+            break;
+        }
+        if (token == QXmlStreamReader::Characters) {
+            text += reader.text();
+
+        } else if (token == QXmlStreamReader::StartElement) {
+            if (reader.name() == QLatin1String("name")) {
+                set.name = reader.readElementText();
+                hasNameElement = true;
+
+            } else if (reader.name() == QLatin1String("overview")) {
+                set.overview = htmlUnescape(reader.readElementText());
+
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
     }
-    if (!setOverviewElements.isEmpty()) {
-        set.overview = htmlUnescape(setOverviewElements.at(0).toElement().text());
+
+    if (!hasNameElement) {
+        set.name = text;
     }
     m_movie.setSet(set);
 }
 
-void MovieXmlReader::movieActor(const QDomElement& actorElement)
+void MovieXmlReader::movieActor(QXmlStreamReader& reader)
 {
     Actor a;
     a.imageHasChanged = false;
-    if (!actorElement.elementsByTagName("name").isEmpty()) {
-        a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("role").isEmpty()) {
-        a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-        a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("name")) {
+            a.name = reader.readElementText();
+        } else if (reader.name() == QLatin1String("role")) {
+            a.role = reader.readElementText();
+        } else if (reader.name() == QLatin1String("thumb")) {
+            a.thumb = reader.readElementText();
+        } else {
+            reader.skipCurrentElement();
+        }
     }
     m_movie.addActor(a);
 }
 
-void MovieXmlReader::movieThumbnail(const QDomElement& thumbElement)
+void MovieXmlReader::movieThumbnail(QXmlStreamReader& reader)
 {
-    QString aspect = thumbElement.attribute("aspect").trimmed();
+    QString aspect = reader.attributes().value("aspect").toString().trimmed();
     // if (aspect == "set.poster") {
     //     // TODO: special handling of set-posters, etc.
     // }
 
     Poster p;
-    p.originalUrl = QUrl(thumbElement.text());
-    p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+    p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
     p.aspect = aspect;
+    p.originalUrl = QUrl(reader.readElementText());
     m_movie.images().addPoster(p);
 }
 
-void MovieXmlReader::movieFanart(const QDomElement& fanartElement)
+void MovieXmlReader::movieFanart(QXmlStreamReader& reader)
 {
-    QDomNodeList thumbs = fanartElement.elementsByTagName("thumb");
-    for (int i = 0; i < thumbs.size(); ++i) {
-        QDomElement thumbElement = thumbs.at(i).toElement();
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("thumb")) {
+            reader.skipCurrentElement();
+            continue;
+        }
         Poster p;
-        p.originalUrl = QUrl(thumbElement.text());
-        p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+        p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
+        p.originalUrl = QUrl(reader.readElementText());
         m_movie.images().addBackdrop(p);
     }
 }
 
-void MovieXmlReader::movieRatingV17(const QDomElement& element)
+void MovieXmlReader::movieRatingV17(QXmlStreamReader& reader)
 {
     // <ratings>
     //   <rating name="default" default="true">
@@ -221,35 +231,48 @@ void MovieXmlReader::movieRatingV17(const QDomElement& element)
     //     <votes>10</votes>
     //   </rating>
     // </ratings>
-    auto ratings = element.elementsByTagName("rating");
+    bool ratingsCleared = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
+        }
 
-    // clear all ratings in case that there are <rating> tags to avoid
-    // duplicated and/or old ratings
-    if (ratings.length() > 0) {
-        m_movie.ratings().clear();
-    }
+        // clear all ratings in case that there are <rating> tags to avoid
+        // duplicated and/or old ratings
+        if (!ratingsCleared) {
+            m_movie.ratings().clear();
+            ratingsCleared = true;
+        }
 
-    for (int i = 0; i < ratings.length(); ++i) {
         Rating rating;
-        auto ratingElement = ratings.at(i).toElement();
-        rating.source = ratingElement.attribute("name", "default");
+        const QXmlStreamAttributes attributes = reader.attributes();
+        rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : "default";
         bool ok = false;
-        int max = ratingElement.attribute("max", "0").toInt(&ok);
+        const int max = attributes.value("max").toString().toInt(&ok);
         if (ok && max > 0) {
             rating.maxRating = max;
         }
-        rating.rating = ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-        rating.voteCount =
-            ratingElement.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt();
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+            } else if (reader.name() == QLatin1String("votes")) {
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+
         m_movie.ratings().setOrAddRating(rating);
         m_movie.setChanged(true);
     }
 }
 
-void MovieXmlReader::movieRatingV16(const QDomElement& element)
+void MovieXmlReader::movieRatingV16(QXmlStreamReader& reader)
 {
     // <rating>10.0</rating>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -259,10 +282,10 @@ void MovieXmlReader::movieRatingV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
+void MovieXmlReader::movieVoteCountV16(QXmlStreamReader& reader)
 {
     // <votes>100</votes>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -272,31 +295,123 @@ void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieResumeTime(const QDomElement& element)
+void MovieXmlReader::movieResumeTime(QXmlStreamReader& reader)
 {
-    auto positions = element.elementsByTagName("position");
-    auto totals = element.elementsByTagName("total");
-
     mediaelch::ResumeTime time;
 
-    if (!positions.isEmpty()) {
-        bool ok = false;
-        const double position = positions.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.position = position;
-        }
-    }
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("position")) {
+            bool ok = false;
+            const double position = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.position = position;
+            }
 
-    if (!totals.isEmpty()) {
-        bool ok = false;
-        const double total = totals.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.total = total;
+        } else if (reader.name() == QLatin1String("total")) {
+            bool ok = false;
+            const double total = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.total = total;
+            }
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
     m_movie.setResumeTime(time);
 }
 
+void MovieXmlReader::movieRuntime(QXmlStreamReader& reader)
+{
+    m_movie.setRuntime(std::chrono::minutes(reader.readElementText().toInt()));
+}
+
+void MovieXmlReader::movieCertification(QXmlStreamReader& reader)
+{
+    m_movie.setCertification(Certification(reader.readElementText()));
+}
+
+void MovieXmlReader::movieLastPlayed(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    QDateTime lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
+    if (!lastPlayed.isValid()) {
+        lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd");
+    }
+    m_movie.setLastPlayed(lastPlayed);
+}
+
+void MovieXmlReader::movieTrailer(QXmlStreamReader& reader)
+{
+    m_movie.setTrailer(QUrl(reader.readElementText()));
+}
+
+void MovieXmlReader::movieYear(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_year.isEmpty()) {
+        m_year = value;
+    }
+}
+
+void MovieXmlReader::moviePremiered(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_premiered.isEmpty()) {
+        m_premiered = value;
+    }
+}
+
+void MovieXmlReader::movieImdbIdV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_imdbIdV16.isNull()) {
+        m_imdbIdV16 = value;
+    }
+}
+
+void MovieXmlReader::movieTmdbIdV16(QXmlStreamReader& reader)
+{
+    const QString value = reader.readElementText();
+    if (m_tmdbIdV16.isNull()) {
+        m_tmdbIdV16 = value;
+    }
+}
+
+void MovieXmlReader::movieUniqueId(QXmlStreamReader& reader)
+{
+    const QString type = reader.attributes().value("type").toString();
+    m_uniqueIds.append({type, reader.readElementText().trimmed()});
+}
+
+void MovieXmlReader::movieCredits(QXmlStreamReader& reader)
+{
+    const QStringList credits = reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& writer : credits) {
+        m_writers.append(writer.trimmed());
+    }
+}
+
+void MovieXmlReader::movieDirector(QXmlStreamReader& reader)
+{
+    const QStringList directors = reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& director : directors) {
+        m_directors.append(director.trimmed());
+    }
+}
+
+void MovieXmlReader::movieFileInfo(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("streamdetails") && m_movie.streamDetails() != nullptr) {
+            StreamDetailsXmlReader(*m_movie.streamDetails()).parse(reader);
+            m_movie.setStreamDetailsLoaded(true);
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
 } // namespace kodi
 } // namespace mediaelch
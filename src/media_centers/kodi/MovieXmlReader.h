@@ -3,71 +3,109 @@
 #include "globals/Globals.h"
 
 #include <QDate>
-#include <QDomDocument>
+#include <QPair>
 #include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class Movie;
 
 namespace mediaelch {
 namespace kodi {
 
+/// \brief Reads Kodi movie NFO files in a single pass without building a DOM.
 class MovieXmlReader
 {
 public:
     explicit MovieXmlReader(Movie& movie);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Parses the <movie> root element, including stream details.
+    /// \details Parse errors can be checked using reader.hasError().
+    void parse(QXmlStreamReader& reader);
 
 private:
+    using TagParser = void (MovieXmlReader::*)(QXmlStreamReader&);
+    struct TagParserEntry
+    {
+        QLatin1String tag;
+        TagParser parser;
+    };
+    static TagParser tagParser(const QXmlStreamReader& reader);
+    void parseMovie(QXmlStreamReader& reader);
+    /// \brief Stores all values whose tags depend on each other, e.g. <premiered> overrides <year>.
+    void storeCollectedValues();
+
     template<class T>
     using MovieStoreMethod = void (Movie::*)(T);
 
     template<MovieStoreMethod<QString> method>
-    void simpleString(const QDomElement& element)
+    void simpleString(QXmlStreamReader& reader)
     {
-        const QString value = element.text();
+        const QString value = reader.readElementText();
         (m_movie.*method)(value);
     }
 
     template<MovieStoreMethod<QString> method, const char splitChar>
-    void stringList(const QDomElement& element)
+    void stringList(QXmlStreamReader& reader)
     {
-        QStringList values = element.text().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
+        QStringList values = reader.readElementText().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
         for (const QString& value : asConst(values)) {
             (m_movie.*method)(value.trimmed());
         }
     }
 
     template<MovieStoreMethod<int> method>
-    void simpleInt(const QDomElement& element)
+    void simpleInt(QXmlStreamReader& reader)
     {
-        (m_movie.*method)(element.text().toInt());
+        (m_movie.*method)(reader.readElementText().toInt());
     }
 
     template<MovieStoreMethod<double> method>
-    void simpleDouble(const QDomElement& element)
+    void simpleDouble(QXmlStreamReader& reader)
     {
-        (m_movie.*method)(element.text().toDouble());
+        (m_movie.*method)(reader.readElementText().toDouble());
     }
 
     template<MovieStoreMethod<QDateTime> method>
-    void simpleDateTime(const QDomElement& element)
+    void simpleDateTime(QXmlStreamReader& reader)
     {
-        const QDateTime value = QDateTime::fromString(element.text(), "yyyy-MM-dd HH:mm:ss");
+        const QDateTime value = QDateTime::fromString(reader.readElementText(), "yyyy-MM-dd HH:mm:ss");
         if (value.isValid()) {
             (m_movie.*method)(value);
         }
     }
 
-    void movieSet(const QDomElement& element);
-    void movieActor(const QDomElement& element);
-    void movieThumbnail(const QDomElement& element);
-    void movieFanart(const QDomElement& element);
-    void movieRatingV17(const QDomElement& element);
-    void movieRatingV16(const QDomElement& element);
-    void movieVoteCountV16(const QDomElement& element);
-    void movieResumeTime(const QDomElement& element);
+    void movieSet(QXmlStreamReader& reader);
+    void movieActor(QXmlStreamReader& reader);
+    void movieThumbnail(QXmlStreamReader& reader);
+    void movieFanart(QXmlStreamReader& reader);
+    void movieRatingV17(QXmlStreamReader& reader);
+    void movieRatingV16(QXmlStreamReader& reader);
+    void movieVoteCountV16(QXmlStreamReader& reader);
+    void movieResumeTime(QXmlStreamReader& reader);
+    void movieRuntime(QXmlStreamReader& reader);
+    void movieCertification(QXmlStreamReader& reader);
+    void movieLastPlayed(QXmlStreamReader& reader);
+    void movieTrailer(QXmlStreamReader& reader);
+    void movieYear(QXmlStreamReader& reader);
+    void moviePremiered(QXmlStreamReader& reader);
+    void movieImdbIdV16(QXmlStreamReader& reader);
+    void movieTmdbIdV16(QXmlStreamReader& reader);
+    void movieUniqueId(QXmlStreamReader& reader);
+    void movieCredits(QXmlStreamReader& reader);
+    void movieDirector(QXmlStreamReader& reader);
+    void movieFileInfo(QXmlStreamReader& reader);
 
     Movie& m_movie;
+
+    // Values that are stored after the whole document was read.
+    QString m_year;
+    QString m_premiered;
+    QString m_imdbIdV16;
+    QString m_tmdbIdV16;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    QStringList m_writers;
+    QStringList m_directors;
 };
 
 } // namespace kodi
@@ -0,0 +1,113 @@
+#include "media_centers/kodi/StreamDetailsXmlReader.h"
+
+#include "data/StreamDetails.h"
+
+#include <algorithm>
+#include <array>
+
+namespace mediaelch {
+namespace kodi {
+
+StreamDetailsXmlReader::StreamDetailsXmlReader(StreamDetails& streamDetails) : m_streamDetails{streamDetails}
+{
+}
+
+void StreamDetailsXmlReader::parse(QXmlStreamReader& reader)
+{
+    int audioStreamNumber = 0;
+    int subtitleStreamNumber = 0;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("video")) {
+            parseVideoStreamDetails(reader);
+
+        } else if (reader.name() == QLatin1String("audio")) {
+            parseAudioStreamDetails(reader, audioStreamNumber);
+            ++audioStreamNumber;
+
+        } else if (reader.name() == QLatin1String("subtitle")) {
+            if (parseSubtitleStreamDetails(reader, subtitleStreamNumber)) {
+                ++subtitleStreamNumber;
+            }
+
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void StreamDetailsXmlReader::parseVideoStreamDetails(QXmlStreamReader& reader)
+{
+    static const std::array<StreamDetails::VideoDetails, 7> details{StreamDetails::VideoDetails::Codec,
+        StreamDetails::VideoDetails::Aspect,
+        StreamDetails::VideoDetails::Width,
+        StreamDetails::VideoDetails::Height,
+        StreamDetails::VideoDetails::DurationInSeconds,
+        StreamDetails::VideoDetails::ScanType,
+        StreamDetails::VideoDetails::StereoMode};
+
+    while (reader.readNextStartElement()) {
+        const auto detail = std::find_if(details.cbegin(), details.cend(), [&reader](StreamDetails::VideoDetails d) {
+            return reader.name() == StreamDetails::detailToString(d);
+        });
+        if (detail == details.cend()) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        const QString value = reader.readElementText();
+        if (!value.isEmpty()) {
+            m_streamDetails.setVideoDetail(*detail, value);
+        }
+    }
+}
+
+void StreamDetailsXmlReader::parseAudioStreamDetails(QXmlStreamReader& reader, int streamNumber)
+{
+    static const std::array<StreamDetails::AudioDetails, 3> details{StreamDetails::AudioDetails::Codec,
+        StreamDetails::AudioDetails::Language,
+        StreamDetails::AudioDetails::Channels};
+
+    while (reader.readNextStartElement()) {
+        const auto detail = std::find_if(details.cbegin(), details.cend(), [&reader](StreamDetails::AudioDetails d) {
+            return reader.name() == StreamDetails::detailToString(d);
+        });
+        if (detail == details.cend()) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        const QString value = reader.readElementText();
+        if (!value.isEmpty()) {
+            m_streamDetails.setAudioDetail(streamNumber, *detail, value);
+        }
+    }
+}
+
+bool StreamDetailsXmlReader::parseSubtitleStreamDetails(QXmlStreamReader& reader, int streamNumber)
+{
+    QString language;
+    bool isExternalFile = false;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == StreamDetails::detailToString(StreamDetails::SubtitleDetails::Language)) {
+            language = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("file")) {
+            isExternalFile = true;
+            reader.skipCurrentElement();
+
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if (isExternalFile) {
+        return false;
+    }
+    if (!language.isEmpty()) {
+        m_streamDetails.setSubtitleDetail(streamNumber, StreamDetails::SubtitleDetails::Language, language);
+    }
+    return true;
+}
+
+} // namespace kodi
+} // namespace mediaelch
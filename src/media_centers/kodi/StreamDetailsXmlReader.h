@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QXmlStreamReader>
+
+class StreamDetails;
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Reads the <streamdetails> element of Kodi NFO files.
+/// \details Shared by all NFO readers that are based on QXmlStreamReader.
+///          Subtitles with a <file> element are external subtitles that are
+///          handled by the media item itself and are skipped.
+class StreamDetailsXmlReader
+{
+public:
+    explicit StreamDetailsXmlReader(StreamDetails& streamDetails);
+    /// \brief Parses the <streamdetails> element at the reader's current position.
+    void parse(QXmlStreamReader& reader);
+
+private:
+    void parseVideoStreamDetails(QXmlStreamReader& reader);
+    void parseAudioStreamDetails(QXmlStreamReader& reader, int streamNumber);
+    /// \return False if the subtitle is an external file.
+    bool parseSubtitleStreamDetails(QXmlStreamReader& reader, int streamNumber);
+
+private:
+    StreamDetails& m_streamDetails;
+};
+
+} // namespace kodi
+} // namespace mediaelch
@@ -163,12 +163,24 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelc
 
 bool MovieController::loadStreamDetailsFromFile()
 {
-    using namespace std::chrono;
-    using namespace std::chrono_literals;
     bool success = m_movie->streamDetails()->loadStreamDetails();
     if (!success) {
         return false;
     }
+    onStreamDetailsLoaded();
+    return true;
+}
+
+void MovieController::setStreamDetails(const StreamDetails::Values& details)
+{
+    m_movie->streamDetails()->setValues(details);
+    onStreamDetailsLoaded();
+}
+
+void MovieController::onStreamDetailsLoaded()
+{
+    using namespace std::chrono;
+    using namespace std::chrono_literals;
     seconds runtime =
         seconds(m_movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     if (runtime > 0s) {
@@ -176,7 +188,6 @@ bool MovieController::loadStreamDetailsFromFile()
     }
     m_movie->setStreamDetailsLoaded(true);
     m_movie->setChanged(true);
-    return true;
 }
 
 QSet<MovieScraperInfo> MovieController::infosToLoad()
@@ -184,6 +195,11 @@ QSet<MovieScraperInfo> MovieController::infosToLoad()
     return m_infosToLoad;
 }
 
+void MovieController::setScrapeDownloadPriority(DownloadPriority priority)
+{
+    m_scrapeDownloadPriority = priority;
+}
+
 void MovieController::setInfosToLoad(QSet<MovieScraperInfo> infos)
 {
     m_infosToLoad = std::move(infos);
@@ -315,6 +331,7 @@ void MovieController::onFanartLoadDone(Movie* movie, QMap<ImageType, QVector<Pos
                 continue;
             }
             DownloadManagerElement d;
+            d.priority = m_scrapeDownloadPriority;
             d.imageType = ImageType::Actor;
             d.url = QUrl(actor->thumb);
             d.actor = actor;
@@ -331,6 +348,7 @@ void MovieController::onFanartLoadDone(Movie* movie, QMap<ImageType, QVector<Pos
             continue;
         }
         DownloadManagerElement d;
+        d.priority = m_scrapeDownloadPriority;
         d.imageType = it.key();
         d.url = it.value().at(0).originalUrl;
         d.movie = m_movie;
@@ -395,6 +413,7 @@ void MovieController::onDownloadFinished(DownloadManagerElement elem)
 void MovieController::loadImage(ImageType type, QUrl url)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.movie = m_movie;
     d.imageType = type;
     d.url = std::move(url);
@@ -406,6 +425,7 @@ void MovieController::loadImages(ImageType type, QVector<QUrl> urls)
 {
     for (const auto& url : urls) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.movie = m_movie;
         d.imageType = type;
         d.url = url;
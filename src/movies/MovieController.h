@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/StreamDetails.h"
 #include "globals/DownloadManagerElement.h"
 #include "globals/Poster.h"
 #include "globals/ScraperInfos.h"
@@ -46,12 +47,16 @@ public:
         QSet<MovieScraperInfo> infos);
 
     ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    /// \brief Sets stream details that were loaded in the background, see mediaelch::StreamDetailsLoader.
+    void setStreamDetails(const StreamDetails::Values& details);
 
     /// \brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
     void scraperLoadDone(mediaelch::scraper::MovieScraper* scraper, mediaelch::ScraperError error);
 
     QSet<MovieScraperInfo> infosToLoad();
+    /// \brief Priority of image downloads after scraping, e.g. lower for multi-scrape batches.
+    void setScrapeDownloadPriority(DownloadPriority priority);
 
     /// \brief Holds wether movie infos were loaded from a MediaCenterInterface or ScraperInterface
     /// \return Infos were loaded
@@ -88,11 +93,15 @@ private slots:
     void onDownloadFinished(DownloadManagerElement elem);
 
 private:
+    /// \brief Updates the runtime and marks the movie as changed.
+    void onStreamDetailsLoaded();
+
     Movie* m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
     QSet<MovieScraperInfo> m_infosToLoad;
     DownloadManager* m_downloadManager;
+    DownloadPriority m_scrapeDownloadPriority = DownloadPriority::Normal;
     bool m_downloadsInProgress = false;
     int m_downloadsSize = 0;
     int m_downloadsLeft = 0;
@@ -0,0 +1,292 @@
+#include "movies/MovieDuplicateFinder.h"
+
+#include "globals/Meta.h"
+#include "movies/Movie.h"
+
+#include <QHash>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// \brief Minimum trigram similarity (Dice coefficient) of two normalized titles.
+constexpr double similarTitleThreshold = 0.9;
+
+/// \brief Progress is only reported every n steps.
+constexpr int progressInterval = 256;
+
+/// \brief Candidate indices by key, e.g. by IMDb id.
+using Buckets = QHash<QString, QVector<int>>;
+
+void addToBucket(Buckets& buckets, const QString& key, int index)
+{
+    if (!key.isEmpty()) {
+        buckets[key].append(index);
+    }
+}
+
+void appendBucket(const Buckets& buckets, const QString& key, QVector<int>& matches)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+    const auto it = buckets.constFind(key);
+    if (it != buckets.constEnd() && it->size() > 1) {
+        matches << *it;
+    }
+}
+
+/// \brief Returns the sorted ids of all trigrams of the title. Unknown trigrams get a new id.
+QVector<int> trigramIds(const QString& title, QHash<quint64, int>& ids)
+{
+    // Padding ensures that the first and last characters count as much as the others.
+    const QString padded = QStringLiteral("  ") + title + QChar(' ');
+    QVector<int> result;
+    result.reserve(padded.size() - 2);
+    for (elch_size_t i = 0; i + 2 < padded.size(); ++i) {
+        const quint64 key = (quint64(padded[i].unicode()) << 32) | (quint64(padded[i + 1].unicode()) << 16)
+                            | quint64(padded[i + 2].unicode());
+        auto it = ids.find(key);
+        if (it == ids.end()) {
+            it = ids.insert(key, qsizetype_to_int(ids.size()));
+        }
+        result.append(it.value());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+int overlap(const QVector<int>& a, const QVector<int>& b)
+{
+    int count = 0;
+    auto itA = a.cbegin();
+    auto itB = b.cbegin();
+    while (itA != a.cend() && itB != b.cend()) {
+        if (*itA < *itB) {
+            ++itA;
+        } else if (*itB < *itA) {
+            ++itB;
+        } else {
+            ++count;
+            ++itA;
+            ++itB;
+        }
+    }
+    return count;
+}
+
+/// \brief Adds all pairs of titles with a trigram similarity of at least similarTitleThreshold to matches.
+///
+/// Uses an inverted index with prefix filtering: Trigrams of each title are ordered by their
+/// frequency and only the rarest ones are indexed. Two titles can only be similar enough if
+/// they share at least one of these trigrams, so common trigrams like "the" are never scanned.
+void addSimilarTitles(const QVector<QString>& titles,
+    QVector<QVector<int>>& matches,
+    const std::function<void(int)>& progress)
+{
+    const int count = qsizetype_to_int(titles.size());
+
+    QHash<quint64, int> ids;
+    QVector<QVector<int>> trigrams(count);
+    for (int i = 0; i < count; ++i) {
+        if (!titles[i].isEmpty()) {
+            trigrams[i] = trigramIds(titles[i], ids);
+        }
+    }
+
+    QVector<int> frequency(ids.size(), 0);
+    for (const QVector<int>& set : asConst(trigrams)) {
+        for (int id : set) {
+            ++frequency[id];
+        }
+    }
+    const auto byFrequency = [&frequency](int a, int b) {
+        return frequency[a] < frequency[b] || (frequency[a] == frequency[b] && a < b);
+    };
+
+    // Dice >= d is equivalent to Jaccard >= d / (2 - d), for which the prefix length is known.
+    const double jaccardThreshold = similarTitleThreshold / (2.0 - similarTitleThreshold);
+
+    QVector<QVector<int>> postings(ids.size());
+    QVector<int> lastCandidateOf(count, -1);
+    for (int i = 0; i < count; ++i) {
+        if ((i + 1) % progressInterval == 0) {
+            progress(i + 1);
+        }
+        const QVector<int>& set = trigrams[i];
+        if (set.isEmpty()) {
+            continue;
+        }
+        QVector<int> prefix = set;
+        std::sort(prefix.begin(), prefix.end(), byFrequency);
+        const int prefixLength =
+            qsizetype_to_int(set.size()) - static_cast<int>(std::ceil(jaccardThreshold * set.size())) + 1;
+        prefix.resize(qBound(1, prefixLength, qsizetype_to_int(set.size())));
+
+        for (int id : asConst(prefix)) {
+            for (int j : asConst(postings[id])) {
+                if (lastCandidateOf[j] == i) {
+                    continue;
+                }
+                lastCandidateOf[j] = i;
+                const int shared = overlap(set, trigrams[j]);
+                if (2.0 * shared >= similarTitleThreshold * (set.size() + trigrams[j].size())) {
+                    matches[i].append(j);
+                    matches[j].append(i);
+                }
+            }
+        }
+        for (int id : asConst(prefix)) {
+            postings[id].append(i);
+        }
+    }
+}
+
+} // namespace
+
+namespace mediaelch {
+
+MovieDuplicateFinder::MovieDuplicateFinder(QObject* parent) : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<DuplicateMap>::finished, this, &MovieDuplicateFinder::onFinished);
+}
+
+MovieDuplicateFinder::~MovieDuplicateFinder()
+{
+    // The background thread emits signals of this object.
+    m_watcher.waitForFinished();
+}
+
+void MovieDuplicateFinder::start(const QVector<Movie*>& movies, bool includeSimilarTitles)
+{
+    if (isRunning()) {
+        return;
+    }
+
+    QVector<Candidate> candidates;
+    candidates.reserve(movies.size());
+    for (Movie* movie : movies) {
+        candidates.append(candidate(movie));
+    }
+
+    m_watcher.setFuture(QtConcurrent::run([this, candidates, includeSimilarTitles]() {
+        return findDuplicates(candidates, includeSimilarTitles, [this](int processed, int total) {
+            emit sigProgress(processed, total);
+        });
+    }));
+}
+
+bool MovieDuplicateFinder::isRunning() const
+{
+    return m_watcher.isRunning();
+}
+
+MovieDuplicateFinder::Candidate MovieDuplicateFinder::candidate(Movie* movie)
+{
+    Candidate candidate;
+    candidate.movie = movie;
+    if (movie->imdbId().isValid()) {
+        candidate.imdbId = movie->imdbId().toString();
+    }
+    if (movie->tmdbId().isValid()) {
+        candidate.tmdbId = movie->tmdbId().toString();
+    }
+    candidate.title = movie->name();
+    return candidate;
+}
+
+MovieDuplicateFinder::DuplicateMap MovieDuplicateFinder::findDuplicates(const QVector<Candidate>& candidates,
+    bool includeSimilarTitles,
+    const std::function<void(int, int)>& progress)
+{
+    const int count = qsizetype_to_int(candidates.size());
+    const int totalSteps = includeSimilarTitles ? 2 * count : count;
+    const auto reportProgress = [&progress, totalSteps](int processed) {
+        if (progress) {
+            progress(processed, totalSteps);
+        }
+    };
+
+    Buckets byImdbId;
+    Buckets byTmdbId;
+    Buckets byTitle;
+    for (int i = 0; i < count; ++i) {
+        addToBucket(byImdbId, candidates[i].imdbId, i);
+        addToBucket(byTmdbId, candidates[i].tmdbId, i);
+        addToBucket(byTitle, candidates[i].title, i);
+    }
+
+    // Indices of all duplicates of each candidate, may contain the candidate itself.
+    QVector<QVector<int>> matches(count);
+    for (int i = 0; i < count; ++i) {
+        appendBucket(byImdbId, candidates[i].imdbId, matches[i]);
+        appendBucket(byTmdbId, candidates[i].tmdbId, matches[i]);
+        appendBucket(byTitle, candidates[i].title, matches[i]);
+    }
+
+    int stepOffset = 0;
+    if (includeSimilarTitles) {
+        QVector<QString> titles;
+        titles.reserve(count);
+        for (const Candidate& candidate : candidates) {
+            titles.append(normalizedTitle(candidate.title));
+        }
+        addSimilarTitles(titles, matches, reportProgress);
+        stepOffset = count;
+    }
+
+    DuplicateMap duplicates;
+    for (int i = 0; i < count; ++i) {
+        if ((i + 1) % progressInterval == 0) {
+            reportProgress(stepOffset + i + 1);
+        }
+        QVector<int>& indices = matches[i];
+        if (indices.isEmpty()) {
+            continue;
+        }
+        // Keep the order of the given movies, like a pairwise comparison would.
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        QVector<Movie*> group{candidates[i].movie};
+        for (int j : asConst(indices)) {
+            if (j != i) {
+                group.append(candidates[j].movie);
+            }
+        }
+        if (group.size() > 1) {
+            duplicates.insert(candidates[i].movie, group);
+        }
+    }
+    reportProgress(totalSteps);
+
+    return duplicates;
+}
+
+QString MovieDuplicateFinder::normalizedTitle(const QString& title)
+{
+    QString normalized;
+    normalized.reserve(title.size());
+    bool pendingSpace = false;
+    for (const QChar c : title) {
+        if (c.isLetterOrNumber()) {
+            if (pendingSpace && !normalized.isEmpty()) {
+                normalized.append(QChar(' '));
+            }
+            pendingSpace = false;
+            normalized.append(c.toLower());
+        } else {
+            pendingSpace = true;
+        }
+    }
+    return normalized;
+}
+
+void MovieDuplicateFinder::onFinished()
+{
+    emit sigFinished(m_watcher.result());
+}
+
+} // namespace mediaelch
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class Movie;
+
+namespace mediaelch {
+
+/// \brief Finds duplicate movies in a background thread.
+///
+/// Movies are put into hash buckets by IMDb id, TMDb id and title, so that
+/// only movies that share a bucket are grouped. This yields the same groups
+/// as comparing each pair of movies using Movie::isDuplicate().
+///
+/// If similar titles are included, titles are additionally normalized and
+/// compared using trigrams, so that e.g. "Alien" and "Alien." are found as well.
+class MovieDuplicateFinder : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// \brief Maps each movie that has duplicates to a list of the movie itself and its duplicates.
+    using DuplicateMap = QMap<Movie*, QVector<Movie*>>;
+
+    /// \brief All properties of a movie that are required to find duplicates.
+    /// \details Copied in the GUI thread because movies must not be accessed from other threads.
+    struct Candidate
+    {
+        Movie* movie = nullptr;
+        QString imdbId;
+        QString tmdbId;
+        QString title;
+    };
+
+    explicit MovieDuplicateFinder(QObject* parent = nullptr);
+    ~MovieDuplicateFinder() override;
+
+    /// \brief Starts detecting duplicates of the given movies in a background thread.
+    /// \details Must be called from the GUI thread. sigFinished() is emitted when done.
+    ///          Does nothing if a detection is already running.
+    void start(const QVector<Movie*>& movies, bool includeSimilarTitles);
+    bool isRunning() const;
+
+    static Candidate candidate(Movie* movie);
+    /// \brief Finds duplicates. Thread safe.
+    /// \param progress Called with the number of processed and total steps, from the calling thread.
+    static DuplicateMap findDuplicates(const QVector<Candidate>& candidates,
+        bool includeSimilarTitles,
+        const std::function<void(int, int)>& progress = {});
+    /// \brief Lowercase title with all characters that are neither letters nor digits replaced by single spaces.
+    static QString normalizedTitle(const QString& title);
+
+signals:
+    /// \brief Emitted from the background thread while detecting duplicates.
+    void sigProgress(int processed, int total);
+    void sigFinished(mediaelch::MovieDuplicateFinder::DuplicateMap duplicates);
+
+private:
+    void onFinished();
+
+    QFutureWatcher<DuplicateMap> m_watcher;
+};
+
+} // namespace mediaelch
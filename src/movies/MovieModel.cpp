@@ -6,6 +6,7 @@
 #include "globals/Manager.h"
 
 #include <QPainter>
+#include <limits>
 #include <numeric>
 
 MovieModel::MovieModel(QObject* parent) :
@@ -27,6 +28,8 @@ void MovieModel::addMovie(Movie* movie)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_movies.append(movie);
+    m_sortKeys.append(createSortKeys(*movie));
+    updateFilterIndex(movie);
     endInsertRows();
     connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
 }
@@ -35,7 +38,10 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount() + qsizetype_to_int(movies.size()) - 1);
     m_movies.append(movies);
+    m_sortKeys.reserve(m_movies.size());
     for (Movie* movie : movies) {
+        m_sortKeys.append(createSortKeys(*movie));
+        updateFilterIndex(movie);
         connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
     }
     endInsertRows();
@@ -48,7 +54,13 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
  */
 void MovieModel::onMovieChanged(Movie* movie)
 {
-    const QModelIndex index = createIndex(qsizetype_to_int(m_movies.indexOf(movie)), 0);
+    const int row = qsizetype_to_int(m_movies.indexOf(movie));
+    if (row >= 0) {
+        // Must be updated before proxy models sort and filter the changed row again.
+        m_sortKeys[row] = createSortKeys(*movie);
+        updateFilterIndex(movie);
+    }
+    const QModelIndex index = createIndex(row, 0);
     emit dataChanged(index, index);
 }
 
@@ -66,6 +78,54 @@ Movie* MovieModel::movie(int row)
     return m_movies.at(row);
 }
 
+const MovieModel::SortKeys& MovieModel::sortKeys(int row) const
+{
+    return m_sortKeys.at(row);
+}
+
+MovieModel::SortKeys MovieModel::createSortKeys(const Movie& movie)
+{
+    SortKeys keys;
+    const QString sortTitle = movie.sortTitle();
+    keys.title = mediaelch::LocaleSortKey(sortTitle.isEmpty() ? helper::appendArticle(movie.name()) : sortTitle);
+    keys.fileLastModified = movie.fileLastModified().isValid() ? movie.fileLastModified().toMSecsSinceEpoch()
+                                                               : std::numeric_limits<qint64>::min();
+    keys.releaseYear = movie.released().year();
+    keys.watched = movie.watched();
+    keys.infoLoaded = movie.controller()->infoLoaded();
+    return keys;
+}
+
+mediaelch::FilterIndex& MovieModel::filterIndex()
+{
+    return m_filterIndex;
+}
+
+void MovieModel::updateFilterIndex(Movie* movie)
+{
+    const auto field = [](MovieFilters filter) { return static_cast<int>(filter); };
+
+    m_filterIndex.setValues(movie, field(MovieFilters::Genres), movie->genres());
+    m_filterIndex.setValues(movie, field(MovieFilters::Studio), movie->studios());
+    m_filterIndex.setValues(movie, field(MovieFilters::Country), movie->countries());
+    m_filterIndex.setValues(movie, field(MovieFilters::Tags), movie->tags());
+    m_filterIndex.setValues(movie, field(MovieFilters::Director), {movie->director()});
+    m_filterIndex.setValues(movie, field(MovieFilters::Set), {movie->set().name});
+    m_filterIndex.setValues(movie, field(MovieFilters::Certification), {movie->certification().toString()});
+    m_filterIndex.setValues(movie,
+        field(MovieFilters::VideoCodec),
+        {movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec)});
+
+    QStringList paths;
+    for (const mediaelch::FilePath& file : movie->files()) {
+        paths << file.toNativePathString();
+    }
+    m_filterIndex.setText(movie, field(MovieFilters::Title), movie->name());
+    m_filterIndex.setText(movie, field(MovieFilters::OriginalTitle), movie->originalName());
+    // File paths cannot contain line breaks, so filters never match across two paths.
+    m_filterIndex.setText(movie, field(MovieFilters::Path), paths.join('\n'));
+}
+
 int MovieModel::rowCount(const QModelIndex& parent) const
 {
     if (parent.isValid()) {
@@ -275,6 +335,8 @@ void MovieModel::clear()
         movie->deleteLater();
     }
     m_movies.clear();
+    m_sortKeys.clear();
+    m_filterIndex.clear();
     endRemoveRows();
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "globals/FilterIndex.h"
+#include "globals/LocaleSortKey.h"
 #include "movies/Movie.h"
 
 #include <QAbstractItemModel>
@@ -45,6 +47,18 @@ public:
         MoviePointerRole = Qt::UserRole + 22
     };
 
+    /// \brief Values that movies are sorted by, precomputed for each movie.
+    /// \details Updated whenever a movie emits sigChanged().
+    struct SortKeys
+    {
+        /// \brief Sort title or the "normalized" title if the former does not exist.
+        mediaelch::LocaleSortKey title;
+        qint64 fileLastModified = 0;
+        int releaseYear = 0;
+        bool watched = false;
+        bool infoLoaded = false;
+    };
+
 public:
     explicit MovieModel(QObject* parent = nullptr);
 
@@ -56,6 +70,10 @@ public:
 
     virtual QVector<Movie*> movies();
     Movie* movie(int row);
+    const SortKeys& sortKeys(int row) const;
+    /// \brief Index of the values that movies are filtered by, see Filter::compileMovieFilter().
+    /// \details Updated whenever a movie emits sigChanged().
+    mediaelch::FilterIndex& filterIndex();
     void addMovie(Movie* movie);
     void addMovies(const QVector<Movie*>& movies);
     void update();
@@ -70,7 +88,13 @@ private slots:
     void onMovieChanged(Movie* movie);
 
 private:
+    static SortKeys createSortKeys(const Movie& movie);
+    void updateFilterIndex(Movie* movie);
+
     QVector<Movie*> m_movies;
+    /// \brief Sort keys for each movie in m_movies, same order.
+    QVector<SortKeys> m_sortKeys;
+    mediaelch::FilterIndex m_filterIndex;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -4,7 +4,7 @@
 
 #include "globals/Filter.h"
 #include "globals/Globals.h"
-#include "globals/Manager.h"
+#include "movies/MovieModel.h"
 
 MovieProxyModel::MovieProxyModel(QObject* parent) :
     QSortFilterProxyModel(parent), m_sortBy{SortBy::New}, m_filterDuplicates{false}
@@ -13,75 +13,75 @@ MovieProxyModel::MovieProxyModel(QObject* parent) :
 }
 
 /**
- * \brief Checks if a row accepts the filter. Checks the first two "columns" of our model (Movie name and folder name)
+ * \brief Checks if a row accepts the filter. Uses the filters compiled in setFilter().
  * \return Filter is accepted or not
  */
 bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
-    if (sourceRow < 0 || sourceRow >= movies.count()) {
+    Movie* movie = (m_movieModel != nullptr) ? m_movieModel->movie(sourceRow) : nullptr;
+    if (movie == nullptr) {
         return true;
     }
 
-    Movie* movie = movies.at(sourceRow);
-    for (Filter* filter : m_filters) {
-        if (!filter->accepts(movie)) {
+    for (const Filter::MoviePredicate& accepts : m_predicates) {
+        if (!accepts(movie)) {
             return false;
         }
     }
 
-    return !(m_filterDuplicates && !movies.at(sourceRow)->hasDuplicates());
+    return !(m_filterDuplicates && !movie->hasDuplicates());
+}
+
+void MovieProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    m_movieModel = qobject_cast<MovieModel*>(sourceModel);
+    compileFilters();
+    QSortFilterProxyModel::setSourceModel(sourceModel);
 }
 
 bool MovieProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QString leftTitle = sourceModel()->data(left, MovieModel::SortTitleRole).toString();
-    const QString rightTitle = sourceModel()->data(right, MovieModel::SortTitleRole).toString();
-    const int cmp = QString::localeAwareCompare(leftTitle, rightTitle);
+    if (m_movieModel == nullptr) {
+        return QSortFilterProxyModel::lessThan(left, right);
+    }
+
+    const MovieModel::SortKeys& leftKeys = m_movieModel->sortKeys(left.row());
+    const MovieModel::SortKeys& rightKeys = m_movieModel->sortKeys(right.row());
 
     switch (m_sortBy) {
-    case SortBy::Name: return (cmp < 0);
+    case SortBy::Name: break;
 
     case SortBy::Added:
-        return sourceModel()->data(left, MovieModel::FileLastModifiedRole).toDateTime()
-               >= sourceModel()->data(right, MovieModel::FileLastModifiedRole).toDateTime();
+        if (leftKeys.fileLastModified != rightKeys.fileLastModified) {
+            return leftKeys.fileLastModified > rightKeys.fileLastModified;
+        }
+        // Otherwise sort by name because both were added at the same time.
+        break;
 
     case SortBy::Seen:
-        if (sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return true;
+        if (leftKeys.watched != rightKeys.watched) {
+            return rightKeys.watched;
         }
         // Otherwise sort by name because both are either seen or not.
         break;
 
     case SortBy::Year:
-        if (sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-            != sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year()) {
-            return sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-                   >= sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year();
+        if (leftKeys.releaseYear != rightKeys.releaseYear) {
+            return leftKeys.releaseYear > rightKeys.releaseYear;
         }
         // Otherwise sort by name because both have the same year.
         break;
 
     case SortBy::New:
-        if (sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return true;
+        if (leftKeys.infoLoaded != rightKeys.infoLoaded) {
+            return rightKeys.infoLoaded;
         }
         // Otherwise sort by name because both are new or not.
         break;
     }
 
-    return (cmp < 0);
+    return leftKeys.title < rightKeys.title;
 }
 
 bool MovieProxyModel::filterDuplicates() const
@@ -99,7 +99,20 @@ void MovieProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = std::move(filters);
     m_filterText = std::move(text);
-    invalidate();
+    compileFilters();
+    invalidateFilter();
+}
+
+void MovieProxyModel::compileFilters()
+{
+    m_predicates.clear();
+    if (m_movieModel == nullptr) {
+        return;
+    }
+    m_predicates.reserve(m_filters.size());
+    for (const Filter* filter : asConst(m_filters)) {
+        m_predicates.append(filter->compileMovieFilter(m_movieModel->filterIndex()));
+    }
 }
 
 void MovieProxyModel::setSortBy(SortBy sortBy)
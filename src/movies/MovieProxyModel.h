@@ -4,11 +4,15 @@
 
 #include <QSortFilterProxyModel>
 
+class MovieModel;
+
 class MovieProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
 public:
     explicit MovieProxyModel(QObject* parent = nullptr);
+    /// \brief Sets the source model, which must be a MovieModel.
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
     void setFilter(QVector<Filter*> filters, QString text);
     void setSortBy(SortBy sortBy);
 
@@ -18,10 +22,16 @@ public:
 protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
     /// \brief Sort function for the movie model. Sorts movies by name and new files to top per default.
+    /// \details Uses the movie model's precomputed sort keys instead of data().
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
 private:
+    void compileFilters();
+
+    MovieModel* m_movieModel = nullptr;
     QVector<Filter*> m_filters;
+    /// \brief m_filters compiled against the movie model's filter index.
+    QVector<Filter::MoviePredicate> m_predicates;
     QString m_filterText;
     SortBy m_sortBy;
     bool m_filterDuplicates;
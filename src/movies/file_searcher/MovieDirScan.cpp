@@ -1,12 +1,72 @@
 #include "MovieDirScan.h"
 
 #include "data/Subtitle.h"
-#include "globals/Helper.h"
+#include "file/FileFilter.h"
+#include "file/FilenameUtils.h"
 #include "log/Log.h"
+#include "movies/file_searcher/ParallelDirectoryWalker.h"
 #include "settings/Settings.h"
 
-#include <QApplication>
-#include <QRegularExpression>
+#include <QDir>
+#include <QHash>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+using mediaelch::DirectoryListing;
+using mediaelch::ParallelDirectoryWalker;
+
+/// \brief Checks whether the given file list contains exactly one file with the given name.
+/// \details File names are compared case insensitive, same as QDir's name filters.
+bool containsOnce(const QStringList& entries, const QString& name)
+{
+    return std::count_if(entries.cbegin(), entries.cend(), [&name](const QString& entry) {
+        return QString::compare(entry, name, Qt::CaseInsensitive) == 0;
+    }) == 1;
+}
+
+/// \brief Returns the main file if path is a DVD or BluRay directory, an empty string otherwise.
+/// \details Equivalent to helper::isDvd() and helper::isBluRay() but uses the already
+///          available listing so that only the disc's subdirectory needs to be listed.
+QString detectDisc(const QString& path, const DirectoryListing& listing)
+{
+    const auto hasDirectory = [&listing](const QString& name) {
+        return std::any_of(listing.directories.cbegin(), listing.directories.cend(), [&name](const QString& dir) {
+            return QString::compare(dir, name, Qt::CaseInsensitive) == 0;
+        });
+    };
+    const auto listAll = [](const QString& dirPath) {
+        DirectoryListing subListing = ParallelDirectoryWalker::listDirectory(dirPath);
+        return subListing.files + subListing.directories;
+    };
+
+    if (hasDirectory("VIDEO_TS") || hasDirectory("VIDEO TS")) {
+        for (const QString& videoTs : {QStringLiteral("VIDEO_TS"), QStringLiteral("VIDEO TS")}) {
+            if (containsOnce(listAll(path + "/" + videoTs), "VIDEO_TS.IFO")) {
+                return QDir::toNativeSeparators(path + "/VIDEO_TS/VIDEO_TS.IFO");
+            }
+        }
+    }
+
+    if (containsOnce(listing.directories, "BDMV") && containsOnce(listAll(path + "/BDMV"), "index.bdmv")) {
+        return QDir::toNativeSeparators(path + "/BDMV/index.bdmv");
+    }
+
+    return {};
+}
+
+bool isSkippedDirectory(const QString& name)
+{
+    // Skip "Extras" folder
+    return QString::compare(name, "Extras", Qt::CaseInsensitive) == 0
+           || QString::compare(name, ".actors", Qt::CaseInsensitive) == 0
+           || QString::compare(name, ".AppleDouble", Qt::CaseInsensitive) == 0
+           || QString::compare(name, "extrafanarts", Qt::CaseInsensitive) == 0
+           || Settings::instance()->advanced()->isFolderExcluded(name);
+}
+
+} // namespace
 
 namespace mediaelch {
 
@@ -18,117 +78,102 @@ void MovieDirScan::scanDir(QString startPath,
 {
     m_aborted = false;
 
-    emit currentDir(path.mid(startPath.length()));
-
-    QDir dir(path);
-    for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted) {
-            return;
-        }
-
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".AppleDouble", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
-            continue;
-        }
-
-        // Handle DVD
-        if (helper::isDvd(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
-            continue;
-        }
-
-        // Handle BluRay
-        if (helper::isBluRay(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/BDMV/index.bdmv"));
-            continue;
-        }
+    // Subdirectories of the directory at depth 0 are scanned if firstScan is set.
+    // Deeper directories are only scanned if separateFolders is not set.
+    // Subdirectories that are not scanned are listed as well, because their
+    // contents are required to detect DVD and BluRay structures.
+    ParallelDirectoryWalker walker(
+        m_aborted, [separateFolders, firstScan](const QString& dirPath, int depth, DirectoryListing& listing) {
+            // The start directory itself is never checked for DVDs or BluRays.
+            if (depth > 0) {
+                listing.discFile = detectDisc(dirPath, listing);
+            }
+            const bool descend = depth == 0 || !separateFolders || (firstScan && depth == 1);
+            if (!listing.discFile.isEmpty() || !descend) {
+                return QStringList{};
+            }
+            QStringList subdirectories;
+            for (const QString& dir : asConst(listing.directories)) {
+                if (!isSkippedDirectory(dir)) {
+                    subdirectories << dir;
+                }
+            }
+            return subdirectories;
+        });
+    const QHash<QString, DirectoryListing> listings = walker.walk(path);
+    const FileFilter fileFilter = Settings::instance()->advanced()->movieFilters();
+
+    std::function<void(const QString&, bool)> collect;
+    collect = [&](const QString& currentPath, bool isFirstScan) {
+        emit currentDir(currentPath.mid(startPath.length()));
+
+        const DirectoryListing listing = listings.value(currentPath);
+        for (const QString& cDir : listing.directories) {
+            if (m_aborted) {
+                return;
+            }
+            if (isSkippedDirectory(cDir)) {
+                continue;
+            }
 
-        // Don't scan subfolders when separate folders is checked
-        if (!separateFolders || firstScan) {
-            scanDir(startPath, path + "/" + cDir, contents, separateFolders);
-        }
-    }
+            // Handle DVD and BluRay
+            const DirectoryListing subListing = listings.value(currentPath + "/" + cDir);
+            if (!subListing.discFile.isEmpty()) {
+                contents.append(QStringList() << subListing.discFile);
+                continue;
+            }
 
-    QStringList files;
-    const QStringList entries = getFiles(path);
-    for (const QString& file : entries) {
-        if (m_aborted) {
-            return;
+            // Don't scan subfolders when separate folders is checked
+            if (!separateFolders || isFirstScan) {
+                collect(currentPath + "/" + cDir, false);
+            }
         }
 
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
+        QStringList files;
+        for (const QString& file : listing.files) {
+            if (m_aborted) {
+                return;
+            }
 
-        // Skip Extras files
-        if (file.contains("-trailer", Qt::CaseInsensitive)            //
-            || file.contains("-sample", Qt::CaseInsensitive)          //
-            || file.contains("-behindthescenes", Qt::CaseInsensitive) //
-            || file.contains("-deleted", Qt::CaseInsensitive)         //
-            || file.contains("-featurette", Qt::CaseInsensitive)      //
-            || file.contains("-interview", Qt::CaseInsensitive)       //
-            || file.contains("-scene", Qt::CaseInsensitive)           //
-            || file.contains("-short", Qt::CaseInsensitive)) {
-            continue;
-        }
-        files.append(file);
-    }
-    files.sort();
+            if (!fileFilter.matches(file) || Settings::instance()->advanced()->isFileExcluded(file)) {
+                continue;
+            }
 
-    if (separateFolders) {
-        QStringList movieFiles;
-        for (const QString& file : files) {
-            movieFiles.append(QDir::toNativeSeparators(path + "/" + file));
-        }
-        if (movieFiles.count() > 0) {
-            contents.append(movieFiles);
+            // Skip Extras files
+            if (mediaelch::file::isExtraFile(file)) {
+                continue;
+            }
+            files.append(file);
         }
-        return;
-    }
+        files.sort();
 
-    /* detect movies with multiple files*/
-    QRegularExpression rx("([\\-_\\s\\.\\(\\)]+((a|b|c|d|e|f)|((part|cd|xvid)"
-                          "[\\-_\\s\\.\\(\\)]*\\d+))[\\-_\\s\\.\\(\\)]+)",
-        QRegularExpression::CaseInsensitiveOption);
-    for (elch_size_t i = 0, n = files.size(); i < n; i++) {
-        if (m_aborted) {
+        if (separateFolders) {
+            QStringList movieFiles;
+            for (const QString& file : files) {
+                movieFiles.append(QDir::toNativeSeparators(currentPath + "/" + file));
+            }
+            if (movieFiles.count() > 0) {
+                contents.append(movieFiles);
+            }
             return;
         }
 
-        QStringList movieFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
-        }
-
-        movieFiles << QDir::toNativeSeparators(path + QDir::separator() + file);
-
-        elch_size_t pos = file.lastIndexOf(rx);
-        if (pos != -1) {
-            QRegularExpressionMatch match = rx.match(file);
-            QString left = file.left(pos);
-            QString right = file.mid(pos + match.captured(0).size());
-            for (elch_size_t x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        movieFiles << QDir::toNativeSeparators(path + QDir::separator() + subFile);
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
-                    }
-                }
+        // detect movies with multiple files
+        const QVector<QStringList> stackedFiles =
+            mediaelch::file::groupStackedFiles(files, mediaelch::file::StackingPattern::PartsAndLetters);
+        for (const QStringList& stack : stackedFiles) {
+            if (m_aborted) {
+                return;
+            }
+            QStringList movieFiles;
+            for (const QString& file : stack) {
+                movieFiles << QDir::toNativeSeparators(currentPath + QDir::separator() + file);
             }
-        }
-        if (movieFiles.count() > 0) {
             contents.append(movieFiles);
         }
-    }
+    };
+
+    collect(path, firstScan);
 }
 
 void MovieDirScan::abort()
@@ -136,17 +181,4 @@ void MovieDirScan::abort()
     m_aborted = true;
 }
 
-QStringList MovieDirScan::getFiles(QString path)
-{
-    const auto& filters = Settings::instance()->advanced()->movieFilters();
-    QStringList files;
-
-    for (const QString& file : filters.files(QDir(path))) {
-        m_lastModifications.insert(
-            QDir::toNativeSeparators(path + "/" + file), QFileInfo(path + QDir::separator() + file).lastModified());
-        files.append(file);
-    }
-    return files;
-}
-
 } // namespace mediaelch
@@ -3,10 +3,9 @@
 #include "globals/Meta.h"
 #include "movies/Movie.h"
 
-#include <QDateTime>
-#include <QHash>
 #include <QString>
 #include <QVector>
+#include <atomic>
 
 namespace mediaelch {
 
@@ -22,6 +21,8 @@ public:
     /// \brief Scans the given path for movie files.
     ///
     /// Results are in a list which contains a QStringList for every movie.
+    /// Directories are listed in parallel using ParallelDirectoryWalker before
+    /// they are grouped into movies.
     ///
     /// \param startPath Scanning started at this path
     /// \param path Path to scan
@@ -43,13 +44,7 @@ signals:
     void currentDir(QString);
 
 private:
-    /// Get a list of files in a directory
-    /// \deprecated Remove with scanDir
-    ELCH_DEPRECATED QStringList getFiles(QString path);
-
-private:
-    QHash<QString, QDateTime> m_lastModifications;
-    bool m_aborted = false;
+    std::atomic_bool m_aborted{false};
 };
 
 } // namespace mediaelch
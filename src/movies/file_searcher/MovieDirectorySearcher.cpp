@@ -4,13 +4,98 @@
 #include "file/FilenameUtils.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "movies/file_searcher/ParallelDirectoryWalker.h"
 
-#include "file/FilenameUtils.h"
-
+#include <QDir>
+#include <QFileInfo>
 #include <QMutexLocker>
+#include <QSet>
 #include <QtConcurrent>
 #include <memory>
 
+namespace {
+
+struct MovieDirectoryContents
+{
+    QString path;
+    /// Whether any file of the directory passed the filters, even if it is not a movie file.
+    bool hasEntries = false;
+    /// Movie files and the main files of DVD/BluRay structures.
+    QStringList files;
+    QHash<QString, QDateTime> lastModifications;
+    QStringList bluRayDirectories;
+    QStringList dvdDirectories;
+};
+
+/// \brief   Collects the movie files directly inside the given, already listed directory.
+/// \details Does not access any loader state, so that directories can be processed in parallel.
+///          Only the matching files are accessed, e.g. for their modification time.
+void collectMovieFiles(MovieDirectoryContents& contents,
+    const mediaelch::DirectoryListing& listing,
+    const mediaelch::FileFilter& filter)
+{
+    const QString dirName = QDir(contents.path).dirName();
+
+    // TODO: If there is a BluRay structure then the directory filter may not work
+    // because BDMV's parent directory is not listed.
+    if (Settings::instance()->advanced()->isFolderExcluded(dirName)) {
+        return;
+    }
+
+    // Skip actors, extras, extra fanarts and extra thumbs folders and all files inside them
+    for (const char* skipped : {".actors", "extras", "extrafanart", "extrathumbs"}) {
+        if (QString::compare(skipped, dirName, Qt::CaseInsensitive) == 0) {
+            return;
+        }
+    }
+
+    for (const QString& fileName : listing.files) {
+        if (!filter.matches(fileName) || Settings::instance()->advanced()->isFileExcluded(fileName)) {
+            continue;
+        }
+
+        // Skips Extras files
+        if (mediaelch::file::isExtraFile(fileName)) {
+            continue;
+        }
+
+        const bool isIndexBdmv = QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0;
+
+        // Skip BluRay backup folder
+        if (isIndexBdmv && QString::compare("backup", dirName, Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+
+        // Drops e.g. broken symlinks, same as QDir::Files does.
+        const QString filePath = contents.path + "/" + fileName;
+        const QFileInfo fileInfo(filePath);
+        if (!fileInfo.isFile()) {
+            continue;
+        }
+
+        if (isIndexBdmv) {
+            QDir bluRayDir(contents.path);
+            if (QString::compare(dirName, "BDMV", Qt::CaseInsensitive) == 0) {
+                bluRayDir.cdUp();
+            }
+            contents.bluRayDirectories << bluRayDir.path();
+        }
+        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+            QDir videoDir(contents.path);
+            if (QString::compare(dirName, "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+                videoDir.cdUp();
+            }
+            contents.dvdDirectories << videoDir.path();
+        }
+
+        contents.hasEntries = true;
+        contents.files.append(filePath);
+        contents.lastModifications.insert(filePath, fileInfo.lastModified());
+    }
+}
+
+} // namespace
+
 namespace mediaelch {
 
 void MovieLoaderStore::addMovie(Movie* movie)
@@ -80,7 +165,36 @@ void MovieDiskLoader::start()
 
     emit progress(this, 0, 0);
     emit progressText(this, "");
-    loadMovieContents();
+
+    const DirectoryPath directory(m_dir.path);
+    // Paths are absolute so that they can be compared to the movies' file paths.
+    const QString root = QDir::cleanPath(QFileInfo(m_dir.path.path()).absoluteFilePath());
+    // Listed before scanning so that changes during the scan are detected next time.
+    const QHash<QString, DirectoryListing> listings = listDirectories(root);
+
+    if (isAborted()) {
+        emit finished(this);
+        return;
+    }
+
+    QHash<QString, qint64> snapshot;
+    for (auto it = listings.cbegin(); it != listings.cend(); ++it) {
+        snapshot.insert(it.key(), it.value().lastModified);
+    }
+
+    const QHash<QString, qint64> previousSnapshot =
+        m_incremental ? m_db->movieDirectorySnapshot(directory) : QHash<QString, qint64>{};
+
+    if (previousSnapshot.isEmpty()) {
+        qCDebug(c_movie) << "[Movie] Full scan of directory:" << QDir::toNativeSeparators(m_dir.path.path());
+        // Avoid duplicates in the database if this directory was loaded before.
+        m_db->clearMoviesInDirectory(directory);
+        QStringList directories = listings.keys();
+        directories.sort();
+        loadMovieContents(listings, directories);
+    } else {
+        loadChangedMovieContents(root, previousSnapshot, snapshot, listings);
+    }
 
     if (isAborted()) {
         emit finished(this);
@@ -97,7 +211,12 @@ void MovieDiskLoader::start()
     // emitting signals is thread safe.
     QtConcurrent::blockingMap(m_contents, [this](const QStringList& files) { createMovie(files); });
 
-    storeAndAddToDatabase();
+    const bool stored = storeAndAddToDatabase();
+
+    if (!isAborted()) {
+        // Movies that are not in the database must be scanned again, i.e. the next scan is a full one.
+        m_db->setMovieDirectorySnapshot(directory, stored ? snapshot : QHash<QString, qint64>{});
+    }
 
     emit finished(this);
 }
@@ -107,111 +226,141 @@ void MovieDiskLoader::abort()
     m_aborted.store(true);
 }
 
-void MovieDiskLoader::loadMovieContents()
+QHash<QString, DirectoryListing> MovieDiskLoader::listDirectories(const QString& root)
 {
-    QDirIterator it(m_dir.path.path(),
-        m_filter.filters(),
-        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-
-    QString lastDir;
-
-    while (it.hasNext()) {
-        if (isAborted()) {
-            return;
+    // Each directory is listed exactly once. The listings are used for the snapshot
+    // as well as for finding movie files, so that no directory is listed twice.
+    std::atomic_int listed{0};
+    ParallelDirectoryWalker walker(m_aborted, [this, &listed](const QString& path, int, DirectoryListing& listing) {
+        listing.lastModified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+        // TODO: Use SignalThrottler
+        if (++listed % 40 == 0) {
+            emit progressText(this, QDir(path).dirName());
         }
-        it.next();
+        return listing.directories;
+    });
+    QHash<QString, DirectoryListing> listings = walker.walk(root);
 
-        QString dirName = it.fileInfo().dir().dirName();
-        QString fileName = it.fileName(); // may actually be a directory name
-
-        const bool isFile = it.fileInfo().isFile();
-        const bool isDir = it.fileInfo().isDir();
-        bool isSpecialDir = false; // set to true for DVD or BluRay Structure
+    if (isAborted()) {
+        return {};
+    }
+    return listings;
+}
 
-        if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
-            continue;
+/// \brief   Returns the directory that contains the DVD/BluRay structure that the given
+///          directory belongs to, e.g. "/Movie" for "/Movie/BDMV/STREAM".
+/// \details If the directory is not part of a disc structure, it is returned unchanged.
+static QString discParentDirectory(const QString& root, const QString& dir)
+{
+    elch_size_t pos = root.length();
+    while (pos < dir.length()) {
+        const elch_size_t start = pos + 1;
+        elch_size_t end = dir.indexOf('/', start);
+        if (end == -1) {
+            end = dir.length();
         }
-
-        // TODO: If there is a BluRay structure then the directory filter may not work
-        // because BDMV's parent directory is not listed.
-        if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
-            || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
-            continue;
+        const QString name = dir.mid(start, end - start);
+        if (QString::compare(name, "BDMV", Qt::CaseInsensitive) == 0
+            || QString::compare(name, "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+            return dir.left(pos);
         }
+        pos = end;
+    }
+    return dir;
+}
 
-        // Skips Extras files
-        if (isFile
-            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
-                || fileName.contains("-sample", Qt::CaseInsensitive)          //
-                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
-                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
-                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
-                || fileName.contains("-interview", Qt::CaseInsensitive)       //
-                || fileName.contains("-scene", Qt::CaseInsensitive)           //
-                || fileName.contains("-short", Qt::CaseInsensitive))) {
-            continue;
+void MovieDiskLoader::loadChangedMovieContents(const QString& root,
+    const QHash<QString, qint64>& previous,
+    const QHash<QString, qint64>& current,
+    const QHash<QString, DirectoryListing>& listings)
+{
+    // DVD and BluRay structures span multiple directories. If anything inside
+    // such a structure changes, all of its disc directories are scanned again.
+    QHash<QString, QStringList> discDirectories;
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        const QString parent = discParentDirectory(root, it.key());
+        if (parent != it.key()) {
+            discDirectories[parent].append(it.key());
         }
+    }
 
-        // Skip actors folder and all files inside it
-        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
+    QSet<QString> changedDirectories;
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        const auto previousIt = previous.constFind(it.key());
+        if (previousIt != previous.cend() && previousIt.value() == it.value()) {
             continue;
         }
-
-        // Skip extras folder and all files inside it
-        if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
+        const QString dir = discParentDirectory(root, it.key());
+        changedDirectories.insert(dir);
+        for (const QString& discDir : discDirectories.value(dir)) {
+            changedDirectories.insert(discDir);
         }
+    }
 
-        // Skip extra fanarts folder and all files inside it
-        if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
+    // Movies in removed or changed directories are removed from the database.
+    QSet<QString> outdatedDirectories = changedDirectories;
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        if (!current.contains(it.key())) {
+            outdatedDirectories.insert(it.key());
         }
+    }
 
-        // Skip extra thumbs folder and all files inside it
-        if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
+    qCDebug(c_movie) << "[Movie] Incremental scan of directory:" << QDir::toNativeSeparators(m_dir.path.path())
+                     << "| Changed directories:" << changedDirectories.size();
+
+    QVector<Movie*> unchangedMovies;
+    QVector<int> outdatedMovieIds;
+    const QVector<Movie*> cachedMovies = m_db->moviesInDirectory(DirectoryPath(m_dir.path), this);
+    for (Movie* movie : cachedMovies) {
+        if (movie->files().isEmpty()
+            || outdatedDirectories.contains(QFileInfo(movie->files().first().toString()).absolutePath())) {
+            outdatedMovieIds.append(movie->databaseId());
+            delete movie;
+        } else {
+            unchangedMovies.append(movie);
         }
+    }
+    m_db->removeMovies(outdatedMovieIds);
 
-        // Skip BluRay backup folder
-        if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
-            && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+    QtConcurrent::blockingMap(unchangedMovies, [](Movie* movie) { //
+        movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
+    });
+    m_store->addMovies(unchangedMovies);
 
-        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            QDir bluRayDir(it.fileInfo().dir());
-            if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
-                bluRayDir.cdUp();
-            }
-            m_bluRayDirectories << bluRayDir.path();
-            isSpecialDir = true;
-        }
-        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-            QDir videoDir(it.fileInfo().dir());
-            if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
-                videoDir.cdUp();
-            }
-            m_dvdDirectories << videoDir.path();
-            isSpecialDir = true;
-        }
+    QStringList directories = changedDirectories.values();
+    directories.sort();
+    loadMovieContents(listings, directories);
+}
 
-        const QString dirPath = it.fileInfo().path();
-        if (!m_contents.contains(dirPath)) {
-            m_contents.insert(dirPath, {});
-        }
-        if (isFile || isSpecialDir) {
-            m_contents[dirPath].append(it.filePath());
-            m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
+void MovieDiskLoader::loadMovieContents(const QHash<QString, DirectoryListing>& listings,
+    const QStringList& directories)
+{
+    // Directories are processed in parallel but merged in the given order.
+    QVector<MovieDirectoryContents> results(directories.size());
+    for (int i = 0; i < results.size(); ++i) {
+        results[i].path = directories.at(i);
+    }
+    QtConcurrent::blockingMap(results, [this, &listings](MovieDirectoryContents& contents) {
+        if (!isAborted()) {
+            collectMovieFiles(contents, listings.value(contents.path), m_filter);
         }
+    });
 
-        if (dirName != lastDir) {
-            lastDir = dirName;
-            // TODO: Use SignalThrottler
-            if (m_contents.count() % 40 == 0) {
-                emit progressText(this, dirName);
-            }
+    if (isAborted()) {
+        return;
+    }
+
+    for (int i = 0; i < results.size(); ++i) {
+        const MovieDirectoryContents& contents = results.at(i);
+        if (!contents.hasEntries) {
+            continue;
+        }
+        m_contents[contents.path].append(contents.files);
+        for (auto it = contents.lastModifications.cbegin(); it != contents.lastModifications.cend(); ++it) {
+            m_lastModifications.insert(it.key(), it.value());
         }
+        m_bluRayDirectories.append(contents.bluRayDirectories);
+        m_dvdDirectories.append(contents.dvdDirectories);
     }
 }
 
@@ -261,7 +410,7 @@ void MovieDiskLoader::createMovie(QStringList files)
         movie->setFileLastModified(m_lastModifications.value(files.at(0)));
         movie->setDiscType(discType);
 
-        // Note: "Label" is set in storeAndAddToDatabase()
+        // Note: "Label" is restored by Database::addMovies()
 
         movie->setChanged(false);
         movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
@@ -312,23 +461,11 @@ void MovieDiskLoader::createMovie(QStringList files)
         }
 
     } else {
+        // The stacked base name is computed once per file. Comparing it pairwise
+        // is quadratic, which stalls the scan for directories with thousands of files.
         QMap<QString, QStringList> stacked;
-        while (!files.isEmpty()) {
-            QString file = files.takeLast();
-
-            QString stackedBase = mediaelch::file::stackedBaseName(file);
-            stacked.insert(stackedBase, {file});
-
-            for (int fileIndex = 0; fileIndex < files.count();) {
-                const QString& f = files[fileIndex];
-
-                if (mediaelch::file::stackedBaseName(f) == stackedBase) {
-                    stacked[stackedBase].append(f);
-                    files.removeAt(fileIndex);
-                } else {
-                    fileIndex++;
-                }
-            }
+        for (const QString& file : asConst(files)) {
+            stacked[mediaelch::file::stackedBaseName(file)].append(file);
         }
         QMapIterator<QString, QStringList> it(stacked);
         while (it.hasNext()) {
@@ -359,25 +496,26 @@ void MovieDiskLoader::createMovie(QStringList files)
     }
 }
 
-void MovieDiskLoader::storeAndAddToDatabase()
+bool MovieDiskLoader::storeAndAddToDatabase()
 {
     if (isAborted()) {
-        return;
+        return false;
     }
 
     emit progress(this, 0, 0);
     emit progressText(this, tr("Storing movies in database..."));
 
-    m_db->transaction();
-    for (Movie* movie : asConst(m_movies)) {
-        // See also: Use https://stackoverflow.com/a/47473949/1603627
-        // We do this in just one thread.
-        movie->setLabel(m_db->getLabel(movie->files()));
-        m_db->addMovie(movie, DirectoryPath(m_dir.path));
-        m_store->addMovie(movie);
+    // See also: Use https://stackoverflow.com/a/47473949/1603627
+    // We do this in just one thread.
+    // Inserts all movies in one transaction and restores their labels.
+    const bool stored = m_db->addMovies(m_movies, DirectoryPath(m_dir.path));
+    if (!stored) {
+        qCCritical(c_movie) << "[Movie] Could not store movies in database for directory:"
+                            << QDir::toNativeSeparators(m_dir.path.path());
     }
-    m_db->commit();
+    m_store->addMovies(m_movies);
     m_movies.clear();
+    return stored;
 }
 
 void MovieDatabaseLoader::start()
@@ -2,7 +2,9 @@
 
 #include "file/FileFilter.h"
 #include "globals/Globals.h"
+#include "movies/file_searcher/ParallelDirectoryWalker.h"
 
+#include <QHash>
 #include <QMutex>
 #include <QString>
 #include <QThread>
@@ -70,7 +72,13 @@ protected:
 /// \brief Creates a thread and moves the worker to it. Auto deletes thread when worker is finished.
 QThread* createAutoDeleteThreadWithMovieLoader(MovieLoader* worker, QObject* threadParent);
 
-/// \brief Load movies from disk.
+/// \brief   Load movies from disk.
+/// \details The modification time of each directory is stored in the database.
+///          If incremental loading is enabled, only directories whose modification
+///          time changed since the last scan are scanned again and all other movies
+///          are loaded from the database.  Note that a directory's modification time
+///          only changes if entries are added, removed or renamed, i.e. changes to
+///          existing files are not detected.
 class MovieDiskLoader : public MovieLoader
 {
     Q_OBJECT
@@ -83,11 +91,28 @@ public:
     void abort() override;
     bool isAborted() override { return m_aborted.load(); }
 
+    /// \brief   Only scan directories that changed since the last scan.
+    /// \details Falls back to a full scan if the directory was never scanned.
+    ///          Must be called before start().
+    void setIncremental(bool incremental) { m_incremental = incremental; }
+
 private:
-    void loadMovieContents();
+    /// \brief   Lists the movie directory and all its subdirectories using ParallelDirectoryWalker.
+    /// \details Each listing's lastModified is set. Returns an empty hash if aborted.
+    QHash<QString, DirectoryListing> listDirectories(const QString& root);
+    /// \brief   Collect the movie files of the given, already listed directories and store them in m_contents.
+    /// \details Only files directly inside the directories are added.
+    void loadMovieContents(const QHash<QString, DirectoryListing>& listings, const QStringList& directories);
+    /// \brief   Load all movies from the database that are not affected by directory changes
+    ///          and collect the movie files of all changed directories.
+    void loadChangedMovieContents(const QString& root,
+        const QHash<QString, qint64>& previous,
+        const QHash<QString, qint64>& current,
+        const QHash<QString, DirectoryListing>& listings);
     void createMovie(QStringList files);
-    /// \brief Store all loaded movies into the MovieLoaderStore and database.
-    void storeAndAddToDatabase();
+    /// \brief   Store all loaded movies into the MovieLoaderStore and database.
+    /// \details Returns false if the movies could not be stored in the database.
+    bool storeAndAddToDatabase();
 
 private:
     SettingsDir m_dir;
@@ -98,6 +123,7 @@ private:
     std::atomic_bool m_aborted{false};
     std::atomic_int m_processed{0};
     int m_approxTotal{0};
+    bool m_incremental = false;
 
     // TODO: Streamline, e.g. use one vector of directories with DiscType tags
     QHash<QString, QDateTime> m_lastModifications;
@@ -46,6 +46,16 @@ void MovieFileSearcher::setMovieDirectories(const QVector<SettingsDir>& director
 }
 
 void MovieFileSearcher::reload(bool reloadFromDisk)
+{
+    startReload(reloadFromDisk, {});
+}
+
+void MovieFileSearcher::reloadIncrementally(const QVector<DirectoryPath>& directories)
+{
+    startReload(false, directories);
+}
+
+void MovieFileSearcher::startReload(bool reloadFromDisk, const QVector<DirectoryPath>& incrementalDirectories)
 {
     if (m_running) {
         qCCritical(c_movie) << "[Movies] Search already in progress";
@@ -56,6 +66,7 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
 
     m_aborted = false;
     m_running = true;
+    m_reloadFromDisk = reloadFromDisk;
 
     emit started();
     emit statusChanged(tr("Searching for Movies..."));
@@ -80,7 +91,9 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
 
     for (SettingsDir movieDir : asConst(m_directories)) {
         if (!movieDir.disabled) {
-            movieDir.autoReload = movieDir.autoReload || reloadFromDisk;
+            // Disk loaders scan incrementally unless reloadFromDisk is set.
+            movieDir.autoReload = movieDir.autoReload || reloadFromDisk
+                                  || incrementalDirectories.contains(DirectoryPath(movieDir.path));
             m_directoryQueue.enqueue(std::move(movieDir));
         }
     }
@@ -149,7 +162,12 @@ void MovieFileSearcher::loadNext()
 
     MovieLoader* loader = nullptr;
     if (dir.autoReload) {
-        loader = new MovieDiskLoader(dir, *m_store, Settings::instance()->advanced()->movieFilters(), nullptr);
+        auto* diskLoader =
+            new MovieDiskLoader(dir, *m_store, Settings::instance()->advanced()->movieFilters(), nullptr);
+        // Directories that are reloaded on each start only need to be scanned for changes.
+        // If the user explicitly requested a reload from disk, scan everything.
+        diskLoader->setIncremental(!m_reloadFromDisk);
+        loader = diskLoader;
     } else {
         loader = new MovieDatabaseLoader(dir, *m_store, nullptr);
     }
@@ -35,8 +35,14 @@ public:
     /// \brief Sets the directories to scan for movies. Not readable directories are skipped.
     void setMovieDirectories(const QVector<SettingsDir>& directories);
 
+    /// \brief Whether movies are currently being loaded.
+    bool isRunning() const { return m_running; }
+
 public slots:
     void reload(bool reloadFromDisk);
+    /// \brief   Reload all movies but only scan the given movie directories for changes.
+    /// \details All other directories are loaded from the database.
+    void reloadIncrementally(const QVector<mediaelch::DirectoryPath>& directories);
     void abort(bool quiet = false);
 
 signals:
@@ -54,6 +60,7 @@ private slots:
     void onProgressText(mediaelch::MovieLoader* job, QString text);
 
 private:
+    void startReload(bool reloadFromDisk, const QVector<mediaelch::DirectoryPath>& incrementalDirectories);
     void loadNext();
 
 private:
@@ -67,6 +74,8 @@ private:
 
     bool m_running = false;
     bool m_aborted = false;
+    /// \brief Whether the current reload was requested with reloadFromDisk.
+    bool m_reloadFromDisk = false;
 };
 
 } // namespace mediaelch
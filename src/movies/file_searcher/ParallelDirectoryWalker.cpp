@@ -0,0 +1,225 @@
+#include "movies/file_searcher/ParallelDirectoryWalker.h"
+
+#include "globals/Meta.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#    include <dirent.h>
+#    include <sys/stat.h>
+#endif
+
+namespace {
+
+bool lessThanIgnoringCase(const QString& lhs, const QString& rhs)
+{
+    return QString::compare(lhs, rhs, Qt::CaseInsensitive) < 0;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+ParallelDirectoryWalker::ParallelDirectoryWalker(const std::atomic_bool& aborted, SubdirectoryFilter filter) :
+    m_aborted{aborted}, m_filter{std::move(filter)}
+{
+}
+
+QHash<QString, DirectoryListing> ParallelDirectoryWalker::walk(const QString& root)
+{
+    const int workerCount = qBound(2, QThread::idealThreadCount() * 2, 16);
+    m_workers.clear();
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    m_visitedSymlinks.clear();
+    push(0, {root, 0});
+
+    // A separate pool is used so that workers never wait for unrelated tasks.
+    QThreadPool pool;
+    pool.setMaxThreadCount(workerCount - 1);
+    QVector<QFuture<void>> futures;
+    for (int i = 1; i < workerCount; ++i) {
+        futures << QtConcurrent::run(&pool, [this, i]() { run(i); });
+    }
+    run(0);
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+
+    QHash<QString, DirectoryListing> listings;
+    for (const auto& worker : m_workers) {
+        for (auto it = worker->results.cbegin(); it != worker->results.cend(); ++it) {
+            listings.insert(it.key(), it.value());
+        }
+    }
+    m_workers.clear();
+    return listings;
+}
+
+DirectoryListing ParallelDirectoryWalker::listDirectory(const QString& path)
+{
+    DirectoryListing listing;
+
+#ifdef Q_OS_UNIX
+    const QByteArray encodedPath = QFile::encodeName(path);
+    DIR* dir = ::opendir(encodedPath.constData());
+    if (dir == nullptr) {
+        return listing;
+    }
+
+    while (const dirent* entry = ::readdir(dir)) {
+        // Skips ".", ".." and hidden entries, same as QDir without QDir::Hidden.
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        bool isDir = (entry->d_type == DT_DIR);
+        bool isSymlink = (entry->d_type == DT_LNK);
+        const QByteArray entryPath = encodedPath + '/' + entry->d_name;
+        if (entry->d_type == DT_UNKNOWN) {
+            // Some file systems, e.g. certain network mounts, don't report the type at all.
+            struct stat info = {};
+            if (::lstat(entryPath.constData(), &info) == 0) {
+                isSymlink = S_ISLNK(info.st_mode);
+                isDir = S_ISDIR(info.st_mode);
+            }
+        }
+        if (isSymlink) {
+            // Symlinks are followed like QDir does.
+            struct stat info = {};
+            isDir = (::stat(entryPath.constData(), &info) == 0 && S_ISDIR(info.st_mode));
+        }
+
+        // Everything that is not a directory is a file in the sense of QDir::Files | QDir::System,
+        // e.g. broken symlinks.
+        const QString name = QFile::decodeName(entry->d_name);
+        if (isDir) {
+            listing.directories.append(name);
+            if (isSymlink) {
+                listing.symlinkedDirectories.append(name);
+            }
+        } else {
+            listing.files.append(name);
+        }
+    }
+    ::closedir(dir);
+
+    std::sort(listing.directories.begin(), listing.directories.end(), lessThanIgnoringCase);
+    std::sort(listing.files.begin(), listing.files.end(), lessThanIgnoringCase);
+
+#else
+    QDir dir(path);
+    const QFileInfoList directories = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo& info : directories) {
+        listing.directories.append(info.fileName());
+        if (info.isSymLink()) {
+            listing.symlinkedDirectories.append(info.fileName());
+        }
+    }
+    listing.files = dir.entryList(QDir::Files | QDir::System);
+#endif
+
+    return listing;
+}
+
+void ParallelDirectoryWalker::run(int self)
+{
+    Task task;
+    while (!m_aborted) {
+        if (pop(self, task) || steal(self, task)) {
+            process(self, task);
+            if (--m_pending == 0) {
+                QMutexLocker locker(&m_idleMutex);
+                m_workAvailable.wakeAll();
+            }
+            continue;
+        }
+
+        QMutexLocker locker(&m_idleMutex);
+        if (m_pending == 0) {
+            return;
+        }
+        // The timeout avoids lost wake-ups and handles aborts.
+        m_workAvailable.wait(&m_idleMutex, 10);
+    }
+}
+
+void ParallelDirectoryWalker::process(int self, const Task& task)
+{
+    DirectoryListing listing = listDirectory(task.path);
+
+    const QStringList subdirectories = m_filter(task.path, task.depth, listing);
+    for (const QString& dir : subdirectories) {
+        const QString path = task.path + "/" + dir;
+        if (listing.symlinkedDirectories.contains(dir) && !visitSymlink(path)) {
+            continue;
+        }
+        push(self, {path, task.depth + 1});
+    }
+
+    Worker& worker = *m_workers[static_cast<size_t>(self)];
+    QMutexLocker locker(&worker.mutex);
+    worker.results.insert(task.path, listing);
+}
+
+bool ParallelDirectoryWalker::visitSymlink(const QString& path)
+{
+    const QString target = QFileInfo(path).canonicalFilePath();
+    QMutexLocker locker(&m_visitedMutex);
+    if (m_visitedSymlinks.contains(target)) {
+        return false;
+    }
+    m_visitedSymlinks.insert(target);
+    return true;
+}
+
+void ParallelDirectoryWalker::push(int self, Task task)
+{
+    ++m_pending;
+    {
+        Worker& worker = *m_workers[static_cast<size_t>(self)];
+        QMutexLocker locker(&worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    QMutexLocker locker(&m_idleMutex);
+    m_workAvailable.wakeOne();
+}
+
+bool ParallelDirectoryWalker::pop(int self, Task& task)
+{
+    Worker& worker = *m_workers[static_cast<size_t>(self)];
+    QMutexLocker locker(&worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ParallelDirectoryWalker::steal(int self, Task& task)
+{
+    const int count = static_cast<int>(m_workers.size());
+    for (int i = 1; i < count; ++i) {
+        Worker& victim = *m_workers[static_cast<size_t>((self + i) % count)];
+        QMutexLocker locker(&victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mediaelch {
+
+/// \brief Contents of a single directory, see ParallelDirectoryWalker.
+struct DirectoryListing
+{
+    /// All subdirectories, sorted like QDir::entryList() does.
+    QStringList directories;
+    /// Subdirectories that are symbolic links.
+    QStringList symlinkedDirectories;
+    /// All files, sorted like QDir::entryList() does.
+    QStringList files;
+    /// Modification time of the directory in milliseconds since epoch, if set by the SubdirectoryFilter.
+    qint64 lastModified = 0;
+    /// If the directory is a DVD or BluRay structure, the path to its main file, if set by the SubdirectoryFilter.
+    QString discFile;
+};
+
+/// \brief   Lists a directory tree using multiple threads.
+/// \details Each worker has its own queue of directories. New subdirectories are
+///          added to the worker's own queue and processed depth-first. Idle workers
+///          steal the oldest entries of other workers, which are usually the largest
+///          subtrees. This keeps all workers busy even for unbalanced trees.
+///          Directory enumeration is latency bound (especially on network shares),
+///          so more workers than CPU cores are used.
+///          Symlinked directories are followed, but each target is only walked once
+///          to avoid endless loops.
+class ParallelDirectoryWalker
+{
+public:
+    /// \brief   Returns the names of the subdirectories of a listed directory that are walked as well.
+    /// \details Called from worker threads with the directory's path, its depth (0 for the start
+    ///          directory) and its listing, which may be adjusted, e.g. to store additional data.
+    using SubdirectoryFilter = std::function<QStringList(const QString& path, int depth, DirectoryListing& listing)>;
+
+    /// \param aborted Stops the walk as soon as possible if set.
+    ParallelDirectoryWalker(const std::atomic_bool& aborted, SubdirectoryFilter filter);
+
+    /// \brief   Lists the given directory and all subdirectories that pass the filter.
+    /// \details Listings are stored by path, i.e. the given root and the paths of its
+    ///          subdirectories, e.g. root + "/" + name.
+    QHash<QString, DirectoryListing> walk(const QString& root);
+
+    /// \brief   Lists the given directory with a single pass. Thread safe.
+    /// \details Behaves like QDir::entryList() with QDir::Dirs | QDir::NoDotAndDotDot
+    ///          and QDir::Files | QDir::System, respectively. On Unix, readdir() and
+    ///          d_type are used so that no additional stat() call per entry is required.
+    static DirectoryListing listDirectory(const QString& path);
+
+private:
+    struct Task
+    {
+        QString path;
+        int depth = 0;
+    };
+
+    struct Worker
+    {
+        QMutex mutex;
+        std::deque<Task> tasks;
+        QHash<QString, DirectoryListing> results;
+    };
+
+    void run(int self);
+    void process(int self, const Task& task);
+    /// \brief Whether the symlinked directory's target was not walked yet.
+    bool visitSymlink(const QString& path);
+    void push(int self, Task task);
+    bool pop(int self, Task& task);
+    bool steal(int self, Task& task);
+
+private:
+    const std::atomic_bool& m_aborted;
+    SubdirectoryFilter m_filter;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    /// Number of directories that are queued or currently processed.
+    std::atomic_int m_pending{0};
+    QMutex m_idleMutex;
+    QWaitCondition m_workAvailable;
+    QMutex m_visitedMutex;
+    /// Canonical paths of symlinked directories that were walked.
+    QSet<QString> m_visitedSymlinks;
+};
+
+} // namespace mediaelch
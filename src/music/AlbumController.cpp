@@ -96,6 +96,7 @@ void AlbumController::setInfoFromNfoLoaded(bool infoFromNfoLoaded)
 void AlbumController::loadImage(ImageType type, QUrl url)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.album = m_album;
     d.imageType = type;
     d.url = url;
@@ -108,6 +109,7 @@ void AlbumController::loadImages(ImageType type, QVector<QUrl> urls)
     bool started = false;
     for (const QUrl& url : urls) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.album = m_album;
         d.imageType = type;
         d.url = url;
@@ -96,6 +96,7 @@ void ArtistController::setInfoLoaded(bool infoLoaded)
 void ArtistController::loadImage(ImageType type, QUrl url)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.artist = m_artist;
     d.imageType = type;
     d.url = url;
@@ -108,6 +109,7 @@ void ArtistController::loadImages(ImageType type, QVector<QUrl> urls)
     bool started = false;
     for (const QUrl& url : urls) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.artist = m_artist;
         d.imageType = type;
         d.url = url;
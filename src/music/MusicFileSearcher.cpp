@@ -6,9 +6,59 @@
 #include "music/Album.h"
 #include "music/Artist.h"
 
-#include <QDirIterator>
+#include <QApplication>
+#include <QDir>
 #include <QFileInfo>
-#include <QtConcurrent>
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedValueRollback>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+struct LoadedArtist
+{
+    /// \brief May be nullptr if loading was aborted.
+    Artist* artist = nullptr;
+    mediaelch::DirectoryPath settingsDir;
+    /// \brief Artists loaded from disk still have to be stored in the database.
+    bool fromDisk = false;
+};
+
+/// \brief Artists that were loaded by worker threads and wait to be added to the model.
+class LoadedArtistQueue
+{
+public:
+    void push(LoadedArtist artist)
+    {
+        QMutexLocker locker(&m_lock);
+        m_artists.append(std::move(artist));
+        m_artistAdded.wakeOne();
+    }
+
+    /// \brief Takes all loaded artists. Waits at most the given time if there are none.
+    QVector<LoadedArtist> takeAll(unsigned long timeoutMs)
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_artists.isEmpty() && timeoutMs > 0) {
+            m_artistAdded.wait(&m_lock, timeoutMs);
+        }
+        QVector<LoadedArtist> artists = std::move(m_artists);
+        m_artists = {};
+        return artists;
+    }
+
+private:
+    QMutex m_lock;
+    QWaitCondition m_artistAdded;
+    QVector<LoadedArtist> m_artists;
+};
+
+} // namespace
 
 MusicFileSearcher::MusicFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::MusicFileSearcherProgressMessageId}, m_aborted{false}
@@ -38,22 +88,18 @@ void MusicFileSearcher::setMusicDirectories(QVector<SettingsDir> directories)
 
 void MusicFileSearcher::reload(bool force)
 {
+    QScopedValueRollback<bool> running(m_running, true);
     m_aborted = false;
 
     emit searchStarted(tr("Searching for Music..."));
     Manager::instance()->musicModel()->clear();
 
-    QVector<Artist*> artists;
-    QVector<Artist*> artistsFromDb;
-    QVector<Album*> albums;
-    QVector<Album*> albumsFromDb;
-
     if (force) {
         Manager::instance()->database()->clearAllArtists();
     }
 
-    QMap<Artist*, mediaelch::DirectoryPath> artistPaths;
-    QMap<Album*, mediaelch::DirectoryPath> albumPaths;
+    QVector<ArtistDirectory> artistDirs;
+    QVector<Artist*> dbArtists;
     for (const SettingsDir& dir : asConst(m_directories)) {
         if (m_aborted) {
             break;
@@ -67,57 +113,17 @@ void MusicFileSearcher::reload(bool force)
         }
 
         if (dir.autoReload || force) {
-            QDirIterator it(dir.path.path(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
-            while (it.hasNext()) {
-                if (m_aborted) {
-                    break;
-                }
-
-                it.next();
-
-                if (Settings::instance()->advanced()->isFolderExcluded(it.fileInfo().dir().dirName())) {
-                    continue;
-                }
-
-                emit currentDir(it.fileInfo().baseName());
-                auto* artist = new Artist(mediaelch::DirectoryPath(it.filePath()), this);
-                artist->setName(it.fileInfo().baseName());
-                artists.append(artist);
-                artistPaths.insert(artist, mediaelch::DirectoryPath(dir.path));
-
-                QDirIterator itAlbums(it.filePath(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
-                while (itAlbums.hasNext()) {
-                    itAlbums.next();
-
-                    if (Settings::instance()->advanced()->isFolderExcluded(itAlbums.fileInfo().dir().dirName())) {
-                        continue;
-                    }
-
-                    if (itAlbums.fileInfo().baseName() == "extrafanart") {
-                        continue;
-                    }
-                    if (itAlbums.fileInfo().baseName() == "extrathumbs") {
-                        continue;
-                    }
-
-                    auto* album = new Album(mediaelch::DirectoryPath(itAlbums.filePath()), this);
-                    album->setTitle(itAlbums.fileInfo().baseName());
-                    album->setArtistObj(artist);
-                    artist->addAlbum(album);
-                    albums.append(album);
-                    albumPaths.insert(album, mediaelch::DirectoryPath(dir.path));
-                }
-            }
+            getArtistDirectories(dir, artistDirs);
         } else {
             QVector<Artist*> artistsInPath =
                 Manager::instance()->database()->artistsInDirectory(mediaelch::DirectoryPath(dir.path));
             for (Artist* artist : artistsInPath) {
-                if (artistsFromDb.count() % 20 == 0) {
+                if (dbArtists.count() % 20 == 0) {
                     emit currentDir(artist->path().toString().mid(dir.path.path().length()));
                 }
-                QVector<Album*> albumsOfArtist = Manager::instance()->database()->albums(artist);
-                artistsFromDb.append(artist);
-                albumsFromDb.append(albumsOfArtist);
+                // Also adds the albums to the artist.
+                Manager::instance()->database()->albums(artist);
+                dbArtists.append(artist);
             }
         }
     }
@@ -125,55 +131,7 @@ void MusicFileSearcher::reload(bool force)
     emit currentDir("");
     emit searchStarted(tr("Loading Music..."));
 
-    int current = 0;
-    int max = qsizetype_to_int(artists.length() + albums.length() + artistsFromDb.length() + albumsFromDb.length());
-
-    Manager::instance()->database()->transaction();
-    for (Artist* artist : artists) {
-        if (m_aborted) {
-            Manager::instance()->database()->commit();
-            return;
-        }
-        artist->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-        if (current % 20 == 0) {
-            emit currentDir(artist->name());
-        }
-        emit progress(++current, max, m_progressMessageId);
-        Manager::instance()->database()->add(artist, artistPaths.value(artist));
-    }
-    for (Album* album : albums) {
-        if (m_aborted) {
-            Manager::instance()->database()->commit();
-            return;
-        }
-        album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-        if (current % 20 == 0) {
-            emit currentDir(album->artist() + "/" + album->title());
-        }
-        emit progress(++current, max, m_progressMessageId);
-        Manager::instance()->database()->add(album, albumPaths.value(album));
-    }
-    Manager::instance()->database()->commit();
-
-    QtConcurrent::blockingMapped(artistsFromDb, MusicFileSearcher::loadArtistData);
-    QtConcurrent::blockingMapped(albumsFromDb, MusicFileSearcher::loadAlbumData);
-
-    artists.append(artistsFromDb);
-    albums.append(albumsFromDb);
-
-    QMap<Artist*, MusicModelItem*> artistModelItems;
-    for (Artist* artist : artists) {
-        MusicModelItem* artistItem = Manager::instance()->musicModel()->appendChild(artist);
-        artistModelItems.insert(artist, artistItem);
-    }
-    for (Album* album : albums) {
-        MusicModelItem* artistItem = artistModelItems.value(album->artistObj(), nullptr);
-        if (artistItem == nullptr) {
-            qCWarning(generic) << "Artist item was not found for album" << album->path();
-            continue;
-        }
-        artistItem->appendChild(album);
-    }
+    setupArtists(artistDirs, dbArtists);
 
     if (!m_aborted) {
         emit musicLoaded();
@@ -196,3 +154,131 @@ Album* MusicFileSearcher::loadAlbumData(Album* album)
     album->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
     return album;
 }
+
+void MusicFileSearcher::getArtistDirectories(const SettingsDir& dir, QVector<ArtistDirectory>& artistDirs)
+{
+    const mediaelch::DirectoryPath settingsDir(dir.path);
+    const QStringList artists = dir.path.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& artist : artists) {
+        if (Settings::instance()->advanced()->isFolderExcluded(artist)) {
+            continue;
+        }
+        artistDirs.append(ArtistDirectory{settingsDir.subDir(artist), settingsDir});
+    }
+}
+
+void MusicFileSearcher::setupArtists(const QVector<ArtistDirectory>& artistDirs, const QVector<Artist*>& dbArtists)
+{
+    LoadedArtistQueue loadedArtists;
+    QThreadPool pool;
+    // Scanning is mostly waiting for the disk, especially for network shares.
+    pool.setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(dbArtists.size() + artistDirs.size());
+    // Artists from the database only parse their stored NFO content and are queued first.
+    for (Artist* artist : dbArtists) {
+        futures << QtConcurrent::run(&pool, [this, artist, &loadedArtists]() {
+            if (!m_aborted) {
+                loadArtistData(artist);
+                for (Album* album : artist->albums()) {
+                    loadAlbumData(album);
+                }
+            }
+            loadedArtists.push(LoadedArtist{artist, {}, false});
+        });
+    }
+    for (const ArtistDirectory& artistDir : artistDirs) {
+        futures << QtConcurrent::run(&pool, [this, artistDir, &loadedArtists]() {
+            loadedArtists.push(LoadedArtist{loadArtistFromDisk(artistDir.path), artistDir.settingsDir, true});
+        });
+    }
+
+    int artistCounter = 0;
+    const int artistSum = qsizetype_to_int(futures.size());
+    elch_size_t pendingArtists = futures.size();
+    while (pendingArtists > 0) {
+        const QVector<LoadedArtist> loaded = loadedArtists.takeAll(50);
+        pendingArtists -= loaded.size();
+
+        // All artists that finished in the meantime are stored and added to the model at once.
+        QVector<Artist*> batch;
+        Manager::instance()->database()->transaction();
+        for (const LoadedArtist& loadedArtist : loaded) {
+            Artist* artist = loadedArtist.artist;
+            if (artist == nullptr) {
+                continue;
+            }
+            if (m_aborted) {
+                // Not in the model yet, no matter where the artist was loaded from. Also deletes the albums.
+                delete artist;
+                continue;
+            }
+            if (loadedArtist.fromDisk) {
+                artist->setParent(this);
+                Manager::instance()->database()->add(artist, loadedArtist.settingsDir);
+                for (Album* album : artist->albums()) {
+                    album->setParent(this);
+                    Manager::instance()->database()->add(album, loadedArtist.settingsDir);
+                }
+            }
+            batch.append(artist);
+        }
+        Manager::instance()->database()->commit();
+
+        if (!batch.isEmpty()) {
+            Manager::instance()->musicModel()->appendArtists(batch);
+            artistCounter += qsizetype_to_int(batch.size());
+            emit currentDir(batch.last()->name());
+            emit progress(artistCounter, artistSum, m_progressMessageId);
+        }
+        // Keep the UI responsive so that loaded artists are shown and loading can be aborted.
+        QApplication::processEvents();
+    }
+    // All artists were pushed, but tasks may not have returned yet.
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+
+    emit currentDir("");
+}
+
+Artist* MusicFileSearcher::loadArtistFromDisk(const mediaelch::DirectoryPath& artistDir)
+{
+    if (m_aborted) {
+        return nullptr;
+    }
+
+    auto* mediaCenter = Manager::instance()->mediaCenterInterface();
+
+    // No parent: The artist is moved to the GUI thread once it is loaded.
+    auto* artist = new Artist(artistDir, nullptr);
+    artist->setName(QFileInfo(artistDir.toString()).baseName());
+    artist->controller()->loadData(mediaCenter, true);
+
+    const QStringList albumDirs = QDir(artistDir.toString()).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& albumDir : albumDirs) {
+        if (m_aborted) {
+            // Also deletes the albums.
+            delete artist;
+            return nullptr;
+        }
+        if (albumDir == "extrafanart" || albumDir == "extrathumbs"
+            || Settings::instance()->advanced()->isFolderExcluded(albumDir)) {
+            continue;
+        }
+
+        // Owned by the artist until it is moved to the GUI thread.
+        auto* album = new Album(artistDir.subDir(albumDir), artist);
+        album->setTitle(QFileInfo(album->path().toString()).baseName());
+        album->setArtistObj(artist);
+        artist->addAlbum(album);
+        album->controller()->loadData(mediaCenter, true);
+        // Booklets are otherwise listed when the album is opened for the first time.
+        album->loadBooklets(mediaCenter);
+    }
+
+    // Also moves all albums.
+    artist->moveToThread(QApplication::instance()->thread());
+    return artist;
+}
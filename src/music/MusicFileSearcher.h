@@ -1,8 +1,10 @@
 #pragma once
 
+#include "file/Path.h"
 #include "globals/Globals.h"
 
 #include <QObject>
+#include <atomic>
 
 class Album;
 class Artist;
@@ -18,6 +20,9 @@ public:
     static Artist* loadArtistData(Artist* artist);
     static Album* loadAlbumData(Album* album);
 
+    /// \brief Whether music is currently (re-)loaded.
+    bool isRunning() const { return m_running; }
+
 public slots:
     void reload(bool force);
     void abort();
@@ -29,7 +34,26 @@ signals:
     void currentDir(QString);
 
 private:
+    struct ArtistDirectory
+    {
+        mediaelch::DirectoryPath path;
+        /// \brief Music directory from the settings that contains the artist.
+        mediaelch::DirectoryPath settingsDir;
+    };
+
+    /// \brief Lists all artist directories in a music directory. Their albums are scanned later on.
+    void getArtistDirectories(const SettingsDir& dir, QVector<ArtistDirectory>& artistDirs);
+    /// \brief Loads the given artists in a thread pool and adds them to the model in batches.
+    /// \details Album discovery, NFO parsing and booklet discovery of multiple artists run in
+    ///          parallel while loaded artists are stored in the database in the GUI thread.
+    void setupArtists(const QVector<ArtistDirectory>& artistDirs, const QVector<Artist*>& dbArtists);
+    /// \brief Scans the artist's directory and loads the artist and its albums. Thread safe.
+    /// \returns An artist without parent that belongs to the GUI thread or nullptr if aborted.
+    Artist* loadArtistFromDisk(const mediaelch::DirectoryPath& artistDir);
+
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
-    bool m_aborted;
+    bool m_running = false;
+    /// \brief Set from the GUI thread, read by worker threads.
+    std::atomic<bool> m_aborted;
 };
@@ -117,13 +117,36 @@ MusicModelItem* MusicModel::appendChild(Artist* artist)
     MusicModelItem* item = m_rootItem->appendChild(artist);
     endInsertRows();
 
+    connectArtistItem(item, artist);
+    return item;
+}
+
+void MusicModel::appendArtists(const QVector<Artist*>& artists)
+{
+    if (artists.isEmpty()) {
+        return;
+    }
+
+    const int first = m_rootItem->childCount();
+    beginInsertRows(QModelIndex(), first, first + qsizetype_to_int(artists.size()) - 1);
+    for (Artist* artist : artists) {
+        MusicModelItem* item = m_rootItem->appendChild(artist);
+        // Children of inserted rows don't need their own insertion.
+        for (Album* album : artist->albums()) {
+            item->appendChild(album);
+        }
+        connectArtistItem(item, artist);
+    }
+    endInsertRows();
+}
+
+void MusicModel::connectArtistItem(MusicModelItem* item, Artist* artist)
+{
     connect(item, &MusicModelItem::sigChanged, this, &MusicModel::onSigChanged, Qt::UniqueConnection);
     connect(artist, &Artist::sigChanged, this, &MusicModel::onArtistChanged, Qt::UniqueConnection);
     connect(
         artist->controller(), &ArtistController::sigSaved, this, &MusicModel::onArtistChanged, Qt::UniqueConnection);
     connect(item, &MusicModelItem::sigIntChanged, this, &MusicModel::onSigChanged, Qt::UniqueConnection);
-
-    return item;
 }
 
 QModelIndex MusicModel::parent(const QModelIndex& index) const
@@ -22,6 +22,8 @@ public:
     bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
 
     MusicModelItem* appendChild(Artist* artist);
+    /// \brief Appends the given artists and their albums with a single row insertion.
+    void appendArtists(const QVector<Artist*>& artists);
     void clear();
     MusicModelItem* getItem(const QModelIndex& index) const;
     QVector<Artist*> artists();
@@ -33,6 +35,8 @@ private slots:
     void onArtistChanged(Artist* artist);
 
 private:
+    void connectArtistItem(MusicModelItem* item, Artist* artist);
+
     MusicModelItem* m_rootItem;
     QIcon m_newIcon;
 };
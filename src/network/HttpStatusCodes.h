@@ -14,7 +14,11 @@ enum class HttpStatusCode : int
     MovedPermanently = 301,
     Found = 302,
 
-    TooManyRequests = 429
+    TooManyRequests = 429,
+    // Server errors
+    BadGateway = 502,
+    ServiceUnavailable = 503,
+    GatewayTimeout = 504
 };
 
 /// \brief Translates the given NetworkError to a human readable error string.
@@ -1,26 +1,414 @@
 #include "network/WebsiteCache.h"
 
+#include "globals/Meta.h"
+#include "log/Log.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
+#include <QVariant>
+#include <QVector>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+struct CacheElement
+{
+    QString url;
+    QString locale;
+    QDateTime date;
+    QByteArray eTag;
+    QByteArray lastModified;
+    QString data;
+};
+
+/// \brief Shared storage of all WebsiteCache instances.
+/// \details Elements are kept in memory up to a certain size. If a directory is set,
+///          all elements are also written to disk, one file per element.
+///          The mutex only guards the in-memory state; files are read, written
+///          and removed without holding it.
+class WebsiteCacheStore
+{
+public:
+    static WebsiteCacheStore& instance()
+    {
+        static WebsiteCacheStore store;
+        return store;
+    }
+
+    void setup(QString directory, int timeoutSeconds, qint64 maxSizeBytes)
+    {
+        if (!directory.isEmpty() && !QDir().mkpath(directory)) {
+            qCWarning(generic) << "[WebsiteCache] Could not create cache directory:" << directory;
+            directory.clear();
+        }
+        QMutexLocker locker(&m_mutex);
+        m_memory.clear();
+        m_timeoutSeconds = timeoutSeconds;
+        m_maxSizeBytes = maxSizeBytes;
+        m_directory = directory;
+        m_index.clear();
+        m_totalSize = 0;
+        m_indexLoaded = false;
+        ++m_generation;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_memory.clear();
+        m_index.clear();
+        m_totalSize = 0;
+        // The directory is empty afterwards, i.e. there is nothing left to index.
+        m_indexLoaded = true;
+        ++m_generation;
+        const QString directory = m_directory;
+        locker.unlock();
+
+        if (!directory.isEmpty()) {
+            QDir(directory).removeRecursively();
+            QDir().mkpath(directory);
+        }
+    }
+
+    int timeoutSeconds()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_timeoutSeconds;
+    }
+
+    bool get(const QString& key, CacheElement& element)
+    {
+        loadIndex();
+
+        QMutexLocker locker(&m_mutex);
+        if (const CacheElement* cached = m_memory.object(key)) {
+            element = *cached;
+            const QString touchPath = markUsed(key);
+            locker.unlock();
+            touch(touchPath);
+            return true;
+        }
+        if (m_directory.isEmpty()) {
+            return false;
+        }
+        const QString path = filePath(key);
+        const int generation = m_generation;
+        locker.unlock();
+
+        const ReadResult result = readFile(path, element);
+        if (result != ReadResult::Ok) {
+            if (result == ReadResult::Corrupt) {
+                qCDebug(generic) << "[WebsiteCache] Removing corrupt cache file:" << path;
+                QFile::remove(path);
+            }
+            locker.relock();
+            if (generation == m_generation) {
+                removeFromIndex(key);
+            }
+            return false;
+        }
+
+        locker.relock();
+        if (generation != m_generation) {
+            // The cache was cleared or set up again in the meantime.
+            return false;
+        }
+        m_memory.insert(key, new CacheElement(element), memoryCost(element));
+        const QString touchPath = markUsed(key);
+        locker.unlock();
+        touch(touchPath);
+        return true;
+    }
+
+    void insert(const QString& key, const CacheElement& element)
+    {
+        loadIndex();
+
+        QMutexLocker locker(&m_mutex);
+        m_memory.insert(key, new CacheElement(element), memoryCost(element));
+        if (m_directory.isEmpty()) {
+            return;
+        }
+        const QString path = filePath(key);
+        const int generation = m_generation;
+        locker.unlock();
+
+        const qint64 size = writeFile(path, element);
+        if (size < 0) {
+            return;
+        }
+
+        locker.relock();
+        if (generation != m_generation) {
+            return;
+        }
+        IndexEntry& entry = m_index[key];
+        m_totalSize += size - entry.size;
+        entry.size = size;
+        entry.lastUsed = nextUseStamp();
+        entry.lastTouched = entry.lastUsed;
+        const QStringList evicted = m_totalSize > m_maxSizeBytes ? evict() : QStringList{};
+        locker.unlock();
+
+        for (const QString& file : evicted) {
+            QFile::remove(file);
+        }
+    }
+
+private:
+    struct IndexEntry
+    {
+        qint64 size = 0;
+        qint64 lastUsed = 0;
+        /// Modification time of the file. The file is touched on use so that the order of
+        /// uses survives restarts, but at most once per s_touchIntervalMs.
+        qint64 lastTouched = 0;
+    };
+
+    enum class ReadResult
+    {
+        Ok,
+        Missing,
+        Corrupt
+    };
+
+    WebsiteCacheStore() { m_memory.setMaxCost(32 * 1024 * 1024); }
+
+    static int memoryCost(const CacheElement& element)
+    {
+        return static_cast<int>(qMin<qint64>(element.data.size() * 2 + 256, std::numeric_limits<int>::max()));
+    }
+
+    QString filePath(const QString& key) const
+    {
+        // Two levels so that directories don't end up with tens of thousands of files.
+        return QStringLiteral("%1/%2/%3.cache").arg(m_directory, key.left(2), key);
+    }
+
+    /// \brief   Marks the element as recently used. Requires the lock.
+    /// \details Returns the path of the file if it has to be touched, an empty string otherwise.
+    QString markUsed(const QString& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return {};
+        }
+        it->lastUsed = nextUseStamp();
+        if (it->lastUsed - it->lastTouched < s_touchIntervalMs) {
+            return {};
+        }
+        it->lastTouched = it->lastUsed;
+        return filePath(key);
+    }
+
+    /// \brief Updates the file's modification time, which is used as the time of last use by loadIndex().
+    static void touch(const QString& path)
+    {
+        if (path.isEmpty()) {
+            return;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        QFile file(path);
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+#endif
+    }
+
+    void removeFromIndex(const QString& key)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            m_totalSize -= it->size;
+            m_index.erase(it);
+        }
+    }
+
+    /// \brief Strictly increasing timestamp so that the order of uses is kept even within a millisecond.
+    qint64 nextUseStamp()
+    {
+        m_lastUseStamp = qMax(QDateTime::currentMSecsSinceEpoch(), m_lastUseStamp + 1);
+        return m_lastUseStamp;
+    }
+
+    /// \brief Reads sizes and modification times of all cache files, once.
+    void loadIndex()
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_indexLoaded || m_directory.isEmpty()) {
+            return;
+        }
+        const QString directory = m_directory;
+        const int generation = m_generation;
+        locker.unlock();
+
+        QHash<QString, IndexEntry> index;
+        QDirIterator it(directory, {"*.cache"}, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo info = it.fileInfo();
+            IndexEntry entry;
+            entry.size = info.size();
+            entry.lastUsed = info.lastModified().toMSecsSinceEpoch();
+            entry.lastTouched = entry.lastUsed;
+            index.insert(info.completeBaseName(), entry);
+        }
+
+        locker.relock();
+        if (m_indexLoaded || generation != m_generation) {
+            // Another thread was faster or the cache was set up again.
+            return;
+        }
+        m_index = std::move(index);
+        m_totalSize = 0;
+        for (const IndexEntry& entry : asConst(m_index)) {
+            m_totalSize += entry.size;
+        }
+        m_indexLoaded = true;
+    }
+
+    static ReadResult readFile(const QString& path, CacheElement& element)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return file.exists() ? ReadResult::Corrupt : ReadResult::Missing;
+        }
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_6);
+        quint32 magic = 0;
+        quint32 version = 0;
+        in >> magic >> version;
+        if (magic != s_magic || version != s_version) {
+            return ReadResult::Corrupt;
+        }
+        in >> element.url >> element.locale >> element.date >> element.eTag >> element.lastModified >> element.data;
+        return in.status() == QDataStream::Ok ? ReadResult::Ok : ReadResult::Corrupt;
+    }
+
+    /// \brief Returns the size of the written file or -1 on errors.
+    static qint64 writeFile(const QString& path, const CacheElement& element)
+    {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCWarning(generic) << "[WebsiteCache] Could not write cache file:" << path;
+            return -1;
+        }
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_6);
+        out << s_magic << s_version;
+        out << element.url << element.locale << element.date << element.eTag << element.lastModified << element.data;
+        const qint64 size = file.size();
+        if (!file.commit()) {
+            qCWarning(generic) << "[WebsiteCache] Could not write cache file:" << path;
+            return -1;
+        }
+        return size;
+    }
+
+    /// \brief   Removes the least recently used elements until the cache uses at most 90% of its maximum size.
+    /// \details Requires the lock. Returns the files that have to be removed.
+    QStringList evict()
+    {
+        QVector<QPair<qint64, QString>> byLastUse;
+        byLastUse.reserve(m_index.size());
+        for (auto it = m_index.cbegin(); it != m_index.cend(); ++it) {
+            byLastUse.append({it->lastUsed, it.key()});
+        }
+        std::sort(byLastUse.begin(), byLastUse.end());
+
+        QStringList files;
+        const qint64 targetSize = m_maxSizeBytes / 10 * 9;
+        for (const auto& entry : asConst(byLastUse)) {
+            if (m_totalSize <= targetSize) {
+                break;
+            }
+            files << filePath(entry.second);
+            removeFromIndex(entry.second);
+            m_memory.remove(entry.second);
+        }
+        qCDebug(generic) << "[WebsiteCache] Cache size after cleanup:" << m_totalSize << "bytes";
+        return files;
+    }
+
+private:
+    static constexpr quint32 s_magic = 0x4d455743; // "MEWC"
+    static constexpr quint32 s_version = 1;
+    static constexpr qint64 s_touchIntervalMs = 60 * 1000;
+
+    QMutex m_mutex;
+    QCache<QString, CacheElement> m_memory;
+    QString m_directory;
+    int m_timeoutSeconds = mediaelch::scraper::WebsiteCache::timeoutSeconds;
+    qint64 m_maxSizeBytes = 0;
+    QHash<QString, IndexEntry> m_index;
+    qint64 m_totalSize = 0;
+    qint64 m_lastUseStamp = 0;
+    bool m_indexLoaded = false;
+    /// Incremented by setup() and clear() so that results of concurrent file operations are dropped.
+    int m_generation = 0;
+};
+
+QString cacheKey(const QUrl& url, const mediaelch::Locale& locale)
+{
+    const QByteArray id = (locale.toString() + "\n" + url.toString()).toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(id, QCryptographicHash::Sha1).toHex());
+}
+
+bool lookup(const QUrl& url, const mediaelch::Locale& locale, CacheElement& element)
+{
+    // Compare URL and locale as well in the unlikely case of a hash collision.
+    return WebsiteCacheStore::instance().get(cacheKey(url, locale), element) && element.url == url.toString()
+           && element.locale == locale.toString();
+}
+
+bool isOutdated(const CacheElement& element)
+{
+    return element.date < QDateTime::currentDateTime().addSecs(-WebsiteCacheStore::instance().timeoutSeconds());
+}
+
+/// \brief   Request attribute that holds the cached element's data if validators were added.
+/// \details The element may be evicted before the server answers with "304 Not Modified".
+const auto s_cachedDataAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+
+bool isNotModified(const QNetworkReply& reply)
+{
+    return reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+}
+
+} // namespace
 
 namespace mediaelch {
 namespace scraper {
 
-WebsiteCache::WebsiteCache()
+void WebsiteCache::setupPersistentCache(const QString& directory, int timeout, qint64 maxSizeBytes)
 {
-    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]() { clearOldCacheEntries(); });
+    WebsiteCacheStore::instance().setup(directory, timeout, maxSizeBytes);
 }
 
-bool WebsiteCache::hasValidElement(const QUrl& url, const Locale& locale)
+void WebsiteCache::clear()
 {
-    const QString h = hash(url, locale);
-    return m_cache.contains(h) && m_cache[h].date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds);
+    WebsiteCacheStore::instance().clear();
 }
 
-QString WebsiteCache::hash(const QUrl& url, const Locale& locale)
+bool WebsiteCache::hasValidElement(const QUrl& url, const Locale& locale)
 {
-    return QStringLiteral("%1_##_%2").arg(locale.toString(), url.toString());
+    CacheElement element;
+    return lookup(url, locale, element) && !isOutdated(element);
 }
 
 void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString data)
@@ -29,36 +417,81 @@ void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString dat
         return;
     }
     CacheElement c;
+    c.url = url.toString();
+    c.locale = locale.toString();
     c.data = std::move(data);
     c.date = QDateTime::currentDateTime();
-    m_cache.insert(hash(url, locale), c);
+    WebsiteCacheStore::instance().insert(cacheKey(url, locale), c);
+}
 
-    if (!m_timer.isActive()) {
-        // set timer for clearing the cache
-        m_timer.start(timeoutSeconds * 1000);
+void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString data, const QNetworkReply& reply)
+{
+    if (data.isEmpty() || !url.isValid() || isNotModified(reply)) {
+        // "304 Not Modified" is already handled by readReply().
+        return;
     }
+    CacheElement c;
+    c.url = url.toString();
+    c.locale = locale.toString();
+    c.data = std::move(data);
+    c.date = QDateTime::currentDateTime();
+    c.eTag = reply.rawHeader("ETag");
+    c.lastModified = reply.rawHeader("Last-Modified");
+    WebsiteCacheStore::instance().insert(cacheKey(url, locale), c);
 }
 
 QString WebsiteCache::getElement(const QUrl& url, const Locale& locale)
 {
-    const QString h = hash(url, locale);
-    return m_cache[h].data;
+    CacheElement element;
+    if (lookup(url, locale, element)) {
+        return element.data;
+    }
+    return {};
 }
 
-void WebsiteCache::clearOldCacheEntries()
+void WebsiteCache::addValidators(QNetworkRequest& request, const QUrl& url, const Locale& locale)
 {
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-        if (it.value().date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds)) {
-            it = m_cache.erase(it);
-        } else {
-            ++it;
-        }
+    CacheElement element;
+    if (!lookup(url, locale, element)) {
+        return;
+    }
+    if (element.eTag.isEmpty() && element.lastModified.isEmpty()) {
+        return;
     }
+    if (!element.eTag.isEmpty()) {
+        request.setRawHeader("If-None-Match", element.eTag);
+    }
+    if (!element.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", element.lastModified);
+    }
+    request.setAttribute(s_cachedDataAttribute, element.data);
+}
 
-    if (!m_cache.isEmpty()) {
-        m_timer.start(timeoutSeconds * 1000);
+QString WebsiteCache::readReply(QNetworkReply& reply, const QUrl& url, const Locale& locale)
+{
+    if (!isNotModified(reply)) {
+        return QString::fromUtf8(reply.readAll());
     }
+
+    // The request's copy is used, because the element may have been evicted in the meantime.
+    const QVariant cachedData = reply.request().attribute(s_cachedDataAttribute);
+    if (!cachedData.isValid()) {
+        // Should not happen: Validators are only sent for cached elements.
+        qCWarning(generic) << "[WebsiteCache] Got 304 Not Modified for an unknown element:" << url;
+        return {};
+    }
+
+    CacheElement element;
+    element.url = url.toString();
+    element.locale = locale.toString();
+    element.date = QDateTime::currentDateTime();
+    element.data = cachedData.toString();
+    // A 304 answer does not have to repeat the validators, i.e. the ones that were sent are kept.
+    element.eTag = reply.hasRawHeader("ETag") ? reply.rawHeader("ETag") : reply.request().rawHeader("If-None-Match");
+    element.lastModified = reply.hasRawHeader("Last-Modified") ? reply.rawHeader("Last-Modified")
+                                                               : reply.request().rawHeader("If-Modified-Since");
+    WebsiteCacheStore::instance().insert(cacheKey(url, locale), element);
+    return element.data;
 }
 
 } // namespace scraper
@@ -2,47 +2,59 @@
 
 #include "data/Locale.h"
 
+#include <QByteArray>
 #include <QDateTime>
-#include <QMap>
+#include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QString>
-#include <QTimer>
 #include <QUrl>
 
 namespace mediaelch {
 namespace scraper {
 
-/// \brief TheTvDb API cache stores the result for a API request as a string.
+/// \brief Cache for scraper API responses, stored as strings.
 ///
-/// Clears cache elements every timeoutSeconds. The cache is *not*
-/// thread safe.
+/// All instances share one cache. By default, elements are only kept in memory
+/// for timeoutSeconds. If setupPersistentCache() was called, elements are
+/// stored on disk and survive restarts. The cache is then bounded by size
+/// and the least recently used elements are removed first. Files are touched
+/// when used so that this order survives restarts. Unreadable files are removed.
+///
+/// Outdated elements are not removed immediately. If the server sent an ETag or
+/// Last-Modified header, addValidators() adds conditional request headers so that
+/// the server can answer with "304 Not Modified" instead of the full response.
+///
+/// The cache is thread safe.
 class WebsiteCache
 {
 public:
     constexpr static int timeoutSeconds = 240;
 
-    WebsiteCache();
+    WebsiteCache() = default;
+
+    /// \brief Store cache elements in the given directory.
+    /// \param directory Directory for cache files. Created if it does not exist.
+    ///        If empty, elements are only cached in memory.
+    /// \param timeout Time in seconds after which elements are revalidated or downloaded again.
+    /// \param maxSizeBytes Maximum size of all cache files.
+    static void setupPersistentCache(const QString& directory, int timeout, qint64 maxSizeBytes);
+    /// \brief Removes all elements from memory and disk.
+    static void clear();
 
     void addElement(const QUrl& url, const Locale& locale, QString data);
+    /// \brief Stores the data together with the reply's ETag and Last-Modified headers.
+    void addElement(const QUrl& url, const Locale& locale, QString data, const QNetworkReply& reply);
     QString getElement(const QUrl& url, const Locale& locale);
     bool hasValidElement(const QUrl& url, const Locale& locale);
 
-private:
-    struct CacheElement
-    {
-        QDateTime date;
-        QString data;
-    };
-
-    QString hash(const QUrl& url, const Locale& locale);
-
-    /// \brief Clears old cache entries that are older than timeoutSeconds.
-    ///
-    /// Restarts the timer if the cache is not empty to ensure that all elements
-    /// are eventually deleted.
-    void clearOldCacheEntries();
-
-    QMap<QUrl, CacheElement> m_cache;
-    QTimer m_timer;
+    /// \brief   Adds "If-None-Match" and "If-Modified-Since" headers for outdated elements.
+    /// \details Only has an effect if the element exists and the server sent an ETag
+    ///          or Last-Modified header for it. The request keeps a copy of the element's
+    ///          data for readReply(), in case the element is removed in the meantime.
+    void addValidators(QNetworkRequest& request, const QUrl& url, const Locale& locale);
+    /// \brief   Returns the reply's body or the cached element if the server answered with "304 Not Modified".
+    /// \details In the latter case, the cached element is valid again for the cache's timeout.
+    QString readReply(QNetworkReply& reply, const QUrl& url, const Locale& locale);
 };
 
 } // namespace scraper
@@ -0,0 +1,140 @@
+#include "scrapers/MultiScrapeQueue.h"
+
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+
+namespace mediaelch {
+namespace scraper {
+
+ScrapeLimits ScrapeLimits::forScraper(const QString& scraperIdentifier)
+{
+    // TMDb's rate limit is generous, but one movie needs up to six requests.
+    if (scraperIdentifier == TmdbMovie::ID) {
+        return {4, 250};
+    }
+    // IMDb has no official API, so be careful to not get blocked.
+    if (scraperIdentifier == ImdbMovie::ID) {
+        return {2, 500};
+    }
+    return sequential();
+}
+
+ScrapeLimits ScrapeLimits::sequential()
+{
+    return {1, 0};
+}
+
+MultiScrapeQueue::MultiScrapeQueue(QObject* parent) : QObject(parent)
+{
+    m_startTimer.setSingleShot(true);
+    connect(&m_startTimer, &QTimer::timeout, this, &MultiScrapeQueue::startNext);
+}
+
+void MultiScrapeQueue::setLimits(ScrapeLimits limits)
+{
+    m_limits = limits;
+    m_limits.maxInFlight = qMax(1, m_limits.maxInFlight);
+    m_limits.minStartIntervalMs = qMax(0, m_limits.minStartIntervalMs);
+}
+
+ScrapeLimits MultiScrapeQueue::limits() const
+{
+    return m_limits;
+}
+
+void MultiScrapeQueue::start(int itemCount)
+{
+    abort();
+    m_itemCount = qMax(0, itemCount);
+    m_nextItem = 0;
+    m_finishedCount = 0;
+    m_lastStart.invalidate();
+    m_isRunning = true;
+    scheduleNext();
+}
+
+bool MultiScrapeQueue::finishItem(int index)
+{
+    if (!m_running.removeOne(index)) {
+        return false;
+    }
+    ++m_finishedCount;
+    emit sigItemFinished(index);
+    scheduleNext();
+    return true;
+}
+
+void MultiScrapeQueue::abort()
+{
+    m_isRunning = false;
+    m_startTimer.stop();
+    m_running.clear();
+    m_nextItem = m_itemCount;
+}
+
+bool MultiScrapeQueue::isRunning() const
+{
+    return m_isRunning;
+}
+
+bool MultiScrapeQueue::isItemRunning(int index) const
+{
+    return m_running.contains(index);
+}
+
+QVector<int> MultiScrapeQueue::runningItems() const
+{
+    return m_running;
+}
+
+int MultiScrapeQueue::itemCount() const
+{
+    return m_itemCount;
+}
+
+int MultiScrapeQueue::finishedCount() const
+{
+    return m_finishedCount;
+}
+
+void MultiScrapeQueue::scheduleNext()
+{
+    if (m_isRunning && !m_startTimer.isActive()) {
+        m_startTimer.start(0);
+    }
+}
+
+void MultiScrapeQueue::startNext()
+{
+    if (!m_isRunning) {
+        return;
+    }
+
+    while (m_running.size() < m_limits.maxInFlight && m_nextItem < m_itemCount) {
+        if (m_limits.minStartIntervalMs > 0 && m_lastStart.isValid()) {
+            const qint64 elapsed = m_lastStart.elapsed();
+            if (elapsed < m_limits.minStartIntervalMs) {
+                m_startTimer.start(static_cast<int>(m_limits.minStartIntervalMs - elapsed));
+                return;
+            }
+        }
+
+        const int index = m_nextItem++;
+        m_running.append(index);
+        m_lastStart.start();
+        // The receiver may finish the item immediately or even abort the queue.
+        emit sigStartItem(index);
+        if (!m_isRunning) {
+            return;
+        }
+    }
+
+    if (m_nextItem >= m_itemCount && m_running.isEmpty()) {
+        m_isRunning = false;
+        m_startTimer.stop();
+        emit sigFinished();
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Limits for scraping multiple items with one scraper at once.
+struct ScrapeLimits
+{
+    /// \brief Maximum number of items that are scraped at the same time.
+    int maxInFlight = 1;
+    /// \brief Minimum time between starting two items in milliseconds.
+    int minStartIntervalMs = 0;
+
+    /// \brief Limits for the scraper with the given identifier, e.g. "TMDb".
+    /// \details Only scrapers whose load jobs don't share state get more than one item
+    ///          in flight. The start interval keeps bursts below the sites' rate limits.
+    static ScrapeLimits forScraper(const QString& scraperIdentifier);
+    /// \brief Scrape one item after another.
+    static ScrapeLimits sequential();
+};
+
+/// \brief Bounded-concurrency queue for multi-scrape dialogs.
+///
+/// The queue does not scrape anything itself. It only decides when an item is
+/// started: sigStartItem() is emitted for each index in [0, itemCount) and the
+/// receiver must call finishItem() once the item is done, successful or not.
+/// At most ScrapeLimits::maxInFlight items are running at once.
+///
+/// Items are always started from the event loop and never from within start()
+/// or finishItem(), so that skipped items don't lead to a deep recursion.
+class MultiScrapeQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MultiScrapeQueue(QObject* parent = nullptr);
+    ~MultiScrapeQueue() override = default;
+
+    void setLimits(ScrapeLimits limits);
+    ScrapeLimits limits() const;
+
+    /// \brief Start scraping items 0 to itemCount-1. Aborts a previous run.
+    void start(int itemCount);
+    /// \brief Mark the given item as done and start the next one.
+    /// \return False if the item is not running, e.g. because it was aborted.
+    bool finishItem(int index);
+    /// \brief Don't start any further items. Running items are forgotten.
+    void abort();
+
+    bool isRunning() const;
+    bool isItemRunning(int index) const;
+    /// \brief Indexes of all items that were started but not finished, yet.
+    QVector<int> runningItems() const;
+    int itemCount() const;
+    int finishedCount() const;
+
+signals:
+    void sigStartItem(int index);
+    void sigItemFinished(int index);
+    /// \brief Emitted once all items are finished. Not emitted if the queue was aborted.
+    void sigFinished();
+
+private slots:
+    void startNext();
+
+private:
+    void scheduleNext();
+
+    ScrapeLimits m_limits;
+    QTimer m_startTimer;
+    QElapsedTimer m_lastStart;
+    QVector<int> m_running;
+    int m_itemCount = 0;
+    int m_nextItem = 0;
+    int m_finishedCount = 0;
+    bool m_isRunning = false;
+};
+
+} // namespace scraper
+} // namespace mediaelch
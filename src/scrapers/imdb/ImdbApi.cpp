@@ -41,17 +41,18 @@ void ImdbApi::sendGetRequest(const Locale& locale, const QUrl& url, ImdbApi::Api
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     addHeadersToRequest(locale, request);
+    m_cache.addValidators(request, url, locale);
 
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, url, this]() {
         auto dls = makeDeleteLaterScope(reply);
         QString html;
         if (reply->error() == QNetworkReply::NoError) {
-            html = QString::fromUtf8(reply->readAll());
+            html = m_cache.readReply(*reply, url, locale);
 
             if (!html.isEmpty()) {
-                m_cache.addElement(reply->url(), locale, html);
+                m_cache.addElement(url, locale, html, *reply);
             }
         } else {
             qCWarning(generic) << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL" << reply->url();
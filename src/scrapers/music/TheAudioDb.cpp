@@ -28,22 +28,23 @@ void TheAudioDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheAud
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.addValidators(request, url, locale);
 
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, url, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, url, locale);
 
         } else {
             qCWarning(generic) << "[MusicBrainz] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
+            m_cache.addElement(url, locale, data, *reply);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
@@ -175,6 +175,11 @@ bool AdvancedSettings::forceCache() const
     return m_forceCache;
 }
 
+int AdvancedSettings::imageCacheMaxSize() const
+{
+    return m_imageCacheMaxSize;
+}
+
 bool AdvancedSettings::portableMode() const
 {
 #ifdef Q_OS_WIN
@@ -189,6 +194,16 @@ int AdvancedSettings::bookletCut() const
     return m_bookletCut;
 }
 
+int AdvancedSettings::streamDetailsWorkers() const
+{
+    return m_streamDetailsWorkers;
+}
+
+bool AdvancedSettings::verifyImportedFiles() const
+{
+    return m_verifyImportedFiles;
+}
+
 bool AdvancedSettings::writeThumbUrlsToNfo() const
 {
     return m_writeThumbUrlsToNfo;
@@ -199,6 +214,36 @@ mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() co
     return m_episodeThumbnailDimensions;
 }
 
+bool AdvancedSettings::libraryWatcherEnabled() const
+{
+    return m_libraryWatcherEnabled;
+}
+
+int AdvancedSettings::libraryWatcherMaxDirectories() const
+{
+    return m_libraryWatcherMaxDirectories;
+}
+
+int AdvancedSettings::libraryWatcherDelay() const
+{
+    return m_libraryWatcherDelay;
+}
+
+bool AdvancedSettings::websiteCacheEnabled() const
+{
+    return m_websiteCacheEnabled;
+}
+
+int AdvancedSettings::websiteCacheTimeout() const
+{
+    return m_websiteCacheTimeout;
+}
+
+int AdvancedSettings::websiteCacheMaxSize() const
+{
+    return m_websiteCacheMaxSize;
+}
+
 bool AdvancedSettings::isFileExcluded(QString file) const
 {
     for (const auto& pattern : m_excludePatterns) {
@@ -254,6 +299,7 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "    debugLog:                " << (settings.m_debugLog ? "true" : "false") << nl;
     out << "    logFile:                 " << settings.m_logFile << nl;
     out << "    forceCache:              " << (settings.m_forceCache ? "true" : "false") << nl;
+    out << "    imageCacheMaxSize:       " << settings.m_imageCacheMaxSize << nl;
     out << "    stylesheet:              "
         << (settings.m_customStylesheet.isEmpty() ? "<bundled>" : settings.m_customStylesheet) << nl;
     out << "    sortTokens:              " << settings.m_sortTokens.join(", ") << nl;
@@ -284,7 +330,17 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "        width:               " << settings.m_episodeThumbnailDimensions.width << nl;
     out << "        height:              " << settings.m_episodeThumbnailDimensions.height << nl;
     out << "    bookletCut:              " << settings.m_bookletCut << nl;
+    out << "    streamDetailsWorkers:    " << settings.m_streamDetailsWorkers << nl;
+    out << "    verifyImportedFiles:     " << (settings.m_verifyImportedFiles ? "true" : "false") << nl;
     out << "    useFirstStudioOnly:      " << (settings.m_useFirstStudioOnly ? "true" : "false") << nl;
+    out << "    libraryWatcher:          " << nl;
+    out << "        enabled:             " << (settings.m_libraryWatcherEnabled ? "true" : "false") << nl;
+    out << "        maxDirectories:      " << settings.m_libraryWatcherMaxDirectories << nl;
+    out << "        delay:               " << settings.m_libraryWatcherDelay << nl;
+    out << "    websiteCache:            " << nl;
+    out << "        enabled:             " << (settings.m_websiteCacheEnabled ? "true" : "false") << nl;
+    out << "        timeout:             " << settings.m_websiteCacheTimeout << nl;
+    out << "        maxSize:             " << settings.m_websiteCacheMaxSize << nl;
     out << "    exclude patterns:        " << nl;
     printExcludePatterns(settings.m_excludePatterns);
 
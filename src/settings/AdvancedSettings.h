@@ -95,10 +95,29 @@ public:
 
     bool useFirstStudioOnly() const;
     bool forceCache() const;
+    /// \brief Maximum size of the thumbnail cache (see ImageCache) in megabytes.
+    int imageCacheMaxSize() const;
     bool portableMode() const;
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
+    /// \brief Number of files whose stream details are loaded at the same time.
+    int streamDetailsWorkers() const;
+    /// \brief Whether imported files are compared to their source using checksums.
+    bool verifyImportedFiles() const;
+
+    bool libraryWatcherEnabled() const;
+    /// \brief Maximum number of watched directories. 0 means automatic, see LibraryWatcher.
+    int libraryWatcherMaxDirectories() const;
+    /// \brief Delay in seconds after which changes are reported.
+    int libraryWatcherDelay() const;
+
+    /// \brief Whether scraper responses are cached on disk. Off by default, see WebsiteCache.
+    bool websiteCacheEnabled() const;
+    /// \brief Time in hours after which cached scraper responses are revalidated.
+    int websiteCacheTimeout() const;
+    /// \brief Maximum size of the website cache in megabytes.
+    int websiteCacheMaxSize() const;
 
     bool isFileExcluded(QString file) const;
     bool isFolderExcluded(QString dir) const;
@@ -134,8 +153,17 @@ private:
     bool m_forceCache = false;
     bool m_portableMode = false;
     int m_bookletCut = 2;
+    int m_streamDetailsWorkers = 4;
+    bool m_verifyImportedFiles = false;
     bool m_writeThumbUrlsToNfo = true;
     bool m_useFirstStudioOnly = false;
+    bool m_libraryWatcherEnabled = false;
+    int m_libraryWatcherMaxDirectories = 0;
+    int m_libraryWatcherDelay = 5;
+    int m_imageCacheMaxSize = 500;
+    bool m_websiteCacheEnabled = false;
+    int m_websiteCacheTimeout = 24;
+    int m_websiteCacheMaxSize = 200;
     bool m_userDefined = false;
 };
 
@@ -123,6 +123,13 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == QLatin1String("bookletCut")) {
             expectInt(m_settings.m_bookletCut);
 
+        } else if (m_xml.name() == QLatin1String("streamDetailsWorkers")) {
+            const auto inRange = [](int workers) { return workers >= 1 && workers <= 32; };
+            expectIntChecked(m_settings.m_streamDetailsWorkers, inRange);
+
+        } else if (m_xml.name() == QLatin1String("verifyImportedFiles")) {
+            expectBool(m_settings.m_verifyImportedFiles);
+
         } else if (m_xml.name() == QLatin1String("sorttokens")) {
             loadSortTokens();
 
@@ -154,6 +161,12 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == QLatin1String("exclude")) {
             loadExcludePatterns();
 
+        } else if (m_xml.name() == QLatin1String("libraryWatcher")) {
+            loadLibraryWatcher();
+
+        } else if (m_xml.name() == QLatin1String("websiteCache")) {
+            loadWebsiteCache();
+
         } else {
             skipUnsupportedTag();
         }
@@ -178,6 +191,9 @@ void AdvancedSettingsXmlReader::loadGui()
     while (m_xml.readNextStartElement()) {
         if (m_xml.name() == QLatin1String("forceCache")) {
             expectBool(m_settings.m_forceCache);
+        } else if (m_xml.name() == QLatin1String("imageCacheMaxSize")) {
+            const auto inRange = [](int megabytes) { return megabytes >= 1 && megabytes <= 100000; };
+            expectIntChecked(m_settings.m_imageCacheMaxSize, inRange);
         } else if (m_xml.name() == QLatin1String("stylesheet")) {
             m_settings.m_customStylesheet = m_xml.readElementText().trimmed();
         } else {
@@ -186,6 +202,48 @@ void AdvancedSettingsXmlReader::loadGui()
     }
 }
 
+void AdvancedSettingsXmlReader::loadLibraryWatcher()
+{
+    while (m_xml.readNextStartElement()) {
+        if (m_xml.name() == QLatin1String("enabled")) {
+            expectBool(m_settings.m_libraryWatcherEnabled);
+
+        } else if (m_xml.name() == QLatin1String("maxDirectories")) {
+            // 0 means automatic. Otherwise, at least all media directories themselves should be watched.
+            const auto inRange = [](int max) { return max == 0 || max >= 10; };
+            expectIntChecked(m_settings.m_libraryWatcherMaxDirectories, inRange);
+
+        } else if (m_xml.name() == QLatin1String("delay")) {
+            const auto inRange = [](int seconds) { return seconds >= 1 && seconds <= 3600; };
+            expectIntChecked(m_settings.m_libraryWatcherDelay, inRange);
+
+        } else {
+            skipUnsupportedTag();
+        }
+    }
+}
+
+void AdvancedSettingsXmlReader::loadWebsiteCache()
+{
+    while (m_xml.readNextStartElement()) {
+        if (m_xml.name() == QLatin1String("enabled")) {
+            expectBool(m_settings.m_websiteCacheEnabled);
+
+        } else if (m_xml.name() == QLatin1String("timeout")) {
+            // At most one year
+            const auto inRange = [](int hours) { return hours >= 1 && hours <= 8760; };
+            expectIntChecked(m_settings.m_websiteCacheTimeout, inRange);
+
+        } else if (m_xml.name() == QLatin1String("maxSize")) {
+            const auto inRange = [](int megabytes) { return megabytes >= 1 && megabytes <= 100000; };
+            expectIntChecked(m_settings.m_websiteCacheMaxSize, inRange);
+
+        } else {
+            skipUnsupportedTag();
+        }
+    }
+}
+
 void AdvancedSettingsXmlReader::loadSortTokens()
 {
     m_settings.m_sortTokens.clear();
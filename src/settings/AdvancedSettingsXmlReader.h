@@ -41,6 +41,8 @@ private:
 
     void loadLog();
     void loadGui();
+    void loadLibraryWatcher();
+    void loadWebsiteCache();
     void loadSortTokens();
     void loadFilters();
     void loadMappings(QHash<QString, QString>& map);
@@ -0,0 +1,220 @@
+#include "tv_shows/EpisodeNumberParser.h"
+
+#include "globals/Helper.h"
+
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <algorithm>
+#include <array>
+
+namespace {
+
+struct EpisodePattern
+{
+    QRegularExpression regex;
+    /// \brief If true, a heuristic is applied to avoid matching e.g. the video's resolution.
+    bool mayBeAmbiguous = false;
+};
+
+/// \brief Whether the file is a DVD, for which the directory name must be checked on disk.
+bool isDvdCandidate(const QString& file)
+{
+    return file.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive);
+}
+
+bool containsDigit(const QString& fileName)
+{
+    return std::any_of(fileName.cbegin(), fileName.cend(), [](const QChar& c) { return c.isDigit(); });
+}
+
+} // namespace
+
+namespace mediaelch {
+
+EpisodeNumberParser::EpisodeNumberParser(int maxCacheSize) : m_maxCacheSize{qMax(1, maxCacheSize)}
+{
+}
+
+EpisodeNumberParser& EpisodeNumberParser::instance()
+{
+    static EpisodeNumberParser s_instance;
+    return s_instance;
+}
+
+EpisodeFileNumbers EpisodeNumberParser::parse(const QStringList& files)
+{
+    if (files.isEmpty()) {
+        return {};
+    }
+    const QString& file = files.at(0);
+    if (!isDvdCandidate(file)) {
+        return parseFileName(episodeFileName(files));
+    }
+
+    EpisodeFileNumbers numbers;
+    if (findCached(file, numbers)) {
+        return numbers;
+    }
+    numbers = parseFileName(episodeFileName(files));
+    insertCached(file, numbers);
+    return numbers;
+}
+
+EpisodeFileNumbers EpisodeNumberParser::parseFileName(const QString& fileName)
+{
+    EpisodeFileNumbers numbers;
+    if (findCached(fileName, numbers)) {
+        return numbers;
+    }
+
+    if (containsDigit(fileName)) {
+        numbers.season = parseSeasonNumber(fileName);
+        numbers.episodes = parseEpisodeNumbers(fileName);
+    } else {
+        // All patterns require a number.
+        numbers.season = SeasonNumber::SpecialsSeason;
+    }
+
+    insertCached(fileName, numbers);
+    return numbers;
+}
+
+int EpisodeNumberParser::cacheSize() const
+{
+    QMutexLocker locker(&m_lock);
+    return qsizetype_to_int(m_cache.size());
+}
+
+void EpisodeNumberParser::clearCache()
+{
+    QMutexLocker locker(&m_lock);
+    m_cache.clear();
+    m_recentlyUsed.clear();
+}
+
+bool EpisodeNumberParser::findCached(const QString& key, EpisodeFileNumbers& numbers)
+{
+    QMutexLocker locker(&m_lock);
+    const auto it = m_cache.constFind(key);
+    if (it == m_cache.constEnd()) {
+        return false;
+    }
+    m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed, it->position);
+    numbers = it->numbers;
+    return true;
+}
+
+void EpisodeNumberParser::insertCached(const QString& key, const EpisodeFileNumbers& numbers)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = m_cache.find(key);
+    if (it != m_cache.end()) {
+        // Parsed by another thread in the meantime.
+        m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed, it->position);
+        it->numbers = numbers;
+        return;
+    }
+    if (m_cache.size() >= m_maxCacheSize) {
+        m_cache.remove(m_recentlyUsed.back());
+        m_recentlyUsed.pop_back();
+    }
+    m_recentlyUsed.push_front(key);
+    m_cache.insert(key, {numbers, m_recentlyUsed.begin()});
+}
+
+QString EpisodeNumberParser::episodeFileName(const QStringList& files)
+{
+    const QStringList filenameParts = files.at(0).split('/');
+    QString filename = filenameParts.last();
+    if (isDvdCandidate(filename)) {
+        if (filenameParts.count() > 1 && helper::isDvd(files.at(0))) {
+            filename = filenameParts.at(filenameParts.count() - 3);
+        } else if (filenameParts.count() > 2 && helper::isDvd(files.at(0), true)) {
+            filename = filenameParts.at(filenameParts.count() - 2);
+        }
+    } else if (filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
+        if (filenameParts.count() > 2) {
+            filename = filenameParts.at(filenameParts.count() - 3);
+        }
+    }
+    return filename;
+}
+
+SeasonNumber EpisodeNumberParser::parseSeasonNumber(const QString& fileName)
+{
+    // The first pattern that matches wins.
+    static const std::array<QRegularExpression, 4> patterns{
+        QRegularExpression(R"(S(\d+)[ ._-]?E)", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression(R"((\d+)?x(\d+))", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression(R"((\d+).(\d){2,4})", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression(R"(Season[ ._]?(\d+)[ ._]?Episode)", QRegularExpression::CaseInsensitiveOption)};
+
+    for (const QRegularExpression& rx : patterns) {
+        const QRegularExpressionMatch match = rx.match(fileName);
+        if (match.hasMatch()) {
+            return SeasonNumber(match.captured(1).toInt());
+        }
+    }
+
+    // Default if no valid season could be parsed.
+    return SeasonNumber::SpecialsSeason;
+}
+
+QVector<EpisodeNumber> EpisodeNumberParser::parseEpisodeNumbers(const QString& fileName)
+{
+    // The first pattern that matches wins, which is why they are not merged into
+    // a single alternation: that would prefer the leftmost match instead.
+    static const std::array<EpisodePattern, 5> patterns{
+        EpisodePattern{QRegularExpression(R"(S(\d+)[ ._-]?E(\d+))", QRegularExpression::CaseInsensitiveOption), false},
+        EpisodePattern{QRegularExpression(R"(S(\d+)[ ._-]?EP(\d+))", QRegularExpression::CaseInsensitiveOption), false},
+        EpisodePattern{QRegularExpression(R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))",
+                           QRegularExpression::CaseInsensitiveOption),
+            false},
+        EpisodePattern{QRegularExpression(R"((\d+)x(\d+))", QRegularExpression::CaseInsensitiveOption), true},
+        EpisodePattern{QRegularExpression(R"((\d+).(\d){2,4})", QRegularExpression::CaseInsensitiveOption), true}};
+    // The one episode we found could actually be a multi-episode file, e.g. S01E01E02
+    static const QRegularExpression multiEpisode(
+        R"([-_EeXx]+([0-9]+)($|[\-\._\sE]))", QRegularExpression::CaseInsensitiveOption);
+
+    QVector<EpisodeNumber> episodes;
+    for (const EpisodePattern& pattern : patterns) {
+        QRegularExpressionMatchIterator matches = pattern.regex.globalMatch(fileName);
+
+        elch_size_t lastMatchEnd = -1;
+        bool ambiguous = false;
+        while (matches.hasNext()) {
+            QRegularExpressionMatch match = matches.next();
+            // if between the last match and this one are more than five characters: break
+            // this way we can try to filter "false matches" like in "21x04 - Hammond vs. 6x6.mp4"
+            if (pattern.mayBeAmbiguous && lastMatchEnd != -1 && lastMatchEnd < match.capturedStart(0) + 5) {
+                ambiguous = true;
+                break;
+            }
+            episodes << EpisodeNumber(match.captured(2).toInt());
+            lastMatchEnd = match.capturedEnd(0);
+        }
+        if (ambiguous) {
+            return episodes;
+        }
+        if (episodes.isEmpty()) {
+            continue;
+        }
+
+        if (episodes.count() == 1) {
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+            matches = multiEpisode.globalMatch(
+                fileName, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption);
+#else
+            matches = multiEpisode.globalMatch(
+                fileName, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
+#endif
+            while (matches.hasNext()) {
+                episodes << EpisodeNumber(matches.next().captured(1).toInt());
+            }
+        }
+        return episodes;
+    }
+    return episodes;
+}
+
+} // namespace mediaelch
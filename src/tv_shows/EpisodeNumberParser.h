@@ -0,0 +1,72 @@
+#pragma once
+
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <list>
+
+namespace mediaelch {
+
+/// \brief Season and episode numbers of an episode file.
+struct EpisodeFileNumbers
+{
+    SeasonNumber season = SeasonNumber::NoSeason;
+    /// \brief Multiple numbers for multi-episode files, e.g. "S01E01E02". Empty if none were found.
+    QVector<EpisodeNumber> episodes;
+};
+
+/// \brief Extracts season and episode numbers from the file names of episodes.
+///
+/// All patterns are compiled once and results are cached by file name, so that
+/// files of the same episode are only parsed once, e.g. when a show is reloaded.
+/// DVDs are cached by path, so that cached DVDs are never checked on disk again.
+/// This class is thread safe.
+class EpisodeNumberParser
+{
+public:
+    /// \brief Default number of cached file names. If the cache is full, the least
+    ///        recently used file name is removed.
+    static constexpr int defaultMaxCacheSize = 100000;
+
+    explicit EpisodeNumberParser(int maxCacheSize = defaultMaxCacheSize);
+
+    static EpisodeNumberParser& instance();
+
+    /// \brief Parses the files of an episode. Only the first file is used.
+    /// \details For DVDs and BluRays, the name of the disc's directory is used instead,
+    ///          e.g. "S01E01" for "S01E01/VIDEO_TS/VIDEO_TS.IFO".
+    EpisodeFileNumbers parse(const QStringList& files);
+    /// \brief Parses a file name without directory.
+    EpisodeFileNumbers parseFileName(const QString& fileName);
+
+    int cacheSize() const;
+    void clearCache();
+
+private:
+    static QString episodeFileName(const QStringList& files);
+    static SeasonNumber parseSeasonNumber(const QString& fileName);
+    static QVector<EpisodeNumber> parseEpisodeNumbers(const QString& fileName);
+
+    bool findCached(const QString& key, EpisodeFileNumbers& numbers);
+    void insertCached(const QString& key, const EpisodeFileNumbers& numbers);
+
+    struct CacheEntry
+    {
+        EpisodeFileNumbers numbers;
+        /// \brief Position of the key in m_recentlyUsed.
+        std::list<QString>::iterator position;
+    };
+
+    const int m_maxCacheSize;
+    mutable QMutex m_lock;
+    QHash<QString, CacheEntry> m_cache;
+    /// \brief Cache keys, most recently used first.
+    std::list<QString> m_recentlyUsed;
+};
+
+} // namespace mediaelch
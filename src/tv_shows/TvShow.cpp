@@ -4,6 +4,7 @@
 #include <QApplication>
 #include <QDir>
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include "file/NameFormatter.h"
@@ -24,7 +25,8 @@ using namespace std::chrono_literals;
 TvShow::TvShow(mediaelch::DirectoryPath dir, QObject* parent) : QObject(parent), m_dir{std::move(dir)}, m_runtime{0min}
 {
     clear();
-    static int m_idCounter = 0;
+    // Shows are created by multiple threads when loading them from disk.
+    static std::atomic<int> m_idCounter{0};
     m_showId = ++m_idCounter;
 }
 
@@ -14,6 +14,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QTime>
+#include <atomic>
 #include <utility>
 
 TvShowEpisode::TvShowEpisode(const mediaelch::FileList& files, QObject* parent) :
@@ -41,7 +42,8 @@ TvShowEpisode::TvShowEpisode(const mediaelch::FileList& files, TvShow* parentSho
 
 void TvShowEpisode::initCounter()
 {
-    static int m_idCounter = 0;
+    // Episodes are created by multiple threads when loading TV shows from disk.
+    static std::atomic<int> m_idCounter{0};
     m_episodeId = ++m_idCounter;
 }
 
@@ -167,6 +169,13 @@ bool TvShowEpisode::loadStreamDetailsFromFile()
     return success;
 }
 
+void TvShowEpisode::setStreamDetails(const StreamDetails::Values& details)
+{
+    m_streamDetails->setValues(details);
+    setStreamDetailsLoaded(true);
+    setChanged(true);
+}
+
 /**
  * \brief Save data using a MediaCenterInterface
  * \param mediaCenterInterface MediaCenterInterface to use
@@ -147,6 +147,8 @@ public:
 
     /// \brief Tries to load streamdetails from the file
     ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    /// \brief Sets stream details that were loaded in the background, see mediaelch::StreamDetailsLoader.
+    void setStreamDetails(const StreamDetails::Values& details);
 
     void clearImages();
     QSet<EpisodeScraperInfo> infosToLoad();
@@ -2,20 +2,64 @@
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedValueRollback>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 #include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
 
+#include "file/FilenameUtils.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "tv_shows/EpisodeNumberParser.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
 #include "tv_shows/model/TvShowModelItem.h"
 
+namespace {
+
+/// \brief Shows that were loaded by worker threads and wait to be added to the model.
+class LoadedShowQueue
+{
+public:
+    /// \param show May be nullptr if loading was aborted.
+    void push(TvShow* show)
+    {
+        QMutexLocker locker(&m_lock);
+        m_shows.append(show);
+        m_showAdded.wakeOne();
+    }
+
+    /// \brief Takes all loaded shows. Waits at most the given time if there are none.
+    QVector<TvShow*> takeAll(unsigned long timeoutMs)
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_shows.isEmpty() && timeoutMs > 0) {
+            m_showAdded.wait(&m_lock, timeoutMs);
+        }
+        QVector<TvShow*> shows = std::move(m_shows);
+        m_shows = {};
+        return shows;
+    }
+
+private:
+    QMutex m_lock;
+    QWaitCondition m_showAdded;
+    QVector<TvShow*> m_shows;
+};
+
+} // namespace
+
 TvShowFileSearcher::TvShowFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::TvShowSearcherProgressMessageId}, m_aborted{false}
 {
@@ -46,23 +90,21 @@ void TvShowFileSearcher::setTvShowDirectories(QVector<SettingsDir> directories)
 void TvShowFileSearcher::reload(bool force)
 {
     qCInfo(generic) << "[TvShowFileSearcher] Reload TV shows, clear database:" << force;
+    QScopedValueRollback<bool> running(m_running, true);
     m_aborted = false;
 
     clearOldTvShows(force);
 
     emit searchStarted(tr("Searching for TV Shows..."));
 
-    auto files = readTvShowContent(force);
-
-    emit currentDir("");
+    const QVector<mediaelch::DirectoryPath> showDirs = readTvShowDirectories(force);
+    const QVector<TvShow*> dbShows = getShowsFromDatabase(force);
 
     emit searchStarted(tr("Loading TV Shows..."));
-    int episodeCounter = 0;
-    const int episodeSum = database().episodeCount();
+    int showCounter = 0;
+    const int showSum = qsizetype_to_int(showDirs.size() + dbShows.size());
 
-    QVector<TvShow*> dbShows = getShowsFromDatabase(force);
-    setupShows(files, episodeCounter, episodeSum);
-    setupShowsFromDatabase(dbShows, episodeCounter, episodeSum);
+    setupShows(showDirs, dbShows, showCounter, showSum);
 
     for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
         if (show->showMissingEpisodes()) {
@@ -84,6 +126,7 @@ TvShowEpisode* TvShowFileSearcher::loadEpisodeData(TvShowEpisode* episode)
 
 void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
 {
+    QScopedValueRollback<bool> running(m_running, true);
     database().clearTvShowInDirectory(showDir);
     emit searchStarted(tr("Searching for Episodes..."));
 
@@ -99,23 +142,7 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
         }
     }
 
-    // get path
-    mediaelch::DirectoryPath path;
-    elch_size_t index = -1;
-    for (elch_size_t i = 0, n = m_directories.count(); i < n; ++i) {
-        if (m_aborted) {
-            return;
-        }
-
-        if (showDir.toString().startsWith(m_directories[i].path.path())) {
-            if (index == -1 || m_directories[index].path.path().length() < m_directories[i].path.path().length()) {
-                index = i;
-            }
-        }
-    }
-    if (index != -1) {
-        path = mediaelch::DirectoryPath(m_directories[index].path);
-    }
+    const mediaelch::DirectoryPath path = settingsDirectory(showDir);
 
     // search for contents
     QVector<QStringList> contents;
@@ -135,11 +162,10 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
         if (m_aborted) {
             return;
         }
-        SeasonNumber seasonNumber = getSeasonNumber(files);
-        QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-        for (const EpisodeNumber& episodeNumber : episodeNumbers) {
+        const mediaelch::EpisodeFileNumbers numbers = mediaelch::EpisodeNumberParser::instance().parse(files);
+        for (const EpisodeNumber& episodeNumber : numbers.episodes) {
             auto* episode = new TvShowEpisode(files, show);
-            episode->setSeason(seasonNumber);
+            episode->setSeason(numbers.season);
             episode->setEpisode(episodeNumber);
             episodes.append(episode);
         }
@@ -166,10 +192,10 @@ TvShowEpisode* TvShowFileSearcher::reloadEpisodeData(TvShowEpisode* episode)
 }
 
 /**
- * \brief Scans a dir for TV show files
+ * \brief Lists all TV show directories in a dir. Their contents are scanned later on.
  * \param path Directory to scan
  */
-void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents)
+void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QVector<mediaelch::DirectoryPath>& showDirs)
 {
     QDir dir(path.toString());
     QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
@@ -182,9 +208,7 @@ void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<Q
             continue;
         }
 
-        QVector<QStringList> tvShowContents;
-        scanTvShowDir(path, path.subDir(cDir), tvShowContents);
-        contents.insert((dir.path() + '/' + cDir), tvShowContents);
+        showDirs.append(mediaelch::DirectoryPath(dir.path() + '/' + cDir));
     }
 }
 
@@ -243,45 +267,24 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
             continue;
         }
         // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+        if (mediaelch::file::isTrailerOrSampleFile(file)) {
             continue;
         }
         files.append(file);
     }
     files.sort();
 
-    QRegularExpression rx("((?:part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
-    for (elch_size_t i = 0, n = files.size(); i < n; i++) {
+    const QVector<QStringList> stackedFiles =
+        mediaelch::file::groupStackedFiles(files, mediaelch::file::StackingPattern::Parts);
+    for (const QStringList& stack : stackedFiles) {
         if (m_aborted) {
             return;
         }
-
         QStringList tvShowFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
-        }
-
-        tvShowFiles << (path.toString() + '/' + file);
-
-        QRegularExpressionMatch match = rx.match(file);
-        elch_size_t pos = match.capturedStart(0);
-        if (pos != -1) {
-            QString left = file.left(pos) + match.captured(1);
-            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
-            for (int x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        tvShowFiles << (path.toString() + '/' + subFile);
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
-                    }
-                }
-            }
-        }
-        if (tvShowFiles.count() > 0) {
-            contents.append(tvShowFiles);
+        for (const QString& file : stack) {
+            tvShowFiles << (path.toString() + '/' + file);
         }
+        contents.append(tvShowFiles);
     }
 }
 
@@ -298,140 +301,12 @@ void TvShowFileSearcher::abort()
 
 SeasonNumber TvShowFileSearcher::getSeasonNumber(QStringList files)
 {
-    if (files.isEmpty()) {
-        return SeasonNumber::NoSeason;
-    }
-
-    QStringList filenameParts = files.at(0).split('/');
-    QString filename = filenameParts.last();
-    if (filename.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 1 && helper::isDvd(files.at(0))) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        } else if (filenameParts.count() > 2 && helper::isDvd(files.at(0), true)) {
-            filename = filenameParts.at(filenameParts.count() - 2);
-        }
-    } else if (filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 2) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        }
-    }
-
-    QRegularExpression rx(R"(S(\d+)[ ._-]?E)", QRegularExpression::CaseInsensitiveOption);
-    QRegularExpressionMatch match;
-
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    rx.setPattern("(\\d+)?x(\\d+)");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    rx.setPattern("(\\d+).(\\d){2,4}");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    rx.setPattern("Season[ ._]?(\\d+)[ ._]?Episode");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    // Default if no valid season could be parsed.
-    return SeasonNumber::SpecialsSeason;
+    return mediaelch::EpisodeNumberParser::instance().parse(files).season;
 }
 
 QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
 {
-    if (files.isEmpty()) {
-        return {};
-    }
-
-    QStringList filenameParts = files.at(0).split('/');
-    QString filename = filenameParts.last();
-    if (filename.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 1 && helper::isDvd(files.at(0))) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        } else if (filenameParts.count() > 2 && helper::isDvd(files.at(0), true)) {
-            filename = filenameParts.at(filenameParts.count() - 2);
-        }
-    } else if (filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 2) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        }
-    }
-
-
-    QVector<EpisodeNumber> episodes;
-
-    /// Scans a given filename for a given pattern.
-    /// If mayBeAmbiguous is true, we apply a heuristic to avoid matching the video's resolution
-    auto scanWithPattern = [&](const QString& pattern, bool mayBeAmbiguous) -> bool {
-        QRegularExpression rx(pattern, QRegularExpression::CaseInsensitiveOption);
-
-        QRegularExpressionMatchIterator matches = rx.globalMatch(filename);
-
-        elch_size_t lastMatchEnd = -1;
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            // if between the last match and this one are more than five characters: break
-            // this way we can try to filter "false matches" like in "21x04 - Hammond vs. 6x6.mp4"
-            if (mayBeAmbiguous && lastMatchEnd != -1 && lastMatchEnd < match.capturedStart(0) + 5) {
-                return true;
-            }
-            episodes << EpisodeNumber(match.captured(2).toInt());
-            lastMatchEnd = match.capturedEnd(0);
-        }
-
-        // Pattern matched
-        if (episodes.isEmpty()) {
-            return false;
-        }
-
-        // The one episode we found could actually be a multi-episode file.
-        // For example: S01E01E02
-        if (episodes.count() == 1) {
-            rx.setPattern(R"([-_EeXx]+([0-9]+)($|[\-\._\sE]))");
-
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-            matches = rx.globalMatch(
-                filename, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption);
-#else
-            matches = rx.globalMatch(
-                filename, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
-#endif
-
-            while (matches.hasNext()) {
-                episodes << EpisodeNumber(matches.next().captured(1).toInt());
-            }
-        }
-        return true;
-    };
-
-    struct EpisodeNumberPattern
-    {
-        QString regex;
-        bool mayBeAmbiguous = false;
-    };
-
-    QVector<EpisodeNumberPattern> patterns{{R"(S(\d+)[ ._-]?E(\d+))", false},
-        {R"(S(\d+)[ ._-]?EP(\d+))", false},
-        {R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))", false},
-        {R"((\d+)x(\d+))", true},
-        {R"((\d+).(\d){2,4})", true}};
-
-    for (const auto& pattern : patterns) {
-        if (scanWithPattern(pattern.regex, pattern.mayBeAmbiguous)) {
-            break;
-        }
-    }
-
-    return episodes;
+    return mediaelch::EpisodeNumberParser::instance().parse(files).episodes;
 }
 
 Database& TvShowFileSearcher::database()
@@ -457,7 +332,7 @@ void TvShowFileSearcher::clearOldTvShows(bool forceClear)
     }
 }
 
-void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum)
+void TvShowFileSearcher::setupShowsFromDatabase(const QVector<TvShow*>& dbShows, int& showCounter, int showSum)
 {
     for (TvShow* show : dbShows) {
         if (m_aborted) {
@@ -474,89 +349,115 @@ void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int e
             }
             episode->setShow(show);
             show->addEpisode(episode);
-            emit progress(++episodeCounter, episodeSum, m_progressMessageId);
-            if (episodeCounter % 1000 == 0) {
-                emit currentDir("");
-            }
         }
 
         Manager::instance()->tvShowModel()->appendShow(show);
+        emit progress(++showCounter, showSum, m_progressMessageId);
     }
 }
 
-void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum)
+void TvShowFileSearcher::setupShows(const QVector<mediaelch::DirectoryPath>& showDirs,
+    const QVector<TvShow*>& dbShows,
+    int& showCounter,
+    int showSum)
 {
-    QMapIterator<QString, QVector<QStringList>> it(contents);
-    while (it.hasNext()) {
-        it.next();
-        episodeSum += qsizetype_to_int(it.value().size());
+    LoadedShowQueue loadedShows;
+    QThreadPool pool;
+    // Scanning is mostly waiting for the disk, especially for network shares.
+    pool.setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(showDirs.size());
+    for (const mediaelch::DirectoryPath& showDir : showDirs) {
+        futures << QtConcurrent::run(&pool, [this, showDir, &loadedShows]() { //
+            loadedShows.push(loadShowFromDisk(showDir));
+        });
     }
-    it.toFront();
 
-    // Setup shows
-    while (it.hasNext()) {
-        if (m_aborted) {
-            return;
-        }
-
-        it.next();
+    // Shows from the database are set up while the others are still loaded from disk.
+    setupShowsFromDatabase(dbShows, showCounter, showSum);
 
-        // get path
-        mediaelch::DirectoryPath path;
-        elch_size_t index = -1;
-        for (elch_size_t i = 0, n = m_directories.count(); i < n; ++i) {
-            if (it.key().startsWith(m_directories[i].path.path())) {
-                if (index == -1) {
-                    index = i;
-                } else if (m_directories[index].path.path().length() < m_directories[i].path.path().length()) {
-                    index = i;
-                }
+    elch_size_t pendingShows = showDirs.size();
+    while (pendingShows > 0) {
+        const QVector<TvShow*> shows = loadedShows.takeAll(50);
+        pendingShows -= shows.size();
+        for (TvShow* show : shows) {
+            if (show == nullptr) {
+                continue;
             }
+            if (m_aborted) {
+                delete show;
+                continue;
+            }
+            addShowFromDisk(show);
+            emit progress(++showCounter, showSum, m_progressMessageId);
         }
-        if (index != -1) {
-            path = mediaelch::DirectoryPath(m_directories[index].path);
-        }
+        // Keep the UI responsive so that loaded shows are shown and loading can be aborted.
+        QApplication::processEvents();
+    }
+    // All shows were pushed, but tasks may not have returned yet.
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
 
-        auto* show = new TvShow(mediaelch::DirectoryPath(it.key()), this);
-        show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
-        emit currentDir(show->title());
-        database().add(show, path);
+    emit currentDir("");
+}
 
-        database().transaction();
-        QVector<TvShowEpisode*> episodes;
+TvShow* TvShowFileSearcher::loadShowFromDisk(const mediaelch::DirectoryPath& showDir)
+{
+    if (m_aborted) {
+        return nullptr;
+    }
 
-        // Setup episodes list
-        for (const QStringList& files : it.value()) {
-            SeasonNumber seasonNumber = getSeasonNumber(files);
-            QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-            for (const EpisodeNumber& episodeNumber : episodeNumbers) {
-                auto* episode = new TvShowEpisode(files, show);
-                episode->setSeason(seasonNumber);
-                episode->setEpisode(episodeNumber);
-                episodes.append(episode);
-            }
-        }
+    QVector<QStringList> contents;
+    scanTvShowDir(settingsDirectory(showDir), showDir, contents);
+    if (m_aborted) {
+        return nullptr;
+    }
 
-        // Load episodes data
-        QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
+    // No parent: The show is moved to the GUI thread once it is loaded.
+    auto* show = new TvShow(showDir, nullptr);
+    show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
 
-        // Add episodes to model
-        for (TvShowEpisode* episode : asConst(episodes)) {
-            database().add(episode, path, show->databaseId());
+    for (const QStringList& files : contents) {
+        const mediaelch::EpisodeFileNumbers numbers = mediaelch::EpisodeNumberParser::instance().parse(files);
+        for (const EpisodeNumber& episodeNumber : numbers.episodes) {
+            if (m_aborted) {
+                delete show;
+                return nullptr;
+            }
+            auto* episode = new TvShowEpisode(files, show);
+            episode->setSeason(numbers.season);
+            episode->setEpisode(episodeNumber);
+            reloadEpisodeData(episode);
             show->addEpisode(episode);
-            emit progress(++episodeCounter, episodeSum, m_progressMessageId);
         }
+    }
 
-        database().commit();
-        Manager::instance()->tvShowModel()->appendShow(show);
+    // Also moves all episodes.
+    show->moveToThread(QApplication::instance()->thread());
+    return show;
+}
+
+void TvShowFileSearcher::addShowFromDisk(TvShow* show)
+{
+    show->setParent(this);
+    emit currentDir(show->title());
+
+    const mediaelch::DirectoryPath path = settingsDirectory(show->dir());
+    database().transaction();
+    database().add(show, path);
+    for (TvShowEpisode* episode : show->episodes()) {
+        database().add(episode, path, show->databaseId());
     }
+    database().commit();
 
-    emit currentDir("");
+    Manager::instance()->tvShowModel()->appendShow(show);
 }
 
-QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool forceReload)
+QVector<mediaelch::DirectoryPath> TvShowFileSearcher::readTvShowDirectories(bool forceReload)
 {
-    QMap<QString, QVector<QStringList>> contents;
+    QVector<mediaelch::DirectoryPath> showDirs;
     for (const SettingsDir& dir : asConst(m_directories)) {
         if (m_aborted) {
             break;
@@ -566,7 +467,7 @@ QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool f
         }
         // Do we need to reload shows from disk?
         if (dir.autoReload || forceReload) {
-            getTvShows(mediaelch::DirectoryPath(dir.path), contents);
+            getTvShows(mediaelch::DirectoryPath(dir.path), showDirs);
             continue;
         }
         // TODO: Check if necessary?
@@ -574,13 +475,29 @@ QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool f
         // all shows regardless of forceReload.
         const int showsFromDatabase = database().showCount(mediaelch::DirectoryPath(dir.path));
         if (showsFromDatabase == 0) {
-            getTvShows(mediaelch::DirectoryPath(dir.path), contents);
+            getTvShows(mediaelch::DirectoryPath(dir.path), showDirs);
             continue;
         }
     }
-    return contents;
+    return showDirs;
 }
 
+mediaelch::DirectoryPath TvShowFileSearcher::settingsDirectory(const mediaelch::DirectoryPath& showDir) const
+{
+    // Settings directories may be nested; use the innermost one.
+    elch_size_t index = -1;
+    for (elch_size_t i = 0, n = m_directories.count(); i < n; ++i) {
+        if (showDir.toString().startsWith(m_directories[i].path.path())) {
+            if (index == -1 || m_directories[index].path.path().length() < m_directories[i].path.path().length()) {
+                index = i;
+            }
+        }
+    }
+    if (index == -1) {
+        return {};
+    }
+    return mediaelch::DirectoryPath(m_directories[index].path);
+}
 
 QVector<TvShow*> TvShowFileSearcher::getShowsFromDatabase(bool forceReload)
 {
@@ -5,6 +5,7 @@
 
 #include <QDir>
 #include <QObject>
+#include <atomic>
 
 class Database;
 
@@ -19,6 +20,9 @@ public:
     static TvShowEpisode* loadEpisodeData(TvShowEpisode* episode);
     static TvShowEpisode* reloadEpisodeData(TvShowEpisode* episode);
 
+    /// \brief Whether TV shows or episodes are currently (re-)loaded.
+    bool isRunning() const { return m_running; }
+
 public slots:
     void reload(bool force);
     void reloadEpisodes(const mediaelch::DirectoryPath& showDir);
@@ -33,20 +37,35 @@ signals:
 private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
-    void getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents);
+    bool m_running = false;
+    void getTvShows(const mediaelch::DirectoryPath& path, QVector<mediaelch::DirectoryPath>& showDirs);
     void scanTvShowDir(const mediaelch::DirectoryPath& startPath,
         const mediaelch::DirectoryPath& path,
         QVector<QStringList>& contents);
     QStringList getFiles(const mediaelch::DirectoryPath& path);
-    bool m_aborted;
+    /// \brief Set from the GUI thread, read by worker threads.
+    std::atomic<bool> m_aborted;
 
 private:
     Database& database();
 
     void clearOldTvShows(bool forceClear);
-    /// \brief Get a map of TV show paths and their respective files in the show folder.
-    QMap<QString, QVector<QStringList>> readTvShowContent(bool forceReload);
+    /// \brief Get the directories of all TV shows that have to be loaded from disk.
+    QVector<mediaelch::DirectoryPath> readTvShowDirectories(bool forceReload);
     QVector<TvShow*> getShowsFromDatabase(bool forceReload);
-    void setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum);
-    void setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum);
+    /// \brief Settings directory that the given show directory belongs to.
+    mediaelch::DirectoryPath settingsDirectory(const mediaelch::DirectoryPath& showDir) const;
+    /// \brief Loads the given shows from disk in a thread pool and adds them to the model as they finish.
+    /// \details Directory scanning, episode number parsing and NFO loading of multiple shows run in
+    ///          parallel while loaded shows are stored in the database in the GUI thread.
+    void setupShows(const QVector<mediaelch::DirectoryPath>& showDirs,
+        const QVector<TvShow*>& dbShows,
+        int& showCounter,
+        int showSum);
+    /// \brief Scans the show's directory and loads the show and its episodes. Thread safe.
+    /// \returns A show without parent that belongs to the GUI thread or nullptr if aborted.
+    TvShow* loadShowFromDisk(const mediaelch::DirectoryPath& showDir);
+    /// \brief Stores a show that was loaded from disk in the database and adds it to the model.
+    void addShowFromDisk(TvShow* show);
+    void setupShowsFromDatabase(const QVector<TvShow*>& dbShows, int& showCounter, int showSum);
 };
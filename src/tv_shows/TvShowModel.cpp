@@ -251,6 +251,7 @@ void TvShowModel::appendShow(TvShow* show)
             }
             seasonItems.value(episode->seasonNumber())->appendEpisode(episode);
         }
+        updateFilterIndex(*showItem);
     }
     endInsertRows();
 }
@@ -295,6 +296,12 @@ QModelIndex TvShowModel::parent(const QModelIndex& index) const
 bool TvShowModel::removeRows(int row, int count, const QModelIndex& parent)
 {
     beginRemoveRows(parent, row, row + count - 1);
+    const TvShowBaseModelItem& parentItem = getItem(parent);
+    for (int i = row; i < row + count; ++i) {
+        if (parentItem.child(i) != nullptr) {
+            removeFromFilterIndex(*parentItem.child(i));
+        }
+    }
     const bool success = getItem(parent).removeChildren(row, count);
     endRemoveRows();
 
@@ -320,20 +327,49 @@ void TvShowModel::clear()
     if (size > 0) {
         beginRemoveRows(QModelIndex(), 0, size - 1);
         m_rootItem.removeChildren(0, size);
+        m_filterIndex.clear();
         endRemoveRows();
     }
 }
 
+const mediaelch::FilterIndex& TvShowModel::filterIndex() const
+{
+    return m_filterIndex;
+}
+
+void TvShowModel::updateFilterIndex(const TvShowBaseModelItem& item)
+{
+    // Same text as Qt::DisplayRole
+    const QString text = helper::appendArticle(item.data(0).toString());
+    m_filterIndex.setText(&item, static_cast<int>(TvShowFilters::Title), text);
+    for (int i = 0, n = item.childCount(); i < n; ++i) {
+        updateFilterIndex(*item.child(i));
+    }
+}
+
+void TvShowModel::removeFromFilterIndex(const TvShowBaseModelItem& item)
+{
+    m_filterIndex.removeItem(&item);
+    for (int i = 0, n = item.childCount(); i < n; ++i) {
+        removeFromFilterIndex(*item.child(i));
+    }
+}
+
 void TvShowModel::onSigChanged(TvShowModelItem* showItem, SeasonModelItem* seasonItem, EpisodeModelItem* episodeItem)
 {
     const QModelIndex showIndex = index(showItem->indexInParent(), 0);
     const QModelIndex seasonIndex = index(seasonItem->indexInParent(), 0, showIndex);
     const QModelIndex modelIndex = index(episodeItem->indexInParent(), 0, seasonIndex);
+    updateFilterIndex(*episodeItem);
     emit dataChanged(modelIndex, modelIndex);
 }
 
 void TvShowModel::onShowChanged(TvShow* show)
 {
+    // Must be updated before proxy models sort the changed row again.
+    show->modelItem()->updateSortKeys();
+    // Includes seasons because their names may have changed.
+    updateFilterIndex(*show->modelItem());
     const QModelIndex modelIndex = index(show->modelItem()->indexInParent(), 0);
 
     // Season names may have changed
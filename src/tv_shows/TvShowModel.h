@@ -1,5 +1,6 @@
 #pragma once
 
+#include "globals/FilterIndex.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 #include "tv_shows/model/TvShowRootModelItem.h"
@@ -44,6 +45,10 @@ public:
     TvShowBaseModelItem& getItem(const QModelIndex& index);
     void clear();
 
+    /// \brief Index of the displayed texts of all shows, seasons and episodes, see TvShowProxyModel.
+    /// \details Items are stored with TvShowFilters::Title as field.
+    const mediaelch::FilterIndex& filterIndex() const;
+
     QVector<TvShow*> tvShows();
     int hasNewShowOrEpisode();
 
@@ -53,9 +58,13 @@ private slots:
 
 private:
     TvShowModelItem* findModelForShow(TvShow* show);
+    /// \brief Updates the filter index for the given item and all its children.
+    void updateFilterIndex(const TvShowBaseModelItem& item);
+    void removeFromFilterIndex(const TvShowBaseModelItem& item);
 
 private:
     TvShowRootModelItem m_rootItem;
+    mediaelch::FilterIndex m_filterIndex;
 
     QMap<int, QMap<bool, QIcon>> m_icons;
     QIcon m_newIcon;
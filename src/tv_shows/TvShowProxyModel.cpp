@@ -1,9 +1,11 @@
 #include "TvShowProxyModel.h"
 
+#include "globals/FilterIndex.h"
 #include "globals/Globals.h"
 #include "globals/Manager.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
+#include "tv_shows/model/TvShowModelItem.h"
 
 TvShowProxyModel::TvShowProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
@@ -51,7 +53,20 @@ bool TvShowProxyModel::filterAcceptsRow(int source_row, const QModelIndex& sourc
 
 bool TvShowProxyModel::filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const
 {
-    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    if (m_needle.isEmpty()) {
+        return true;
+    }
+    auto* model = dynamic_cast<TvShowModel*>(sourceModel());
+    if (model == nullptr) {
+        return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    }
+    // Use the model's precomputed texts instead of data() and the wildcard.
+    const TvShowBaseModelItem& item = model->getItem(model->index(sourceRow, 0, sourceParent));
+    const mediaelch::FilterIndex& filterIndex = model->filterIndex();
+    if (!filterIndex.containsItem(&item)) {
+        return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    }
+    return filterIndex.text(&item, static_cast<int>(TvShowFilters::Title)).contains(m_needle);
 }
 
 bool TvShowProxyModel::hasAcceptedChildren(int source_row, const QModelIndex& source_parent) const
@@ -83,31 +98,33 @@ bool TvShowProxyModel::hasAcceptedChildren(int source_row, const QModelIndex& so
 }
 
 /// \brief Sort function for the TV show model. Sorts TV shows by name.
+/// \details TV shows are sorted using sort keys precomputed by their model items instead of data().
 bool TvShowProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
     auto* model = dynamic_cast<TvShowModel*>(sourceModel());
     TvShowBaseModelItem& leftItem = model->getItem(left);
     TvShowBaseModelItem& rightItem = model->getItem(right);
 
-    if (leftItem.type() == rightItem.type() && leftItem.type() == TvShowType::Season) {
-        // todo: remove dynamic cast
-        return dynamic_cast<SeasonModelItem*>(&leftItem)->seasonNumber()
-               < dynamic_cast<SeasonModelItem*>(&rightItem)->seasonNumber();
-    }
-
-    if (leftItem.type() == rightItem.type() && leftItem.type() == TvShowType::Episode) {
-        return dynamic_cast<EpisodeModelItem*>(&leftItem)->tvShowEpisode()->episodeNumber()
-               < dynamic_cast<EpisodeModelItem*>(&rightItem)->tvShowEpisode()->episodeNumber();
-    }
-
-    if (leftItem.type() == rightItem.type() && leftItem.type() == TvShowType::TvShow) {
-        bool leftNew = !leftItem.tvShow()->infoLoaded() || leftItem.tvShow()->hasNewEpisodes();
-        bool rightNew = !rightItem.tvShow()->infoLoaded() || rightItem.tvShow()->hasNewEpisodes();
-        if (leftNew && !rightNew) {
-            return true;
+    if (leftItem.type() == rightItem.type()) {
+        switch (leftItem.type()) {
+        case TvShowType::Season:
+            return static_cast<SeasonModelItem&>(leftItem).seasonNumber()
+                   < static_cast<SeasonModelItem&>(rightItem).seasonNumber();
+
+        case TvShowType::Episode:
+            return static_cast<EpisodeModelItem&>(leftItem).tvShowEpisode()->episodeNumber()
+                   < static_cast<EpisodeModelItem&>(rightItem).tvShowEpisode()->episodeNumber();
+
+        case TvShowType::TvShow: {
+            const auto& leftShow = static_cast<TvShowModelItem&>(leftItem);
+            const auto& rightShow = static_cast<TvShowModelItem&>(rightItem);
+            if (leftShow.isNewForSorting() != rightShow.isNewForSorting()) {
+                return leftShow.isNewForSorting();
+            }
+            return leftShow.titleSortKey() < rightShow.titleSortKey();
         }
-        if (!leftNew && rightNew) {
-            return false;
+
+        case TvShowType::None: break;
         }
     }
 
@@ -119,4 +136,6 @@ void TvShowProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = std::move(filters);
     m_filterText = std::move(text);
+    const QString filterText = m_filters.isEmpty() ? m_filterText : m_filters.first()->shortText();
+    m_needle = mediaelch::FilterIndex::folded(filterText);
 }
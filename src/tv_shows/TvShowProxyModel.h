@@ -10,6 +10,8 @@ class TvShowProxyModel : public QSortFilterProxyModel
 
 public:
     explicit TvShowProxyModel(QObject* parent = nullptr);
+    /// \brief Sets the filters. Only the text of the first filter or the given text is used.
+    /// \details Does not invalidate the filter, which is done by setFilterWildcard().
     void setFilter(QVector<Filter*> filters, QString text);
 
 protected:
@@ -21,4 +23,6 @@ protected:
 private:
     QVector<Filter*> m_filters;
     QString m_filterText;
+    /// \brief Case folded text that shows, seasons or episodes must contain.
+    QString m_needle;
 };
@@ -4,6 +4,7 @@
 #include <QStringList>
 
 #include "globals/Globals.h"
+#include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
@@ -98,10 +99,34 @@ const QList<SeasonModelItem*>& TvShowModelItem::seasons() const
 void TvShowModelItem::setTvShow(TvShow* show)
 {
     m_tvShow = show;
+    updateSortKeys();
+}
+
+const mediaelch::LocaleSortKey& TvShowModelItem::titleSortKey() const
+{
+    return m_titleSortKey;
+}
+
+bool TvShowModelItem::isNewForSorting() const
+{
+    return m_isNewForSorting;
+}
+
+void TvShowModelItem::updateSortKeys()
+{
+    if (m_tvShow == nullptr) {
+        m_titleSortKey = {};
+        m_isNewForSorting = false;
+        return;
+    }
+    m_titleSortKey = mediaelch::LocaleSortKey(helper::appendArticle(m_tvShow->title()));
+    m_isNewForSorting = !m_tvShow->infoLoaded() || m_tvShow->hasNewEpisodes();
 }
 
 void TvShowModelItem::onEpisodeChanged(SeasonModelItem* seasonItem, EpisodeModelItem* episodeItem)
 {
+    // The episode's info may have been loaded.
+    updateSortKeys();
     emit sigChanged(this, seasonItem, episodeItem);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "globals/Globals.h"
+#include "globals/LocaleSortKey.h"
 #include "tv_shows/SeasonNumber.h"
 #include "tv_shows/model/TvShowBaseModelItem.h"
 
@@ -62,6 +63,13 @@ public:
 
     void setTvShow(TvShow* show);
 
+    /// \brief Precomputed key of the displayed title, used by TvShowProxyModel.
+    const mediaelch::LocaleSortKey& titleSortKey() const;
+    /// \brief Whether the show's or any episode's info is not loaded, precomputed for TvShowProxyModel.
+    bool isNewForSorting() const;
+    /// \brief Updates the precomputed sort keys. Must be called when the show or one of its episodes changed.
+    void updateSortKeys();
+
 signals:
     void sigChanged(TvShowModelItem*, SeasonModelItem*, EpisodeModelItem*);
 
@@ -73,4 +81,6 @@ private:
 
     TvShowRootModelItem& m_parentItem;
     TvShow* m_tvShow = nullptr;
+    mediaelch::LocaleSortKey m_titleSortKey;
+    bool m_isNewForSorting = false;
 };
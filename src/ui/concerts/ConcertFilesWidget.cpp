@@ -253,7 +253,6 @@ void ConcertFilesWidget::concertSelectedEmitter()
 void ConcertFilesWidget::setFilter(QVector<Filter*> filters, QString text)
 {
     m_concertProxyModel->setFilter(filters, text);
-    m_concertProxyModel->setFilterWildcard("*" + text + "*");
     setAlphaListData();
 }
 
@@ -5,11 +5,28 @@
 #include "globals/Meta.h"
 #include "settings/Settings.h"
 
+#include <QApplication>
 #include <QDateTime>
 #include <QElapsedTimer>
 #include <QFile>
 #include <QFileDialog>
 #include <QRegularExpression>
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace {
+
+class ExportTask : public QRunnable
+{
+public:
+    explicit ExportTask(std::function<void()> task) : m_task{std::move(task)} {}
+    void run() override { m_task(); }
+
+private:
+    std::function<void()> m_task;
+};
+
+} // namespace
 
 CsvExportDialog::CsvExportDialog(Settings& settings, QWidget* parent) :
     QDialog(parent), ui(new Ui::CsvExportDialog), m_settings{settings}
@@ -85,12 +102,26 @@ int CsvExportDialog::exec()
     return QDialog::exec();
 }
 
+void CsvExportDialog::reject()
+{
+    // Stops a running export.
+    m_canceled = true;
+    QDialog::reject();
+}
+
 void CsvExportDialog::onExport()
 {
     using namespace mediaelch;
 
     m_shouldAbort = false;
+    m_canceled = false;
     ui->exportProgress->setValue(0);
+
+    if (Manager::instance()->isLoadingMedia()) {
+        ui->lblMessage->setErrorMessage(tr("Media is still being loaded. Please wait until loading has finished."));
+        return;
+    }
+
     ui->btnExport->setEnabled(false);
 
     // Get separator and replacement characters
@@ -117,111 +148,108 @@ void CsvExportDialog::onExport()
 
     QElapsedTimer timer;
     timer.start();
+    Manager::instance()->setExporting(true);
 
     QDir exportDir(location);
 
+    // Exports run in a worker thread. Everything that is read from the UI is read beforehand.
+    const auto setUp = [&](CsvMediaExport& exporter) {
+        exporter.setSeparator(separator);
+        exporter.setReplacement(replacement);
+        exporter.setCancelFlag(&m_canceled);
+    };
+
     // Movies ------------------------------------------
     if (!m_shouldAbort && ui->checkMovies->isChecked()) {
-        const QVector<Movie*>& movies = Manager::instance()->movieModel()->movies();
-
-        int processedCount = 0;
-        ui->exportProgress->setRange(0, qsizetype_to_int(movies.size()));
+        const QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
+        const auto fields = getFields<CsvMovieExport::Field>(ui->movieDetailsToExport);
         ui->lblMessage->setStatusMessage(tr("Export movies..."));
 
-        QFile file(exportFilePath(exportDir, "movies"));
-        openFileWithStream(file, [&](QTextStream& stream) {
-            // Export with a progress bar (even though it may be so fast that it's not noticable)
-            CsvMovieExport exporter(stream, getFields<CsvMovieExport::Field>(ui->movieDetailsToExport));
-            exporter.setSeparator(separator);
-            exporter.setReplacement(replacement);
-            exporter.exportMovies(movies, [&]() { ui->exportProgress->setValue(++processedCount); });
-        });
+        exportToFile(exportFilePath(exportDir, "movies"),
+            qsizetype_to_int(movies.size()),
+            [&](QTextStream& stream, std::function<void()> callback) {
+                CsvMovieExport exporter(stream, fields);
+                setUp(exporter);
+                exporter.exportMovies(movies, std::move(callback));
+            });
     }
     // TV shows ----------------------------------------
     if (!m_shouldAbort) {
-        const QVector<TvShow*>& tvShows = Manager::instance()->tvShowModel()->tvShows();
+        const QVector<TvShow*> tvShows = Manager::instance()->tvShowModel()->tvShows();
         if (ui->checkTvShows->isChecked()) {
-            int processedCount = 0;
-            ui->exportProgress->setRange(0, qsizetype_to_int(tvShows.size()));
+            const auto fields = getFields<CsvTvShowExport::Field>(ui->tvShowDetailsToExport);
             ui->lblMessage->setStatusMessage(tr("Export TV shows..."));
 
-            QFile showFile(exportFilePath(exportDir, "tv_shows"));
-            openFileWithStream(showFile, [&](QTextStream& stream) {
-                // Export with a progress bar (even though it may be so fast that it's not noticable)
-                CsvTvShowExport exporter(stream, getFields<CsvTvShowExport::Field>(ui->tvShowDetailsToExport));
-                exporter.setSeparator(separator);
-                exporter.setReplacement(replacement);
-                exporter.exportTvShows(tvShows, [&]() { ui->exportProgress->setValue(++processedCount); });
-            });
+            exportToFile(exportFilePath(exportDir, "tv_shows"),
+                qsizetype_to_int(tvShows.size()),
+                [&](QTextStream& stream, std::function<void()> callback) {
+                    CsvTvShowExport exporter(stream, fields);
+                    setUp(exporter);
+                    exporter.exportTvShows(tvShows, std::move(callback));
+                });
         }
-        if (ui->checkTvEpisodes->isChecked()) {
-            int processedCount = 0;
-            ui->exportProgress->setRange(0, qsizetype_to_int(tvShows.size()));
+        if (!m_shouldAbort && ui->checkTvEpisodes->isChecked()) {
+            const auto fields = getFields<CsvTvEpisodeExport::Field>(ui->tvEpisodeDetailsToExport);
             ui->lblMessage->setStatusMessage(tr("Export TV episodes..."));
 
-            QFile episodeFile(exportFilePath(exportDir, "tv_episodes"));
-            openFileWithStream(episodeFile, [&](QTextStream& stream) {
-                // Export with a progress bar (even though it may be so fast that it's not noticable)
-                CsvTvEpisodeExport exporter(stream, getFields<CsvTvEpisodeExport::Field>(ui->tvEpisodeDetailsToExport));
-                exporter.setSeparator(separator);
-                exporter.setReplacement(replacement);
-                exporter.exportEpisodes(tvShows, [&]() { ui->exportProgress->setValue(++processedCount); });
-            });
+            exportToFile(exportFilePath(exportDir, "tv_episodes"),
+                qsizetype_to_int(tvShows.size()),
+                [&](QTextStream& stream, std::function<void()> callback) {
+                    CsvTvEpisodeExport exporter(stream, fields);
+                    setUp(exporter);
+                    exporter.exportEpisodes(tvShows, std::move(callback));
+                });
         }
     }
     // Concerts ----------------------------------------
     if (!m_shouldAbort && ui->checkConcerts->isChecked()) {
-        const QVector<Concert*>& concerts = Manager::instance()->concertModel()->concerts();
-
-        int processedCount = 0;
-        ui->exportProgress->setRange(0, qsizetype_to_int(concerts.size()));
+        const QVector<Concert*> concerts = Manager::instance()->concertModel()->concerts();
+        const auto fields = getFields<CsvConcertExport::Field>(ui->concertDetailsToExport);
         ui->lblMessage->setStatusMessage(tr("Export concerts..."));
 
-        QFile episodeFile(exportFilePath(exportDir, "concerts"));
-        openFileWithStream(episodeFile, [&](QTextStream& stream) {
-            // Export with a progress bar (even though it may be so fast that it's not noticable)
-            CsvConcertExport exporter(stream, getFields<CsvConcertExport::Field>(ui->concertDetailsToExport));
-            exporter.setSeparator(separator);
-            exporter.setReplacement(replacement);
-            exporter.exportConcerts(concerts, [&]() { ui->exportProgress->setValue(++processedCount); });
-        });
+        exportToFile(exportFilePath(exportDir, "concerts"),
+            qsizetype_to_int(concerts.size()),
+            [&](QTextStream& stream, std::function<void()> callback) {
+                CsvConcertExport exporter(stream, fields);
+                setUp(exporter);
+                exporter.exportConcerts(concerts, std::move(callback));
+            });
     }
     // Music -------------------------------------------
     if (!m_shouldAbort) {
-        const QVector<Artist*>& artists = Manager::instance()->musicModel()->artists();
+        const QVector<Artist*> artists = Manager::instance()->musicModel()->artists();
         // Artists ----------------------------------------
         if (ui->checkMusicArtists->isChecked()) {
-            int processedCount = 0;
-            ui->exportProgress->setRange(0, qsizetype_to_int(artists.size()));
+            const auto fields = getFields<CsvArtistExport::Field>(ui->artistDetailsToExport);
             ui->lblMessage->setStatusMessage(tr("Export artists..."));
 
-            QFile episodeFile(exportFilePath(exportDir, "artists"));
-            openFileWithStream(episodeFile, [&](QTextStream& stream) {
-                // Export with a progress bar (even though it may be so fast that it's not noticable)
-                CsvArtistExport exporter(stream, getFields<CsvArtistExport::Field>(ui->artistDetailsToExport));
-                exporter.setSeparator(separator);
-                exporter.setReplacement(replacement);
-                exporter.exportArtists(artists, [&]() { ui->exportProgress->setValue(++processedCount); });
-            });
+            exportToFile(exportFilePath(exportDir, "artists"),
+                qsizetype_to_int(artists.size()),
+                [&](QTextStream& stream, std::function<void()> callback) {
+                    CsvArtistExport exporter(stream, fields);
+                    setUp(exporter);
+                    exporter.exportArtists(artists, std::move(callback));
+                });
         }
         // Albums ----------------------------------------
-        if (ui->checkMusicAlbums->isChecked()) {
-            int processedCount = 0;
-            ui->exportProgress->setRange(0, qsizetype_to_int(artists.size()));
+        if (!m_shouldAbort && ui->checkMusicAlbums->isChecked()) {
+            const auto fields = getFields<CsvAlbumExport::Field>(ui->albumDetailsToExport);
             ui->lblMessage->setStatusMessage(tr("Export albums..."));
 
-            QFile episodeFile(exportFilePath(exportDir, "albums"));
-            openFileWithStream(episodeFile, [&](QTextStream& stream) {
-                // Export with a progress bar (even though it may be so fast that it's not noticable)
-                CsvAlbumExport exporter(stream, getFields<CsvAlbumExport::Field>(ui->albumDetailsToExport));
-                exporter.setSeparator(separator);
-                exporter.setReplacement(replacement);
-                exporter.exportAlbumsOfArtists(artists, [&]() { ui->exportProgress->setValue(++processedCount); });
-            });
+            exportToFile(exportFilePath(exportDir, "albums"),
+                qsizetype_to_int(artists.size()),
+                [&](QTextStream& stream, std::function<void()> callback) {
+                    CsvAlbumExport exporter(stream, fields);
+                    setUp(exporter);
+                    exporter.exportAlbumsOfArtists(artists, std::move(callback));
+                });
         }
     }
     // ------------------------------------------
-    if (!m_shouldAbort) {
+    Manager::instance()->setExporting(false);
+    if (m_canceled) {
+        qCInfo(generic) << "[CsvExport] Canceled";
+    } else if (!m_shouldAbort) {
         QString secondsElapsed = QString::number(static_cast<double>(timer.elapsed()) / 1000.0);
         ui->lblMessage->setSuccessMessage(tr("Export completed in %1 seconds.").arg(secondsElapsed));
         qCInfo(generic) << "[CsvExport] Finished successfully in" << secondsElapsed << "seconds";
@@ -525,6 +553,50 @@ void CsvExportDialog::loadSettings()
     }
 }
 
+void CsvExportDialog::exportToFile(const QString& filePath,
+    int itemCount,
+    const std::function<void(QTextStream&, std::function<void()>)>& exportItems)
+{
+    QFile file(filePath);
+    bool isOpen = openFileOrPrintError(file);
+    if (!isOpen) {
+        return;
+    }
+    QTextStream out(&file);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    // Default in Qt6
+    out.setCodec("UTF-8");
+#endif
+    // UTF-8 BOM required for e.g. Excel
+    out.setGenerateByteOrderMark(true);
+
+    // Rows are written directly into the stream, which flushes them to the file
+    // in chunks. Only the progress is shared with the GUI thread.
+    std::atomic_int processedCount{0};
+    QThreadPool pool;
+    pool.start(new ExportTask([&]() {
+        exportItems(out, [&processedCount]() { ++processedCount; });
+        // flush before closing the file or the data won't be written
+        out.flush();
+    }));
+
+    ui->exportProgress->setRange(0, itemCount);
+    while (!pool.waitForDone(50)) {
+        ui->exportProgress->setValue(processedCount.load());
+        QApplication::processEvents();
+    }
+    ui->exportProgress->setValue(processedCount.load());
+    file.close();
+
+    if (m_canceled) {
+        // Don't leave incomplete files behind.
+        file.remove();
+        m_shouldAbort = true;
+        return;
+    }
+    m_shouldAbort = !checkTextStreamStatus(out);
+}
+
 bool CsvExportDialog::openFileOrPrintError(QFile& file)
 {
     if (!file.open(QFile::WriteOnly | QFile::Text)) {
@@ -6,6 +6,8 @@
 #include <QDir>
 #include <QListWidget>
 #include <QListWidgetItem>
+#include <atomic>
+#include <functional>
 
 namespace Ui {
 class CsvExportDialog;
@@ -23,6 +25,7 @@ public:
 
 public slots:
     int exec() override;
+    void reject() override;
 
 private slots:
     void onExport();
@@ -63,26 +66,12 @@ private:
         return fields;
     }
 
-    template<typename T>
-    void openFileWithStream(QFile& file, T callback)
-    {
-        bool isOpen = openFileOrPrintError(file);
-        if (!isOpen) {
-            return;
-        }
-        QTextStream out(&file);
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-        // Default in Qt6
-        out.setCodec("UTF-8");
-#endif
-        // UTF-8 BOM required for e.g. Excel
-        out.setGenerateByteOrderMark(true);
-        callback(out);
-        // flush before closing the file or the data won't be written
-        out.flush();
-        file.close();
-        m_shouldAbort = !checkTextStreamStatus(out);
-    }
+    /// \brief Writes a CSV file in a worker thread and updates the progress bar while waiting.
+    /// \param exportItems Called in the worker thread. Has to call its second argument after each
+    ///                    exported item so that the progress can be reported.
+    void exportToFile(const QString& filePath,
+        int itemCount,
+        const std::function<void(QTextStream&, std::function<void()>)>& exportItems);
 
     bool openFileOrPrintError(QFile& file);
     bool checkTextStreamStatus(QTextStream& stream);
@@ -94,4 +83,5 @@ private:
     Ui::CsvExportDialog* ui;
     Settings& m_settings;
     bool m_shouldAbort = false;
+    std::atomic_bool m_canceled{false};
 };
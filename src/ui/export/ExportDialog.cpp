@@ -59,6 +59,11 @@ void ExportDialog::onBtnExport()
         return;
     }
 
+    if (Manager::instance()->isLoadingMedia()) {
+        ui->message->setErrorMessage(tr("Media is still being loaded. Please wait until loading has finished."));
+        return;
+    }
+
     ExportTemplate* exportTemplate = ExportTemplateLoader::instance()->getTemplateByIdentifier(themeName());
     if (exportTemplate == nullptr) {
         warnAboutInvalidTheme();
@@ -87,7 +92,9 @@ void ExportDialog::onBtnExport()
     ui->btnExport->setEnabled(false);
     ui->progressBar->setRange(0, libraryItemCount(sections));
 
+    Manager::instance()->setExporting(true);
     exporter.doExport(*exportTemplate, location + "/" + subDir, sections);
+    Manager::instance()->setExporting(false);
 
     ui->progressBar->setValue(ui->progressBar->maximum());
 
@@ -111,6 +118,11 @@ void ExportDialog::onThemeChanged()
 {
     resetProgress();
 
+    if (Manager::instance()->isLoadingMedia()) {
+        ui->message->setErrorMessage(tr("Media is still being loaded. Please wait until loading has finished."));
+        return;
+    }
+
     ExportTemplate* exportTemplate = ExportTemplateLoader::instance()->getTemplateByIdentifier(themeName());
     if (exportTemplate == nullptr) {
         warnAboutInvalidTheme();
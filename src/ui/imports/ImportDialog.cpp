@@ -31,8 +31,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     loadingMovie->start();
     ui->loading->setMovie(loadingMovie);
 
-    m_timer.setInterval(500);
-
     m_posterDownloadManager = new DownloadManager(this);
     connect(m_posterDownloadManager,
         &DownloadManager::sigDownloadFinished,
@@ -44,7 +42,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     connect(ui->concertSearchWidget, &ConcertSearchWidget::sigResultClicked, this, &ImportDialog::onConcertChosen);
     connect(ui->tvShowSearchWidget, &TvShowSearchWidget::sigResultClicked, this, &ImportDialog::onTvShowChosen);
     connect(ui->btnImport, &QAbstractButton::clicked, this, &ImportDialog::onImport);
-    connect(&m_timer, &QTimer::timeout, this, &ImportDialog::onFileWatcherTimeout);
 }
 
 ImportDialog::~ImportDialog()
@@ -415,6 +412,7 @@ void ImportDialog::onEpisodeLoadDone(TvShowEpisode* episode)
     Q_UNUSED(episode)
     if (!m_episode->thumbnail().isEmpty()) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowEpisodeThumb;
         d.url = m_episode->thumbnail();
         d.episode = m_episode;
@@ -612,6 +610,7 @@ void ImportDialog::onImport()
     ui->btnReject->setEnabled(false);
     m_worker = new FileWorker();
     m_worker->setFiles(m_filesToMove);
+    m_worker->setVerifyChecksums(Settings::instance()->advanced()->verifyImportedFiles());
     m_workerThread = new QThread(this);
     if (ui->chkKeepSourceFiles->isChecked()) {
         connect(m_workerThread.data(), &QThread::started, m_worker.data(), &FileWorker::copyFiles);
@@ -622,39 +621,22 @@ void ImportDialog::onImport()
     connect(m_workerThread.data(), &QThread::finished, m_workerThread.data(), &QObject::deleteLater);
     connect(m_worker.data(), &FileWorker::sigFinished, m_workerThread.data(), &QThread::quit);
     connect(m_worker.data(), &FileWorker::sigFinished, this, &ImportDialog::onMovingFilesFinished);
+    connect(m_worker.data(), &FileWorker::sigProgress, this, &ImportDialog::onImportProgress);
     m_worker->moveToThread(m_workerThread);
     m_workerThread->start();
-    m_timer.start();
 }
 
-void ImportDialog::onFileWatcherTimeout()
+void ImportDialog::onImportProgress(qint64 bytesDone, qint64 bytesTotal)
 {
-    qint64 sourceSize = 0;
-    qint64 destinationSize = 0;
-    QMapIterator<QString, QString> it(m_filesToMove);
-    while (it.hasNext()) {
-        it.next();
-        QFileInfo sourceFi(it.key());
-        sourceSize += sourceFi.size();
-
-        QFileInfo destFi(it.value());
-        if (!destFi.exists()) {
-            continue;
-        }
-        destinationSize += destFi.size();
-    }
-
-    if (sourceSize == 0) {
+    if (bytesTotal <= 0) {
         return;
     }
-
-    ui->progressBar->setValue(qRound(static_cast<float>(destinationSize) * 100.0f / static_cast<float>(sourceSize)));
+    ui->progressBar->setValue(static_cast<int>(bytesDone * 100 / bytesTotal));
 }
 
 void ImportDialog::onMovingFilesFinished()
 {
     ui->progressBar->setValue(100);
-    m_timer.stop();
     if (m_type == "movie") {
         m_movie->setFiles(m_newFiles);
         m_movie->setInSeparateFolder(m_separateFolders);
@@ -50,7 +50,12 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
     connect(manager->musicFileSearcher(),   &MusicFileSearcher::searchStarted,   ui->status, &QLabel::setText);
     // clang-format on
 
+    // Searchers may also be started in the background, e.g. by the library watcher.
+    // Only continue with the next scanner if the dialog started the scan.
     connect(manager->movieFileSearcher(), &MovieFileSearcher::finished, this, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
@@ -58,6 +63,9 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
         }
     });
     connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, this, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
@@ -65,13 +73,20 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
         }
     });
     connect(manager->concertFileSearcher(), &ConcertFileSearcher::concertsLoaded, this, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
             onStartMusicScanner();
         }
     });
-    connect(manager->musicFileSearcher(), &MusicFileSearcher::musicLoaded, this, &FileScannerDialog::accept);
+    connect(manager->musicFileSearcher(), &MusicFileSearcher::musicLoaded, this, [this]() {
+        if (isVisible()) {
+            accept();
+        }
+    });
 }
 
 /**
@@ -25,6 +25,7 @@
 #include "ui/notifications/NotificationBox.h"
 #include "ui/notifications/Notificator.h"
 
+#include <QApplication>
 #include <QCheckBox>
 #include <QDesktopServices>
 #include <QDir>
@@ -33,6 +34,7 @@
 #include <QShortcut>
 #include <QTimer>
 #include <QToolBar>
+#include <algorithm>
 
 #ifdef Q_OS_MAC
 #    include <QMenuBar>
@@ -264,6 +266,8 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     // Start scanning for files
     QTimer::singleShot(0, m_fileScannerDialog, &FileScannerDialog::exec);
 
+    setupLibraryWatcher();
+
 #ifdef MEDIAELCH_UPDATER
     if (Settings::instance()->checkForUpdates()) {
         qCInfo(generic) << "Searching for updates";
@@ -718,6 +722,136 @@ void MainWindow::onRenewModels()
     ui->tvShowFilesWidget->renewModel();
     ui->concertFilesWidget->renewModel();
     ui->downloadsWidget->scanDownloadFolders();
+    setupLibraryWatcher();
+}
+
+void MainWindow::setupLibraryWatcher()
+{
+    AdvancedSettings* advanced = Settings::instance()->advanced();
+    if (!advanced->libraryWatcherEnabled()) {
+        if (m_libraryWatcher != nullptr) {
+            m_libraryWatcher->deleteLater();
+            m_libraryWatcher = nullptr;
+        }
+        return;
+    }
+
+    if (m_libraryWatcher == nullptr) {
+        m_libraryWatcher = new mediaelch::LibraryWatcher(this);
+        connect(m_libraryWatcher,
+            &mediaelch::LibraryWatcher::directoriesChanged,
+            this,
+            &MainWindow::onLibraryDirectoriesChanged);
+    }
+
+    const DirectorySettings& dirSettings = Settings::instance()->directorySettings();
+    m_libraryWatcher->setDelay(advanced->libraryWatcherDelay() * 1000);
+    m_libraryWatcher->setMaxWatchedDirectories(advanced->libraryWatcherMaxDirectories());
+    m_libraryWatcher->setDirectories(SettingsDirType::Movies, dirSettings.movieDirectories());
+    m_libraryWatcher->setDirectories(SettingsDirType::TvShows, dirSettings.tvShowDirectories());
+    m_libraryWatcher->setDirectories(SettingsDirType::Concerts, dirSettings.concertDirectories());
+    m_libraryWatcher->setDirectories(SettingsDirType::Music, dirSettings.musicDirectories());
+    m_libraryWatcher->rewatch();
+}
+
+bool MainWindow::hasUnsavedChanges(SettingsDirType type) const
+{
+    auto* manager = Manager::instance();
+    switch (type) {
+    case SettingsDirType::Movies: {
+        const QVector<Movie*> movies = manager->movieModel()->movies();
+        return std::any_of(movies.cbegin(), movies.cend(), [](Movie* movie) { return movie->hasChanged(); });
+    }
+    case SettingsDirType::TvShows: {
+        const QVector<TvShow*> shows = manager->tvShowModel()->tvShows();
+        return std::any_of(shows.cbegin(), shows.cend(), [](TvShow* show) {
+            const auto& episodes = show->episodes();
+            return show->hasChanged()
+                   || std::any_of(episodes.cbegin(), episodes.cend(), [](TvShowEpisode* episode) {
+                          return episode->hasChanged();
+                      });
+        });
+    }
+    case SettingsDirType::Concerts: {
+        const QVector<Concert*> concerts = manager->concertModel()->concerts();
+        return std::any_of(concerts.cbegin(), concerts.cend(), [](Concert* concert) { return concert->hasChanged(); });
+    }
+    case SettingsDirType::Music: {
+        const QVector<Artist*> artists = manager->musicModel()->artists();
+        return std::any_of(artists.cbegin(), artists.cend(), [](Artist* artist) {
+            const QVector<Album*> albums = artist->albums();
+            return artist->hasChanged()
+                   || std::any_of(albums.cbegin(), albums.cend(), [](Album* album) { return album->hasChanged(); });
+        });
+    }
+    case SettingsDirType::Downloads: return false;
+    }
+    return false;
+}
+
+void MainWindow::onLibraryDirectoriesChanged(SettingsDirType type, QVector<mediaelch::DirectoryPath> directories)
+{
+    using namespace mediaelch;
+    auto* manager = Manager::instance();
+
+    // Never interfere with a running scan or discard the user's changes.
+    // Scans and exports process events while worker threads still read the
+    // loaded items, so a reload must not delete them while they are running.
+    // The directories are reloaded once that is possible.
+    const bool isBusy = m_fileScannerDialog->isVisible() || QApplication::activeModalWidget() != nullptr
+                        || manager->isLoadingMedia() || manager->isExporting();
+    if (isBusy || hasUnsavedChanges(type)) {
+        qCDebug(generic) << "[MainWindow] Postponing reload of changed directories";
+        m_libraryWatcher->postpone(type, directories);
+        return;
+    }
+
+    const DirectorySettings& dirSettings = Settings::instance()->directorySettings();
+
+    switch (type) {
+    case SettingsDirType::Movies: {
+        QVector<DirectoryPath> roots;
+        for (const SettingsDir& dir : dirSettings.movieDirectories()) {
+            const DirectoryPath root(dir.path.path());
+            const bool changed = std::any_of(directories.cbegin(),
+                directories.cend(),
+                [&root](const DirectoryPath& changedDir) { return root.isParentFolderOf(changedDir); });
+            if (changed && !roots.contains(root)) {
+                roots << root;
+            }
+        }
+        manager->movieFileSearcher()->reloadIncrementally(roots);
+        break;
+    }
+    case SettingsDirType::TvShows: {
+        // Only show directories are of interest; files directly inside
+        // a TV show media directory don't belong to any show.
+        QVector<DirectoryPath> showDirs;
+        for (const DirectoryPath& changedDir : asConst(directories)) {
+            const bool isRoot =
+                std::any_of(dirSettings.tvShowDirectories().cbegin(),
+                    dirSettings.tvShowDirectories().cend(),
+                    [&changedDir](const SettingsDir& dir) { return DirectoryPath(dir.path.path()) == changedDir; });
+            if (!isRoot) {
+                showDirs << changedDir;
+            }
+        }
+        if (!showDirs.isEmpty()) {
+            ui->tvShowFilesWidget->reloadShowDirectories(showDirs);
+        }
+        break;
+    }
+    case SettingsDirType::Concerts:
+        // Concerts and music don't support partial reloads, yet.
+        manager->concertModel()->clear();
+        manager->concertFileSearcher()->reload(true);
+        break;
+    case SettingsDirType::Music:
+        manager->musicModel()->clear();
+        manager->musicFileSearcher()->reload(true);
+        break;
+    case SettingsDirType::Downloads: break;
+    }
 }
 
 void MainWindow::onJumpToMovie(Movie* movie)
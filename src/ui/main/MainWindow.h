@@ -7,6 +7,7 @@
 
 #include "globals/Filter.h"
 #include "globals/Globals.h"
+#include "globals/LibraryWatcher.h"
 #include "renamer/RenamerDialog.h"
 #include "settings/Settings.h"
 #include "ui/export/ExportDialog.h"
@@ -67,11 +68,17 @@ private slots:
     void onJumpToMovie(Movie* movie);
     void updateTvShows();
     void onCommandBarOpen();
+    /// \brief Reloads directories that were changed on disk. See LibraryWatcher.
+    void onLibraryDirectoriesChanged(SettingsDirType type, QVector<mediaelch::DirectoryPath> directories);
 
 private:
     MainWidgets currentTab() const;
     void setupToolbar();
     void setIcons(QToolButton* button);
+    /// \brief (Re)creates the library watcher if it is enabled in the advanced settings.
+    void setupLibraryWatcher();
+    /// \brief Whether any item of the given type has unsaved changes that a reload would discard.
+    bool hasUnsavedChanges(SettingsDirType type) const;
 
 private:
     Ui::MainWindow* ui = nullptr;
@@ -81,6 +88,7 @@ private:
     FileScannerDialog* m_fileScannerDialog = nullptr;
     KodiSync* m_xbmcSync = nullptr;
     RenamerDialog* m_renamer = nullptr;
+    mediaelch::LibraryWatcher* m_libraryWatcher = nullptr;
     QAction* m_actionSearch = nullptr;
     QAction* m_actionSave = nullptr;
     QAction* m_actionXbmc = nullptr;
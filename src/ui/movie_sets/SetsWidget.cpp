@@ -383,6 +383,7 @@ void SetsWidget::chooseSetPoster()
 
     if (exitCode == QDialog::Accepted) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.movie = movie;
         d.imageType = ImageType::MovieSetPoster;
         d.url = imageUrl;
@@ -417,6 +418,7 @@ void SetsWidget::chooseSetBackdrop()
 
     if (exitCode == QDialog::Accepted) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.movie = movie;
         d.imageType = ImageType::MovieSetBackdrop;
         d.url = imageUrl;
@@ -12,6 +12,8 @@
 
 #include <QDesktopServices>
 #include <QMenu>
+#include <QSet>
+#include <algorithm>
 
 MovieDuplicates::MovieDuplicates(QWidget* parent) : QWidget(parent), ui(new Ui::MovieDuplicates)
 {
@@ -49,11 +51,16 @@ MovieDuplicates::MovieDuplicates(QWidget* parent) : QWidget(parent), ui(new Ui::
 
     createContextMenu();
 
+    m_finder = new mediaelch::MovieDuplicateFinder(this);
+
     // clang-format off
     connect(ui->movies,                   &MyTableView::doubleClicked,          this, &MovieDuplicates::onJumpToMovie);
     connect(ui->btnDetect,                &QPushButton::clicked,                this, &MovieDuplicates::detectDuplicates);
     connect(ui->movies->selectionModel(), &QItemSelectionModel::currentChanged, this, &MovieDuplicates::onItemActivated);
     // clang-format on
+
+    connect(m_finder, &mediaelch::MovieDuplicateFinder::sigProgress, this, &MovieDuplicates::onDetectionProgress);
+    connect(m_finder, &mediaelch::MovieDuplicateFinder::sigFinished, this, &MovieDuplicates::onDetectionFinished);
 }
 
 MovieDuplicates::~MovieDuplicates()
@@ -64,38 +71,55 @@ MovieDuplicates::~MovieDuplicates()
 
 void MovieDuplicates::detectDuplicates()
 {
+    if (m_finder->isRunning()) {
+        return;
+    }
     qCDebug(generic) << "Detecting duplicates";
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
     m_duplicateMovies.clear();
 
-    int counter = 0;
-    int movieCount = qsizetype_to_int(Manager::instance()->movieModel()->movies().count());
+    const QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
+    for (Movie* movie : movies) {
+        movie->setHasDuplicates(false);
+    }
+
+    ui->btnDetect->setEnabled(false);
+    ui->chkSimilarTitles->setEnabled(false);
     NotificationBox::instance()->showProgressBar(
         tr("Detecting duplicate movies..."), Constants::MovieDuplicatesProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, movieCount, Constants::MovieDuplicatesProgressMessageId);
+    NotificationBox::instance()->progressBarProgress(
+        0, qsizetype_to_int(movies.count()), Constants::MovieDuplicatesProgressMessageId);
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        ++counter;
-        QApplication::processEvents();
+    m_finder->start(movies, ui->chkSimilarTitles->isChecked());
+}
 
-        NotificationBox::instance()->progressBarProgress(
-            counter, movieCount, Constants::MovieDuplicatesProgressMessageId);
-        movie->setHasDuplicates(false);
+void MovieDuplicates::onDetectionProgress(int processed, int total)
+{
+    NotificationBox::instance()->progressBarProgress(processed, total, Constants::MovieDuplicatesProgressMessageId);
+}
 
-        QVector<Movie*> dups{movie};
-        for (Movie* subMovie : Manager::instance()->movieModel()->movies()) {
-            if (movie != subMovie && subMovie->isDuplicate(movie)) {
-                dups.append(subMovie);
-            }
-        }
-        if (dups.count() > 1) {
-            m_duplicateMovies.insert(movie, dups);
-            movie->setHasDuplicates(true);
+void MovieDuplicates::onDetectionFinished(mediaelch::MovieDuplicateFinder::DuplicateMap duplicates)
+{
+    // Movies may have been reloaded while detecting duplicates in the background.
+    QSet<Movie*> currentMovies;
+    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+        currentMovies.insert(movie);
+    }
+
+    for (auto it = duplicates.cbegin(); it != duplicates.cend(); ++it) {
+        const bool isCurrent = std::all_of(it.value().cbegin(), it.value().cend(), [&currentMovies](Movie* movie) {
+            return currentMovies.contains(movie);
+        });
+        if (isCurrent) {
+            m_duplicateMovies.insert(it.key(), it.value());
+            it.key()->setHasDuplicates(true);
         }
     }
 
+    ui->btnDetect->setEnabled(true);
+    ui->chkSimilarTitles->setEnabled(true);
     NotificationBox::instance()->hideProgressBar(Constants::MovieDuplicatesProgressMessageId);
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "movies/MovieDuplicateFinder.h"
+
 #include <QMap>
 #include <QModelIndex>
 #include <QVector>
@@ -26,6 +28,8 @@ signals:
 
 private slots:
     void detectDuplicates();
+    void onDetectionProgress(int processed, int total);
+    void onDetectionFinished(mediaelch::MovieDuplicateFinder::DuplicateMap duplicates);
     void onItemActivated(QModelIndex /*index*/, QModelIndex /*previous*/);
 
     void showContextMenu(QPoint point);
@@ -41,6 +45,7 @@ private:
     Ui::MovieDuplicates* ui;
     MovieProxyModel* m_movieProxyModel;
     QMenu* m_contextMenu = nullptr;
+    mediaelch::MovieDuplicateFinder* m_finder = nullptr;
 
     QMap<Movie*, QVector<Movie*>> m_duplicateMovies;
 };
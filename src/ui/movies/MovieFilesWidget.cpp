@@ -342,7 +342,6 @@ void MovieFilesWidget::movieSelectedEmitter()
 void MovieFilesWidget::setFilter(QVector<Filter*> filters, QString text)
 {
     m_movieProxyModel->setFilter(filters, text);
-    m_movieProxyModel->setFilterWildcard("*" + text + "*");
     setAlphaListData();
     updateStatusLabel();
 }
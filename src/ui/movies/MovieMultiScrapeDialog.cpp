@@ -27,7 +27,6 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent
     ui->movieCounter->setFont(font);
 
     m_executed = false;
-    m_currentMovie = nullptr;
 
     ui->chkActors->setMyData(static_cast<int>(MovieScraperInfo::Actors));
     ui->chkBackdrop->setMyData(static_cast<int>(MovieScraperInfo::Backdrop));
@@ -68,6 +67,16 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent
         elchOverload<int>(&QComboBox::currentIndexChanged),
         this,
         &MovieMultiScrapeDialog::setCheckBoxesEnabled);
+
+    m_scrapeQueue = new mediaelch::scraper::MultiScrapeQueue(this);
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigStartItem,
+        this,
+        &MovieMultiScrapeDialog::onStartItem);
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigFinished,
+        this,
+        &MovieMultiScrapeDialog::onScrapingFinished);
 }
 
 MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
@@ -77,7 +86,7 @@ MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
 
 int MovieMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    abortRunningItems();
     ui->movieCounter->setVisible(false);
     ui->comboScraper->setEnabled(true);
     ui->btnCancel->setVisible(true);
@@ -90,7 +99,6 @@ int MovieMultiScrapeDialog::exec()
     ui->progressMovie->setValue(0);
     ui->groupBox->setEnabled(true);
     ui->movie->clear();
-    m_currentMovie = nullptr;
     m_executed = true;
     setCheckBoxesEnabled(ui->comboScraper->currentIndex());
     adjustSize();
@@ -112,10 +120,7 @@ void MovieMultiScrapeDialog::accept()
 void MovieMultiScrapeDialog::reject()
 {
     m_executed = false;
-    if (m_currentMovie != nullptr) {
-        m_queue.clear();
-        m_currentMovie->controller()->abortDownloads();
-    }
+    abortRunningItems();
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
     Settings::instance()->saveSettings();
@@ -147,12 +152,12 @@ void MovieMultiScrapeDialog::onStartScraping()
     m_isTmdb = m_scraperInterface->meta().identifier == TmdbMovie::ID;
     m_isImdb = m_scraperInterface->meta().identifier == ImdbMovie::ID;
 
-    m_queue.append(m_movies.toList());
+    m_scrapeQueue->setLimits(ScrapeLimits::forScraper(m_scraperInterface->meta().identifier));
 
-    ui->movieCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->movieCounter->setText(QString("0/%1").arg(m_movies.count()));
     ui->movieCounter->setVisible(true);
     ui->progressAll->setMaximum(qsizetype_to_int(m_movies.count()));
-    scrapeNext();
+    m_scrapeQueue->start(qsizetype_to_int(m_movies.count()));
 }
 
 void MovieMultiScrapeDialog::onScrapingFinished()
@@ -175,7 +180,7 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MovieMultiScrapeDialog::scrapeNext()
+void MovieMultiScrapeDialog::onStartItem(int index)
 {
     using namespace mediaelch::scraper;
 
@@ -183,62 +188,49 @@ void MovieMultiScrapeDialog::scrapeNext()
         return;
     }
 
-    if ((m_currentMovie != nullptr) && ui->chkAutoSave->isChecked()) {
-        m_currentMovie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-    }
-
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
-    m_currentMovie = m_queue.dequeue();
-
-    ui->movie->setText(m_currentMovie->name().trimmed());
-    ui->movieCounter->setText(QString("%1/%2").arg(m_movies.count() - m_queue.count()).arg(m_movies.count()));
-
-    ui->progressAll->setValue(ui->progressAll->maximum() - qsizetype_to_int(m_queue.size()) - 1);
-    ui->progressMovie->setValue(0);
+    Movie* movie = m_movies.at(index);
+    m_running[index].movie = movie;
+    updateProgress();
 
     if (ui->chkOnlyImdb->isChecked()
-        && ((!m_currentMovie->imdbId().isValid() && m_isImdb)
-            || (!m_currentMovie->tmdbId().isValid() && !m_currentMovie->imdbId().isValid() && m_isTmdb)
-            || (!m_currentMovie->imdbId().isValid() && !m_currentMovie->tmdbId().isValid()
+        && ((!movie->imdbId().isValid() && m_isImdb)
+            || (!movie->tmdbId().isValid() && !movie->imdbId().isValid() && m_isTmdb)
+            || (!movie->imdbId().isValid() && !movie->tmdbId().isValid()
                 && m_scraperInterface->meta().identifier == CustomMovieScraper::ID))) {
-        scrapeNext();
+        finishItem(index);
         return;
     }
 
-    connect(m_currentMovie->controller(),
+    connect(movie->controller(),
         &MovieController::sigLoadDone,
         this,
-        &MovieMultiScrapeDialog::scrapeNext,
+        &MovieMultiScrapeDialog::onLoadDone,
         Qt::UniqueConnection);
-    connect(m_currentMovie->controller(),
+    connect(movie->controller(),
         &MovieController::sigDownloadProgress,
         this,
         &MovieMultiScrapeDialog::onProgress,
         Qt::UniqueConnection);
+    // Images of the movie that is currently shown are downloaded first.
+    movie->controller()->setScrapeDownloadPriority(DownloadPriority::Background);
 
-    m_currentIds.clear();
-
-    if (m_isImdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
+    if (m_isImdb && movie->imdbId().isValid()) {
+        loadMovieData(movie, movie->imdbId());
         return;
     }
-    if (m_isTmdb && m_currentMovie->tmdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->tmdbId());
+    if (m_isTmdb && movie->tmdbId().isValid()) {
+        loadMovieData(movie, movie->tmdbId());
         return;
     }
-    if (m_isTmdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
+    if (m_isTmdb && movie->imdbId().isValid()) {
+        loadMovieData(movie, movie->imdbId());
         return;
     }
 
     MovieSearchJob::Config config;
     config.includeAdult = Settings::instance()->showAdultScrapers();
     // FIXME config.locale =
-    config.query = m_currentMovie->name();
+    config.query = movie->name();
     config.query = config.query.replace(".", " ");
 
     MovieScraper* scraperForSearchJob = m_scraperInterface;
@@ -247,16 +239,26 @@ void MovieMultiScrapeDialog::scrapeNext()
         scraperForSearchJob = CustomMovieScraper::instance()->titleScraper();
         const QString& titleScraper = scraperForSearchJob->meta().identifier;
 
-        if ((titleScraper == ImdbMovie::ID || titleScraper == TmdbMovie::ID) && m_currentMovie->imdbId().isValid()) {
-            config.query = m_currentMovie->imdbId().toString();
+        if ((titleScraper == ImdbMovie::ID || titleScraper == TmdbMovie::ID) && movie->imdbId().isValid()) {
+            config.query = movie->imdbId().toString();
 
-        } else if (titleScraper == TmdbMovie::ID && m_currentMovie->tmdbId().isValid()) {
-            config.query = m_currentMovie->tmdbId().withPrefix();
+        } else if (titleScraper == TmdbMovie::ID && movie->tmdbId().isValid()) {
+            config.query = movie->tmdbId().withPrefix();
         }
     }
 
-    auto* searchJob = m_scraperInterface->search(config);
-    searchJob->setProperty("scraper", QVariant::fromValue(scraperForSearchJob));
+    startSearch(index, m_scraperInterface->search(config), scraperForSearchJob);
+}
+
+void MovieMultiScrapeDialog::startSearch(int index,
+    mediaelch::scraper::MovieSearchJob* searchJob,
+    mediaelch::scraper::MovieScraper* scraper)
+{
+    using namespace mediaelch::scraper;
+
+    m_running[index].searchJob = searchJob;
+    searchJob->setProperty("scraper", QVariant::fromValue(scraper));
+    searchJob->setProperty("multiScrapeIndex", index);
     connect(searchJob, &MovieSearchJob::sigFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
     searchJob->start();
 }
@@ -287,74 +289,159 @@ void MovieMultiScrapeDialog::onSearchFinished(mediaelch::scraper::MovieSearchJob
         return;
     }
 
-    if (searchJob->hasError()) {
+    const int index = searchJob->property("multiScrapeIndex").toInt();
+    if (!m_running.contains(index) || m_running.value(index).searchJob != searchJob) {
+        // The movie was aborted in the meantime.
+        return;
+    }
+    m_running[index].searchJob = nullptr;
+
+    Movie* movie = m_running.value(index).movie;
+    if (movie == nullptr || searchJob->hasError()) {
         // TODO: Show the error
-        scrapeNext();
+        finishItem(index);
         return;
     }
 
     if (searchJob->results().isEmpty()) {
-        scrapeNext();
+        finishItem(index);
         return;
     }
 
     if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
         if (!searchJob->property("scraper").isValid()) {
             qCCritical(generic) << "[MovieMultiScraperDialog] Could not get scraper from search job! Invalid QVariant";
-            scrapeNext();
+            finishItem(index);
             return;
         }
         auto* scraper = searchJob->property("scraper").value<MovieScraper*>();
         if (scraper == nullptr) {
             qCCritical(generic)
                 << "[MovieMultiScraperDialog] Could not get scraper from search job! Scraper is nullptr";
-            scrapeNext();
+            finishItem(index);
             return;
         }
-        m_currentIds.insert(scraper, searchJob->results().first().identifier);
+        m_running[index].ids.insert(scraper, searchJob->results().first().identifier);
         const QVector<MovieScraper*>& searchScrapers =
-            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_currentIds);
+            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_running.value(index).ids);
 
         if (!searchScrapers.isEmpty()) {
             MovieSearchJob::Config config;
             // FIXME config.locale = TODO
             config.includeAdult = Settings::instance()->showAdultScrapers();
-            config.query = m_currentMovie->name();
+            config.query = movie->name();
             config.query = config.query.replace(".", " ");
 
             if ((searchScrapers.first()->meta().identifier == TmdbMovie::ID
                     || searchScrapers.first()->meta().identifier == ImdbMovie::ID)
-                && m_currentMovie->imdbId().isValid()) {
-                config.query = m_currentMovie->imdbId().toString();
+                && movie->imdbId().isValid()) {
+                config.query = movie->imdbId().toString();
 
-            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                       && m_currentMovie->tmdbId().isValid()) {
-                config.query = m_currentMovie->tmdbId().toString();
+            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID && movie->tmdbId().isValid()) {
+                config.query = movie->tmdbId().toString();
             }
 
-            auto* nextSearchJob = searchScrapers.first()->search(config);
-            nextSearchJob->setProperty("scraper", QVariant::fromValue(searchScrapers.first()));
-            connect(nextSearchJob, &MovieSearchJob::sigFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
-            nextSearchJob->start();
-
+            startSearch(index, searchScrapers.first()->search(config), searchScrapers.first());
             return;
         }
     } else {
-        m_currentIds.insert(m_scraperInterface, searchJob->results().first().identifier);
+        m_running[index].ids.insert(m_scraperInterface, searchJob->results().first().identifier);
     }
 
-    m_currentMovie->controller()->loadData(m_currentIds, m_scraperInterface, m_infosToLoad);
+    movie->controller()->loadData(m_running.value(index).ids, m_scraperInterface, m_infosToLoad);
 }
 
-void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
+void MovieMultiScrapeDialog::onLoadDone(Movie* movie)
+{
+    if (!isExecuted()) {
+        return;
+    }
+    const int index = runningIndexOf(movie);
+    if (index < 0) {
+        return;
+    }
+    if (ui->chkAutoSave->isChecked()) {
+        movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    }
+    finishItem(index);
+}
+
+void MovieMultiScrapeDialog::finishItem(int index)
+{
+    const ScrapeItem item = m_running.take(index);
+    if (item.movie != nullptr) {
+        disconnect(item.movie->controller(), nullptr, this, nullptr);
+        item.movie->controller()->setScrapeDownloadPriority(DownloadPriority::Normal);
+    }
+    m_scrapeQueue->finishItem(index);
+    updateProgress();
+}
+
+void MovieMultiScrapeDialog::abortRunningItems()
 {
-    Q_UNUSED(movie);
+    m_scrapeQueue->abort();
+    for (const ScrapeItem& item : asConst(m_running)) {
+        if (item.movie != nullptr) {
+            disconnect(item.movie->controller(), nullptr, this, nullptr);
+            item.movie->controller()->abortDownloads();
+            item.movie->controller()->setScrapeDownloadPriority(DownloadPriority::Normal);
+        }
+    }
+    m_running.clear();
+}
 
+int MovieMultiScrapeDialog::runningIndexOf(Movie* movie) const
+{
+    if (movie == nullptr) {
+        return -1;
+    }
+    for (auto it = m_running.constBegin(); it != m_running.constEnd(); ++it) {
+        if (it.value().movie == movie) {
+            return it.key();
+        }
+    }
+    return -1;
+}
+
+void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
+{
     if (!isExecuted()) {
         return;
     }
-    ui->progressMovie->setValue(maximum - current);
-    ui->progressMovie->setMaximum(maximum);
+    const int index = runningIndexOf(movie);
+    if (index < 0) {
+        return;
+    }
+    // "current" is the number of downloads that are left.
+    m_running[index].downloadsDone = maximum - current;
+    m_running[index].downloadsTotal = maximum;
+    updateProgress();
+}
+
+void MovieMultiScrapeDialog::updateProgress()
+{
+    const int finished = m_scrapeQueue->finishedCount();
+    ui->movieCounter->setText(
+        QString("%1/%2").arg(finished + qsizetype_to_int(m_running.size())).arg(m_movies.count()));
+    ui->progressAll->setValue(finished);
+
+    // Show all movies that are scraped right now and their combined download progress.
+    QStringList titles;
+    int downloadsDone = 0;
+    int downloadsTotal = 0;
+    for (int index : m_scrapeQueue->runningItems()) {
+        const ScrapeItem item = m_running.value(index);
+        if (item.movie == nullptr) {
+            continue;
+        }
+        titles << item.movie->name().trimmed();
+        downloadsDone += item.downloadsDone;
+        downloadsTotal += item.downloadsTotal;
+    }
+    ui->movie->setText(
+        ui->movie->fontMetrics().elidedText(titles.join(", "), Qt::ElideRight, ui->movie->width()));
+    ui->progressMovie->setMaximum(qMax(1, downloadsTotal));
+    ui->progressMovie->setValue(downloadsDone);
 }
 
 bool MovieMultiScrapeDialog::isExecuted() const
@@ -2,11 +2,12 @@
 
 #include "globals/ScraperResult.h"
 #include "movies/Movie.h"
+#include "scrapers/MultiScrapeQueue.h"
 #include "scrapers/movie/MovieIdentifier.h"
 
 #include <QDialog>
+#include <QHash>
 #include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class MovieMultiScrapeDialog;
@@ -37,24 +38,43 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob);
-    void scrapeNext();
+    void onStartItem(int index);
+    void onLoadDone(Movie* movie);
     void onProgress(Movie* movie, int current, int maximum);
     void onChkToggled();
     void onChkAllToggled();
     void setCheckBoxesEnabled(int index);
 
 private:
+    /// \brief State of a movie that is currently being scraped.
+    struct ScrapeItem
+    {
+        QPointer<Movie> movie;
+        QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> ids;
+        /// \brief The search job that is currently running for this movie, if any.
+        mediaelch::scraper::MovieSearchJob* searchJob = nullptr;
+        int downloadsDone = 0;
+        int downloadsTotal = 0;
+    };
+
     Ui::MovieMultiScrapeDialog* ui = nullptr;
     QVector<Movie*> m_movies;
-    QQueue<Movie*> m_queue;
-    QPointer<Movie> m_currentMovie;
+    mediaelch::scraper::MultiScrapeQueue* m_scrapeQueue = nullptr;
+    /// \brief Movies that are currently being scraped by their index in m_movies.
+    QHash<int, ScrapeItem> m_running;
     mediaelch::scraper::MovieScraper* m_scraperInterface = nullptr;
-    QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> m_currentIds;
     bool m_isImdb = false;
     bool m_isTmdb = false;
     bool m_executed = false;
     QSet<MovieScraperInfo> m_infosToLoad;
     void loadMovieData(Movie* movie, ImdbId id);
     void loadMovieData(Movie* movie, TmdbId id);
+    void startSearch(int index,
+        mediaelch::scraper::MovieSearchJob* searchJob,
+        mediaelch::scraper::MovieScraper* scraper);
+    void finishItem(int index);
+    void abortRunningItems();
+    int runningIndexOf(Movie* movie) const;
+    void updateProgress();
     bool isExecuted() const;
 };
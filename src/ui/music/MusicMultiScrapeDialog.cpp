@@ -54,6 +54,19 @@ MusicMultiScrapeDialog::MusicMultiScrapeDialog(QWidget* parent) : QDialog(parent
     }
     connect(ui->chkUnCheckAll, &QAbstractButton::clicked, this, &MusicMultiScrapeDialog::onChkAllToggled);
     connect(ui->btnStartScraping, &QAbstractButton::clicked, this, &MusicMultiScrapeDialog::onStartScraping);
+
+    // Search results are reported by a scraper-wide signal that can't be mapped to
+    // an item, so the items are scraped one after another.
+    m_scrapeQueue = new mediaelch::scraper::MultiScrapeQueue(this);
+    m_scrapeQueue->setLimits(mediaelch::scraper::ScrapeLimits::sequential());
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigStartItem,
+        this,
+        &MusicMultiScrapeDialog::onStartItem);
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigFinished,
+        this,
+        &MusicMultiScrapeDialog::onScrapingFinished);
 }
 
 MusicMultiScrapeDialog::~MusicMultiScrapeDialog()
@@ -99,7 +112,9 @@ bool MusicMultiScrapeDialog::isExecuted() const
 
 int MusicMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    m_scrapeQueue->abort();
+    m_items.clear();
+    m_currentIndex = -1;
     ui->itemCounter->setVisible(false);
     ui->btnCancel->setVisible(true);
     ui->btnClose->setVisible(false);
@@ -137,7 +152,7 @@ void MusicMultiScrapeDialog::reject()
     if (m_currentArtist != nullptr) {
         m_currentArtist->controller()->abortDownloads();
     }
-    m_queue.clear();
+    m_scrapeQueue->abort();
     QDialog::reject();
 }
 
@@ -170,14 +185,14 @@ void MusicMultiScrapeDialog::onStartScraping()
         QueueItem item1{};
         item1.album = nullptr;
         item1.artist = artist;
-        m_queue.append(item1);
+        m_items.append(item1);
         if (ui->chkScrapeAllAlbums->isChecked()) {
             const auto albums = artist->albums();
             for (Album* album : albums) {
                 QueueItem item2{};
                 item2.album = album;
                 item2.artist = nullptr;
-                m_queue.append(item2);
+                m_items.append(item2);
                 queueAlbums.append(album);
             }
         }
@@ -188,15 +203,15 @@ void MusicMultiScrapeDialog::onStartScraping()
             QueueItem item{};
             item.album = album;
             item.artist = nullptr;
-            m_queue.append(item);
+            m_items.append(item);
             queueAlbums.append(album);
         }
     }
 
-    ui->itemCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->itemCounter->setText(QString("0/%1").arg(m_items.count()));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(qsizetype_to_int(m_queue.count()));
-    scrapeNext();
+    ui->progressAll->setMaximum(qsizetype_to_int(m_items.count()));
+    m_scrapeQueue->start(qsizetype_to_int(m_items.count()));
 }
 
 void MusicMultiScrapeDialog::onScrapingFinished()
@@ -212,7 +227,7 @@ void MusicMultiScrapeDialog::onScrapingFinished()
 
 void MusicMultiScrapeDialog::scrapeNext()
 {
-    if (!isExecuted()) {
+    if (!isExecuted() || !m_scrapeQueue->isItemRunning(m_currentIndex)) {
         return;
     }
 
@@ -224,12 +239,19 @@ void MusicMultiScrapeDialog::scrapeNext()
         m_currentArtist->controller()->saveData(Manager::instance()->mediaCenterInterface());
     }
 
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
+    m_currentAlbum = nullptr;
+    m_currentArtist = nullptr;
+    m_scrapeQueue->finishItem(m_currentIndex);
+}
+
+void MusicMultiScrapeDialog::onStartItem(int index)
+{
+    if (!isExecuted()) {
         return;
     }
 
-    QueueItem item = m_queue.dequeue();
+    const QueueItem& item = m_items.at(index);
+    m_currentIndex = index;
     m_currentAlbum = item.album;
     m_currentArtist = item.artist;
     if (m_currentAlbum != nullptr) {
@@ -237,9 +259,8 @@ void MusicMultiScrapeDialog::scrapeNext()
     } else if (m_currentArtist != nullptr) {
         ui->itemName->setText(m_currentArtist->name().trimmed());
     }
-    ui->itemCounter->setText(
-        QString("%1/%2").arg(ui->progressAll->maximum() - m_queue.count()).arg(ui->progressAll->maximum()));
-    ui->progressAll->setValue(ui->progressAll->maximum() - qsizetype_to_int(m_queue.size()) - 1);
+    ui->itemCounter->setText(QString("%1/%2").arg(index + 1).arg(m_items.count()));
+    ui->progressAll->setValue(index);
     ui->progressItem->setValue(0);
 
     if (m_currentAlbum != nullptr) {
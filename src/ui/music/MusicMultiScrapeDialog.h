@@ -3,10 +3,10 @@
 #include "globals/Globals.h"
 #include "globals/ScraperInfos.h"
 #include "globals/ScraperResult.h"
+#include "scrapers/MultiScrapeQueue.h"
 #include "scrapers/music/MusicScraper.h"
 
 #include <QDialog>
-#include <QQueue>
 #include <QVector>
 
 class Album;
@@ -37,6 +37,7 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(QVector<ScraperSearchResult> results);
+    void onStartItem(int index);
     void scrapeNext();
     void onProgress(Artist* artist, int current, int maximum);
     void onProgress(Album* album, int current, int maximum);
@@ -53,7 +54,9 @@ private:
     void disconnectScrapers() const;
     bool isExecuted() const;
 
-    QQueue<QueueItem> m_queue;
+    QVector<QueueItem> m_items;
+    mediaelch::scraper::MultiScrapeQueue* m_scrapeQueue = nullptr;
+    int m_currentIndex = -1;
     bool m_executed;
     Artist* m_currentArtist = nullptr;
     Album* m_currentAlbum = nullptr;
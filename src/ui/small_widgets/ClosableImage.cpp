@@ -60,6 +60,11 @@ ClosableImage::ClosableImage(QWidget* parent) : QLabel(parent)
     setAcceptDrops(true);
 }
 
+ClosableImage::~ClosableImage()
+{
+    ImageCache::instance()->cancelRequest(m_imageRequest);
+}
+
 void ClosableImage::mousePressEvent(QMouseEvent* ev)
 {
     if (m_loading || ev->button() != Qt::LeftButton || !m_pixmap.isNull()) {
@@ -154,17 +159,26 @@ void ClosableImage::paintEvent(QPaintEvent* event)
         return;
     }
 
-    QImage img;
-    int origWidth = 0;
-    int origHeight = 0;
-    const int w = static_cast<int>((width() - 9) * helper::devicePixelRatio(this));
+    const int w = imageWidth();
     if (!m_image.isNull()) {
-        img = QImage::fromData(m_image);
-        origWidth = img.width();
-        origHeight = img.height();
-        img = img.scaledToWidth(w, Qt::SmoothTransformation);
+        if (m_requestedWidth != w) {
+            // Decode only once and not on each repaint.
+            const QImage origImg = QImage::fromData(m_image);
+            m_originalSize = origImg.size();
+            m_scaledImage = origImg.scaledToWidth(w, Qt::SmoothTransformation);
+            m_requestedWidth = w;
+        }
     } else if (!m_imagePath.isEmpty()) {
-        img = ImageCache::instance()->image(mediaelch::FilePath(m_imagePath), w, 0, origWidth, origHeight);
+        // Only images that are on screen are painted, so they are loaded before hidden ones.
+        if (m_requestedWidth != w) {
+            requestImage(ImageCache::Priority::High);
+        } else if (m_imageRequest != 0) {
+            ImageCache::instance()->setRequestPriority(m_imageRequest, ImageCache::Priority::High);
+        }
+        if (m_scaledImage.isNull()) {
+            // Still loading or not readable.
+            return;
+        }
     } else {
         const int x =
             static_cast<int>((width() - (m_defaultPixmap.width() / helper::devicePixelRatio(m_defaultPixmap))) / 2);
@@ -178,6 +192,7 @@ void ClosableImage::paintEvent(QPaintEvent* event)
         return;
     }
 
+    QImage img = m_scaledImage;
     helper::setDevicePixelRatio(img, helper::devicePixelRatio(this));
     QRect r = rect();
     p.drawImage(0, 7, img);
@@ -187,7 +202,7 @@ void ClosableImage::paintEvent(QPaintEvent* event)
     helper::setDevicePixelRatio(closeImg, helper::devicePixelRatio(this));
     p.drawImage(r.width() - 21, 0, closeImg);
     if (m_showZoomAndResolution) {
-        QString res = QString("%1x%2").arg(origWidth).arg(origHeight);
+        QString res = QString("%1x%2").arg(m_originalSize.width()).arg(m_originalSize.height());
         QFontMetrics fm(m_font);
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
@@ -257,6 +272,39 @@ void ClosableImage::setImageByPath(const QString& image)
     m_imagePath = image;
     QSize size = ImageCache::instance()->imageSize(mediaelch::FilePath(image));
     updateSize(size.width(), size.height());
+    // Start loading right away. Hidden images, e.g. on other tabs, are loaded last.
+    requestImage(visibleRegion().isEmpty() ? ImageCache::Priority::Low : ImageCache::Priority::High);
+}
+
+int ClosableImage::imageWidth()
+{
+    return static_cast<int>((width() - 9) * helper::devicePixelRatio(this));
+}
+
+void ClosableImage::requestImage(ImageCache::Priority priority)
+{
+    ImageCache::instance()->cancelRequest(m_imageRequest);
+    m_requestedWidth = imageWidth();
+    m_imageRequest = ImageCache::instance()->requestImage(mediaelch::FilePath(m_imagePath),
+        m_requestedWidth,
+        0,
+        priority,
+        this,
+        [this](QImage image, QSize originalSize) {
+            m_imageRequest = 0;
+            m_scaledImage = std::move(image);
+            m_originalSize = originalSize;
+            update();
+        });
+}
+
+void ClosableImage::resetScaledImage()
+{
+    ImageCache::instance()->cancelRequest(m_imageRequest);
+    m_imageRequest = 0;
+    m_scaledImage = QImage();
+    m_originalSize = QSize();
+    m_requestedWidth = 0;
 }
 
 void ClosableImage::updateSize(int imageWidth, int imageHeight)
@@ -353,6 +401,7 @@ void ClosableImage::setLoading(const bool& loading)
         setMovie(m_loadingMovie);
         m_image = QByteArray();
         m_imagePath.clear();
+        resetScaledImage();
         update();
     } else {
         setMovie(nullptr);
@@ -366,6 +415,7 @@ void ClosableImage::clear()
     }
     m_imagePath.clear();
     m_image = QByteArray();
+    resetScaledImage();
     m_pixmap = m_emptyPixmap;
     m_loading = false;
     setMovie(nullptr);
@@ -397,6 +447,7 @@ void ClosableImage::closed()
     m_pixmap = QPixmap();
     m_image = QByteArray();
     m_imagePath.clear();
+    resetScaledImage();
     update();
 }
 
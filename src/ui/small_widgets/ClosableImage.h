@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/ImageCache.h"
 #include "globals/Globals.h"
 
 #include <QLabel>
@@ -19,6 +20,7 @@ class ClosableImage : public QLabel
 
 public:
     explicit ClosableImage(QWidget* parent = nullptr);
+    ~ClosableImage() override;
     void setMyData(const QVariant& myData);
     QVariant myData() const;
     void setImage(const QByteArray& image);
@@ -83,8 +85,19 @@ private:
     QPointer<QPropertyAnimation> m_anim;
     ImageType m_imageType = ImageType::None;
     QPixmap m_emptyPixmap;
+    /// \brief Scaled version of m_image or m_imagePath that is painted.
+    QImage m_scaledImage;
+    QSize m_originalSize;
+    /// \brief Width that m_scaledImage was requested for. Zero if not requested yet.
+    int m_requestedWidth = 0;
+    ImageCache::RequestId m_imageRequest = 0;
 
     void updateSize(int imageWidth, int imageHeight);
+    /// \brief Width of the painted image in device pixels.
+    int imageWidth();
+    /// \brief Loads m_imagePath in the background and repaints once it is loaded.
+    void requestImage(ImageCache::Priority priority);
+    void resetScaledImage();
     QRect imgRect();
     QRect closeRect();
     QRect zoomRect();
@@ -2,6 +2,7 @@
 #include "ui_FilterWidget.h"
 
 #include <QGraphicsDropShadowEffect>
+#include <QSet>
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
@@ -293,50 +294,33 @@ void FilterWidget::setupFilters()
  */
 QVector<Filter*> FilterWidget::setupMovieFilters()
 {
-    // Load available genres/directors/etc.
-
-    QStringList years;
-    QStringList genres;
-    QStringList certifications;
-    QStringList studios;
-    QStringList countries;
-    QStringList tags;
-    QStringList directors;
-    QStringList videocodecs;
+    // Load available genres/directors/etc. from the movie model's filter index,
+    // which already contains the distinct values of all movies.
+
+    MovieModel* movieModel = Manager::instance()->movieModel();
+    const mediaelch::FilterIndex& index = movieModel->filterIndex();
+    const auto valuesOf = [&index](MovieFilters filter) { return index.values(static_cast<int>(filter)); };
+
+    QStringList genres = valuesOf(MovieFilters::Genres);
+    QStringList certifications = valuesOf(MovieFilters::Certification);
+    QStringList studios = valuesOf(MovieFilters::Studio);
+    QStringList countries = valuesOf(MovieFilters::Country);
+    QStringList tags = valuesOf(MovieFilters::Tags);
+    QStringList directors = valuesOf(MovieFilters::Director);
+    QStringList videocodecs = valuesOf(MovieFilters::VideoCodec);
     // TODO: QVector<MovieSet>
-    QStringList sets;
-
-    const auto copyNotEmptyUnique = [](const QStringList& from, QStringList& to) {
-        for (const QString& str : from) {
-            if (!str.isEmpty() && !to.contains(str)) {
-                to.append(str);
-            }
-        }
-    };
-
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        copyNotEmptyUnique(movie->genres(), genres);
-        copyNotEmptyUnique(movie->studios(), studios);
-        copyNotEmptyUnique(movie->countries(), countries);
-        copyNotEmptyUnique(movie->tags(), tags);
+    QStringList sets = valuesOf(MovieFilters::Set);
 
-        if (!directors.contains(movie->director())) {
-            directors.append(movie->director());
-        }
-        if (!videocodecs.contains(movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec))) {
-            videocodecs.append(movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec));
-        }
-        if (movie->released().isValid() && !years.contains(QString::number(movie->released().year()))) {
-            years.append(QString::number(movie->released().year()));
-        }
-        const auto certStr = movie->certification().toString();
-        if (movie->certification().isValid() && !certifications.contains(certStr)) {
-            certifications.append(certStr);
-        }
-        if (!movie->set().name.isEmpty() && !sets.contains(movie->set().name)) {
-            sets.append(movie->set().name);
+    QSet<int> releaseYears;
+    for (Movie* movie : movieModel->movies()) {
+        if (movie->released().isValid()) {
+            releaseYears.insert(movie->released().year());
         }
     }
+    QStringList years;
+    for (int year : asConst(releaseYears)) {
+        years.append(QString::number(year));
+    }
 
     const auto sortByLocaleCompare = [](QStringList& list) {
         std::sort(list.begin(), list.end(), LocaleStringCompare());
@@ -2,7 +2,10 @@
 #include "ui_LoadingStreamDetails.h"
 
 #include "concerts/Concert.h"
+#include "data/StreamDetailsLoader.h"
+#include "log/Log.h"
 #include "movies/Movie.h"
+#include "settings/Settings.h"
 #include "tv_shows/TvShowEpisode.h"
 
 LoadingStreamDetails::LoadingStreamDetails(QWidget* parent) : QDialog(parent), ui(new Ui::LoadingStreamDetails)
@@ -31,59 +34,68 @@ LoadingStreamDetails::~LoadingStreamDetails()
 
 void LoadingStreamDetails::loadMovies(QVector<Movie*> movies)
 {
-    ui->progressBar->setRange(0, qsizetype_to_int(movies.count()));
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
-    for (Movie* movie : movies) {
-        movie->blockSignals(true);
-        const bool success = movie->controller()->loadStreamDetailsFromFile();
-        if (success) {
-            movie->setChanged(true);
-        }
-        movie->blockSignals(false);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(movie->name());
-        QApplication::processEvents();
+    QVector<mediaelch::FileList> files;
+    QStringList names;
+    for (const Movie* movie : asConst(movies)) {
+        files << movie->files();
+        names << movie->name();
     }
-    accept();
+    load(std::move(files), std::move(names), [&movies](int index, const StreamDetails::Values& details) {
+        movies[index]->controller()->setStreamDetails(details);
+    });
 }
 
 void LoadingStreamDetails::loadConcerts(QVector<Concert*> concerts)
 {
-    ui->progressBar->setRange(0, qsizetype_to_int(concerts.count()));
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
-    for (Concert* concert : concerts) {
-        const bool success = concert->controller()->loadStreamDetailsFromFile();
-        if (success) {
-            concert->setChanged(true);
-        }
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(concert->title());
-        QApplication::processEvents();
+    QVector<mediaelch::FileList> files;
+    QStringList names;
+    for (const Concert* concert : asConst(concerts)) {
+        files << concert->files();
+        names << concert->title();
     }
-    accept();
+    load(std::move(files), std::move(names), [&concerts](int index, const StreamDetails::Values& details) {
+        concerts[index]->controller()->setStreamDetails(details);
+    });
 }
 
 void LoadingStreamDetails::loadTvShowEpisodes(QVector<TvShowEpisode*> episodes)
 {
-    ui->progressBar->setRange(0, qsizetype_to_int(episodes.count()));
+    QVector<mediaelch::FileList> files;
+    QStringList names;
+    for (const TvShowEpisode* episode : asConst(episodes)) {
+        files << episode->files();
+        names << episode->title();
+    }
+    load(std::move(files), std::move(names), [&episodes](int index, const StreamDetails::Values& details) {
+        episodes[index]->setStreamDetails(details);
+    });
+}
+
+void LoadingStreamDetails::load(QVector<mediaelch::FileList> files, QStringList names, ApplyFunction apply)
+{
+    ui->progressBar->setRange(0, qsizetype_to_int(files.count()));
     ui->progressBar->setValue(0);
     ui->currentFile->clear();
     adjustSize();
-    show();
-    for (TvShowEpisode* episode : episodes) {
-        const bool success = episode->loadStreamDetailsFromFile();
-        if (success) {
-            episode->setChanged(true);
-        }
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(episode->title());
-        QApplication::processEvents();
+
+    mediaelch::StreamDetailsLoader loader;
+    loader.setWorkerCount(Settings::instance()->advanced()->streamDetailsWorkers());
+    connect(&loader,
+        &mediaelch::StreamDetailsLoader::sigLoaded,
+        this,
+        [this, &names, &apply](int index, bool success, StreamDetails::Values details) {
+            if (success) {
+                apply(index, details);
+            }
+            ui->progressBar->setValue(ui->progressBar->value() + 1);
+            ui->currentFile->setText(names.at(index));
+        });
+    connect(&loader, &mediaelch::StreamDetailsLoader::sigFinished, this, &QDialog::accept);
+
+    if (!loader.load(std::move(files))) {
+        qCWarning(generic) << "[LoadingStreamDetails] Could not load stream details: MediaInfo is not available";
+        return;
     }
-    accept();
+    // Closing the dialog cancels loading. Stream details that were loaded until then are kept.
+    exec();
 }
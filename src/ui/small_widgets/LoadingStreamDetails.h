@@ -1,8 +1,13 @@
 #pragma once
 
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
 #include <QDialog>
+#include <QStringList>
 #include <QVector>
 #include <QWidget>
+#include <functional>
 
 class Concert;
 class Movie;
@@ -12,6 +17,10 @@ namespace Ui {
 class LoadingStreamDetails;
 }
 
+/// \brief Loads the stream details of multiple items and shows the progress.
+/// \details The load*() functions block until all stream details are loaded or
+///          the dialog is closed. Files are probed in the background and each
+///          item is updated as soon as its stream details are available.
 class LoadingStreamDetails : public QDialog
 {
     Q_OBJECT
@@ -24,5 +33,8 @@ public:
     void loadTvShowEpisodes(QVector<TvShowEpisode*> episodes);
 
 private:
+    using ApplyFunction = std::function<void(int index, const StreamDetails::Values& details)>;
+    void load(QVector<mediaelch::FileList> files, QStringList names, ApplyFunction apply);
+
     Ui::LoadingStreamDetails* ui;
 };
@@ -497,8 +497,39 @@ void TvShowFilesWidget::hideSpecialsInMissingEpisodes()
 void TvShowFilesWidget::setFilter(const QVector<Filter*>& filters, QString text)
 {
     QString filterText = filters.isEmpty() ? text : filters.first()->shortText();
-    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
+    // Filters the model, so the proxy's filters have to be set before.
     m_tvShowProxyModel->setFilter(filters, text);
+    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
+}
+
+/// \brief Reloads the given show directories, e.g. after the library watcher noticed changes.
+void TvShowFilesWidget::reloadShowDirectories(const QVector<mediaelch::DirectoryPath>& showDirs)
+{
+    auto* manager = Manager::instance();
+    auto* selectionModel = ui->files->selectionModel();
+    selectionModel->blockSignals(true);
+
+    for (const mediaelch::DirectoryPath& showDir : showDirs) {
+        if (showDir.dir().exists()) {
+            manager->tvShowFileSearcher()->reloadEpisodes(showDir);
+            continue;
+        }
+        const QVector<TvShow*> shows = manager->tvShowModel()->tvShows();
+        for (TvShow* show : shows) {
+            if (show->dir() == showDir) {
+                qCInfo(generic) << "[TvShowFilesWidget] Removing show because its directory was removed:" << showDir;
+                manager->database()->clearTvShowInDirectory(showDir);
+                manager->tvShowModel()->removeShow(show);
+                break;
+            }
+        }
+    }
+
+    selectionModel->blockSignals(false);
+    selectionModel->clearSelection();
+    selectionModel->clearCurrentIndex();
+    emit sigNothingSelected();
+    updateStatusLabel();
 }
 
 /// \brief Renews the model (necessary after searching for TV shows)
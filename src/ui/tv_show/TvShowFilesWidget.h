@@ -37,6 +37,10 @@ public:
 
 public slots:
     void renewModel(bool force = false);
+    /// \brief   Reload the given TV show directories, e.g. because they changed on disk.
+    /// \details Shows whose directory does not exist anymore are removed.
+    ///          The selection is cleared because selected shows may be replaced.
+    void reloadShowDirectories(const QVector<mediaelch::DirectoryPath>& showDirs);
     void emitLastSelection();
     void multiScrape();
     // void updateProxy();
@@ -85,9 +85,6 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
 #endif
     ui->itemCounter->setFont(font);
 
-    m_showQueue.append(m_shows.toList());
-    m_episodeQueue.append(m_episodes.toList());
-
     ui->chkActors->setMyData(static_cast<int>(ShowScraperInfo::Actors));
     ui->chkBanner->setMyData(static_cast<int>(ShowScraperInfo::Banner));
     ui->chkCertification->setMyData(static_cast<int>(ShowScraperInfo::Certification));
@@ -147,6 +144,18 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     connect(m_downloadManager, &DownloadManager::sigElemDownloaded,    this, &TvShowMultiScrapeDialog::onDownloadFinished, queuedUnique);
     connect(m_downloadManager, &DownloadManager::allDownloadsFinished, this, &TvShowMultiScrapeDialog::scrapeNext,         queuedUnique);
     // clang-format on
+    // Episodes reuse show IDs found by previous items and all items share one download
+    // manager, so the items are scraped one after another.
+    m_scrapeQueue = new mediaelch::scraper::MultiScrapeQueue(this);
+    m_scrapeQueue->setLimits(mediaelch::scraper::ScrapeLimits::sequential());
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigStartItem,
+        this,
+        &TvShowMultiScrapeDialog::onStartItem);
+    connect(m_scrapeQueue,
+        &mediaelch::scraper::MultiScrapeQueue::sigFinished,
+        this,
+        &TvShowMultiScrapeDialog::onScrapingFinished);
 }
 
 TvShowMultiScrapeDialog::~TvShowMultiScrapeDialog()
@@ -209,6 +218,7 @@ void TvShowMultiScrapeDialog::accept()
 
 void TvShowMultiScrapeDialog::reject()
 {
+    m_scrapeQueue->abort();
     m_downloadManager->abortDownloads();
 
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyId->isChecked());
@@ -299,44 +309,52 @@ void TvShowMultiScrapeDialog::onStartScraping()
     ui->comboScraper->setEnabled(false);
     ui->txtScraperLog->clear();
 
-    ui->itemCounter->setText(QStringLiteral("0/%1").arg(m_showQueue.count() + m_episodeQueue.count()));
+    const int itemCount = qsizetype_to_int(m_shows.count() + m_episodes.count());
+    ui->itemCounter->setText(QStringLiteral("0/%1").arg(itemCount));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(qsizetype_to_int(m_showQueue.count() + m_episodeQueue.count()));
+    ui->progressAll->setMaximum(itemCount);
 
     logToUser(tr("Start scraping using \"%1\"").arg(m_currentScraper->meta().name));
 
-    scrapeNext();
+    m_scrapeQueue->start(itemCount);
 }
 
 void TvShowMultiScrapeDialog::scrapeNext()
 {
+    if (!m_scrapeQueue->isItemRunning(m_currentIndex)) {
+        return;
+    }
     qCDebug(generic) << "[TvShowMultiScrapeDialog] Scrape next item";
-    using namespace mediaelch::scraper;
 
     saveCurrentItem();
 
-    if (m_showQueue.isEmpty() && m_episodeQueue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
+    m_currentShow = nullptr;
+    m_currentEpisode = nullptr;
+    m_scrapeQueue->finishItem(m_currentIndex);
+}
 
+void TvShowMultiScrapeDialog::onStartItem(int index)
+{
+    using namespace mediaelch::scraper;
+
+    m_currentIndex = index;
     m_currentShow = nullptr;
     m_currentEpisode = nullptr;
 
-    if (!m_showQueue.isEmpty()) {
-        m_currentShow = m_showQueue.dequeue();
+    const int showCount = qsizetype_to_int(m_shows.count());
+    if (index < showCount) {
+        m_currentShow = m_shows.at(index);
         ui->title->setText(m_currentShow->title().trimmed());
 
-    } else if (!m_episodeQueue.isEmpty()) {
-        m_currentEpisode = m_episodeQueue.dequeue();
+    } else {
+        m_currentEpisode = m_episodes.at(index - showCount);
         ui->title->setText(m_currentEpisode->title().trimmed());
     }
 
     const int sum = qsizetype_to_int(m_shows.count() + m_episodes.count());
-    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(sum - m_showQueue.count() - m_episodeQueue.count()).arg(sum));
+    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(index + 1).arg(sum));
 
-    ui->progressAll->setValue(
-        ui->progressAll->maximum() - qsizetype_to_int(m_showQueue.size() + m_episodeQueue.count()) - 1);
+    ui->progressAll->setValue(index);
     ui->progressItem->setValue(0);
 
     // Check if the show/episode has an ID that suits the current scraper.
@@ -422,10 +440,8 @@ void TvShowMultiScrapeDialog::scrapeNext()
         }
 
     } else {
-        qCCritical(generic)
-            << "[TvShowMultiScrapeDialog] Cannot scrape next! No further items to process but initial check "
-               "did not notice it!";
-        onScrapingFinished();
+        qCCritical(generic) << "[TvShowMultiScrapeDialog] Cannot scrape item" << index << "because it was deleted!";
+        scrapeNext();
     }
 }
 
@@ -676,6 +692,7 @@ void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<P
 void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow* show, SeasonNumber season)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Background;
     d.imageType = imageType;
     d.url = std::move(url);
     d.season = season;
@@ -686,6 +703,7 @@ void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow*
 void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow* show, Actor* actor)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Background;
     d.imageType = imageType;
     d.url = std::move(url);
     d.actor = actor;
@@ -696,6 +714,7 @@ void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow*
 void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShowEpisode* episode)
 {
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Background;
     d.imageType = imageType;
     d.url = std::move(url);
     d.episode = episode;
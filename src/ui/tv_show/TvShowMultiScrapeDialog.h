@@ -1,13 +1,13 @@
 #pragma once
 
 #include "globals/DownloadManager.h"
+#include "scrapers/MultiScrapeQueue.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDialog>
 #include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class TvShowMultiScrapeDialog;
@@ -40,6 +40,7 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob);
+    void onStartItem(int index);
     void scrapeNext();
     void onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details);
     void onEpisodeLoadDone();
@@ -57,8 +58,9 @@ private:
     SeasonOrder m_seasonOrder = SeasonOrder::Aired;
     QSet<ShowScraperInfo> m_showDetailsToLoad;
     QSet<EpisodeScraperInfo> m_episodeDetailsToLoad;
-    QQueue<TvShow*> m_showQueue;
-    QQueue<TvShowEpisode*> m_episodeQueue;
+    /// \brief Items are all shows followed by all episodes.
+    mediaelch::scraper::MultiScrapeQueue* m_scrapeQueue = nullptr;
+    int m_currentIndex = -1;
     QPointer<TvShow> m_currentShow = nullptr;
     QPointer<TvShowEpisode> m_currentEpisode = nullptr;
     mediaelch::scraper::TvScraper* m_currentScraper = nullptr;
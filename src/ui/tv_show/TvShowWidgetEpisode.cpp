@@ -691,6 +691,7 @@ void TvShowWidgetEpisode::onLoadDone()
 
     if (!m_episode->thumbnail().isEmpty() && m_episode->wantThumbnailDownload()) {
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowEpisodeThumb;
         d.url = m_episode->thumbnail();
         d.episode = m_episode;
@@ -734,6 +735,7 @@ void TvShowWidgetEpisode::onChooseThumbnail()
     if (exitCode == QDialog::Accepted) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowEpisodeThumb;
         d.url = imageUrl;
         d.episode = m_episode;
@@ -753,6 +755,7 @@ void TvShowWidgetEpisode::onImageDropped(ImageType imageType, QUrl imageUrl)
     }
     emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.imageType = ImageType::TvShowEpisodeThumb;
     d.url = imageUrl;
     d.episode = m_episode;
@@ -282,6 +282,7 @@ void TvShowWidgetSeason::onChooseImage()
     if (exitCode == QDialog::Accepted) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = image->imageType();
         d.url = imageUrl;
         d.season = m_season;
@@ -318,6 +319,7 @@ void TvShowWidgetSeason::onImageDropped(ImageType imageType, QUrl imageUrl)
 
     emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.imageType = imageType;
     d.url = imageUrl;
     d.season = m_season;
@@ -558,6 +558,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
     if (!show->posters().isEmpty() && show->infosToLoad().contains(ShowScraperInfo::Poster)) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowPoster;
         d.url = show->posters().at(0).originalUrl;
         d.show = show;
@@ -571,6 +572,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
     if (!show->backdrops().isEmpty() && show->infosToLoad().contains(ShowScraperInfo::Fanart)) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowBackdrop;
         d.url = show->backdrops().at(0).originalUrl;
         d.show = show;
@@ -584,6 +586,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
     if (!show->banners().isEmpty() && show->infosToLoad().contains(ShowScraperInfo::Banner)) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = ImageType::TvShowBanner;
         d.url = show->banners().at(0).originalUrl;
         d.show = show;
@@ -600,6 +603,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
         it.next();
         if (it.key() == ImageType::TvShowClearArt && !it.value().isEmpty()) {
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowClearArt;
             d.url = it.value().at(0).originalUrl;
             d.show = show;
@@ -610,6 +614,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
             downloadsSize++;
         } else if (it.key() == ImageType::TvShowCharacterArt && !it.value().isEmpty()) {
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowCharacterArt;
             d.url = it.value().at(0).originalUrl;
             d.show = show;
@@ -620,6 +625,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
             downloadsSize++;
         } else if (it.key() == ImageType::TvShowLogos && !it.value().isEmpty()) {
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowLogos;
             d.url = it.value().at(0).originalUrl;
             d.show = show;
@@ -630,6 +636,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
             downloadsSize++;
         } else if (it.key() == ImageType::TvShowThumb && !it.value().isEmpty()) {
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowThumb;
             d.url = it.value().at(0).originalUrl;
             d.show = show;
@@ -648,6 +655,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
                 }
 
                 DownloadManagerElement d;
+                d.priority = DownloadPriority::Visible;
                 d.imageType = ImageType::TvShowSeasonThumb;
                 d.url = p.originalUrl;
                 d.show = show;
@@ -665,6 +673,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
                 continue;
             }
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::Actor;
             d.url = QUrl(actor->thumb);
             d.actor = actor;
@@ -678,6 +687,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
         if (!show->seasonPosters(season).isEmpty() && show->infosToLoad().contains(ShowScraperInfo::SeasonPoster)) {
             emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowSeasonPoster;
             d.url = show->seasonPosters(season).at(0).originalUrl;
             d.season = season;
@@ -688,6 +698,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
         if (!show->seasonBackdrops(season).isEmpty() && show->infosToLoad().contains(ShowScraperInfo::SeasonBackdrop)) {
             emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowSeasonBackdrop;
             d.url = show->seasonBackdrops(season).at(0).originalUrl;
             d.season = season;
@@ -698,6 +709,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
         if (!show->seasonBanners(season).isEmpty() && show->infosToLoad().contains(ShowScraperInfo::SeasonBanner)) {
             emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowSeasonBanner;
             d.url = show->seasonBanners(season).at(0).originalUrl;
             d.season = season;
@@ -713,6 +725,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
                 continue;
             }
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowEpisodeThumb;
             d.url = episode->thumbnail();
             d.episode = episode;
@@ -1136,6 +1149,7 @@ void TvShowWidgetTvShow::onAddExtraFanart()
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         for (const QUrl& url : imageUrls) {
             DownloadManagerElement d;
+            d.priority = DownloadPriority::Visible;
             d.imageType = ImageType::TvShowExtraFanart;
             d.url = url;
             d.show = m_show;
@@ -1152,6 +1166,7 @@ void TvShowWidgetTvShow::onExtraFanartDropped(QUrl imageUrl)
     }
     emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.imageType = ImageType::TvShowExtraFanart;
     d.url = std::move(imageUrl);
     d.show = m_show;
@@ -1203,6 +1218,7 @@ void TvShowWidgetTvShow::onChooseImage()
     if (exitCode == QDialog::Accepted) {
         emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
         DownloadManagerElement d;
+        d.priority = DownloadPriority::Visible;
         d.imageType = image->imageType();
         d.url = imageUrl;
         d.show = m_show;
@@ -1240,6 +1256,7 @@ void TvShowWidgetTvShow::onImageDropped(ImageType imageType, QUrl imageUrl)
 
     emit sigSetActionSaveEnabled(false, MainWidgets::TvShows);
     DownloadManagerElement d;
+    d.priority = DownloadPriority::Visible;
     d.imageType = imageType;
     d.url = std::move(imageUrl);
     d.show = m_show;
@@ -7,7 +7,6 @@
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDateTime>
-#include <QDomDocument>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -25,10 +24,9 @@ static void createAndCompareSingleEpisode(const QString& filename, Callback call
     TvShowEpisode episode;
     QString episodeContent = getFileContent(filename);
 
-    mediaelch::kodi::EpisodeXmlReader reader(episode);
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+    using mediaelch::kodi::EpisodeXmlReader;
+    EpisodeXmlReader reader(episode);
+    REQUIRE(reader.parse(EpisodeXmlReader::makeValidEpisodeXml(episodeContent), 0));
 
     callback(episode);
 
@@ -47,16 +45,17 @@ static void createAndCompareMultiEpisode(const QString& filename, Callback callb
     QVector<TvShowEpisode*> episodesPointer;
     QString episodeContent = getFileContent(filename);
 
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    QDomNodeList detailTags = doc.elementsByTagName("episodedetails");
-
-    for (int i = 0; i < detailTags.size(); ++i) {
-        episodes.push_back(std::make_unique<TvShowEpisode>());
-        episodesPointer.push_back(episodes.back().get());
-
-        mediaelch::kodi::EpisodeXmlReader reader(*episodesPointer.last());
-        reader.parseNfoDom(detailTags.at(i).toElement());
+    using mediaelch::kodi::EpisodeXmlReader;
+    const QString episodesXml = EpisodeXmlReader::makeValidEpisodeXml(episodeContent);
+
+    for (int i = 0;; ++i) {
+        auto episode = std::make_unique<TvShowEpisode>();
+        EpisodeXmlReader reader(*episode);
+        if (!reader.parse(episodesXml, i)) {
+            break;
+        }
+        episodesPointer.push_back(episode.get());
+        episodes.push_back(std::move(episode));
     }
 
     callback(episodesPointer);
@@ -108,10 +107,7 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
         CAPTURE(filename);
 
         EpisodeXmlReader reader(episode);
-
-        QDomDocument doc;
-        doc.setContent(episodeContent);
-        reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+        REQUIRE(reader.parse(EpisodeXmlReader::makeValidEpisodeXml(episodeContent), 0));
 
         mediaelch::kodi::EpisodeXmlWriterGeneric writer(mediaelch::KodiVersion(18), {&episode});
         QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
@@ -149,5 +145,11 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
                 CHECK(e->actors().size() == 16);
             }
         });
+
+        using mediaelch::kodi::EpisodeXmlReader;
+        const QString episodesXml = EpisodeXmlReader::makeValidEpisodeXml(getFileContent(filename));
+        CHECK(EpisodeXmlReader::findEpisodeDetails(episodesXml, SeasonNumber(2), EpisodeNumber(3)) == 1);
+        CHECK(EpisodeXmlReader::findEpisodeDetails(episodesXml, SeasonNumber(2), EpisodeNumber(4)) == 0);
+        CHECK(EpisodeXmlReader::findEpisodeDetails(episodesXml, SeasonNumber(2), EpisodeNumber(5)) == -1);
     }
 }
@@ -6,7 +6,7 @@
 #include "test/integration/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,9 @@ static void createAndCompareMovie(const QString& filename, Callback callback)
     QString movieContent = getFileContent(filename);
 
     mediaelch::kodi::MovieXmlReader reader(movie);
-    QDomDocument doc;
-    doc.setContent(movieContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(movieContent);
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     callback(movie);
 
@@ -0,0 +1,143 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "data/Subtitle.h"
+#include "movies/Movie.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <algorithm>
+
+using namespace mediaelch;
+
+static Movie* createMovie(const QString& file, QObject* parent)
+{
+    auto* movie = new Movie({}, parent);
+    movie->setFiles(QStringList{file});
+    movie->setFileLastModified(QDateTime(QDate(2020, 5, 17), QTime(12, 30, 15)));
+    movie->setNfoContent(QStringLiteral("<movie><title>%1</title></movie>").arg(file));
+    return movie;
+}
+
+static QVector<Movie*> sortedByFile(QVector<Movie*> movies)
+{
+    std::sort(movies.begin(), movies.end(), [](Movie* lhs, Movie* rhs) { //
+        return lhs->files().first().toString() < rhs->files().first().toString();
+    });
+    return movies;
+}
+
+TEST_CASE("Database stores and loads movies", "[data][database]")
+{
+    Database db(":memory:", nullptr);
+    QObject parent;
+    const DirectoryPath dir("/movies");
+
+    SECTION("all columns are loaded into the correct movie attributes")
+    {
+        Movie* plain = createMovie("/movies/A/A.mkv", &parent);
+
+        Movie* flags = createMovie("/movies/B/B.cd1.avi", &parent);
+        flags->setFiles(QStringList{"/movies/B/B.cd1.avi", "/movies/B/B.cd2.avi"});
+        flags->setInSeparateFolder(true);
+        flags->setDiscType(DiscType::BluRay);
+        flags->images().setHasImage(ImageType::MoviePoster, true);
+        flags->images().setHasImage(ImageType::MovieBackdrop, false);
+        flags->images().setHasImage(ImageType::MovieLogo, true);
+        flags->images().setHasImage(ImageType::MovieClearArt, false);
+        flags->images().setHasImage(ImageType::MovieCdArt, true);
+        flags->images().setHasImage(ImageType::MovieBanner, false);
+        flags->images().setHasImage(ImageType::MovieThumb, true);
+        flags->images().setHasExtraFanarts(true);
+        auto* subtitle = new Subtitle(flags);
+        subtitle->setFiles({"/movies/B/B.de.srt"});
+        subtitle->setLanguage("de");
+        subtitle->setForced(true);
+        flags->addSubtitle(subtitle, true);
+
+        // Labels are restored from the first file, see Database::getLabel().
+        Movie* labeled = createMovie("/movies/C/C.mkv", &parent);
+        db.setLabel(labeled->files(), ColorLabel::Green);
+
+        REQUIRE(db.addMovies({plain, flags, labeled}, dir));
+        CHECK(plain->databaseId() >= 0);
+        CHECK(flags->databaseId() >= 0);
+        CHECK(labeled->label() == ColorLabel::Green);
+
+        const QVector<Movie*> movies = sortedByFile(db.moviesInDirectory(dir, &parent));
+        REQUIRE(movies.size() == 3);
+
+        const Movie* a = movies[0];
+        CHECK(a->databaseId() == plain->databaseId());
+        CHECK(a->files() == plain->files());
+        CHECK(a->nfoContent() == plain->nfoContent());
+        CHECK(a->fileLastModified() == plain->fileLastModified());
+        CHECK_FALSE(a->inSeparateFolder());
+        CHECK(a->discType() == DiscType::Single);
+        CHECK(a->label() == ColorLabel::NoLabel);
+        CHECK_FALSE(a->images().hasImage(ImageType::MoviePoster));
+        CHECK_FALSE(a->images().hasExtraFanarts());
+        CHECK(a->subtitles().isEmpty());
+
+        Movie* b = movies[1];
+        CHECK(b->databaseId() == flags->databaseId());
+        CHECK(b->files() == flags->files());
+        CHECK(b->inSeparateFolder());
+        CHECK(b->discType() == DiscType::BluRay);
+        CHECK(b->images().hasImage(ImageType::MoviePoster));
+        CHECK_FALSE(b->images().hasImage(ImageType::MovieBackdrop));
+        CHECK(b->images().hasImage(ImageType::MovieLogo));
+        CHECK_FALSE(b->images().hasImage(ImageType::MovieClearArt));
+        CHECK(b->images().hasImage(ImageType::MovieCdArt));
+        CHECK_FALSE(b->images().hasImage(ImageType::MovieBanner));
+        CHECK(b->images().hasImage(ImageType::MovieThumb));
+        CHECK(b->images().hasExtraFanarts());
+        REQUIRE(b->subtitles().size() == 1);
+        CHECK(b->subtitles().first()->files() == QStringList{"/movies/B/B.de.srt"});
+        CHECK(b->subtitles().first()->language() == "de");
+        CHECK(b->subtitles().first()->forced());
+
+        CHECK(movies[2]->label() == ColorLabel::Green);
+    }
+
+    SECTION("only movies of the given directory are loaded")
+    {
+        REQUIRE(db.addMovies({createMovie("/movies/A/A.mkv", &parent)}, dir));
+        REQUIRE(db.addMovies({createMovie("/other/B/B.mkv", &parent)}, DirectoryPath("/other")));
+
+        const QVector<Movie*> movies = db.moviesInDirectory(dir, &parent);
+        REQUIRE(movies.size() == 1);
+        CHECK(movies.first()->files().first().toString() == "/movies/A/A.mkv");
+    }
+}
+
+TEST_CASE("Database benchmark", "[data][database][.benchmark]")
+{
+    // Not run by default. Run with: mediaelch_unit "[benchmark]"
+    Database db(":memory:", nullptr);
+    QObject parent;
+    const DirectoryPath dir("/movies");
+
+    QVector<Movie*> movies;
+    movies.reserve(50000);
+    for (int i = 0; i < 50000; ++i) {
+        const QString movieDir = QStringLiteral("/movies/Movie %1/").arg(i);
+        Movie* movie = createMovie(movieDir + QStringLiteral("Movie %1.mkv").arg(i), &parent);
+        if (i % 10 == 0) {
+            movie->setFiles(QStringList{movieDir + "Movie cd1.avi", movieDir + "Movie cd2.avi"});
+        }
+        movie->images().setHasImage(ImageType::MoviePoster, i % 2 == 0);
+        movies << movie;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    REQUIRE(db.addMovies(movies, dir));
+    const qint64 addTime = timer.restart();
+    const QVector<Movie*> loaded = db.moviesInDirectory(dir, &parent);
+    const qint64 loadTime = timer.elapsed();
+
+    WARN("Database: addMovies " << addTime << "ms, moviesInDirectory " << loadTime << "ms for " << movies.size()
+                                << " movies");
+    CHECK(loaded.size() == movies.size());
+}
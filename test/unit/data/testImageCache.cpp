@@ -0,0 +1,203 @@
+#include "test/test_helpers.h"
+
+#include "data/ImageCache.h"
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QTemporaryDir>
+
+namespace {
+
+mediaelch::FilePath createImage(const QTemporaryDir& dir, const QString& fileName, QSize size)
+{
+    // A gradient, so that larger thumbnails result in larger files.
+    QImage img(size, QImage::Format_RGB32);
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x) {
+            img.setPixel(x, y, qRgb(x % 256, y % 256, (x * y) % 256));
+        }
+    }
+    const QString path = dir.filePath(fileName);
+    REQUIRE(img.save(path, "png"));
+    return mediaelch::FilePath(path);
+}
+
+void waitForRequests(const ImageCache& cache)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (cache.pendingRequestCount() > 0 && timer.elapsed() < 10000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+    REQUIRE(cache.pendingRequestCount() == 0);
+}
+
+} // namespace
+
+TEST_CASE("ImageCache", "[data][image]")
+{
+    QTemporaryDir sourceDir;
+    QTemporaryDir cacheDir;
+    REQUIRE(sourceDir.isValid());
+    REQUIRE(cacheDir.isValid());
+    const mediaelch::DirectoryPath cachePath(cacheDir.path());
+    const qint64 maxSize = 10 * 1024 * 1024;
+
+    const mediaelch::FilePath poster = createImage(sourceDir, "poster.png", {400, 300});
+    int origWidth = 0;
+    int origHeight = 0;
+
+    SECTION("thumbnails are cached and found again after a restart")
+    {
+        {
+            ImageCache cache(cachePath, maxSize, false);
+            QImage img = cache.image(poster, 100, 0, origWidth, origHeight);
+            CHECK(img.size() == QSize(100, 75));
+            CHECK(origWidth == 400);
+            CHECK(origHeight == 300);
+            CHECK(cache.thumbnailCount() == 1);
+            CHECK(cache.cacheSize() > 0);
+
+            origWidth = 0;
+            img = cache.image(poster, 100, 0, origWidth, origHeight);
+            CHECK(img.size() == QSize(100, 75));
+            CHECK(origWidth == 400);
+            CHECK(cache.thumbnailCount() == 1);
+            CHECK(cache.imageSize(poster) == QSize(400, 300));
+            // The index is saved when the cache is destroyed.
+        }
+        {
+            ImageCache cache(cachePath, maxSize, false);
+            CHECK(cache.thumbnailCount() == 1);
+            CHECK(cache.imageSize(poster) == QSize(400, 300));
+
+            cache.invalidateImages(poster);
+            CHECK(cache.thumbnailCount() == 0);
+            CHECK(cache.cacheSize() == 0);
+        }
+    }
+
+    SECTION("least recently used thumbnails are removed if the cache is too large")
+    {
+        qint64 smallSize = 0;
+        qint64 totalSize = 0;
+        {
+            ImageCache cache(cachePath, maxSize, false);
+            Q_UNUSED(cache.image(poster, 40, 0, origWidth, origHeight));
+            smallSize = cache.cacheSize();
+            Q_UNUSED(cache.image(poster, 0, 300, origWidth, origHeight));
+            // Use the small thumbnail again, so that the large one is removed first.
+            Q_UNUSED(cache.image(poster, 40, 0, origWidth, origHeight));
+            REQUIRE(cache.thumbnailCount() == 2);
+            totalSize = cache.cacheSize();
+        }
+        // Eviction stops at 90% of the maximum size, which must still fit the small thumbnail.
+        REQUIRE(smallSize <= (totalSize - 1) / 10 * 9);
+
+        ImageCache cache(cachePath, totalSize - 1, false);
+        CHECK(cache.thumbnailCount() == 1);
+        CHECK(cache.cacheSize() == smallSize);
+    }
+
+    SECTION("images are loaded in the background")
+    {
+        ImageCache cache(cachePath, maxSize, false);
+        QObject receiver;
+        QImage loaded;
+        QSize originalSize;
+        int callbackCount = 0;
+        const auto callback = [&](QImage image, QSize size) {
+            loaded = std::move(image);
+            originalSize = size;
+            ++callbackCount;
+        };
+
+        cache.requestImage(poster, 100, 0, ImageCache::Priority::Low, &receiver, callback);
+        // Same thumbnail: decoded only once
+        cache.requestImage(poster, 100, 0, ImageCache::Priority::High, &receiver, callback);
+        waitForRequests(cache);
+        CHECK(callbackCount == 2);
+        CHECK(loaded.size() == QSize(100, 75));
+        CHECK(originalSize == QSize(400, 300));
+        CHECK(cache.thumbnailCount() == 1);
+
+        // Now read from the thumbnail
+        loaded = QImage();
+        cache.requestImage(poster, 100, 0, ImageCache::Priority::High, &receiver, callback);
+        waitForRequests(cache);
+        CHECK(callbackCount == 3);
+        CHECK(loaded.size() == QSize(100, 75));
+        CHECK(originalSize == QSize(400, 300));
+
+        // Same result as the synchronous version
+        CHECK(cache.image(poster, 100, 0, origWidth, origHeight).size() == QSize(100, 75));
+        CHECK(cache.thumbnailCount() == 1);
+    }
+
+    SECTION("cancelled requests don't call the callback")
+    {
+        ImageCache cache(cachePath, maxSize, false);
+        QObject receiver;
+        int callbackCount = 0;
+        const auto callback = [&](QImage /*image*/, QSize /*size*/) { ++callbackCount; };
+
+        const ImageCache::RequestId cancelled =
+            cache.requestImage(poster, 50, 0, ImageCache::Priority::Low, &receiver, callback);
+        cache.cancelRequest(cancelled);
+        CHECK(cache.pendingRequestCount() == 0);
+
+        {
+            QObject destroyedReceiver;
+            cache.requestImage(poster, 60, 0, ImageCache::Priority::Low, &destroyedReceiver, callback);
+        }
+        waitForRequests(cache);
+        CHECK(callbackCount == 0);
+    }
+
+    SECTION("invalidated decodes don't remove the thumbnail of a newer decode")
+    {
+        ImageCache cache(cachePath, maxSize, false);
+        QObject receiver;
+        int callbackCount = 0;
+        const auto callback = [&](QImage /*image*/, QSize /*size*/) { ++callbackCount; };
+
+        cache.requestImage(poster, 100, 0, ImageCache::Priority::High, &receiver, callback);
+        cache.invalidateImages(poster);
+        // Not merged with the invalidated decode; both write the same thumbnail file.
+        cache.requestImage(poster, 100, 0, ImageCache::Priority::High, &receiver, callback);
+        waitForRequests(cache);
+        CHECK(callbackCount == 2);
+        CHECK(cache.thumbnailCount() == 1);
+
+        int files = 0;
+        QDirIterator it(cacheDir.path(), {"*.jpg", "*.png"}, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            ++files;
+        }
+        CHECK(files == 1);
+    }
+
+    SECTION("images that can't be read result in a null image")
+    {
+        ImageCache cache(cachePath, maxSize, false);
+        QObject receiver;
+        bool called = false;
+        QImage loaded(1, 1, QImage::Format_RGB32);
+        cache.requestImage(mediaelch::FilePath(sourceDir.filePath("missing.jpg")),
+            100,
+            0,
+            ImageCache::Priority::High,
+            &receiver,
+            [&](QImage image, QSize /*size*/) {
+                loaded = std::move(image);
+                called = true;
+            });
+        waitForRequests(cache);
+        CHECK(called);
+        CHECK(loaded.isNull());
+        CHECK(cache.thumbnailCount() == 0);
+    }
+}
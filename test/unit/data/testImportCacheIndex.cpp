@@ -0,0 +1,41 @@
+#include "test/test_helpers.h"
+
+#include "data/ImportCacheIndex.h"
+
+using namespace mediaelch;
+
+TEST_CASE("ImportCacheIndex finds the most similar file name", "[data]")
+{
+    ImportCacheIndex index;
+    CHECK(index.bestMatch("Some.Show.S01E01.720p", 0.7) == nullptr);
+
+    index.add({"Some.Show.S01E01.720p", "tvshow", "/shows/Some Show"});
+    index.add({"Another.Movie.2019.1080p", "movie", "/movies"});
+    index.add({"Some.Show.S01E02.720p", "tvshow", "/shows/Some Show (copy)"});
+    REQUIRE(index.size() == 3);
+
+    SECTION("most similar entry")
+    {
+        const auto* entry = index.bestMatch("Some.Show.S01E03.720p", 0.7);
+        REQUIRE(entry != nullptr);
+        // Both episodes are equally similar; the first one wins.
+        CHECK(entry->path == "/shows/Some Show");
+
+        entry = index.bestMatch("Another.Movie.2019.720p", 0.7);
+        REQUIRE(entry != nullptr);
+        CHECK(entry->type == "movie");
+    }
+
+    SECTION("nothing similar enough")
+    {
+        CHECK(index.bestMatch("Completely.Different.Name", 0.7) == nullptr);
+        CHECK(index.bestMatch("", 0.7) == nullptr);
+    }
+
+    SECTION("entries without common trigrams are found for low thresholds")
+    {
+        const auto* entry = index.bestMatch("xAxoxhxrxMxvxex2x1x", 0.3);
+        REQUIRE(entry != nullptr);
+        CHECK(entry->type == "movie");
+    }
+}
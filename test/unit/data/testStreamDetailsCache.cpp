@@ -0,0 +1,110 @@
+#include "test/test_helpers.h"
+
+#include "data/StreamDetails.h"
+#include "data/StreamDetailsCache.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+QString createFile(const QTemporaryDir& dir, const QString& fileName, const QByteArray& content)
+{
+    const QString path = dir.filePath(fileName);
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(content);
+    file.close();
+    return path;
+}
+
+StreamDetails::Values exampleValues()
+{
+    StreamDetails::Values values;
+    values.videoDetails.insert(StreamDetails::VideoDetails::Codec, "h264");
+    values.videoDetails.insert(StreamDetails::VideoDetails::Width, "1920");
+    values.audioDetails << QMap<StreamDetails::AudioDetails, QString>{{StreamDetails::AudioDetails::Language, "eng"},
+        {StreamDetails::AudioDetails::Codec, "ac3"},
+        {StreamDetails::AudioDetails::Channels, "6"}};
+    values.subtitleDetails << QMap<StreamDetails::SubtitleDetails, QString>{
+        {StreamDetails::SubtitleDetails::Language, "ger"}};
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("StreamDetailsCache", "[data][stream_details]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = createFile(dir, "movie.mkv", "some content");
+
+    SECTION("key changes if the file changes")
+    {
+        const QString key = StreamDetailsCache::key(FileList(QStringList{path}));
+        CHECK_FALSE(key.isEmpty());
+        CHECK(key == StreamDetailsCache::key(FileList(QStringList{path})));
+
+        createFile(dir, "movie.mkv", "some other content");
+        CHECK(key != StreamDetailsCache::key(FileList(QStringList{path})));
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        const QString sameSizeKey = StreamDetailsCache::key(FileList(QStringList{path}));
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::ReadWrite));
+        REQUIRE(file.setFileTime(QDateTime::currentDateTime().addDays(-1), QFileDevice::FileModificationTime));
+        file.close();
+        CHECK(sameSizeKey != StreamDetailsCache::key(FileList(QStringList{path})));
+#endif
+    }
+
+    SECTION("key is empty if a file does not exist")
+    {
+        CHECK(StreamDetailsCache::key(FileList(QStringList{dir.filePath("missing.mkv")})).isEmpty());
+        CHECK(StreamDetailsCache::key(FileList(QStringList{path, dir.filePath("missing.mkv")})).isEmpty());
+    }
+
+    SECTION("details can be found by key")
+    {
+        StreamDetailsCache cache;
+        const QString key = StreamDetailsCache::key(FileList(QStringList{path}));
+        StreamDetails::Values found;
+        CHECK_FALSE(cache.find(key, found));
+
+        cache.insert(key, exampleValues());
+        REQUIRE(cache.find(key, found));
+        CHECK(found.videoDetails == exampleValues().videoDetails);
+        CHECK(found.audioDetails == exampleValues().audioDetails);
+        CHECK(cache.size() == 1);
+
+        cache.insert("", exampleValues());
+        CHECK(cache.size() == 1);
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+        CHECK_FALSE(cache.find(key, found));
+    }
+}
+
+TEST_CASE("StreamDetails values", "[data][stream_details]")
+{
+    StreamDetails details(nullptr, {});
+    details.setValues(exampleValues());
+
+    CHECK(details.videoCodec() == "h264");
+    CHECK(details.audioCodec() == "ac3");
+    CHECK(details.hasAudioChannels(6));
+    CHECK(details.hasSubtitles());
+
+    const StreamDetails::Values values = details.values();
+    CHECK(values.videoDetails == exampleValues().videoDetails);
+    CHECK(values.audioDetails == exampleValues().audioDetails);
+    CHECK(values.subtitleDetails == exampleValues().subtitleDetails);
+
+    details.setValues({});
+    CHECK_FALSE(details.hasAudioChannels(6));
+    CHECK_FALSE(details.hasSubtitles());
+}
@@ -0,0 +1,134 @@
+#include "test/test_helpers.h"
+
+#include "export/CompiledTemplate.h"
+
+#include <QElapsedTimer>
+
+using namespace mediaelch;
+
+namespace {
+
+QVector<TemplateValues> items(const QString& name, const QStringList& values)
+{
+    QVector<TemplateValues> result;
+    for (const QString& value : values) {
+        TemplateValues item;
+        item.set(name, value);
+        result << item;
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("CompiledTemplate", "[export]")
+{
+    SECTION("placeholders are replaced")
+    {
+        CompiledTemplate tmpl("<h1>{{ MOVIE.TITLE }}</h1> ({{ MOVIE.YEAR }}) {{ MOVIE.TITLE }}");
+        TemplateValues values;
+        values.set("MOVIE.TITLE", "Alien");
+        values.set("MOVIE.YEAR", "1979");
+        CHECK(tmpl.render(values) == "<h1>Alien</h1> (1979) Alien");
+    }
+
+    SECTION("unknown placeholders and text are kept")
+    {
+        const QString source = "{{ UNKNOWN }} {{MOVIE.TITLE}} {{ {{ A }} }} {{ BEGIN_BLOCK_X }} {{ END_BLOCK_Y }} {{";
+        CompiledTemplate tmpl(source);
+        TemplateValues values;
+        values.set("A", "a");
+        CHECK(tmpl.render(values) == "{{ UNKNOWN }} {{MOVIE.TITLE}} {{ a }} {{ BEGIN_BLOCK_X }} {{ END_BLOCK_Y }} {{");
+        CHECK(tmpl.render(TemplateValues{}) == source);
+    }
+
+    SECTION("blocks are repeated for each item")
+    {
+        CompiledTemplate tmpl("Tags: {{ BEGIN_BLOCK_TAGS }}\n  <b>{{ TAG.NAME }}</b>\n{{ END_BLOCK_TAGS }}!");
+        TemplateValues values;
+        values.setBlock("TAGS", items("TAG.NAME", {"a", "b", "c"}));
+        CHECK(tmpl.render(values) == "Tags: <b>a</b> <b>b</b> <b>c</b>!");
+
+        values.setBlock("TAGS", {});
+        CHECK(tmpl.render(values) == "Tags: !");
+
+        values.setBlockContent("TAGS", "none");
+        CHECK(tmpl.render(values) == "Tags: none!");
+
+        CHECK(tmpl.render(TemplateValues{})
+              == "Tags: {{ BEGIN_BLOCK_TAGS }}\n  <b>{{ TAG.NAME }}</b>\n{{ END_BLOCK_TAGS }}!");
+    }
+
+    SECTION("block items fall back to enclosing values")
+    {
+        CompiledTemplate tmpl("{{ BEGIN_BLOCK_SEASON }}{{ SHOW }} {{ SEASON }}: "
+                              "{{ BEGIN_BLOCK_EPISODE }}{{ SEASON }}x{{ EPISODE }}{{ END_BLOCK_EPISODE }}"
+                              "{{ END_BLOCK_SEASON }}");
+        CHECK(tmpl.containsBlock("SEASON"));
+        CHECK(tmpl.containsBlock("EPISODE"));
+        CHECK_FALSE(tmpl.containsBlock("ACTORS"));
+
+        TemplateValues first;
+        first.set("SEASON", "1");
+        first.setBlock("EPISODE", items("EPISODE", {"1", "2"}), ", ");
+        TemplateValues second;
+        second.set("SEASON", "2");
+        second.setBlock("EPISODE", items("EPISODE", {"1"}), ", ");
+
+        TemplateValues values;
+        values.set("SHOW", "Show");
+        values.setBlock("SEASON", {first, second}, "\n");
+        CHECK(tmpl.render(values) == "Show 1: 1x1, 1x2\nShow 2: 2x1");
+
+        CompiledTemplate episodes = tmpl.block("EPISODE");
+        CHECK(episodes.render(second) == "2x{{ EPISODE }}");
+        CHECK(tmpl.block("ACTORS").isEmpty());
+    }
+
+    SECTION("images are resolved by the innermost values that know them")
+    {
+        CompiledTemplate tmpl("{{ IMAGE.POSTER[150, 225] }} {{ BEGIN_BLOCK_EPISODE }}{{ IMAGE.THUMBNAIL[10,20] }} "
+                              "{{ IMAGE.POSTER[1, 2] }}{{ END_BLOCK_EPISODE }} {{ IMAGE.POSTER[0, 1] }}");
+        TemplateValues episode;
+        episode.setImageResolver([](const QString& type, const QSize& size, QString& replacement) {
+            if (type != "thumbnail") {
+                return false;
+            }
+            replacement = QStringLiteral("episode_%1x%2").arg(size.width()).arg(size.height());
+            return true;
+        });
+        TemplateValues values;
+        values.setImageResolver([](const QString& type, const QSize& size, QString& replacement) {
+            replacement = QStringLiteral("show_%1_%2x%3").arg(type).arg(size.width()).arg(size.height());
+            return true;
+        });
+        values.setBlock("EPISODE", {episode});
+        CHECK(tmpl.render(values) == "show_poster_150x225 episode_10x20 show_poster_1x2 {{ IMAGE.POSTER[0, 1] }}");
+    }
+}
+
+TEST_CASE("CompiledTemplate benchmark", "[export][.benchmark]")
+{
+    // Not run by default. Run with: mediaelch_unit "[benchmark]"
+    QString source;
+    for (int i = 0; i < 40; ++i) {
+        source += QStringLiteral("<p class=\"value-%1\">{{ MOVIE.VALUE_%1 }}</p>\n").arg(i);
+    }
+    source += "{{ BEGIN_BLOCK_ACTORS }}<li>{{ ACTOR.NAME }}</li>{{ END_BLOCK_ACTORS }}";
+
+    TemplateValues values;
+    for (int i = 0; i < 40; ++i) {
+        values.set(QStringLiteral("MOVIE.VALUE_%1").arg(i), QStringLiteral("Some value %1").arg(i));
+    }
+    values.setBlock("ACTORS", items("ACTOR.NAME", {"Actor A", "Actor B", "Actor C", "Actor D"}));
+
+    QElapsedTimer timer;
+    timer.start();
+    const CompiledTemplate tmpl(source);
+    elch_size_t size = 0;
+    for (int i = 0; i < 40000; ++i) {
+        size += tmpl.render(values).size();
+    }
+    WARN("CompiledTemplate: " << timer.elapsed() << "ms for 40000 pages");
+    CHECK(size > 0);
+}
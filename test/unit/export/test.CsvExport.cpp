@@ -0,0 +1,148 @@
+#include "test/test_helpers.h"
+
+#include "export/CsvExport.h"
+#include "movies/Movie.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QElapsedTimer>
+
+using namespace mediaelch;
+
+TEST_CASE("CsvMovieExport", "[export][csv]")
+{
+    using Field = CsvMovieExport::Field;
+
+    Movie first;
+    first.setName("=Alien");
+    first.setOverview("Line 1\nLine 2; with separator");
+    first.setUserRating(7.5);
+    first.setTop250(-1);
+    first.setRuntime(std::chrono::minutes(117));
+    first.addGenre("Horror");
+    first.addGenre("Sci-Fi");
+    Movie second;
+    second.setName("Aliens");
+    const QVector<Movie*> movies{&first, &second};
+
+    QString output;
+    QTextStream stream(&output);
+    int callbackCount = 0;
+
+    SECTION("only selected fields are written in the given order")
+    {
+        CsvMovieExport exporter(
+            stream, {Field::UserRating, Field::Title, Field::Runtime, Field::Genres, Field::IsImdbTop250});
+        exporter.setSeparator(";");
+        exporter.exportMovies(movies, [&]() { ++callbackCount; });
+        stream.flush();
+
+        CHECK(callbackCount == 2);
+        CHECK(output
+              == "movie_user_rating;movie_title;movie_runtime;movie_genres;movie_top250\n"
+                 "7.5;'=Alien;117;Horror, Sci-Fi;'-1\n"
+                 "0;Aliens;0;;0\n");
+    }
+
+    SECTION("separators and newlines are replaced")
+    {
+        CsvMovieExport exporter(stream, {Field::Overview});
+        exporter.setSeparator(";");
+        exporter.setReplacement(",");
+        exporter.exportMovies({&first}, [&]() { ++callbackCount; });
+        stream.flush();
+
+        CHECK(output == "movie_overview\nLine 1\\nLine 2, with separator\n");
+    }
+
+    SECTION("nothing is written without fields")
+    {
+        CsvMovieExport exporter(stream, {});
+        exporter.exportMovies(movies, [&]() { ++callbackCount; });
+        stream.flush();
+
+        CHECK(callbackCount == 0);
+        CHECK(output.isEmpty());
+    }
+
+    SECTION("canceled exports stop early")
+    {
+        std::atomic_bool canceled{false};
+        CsvMovieExport exporter(stream, {Field::Title});
+        exporter.setCancelFlag(&canceled);
+        exporter.exportMovies(movies, [&]() {
+            ++callbackCount;
+            canceled = true;
+        });
+        stream.flush();
+
+        CHECK(callbackCount == 1);
+        CHECK(output == "movie_title\n'=Alien\n");
+    }
+}
+
+TEST_CASE("CsvTvEpisodeExport", "[export][csv]")
+{
+    using Field = CsvTvEpisodeExport::Field;
+
+    TvShow show;
+    show.setTitle("Show");
+    auto* episode = new TvShowEpisode({}, &show);
+    episode->setTitle("Pilot");
+    episode->setSeason(SeasonNumber(1));
+    episode->setEpisode(EpisodeNumber(2));
+    episode->setFirstAired(QDate(2020, 1, 2));
+    episode->setWriters({"Writer A", "Writer B"});
+    show.addEpisode(episode);
+
+    QString output;
+    QTextStream stream(&output);
+    CsvTvEpisodeExport exporter(stream,
+        {Field::ShowTitle,
+            Field::EpisodeSeason,
+            Field::EpisodeNumber,
+            Field::EpisodeTitle,
+            Field::EpisodeFirstAired,
+            Field::EpisodeWriters});
+    exporter.exportEpisodes({&show}, []() {});
+    stream.flush();
+
+    CHECK(output
+          == "show_title\tepisode_season\tepisode_number\tepisode_title\tepisode_first_aired\tepisode_writers\n"
+             "Show\t1\t2\tPilot\t2020-01-02\tWriter A, Writer B\n");
+}
+
+TEST_CASE("CsvTvEpisodeExport benchmark", "[export][csv][.benchmark]")
+{
+    // Not run by default. Run with: mediaelch_unit "[benchmark]"
+    using Field = CsvTvEpisodeExport::Field;
+
+    TvShow show;
+    show.setTitle("Show");
+    for (int i = 0; i < 250000; ++i) {
+        auto* episode = new TvShowEpisode({}, &show);
+        episode->setTitle(QStringLiteral("Episode %1").arg(i));
+        episode->setSeason(SeasonNumber(i / 100));
+        episode->setEpisode(EpisodeNumber(i % 100));
+        episode->setOverview("Some overview that is a bit longer than the title of the episode.");
+        show.addEpisode(episode);
+    }
+
+    QString output;
+    QTextStream stream(&output);
+    CsvTvEpisodeExport exporter(stream,
+        {Field::ShowTitle,
+            Field::EpisodeSeason,
+            Field::EpisodeNumber,
+            Field::EpisodeTitle,
+            Field::EpisodeOverview,
+            Field::EpisodeUserRating,
+            Field::EpisodeFilenames});
+
+    QElapsedTimer timer;
+    timer.start();
+    exporter.exportEpisodes({&show}, []() {});
+    stream.flush();
+    WARN("CsvTvEpisodeExport: " << timer.elapsed() << "ms for 250000 episodes");
+    CHECK(output.size() > 0);
+}
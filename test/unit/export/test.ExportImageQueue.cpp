@@ -0,0 +1,91 @@
+#include "test/test_helpers.h"
+
+#include "export/ExportImageQueue.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+QString createImage(const QTemporaryDir& dir, const QString& fileName)
+{
+    QImage img(QSize(400, 600), QImage::Format_RGB32);
+    img.fill(Qt::darkCyan);
+    const QString path = dir.filePath(fileName);
+    REQUIRE(img.save(path, "png"));
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("ExportImageQueue", "[export][image]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString poster = createImage(dir, "poster.png");
+    std::atomic_bool cancelFlag{false};
+
+    SECTION("images are scaled once per size")
+    {
+        ExportImageQueue queue(cancelFlag);
+        queue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+        queue.add(poster, dir.filePath("2-poster_100x150.jpg"), QSize(100, 150));
+        queue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+        queue.add(poster, dir.filePath("1-poster_50x75.jpg"), QSize(50, 75));
+        queue.add(poster, dir.filePath("1-poster_50x75.png"), QSize(50, 75));
+        REQUIRE(queue.waitForDone(10000));
+        queue.add(poster, dir.filePath("3-poster_100x150.jpg"), QSize(100, 150));
+        REQUIRE(queue.waitForDone(10000));
+
+        CHECK(queue.scaledCount() == 3);
+        CHECK(QImage(dir.filePath("1-poster_100x150.jpg")).size() == QSize(100, 150));
+        CHECK(QImage(dir.filePath("2-poster_100x150.jpg")).size() == QSize(100, 150));
+        CHECK(QImage(dir.filePath("3-poster_100x150.jpg")).size() == QSize(100, 150));
+        CHECK(QImage(dir.filePath("1-poster_50x75.jpg")).size() == QSize(50, 75));
+        CHECK(QImage(dir.filePath("1-poster_50x75.png")).size() == QSize(50, 75));
+    }
+
+    SECTION("up to date images are skipped")
+    {
+        {
+            ExportImageQueue queue(cancelFlag);
+            queue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+            queue.add(poster, dir.filePath("2-poster_100x150.jpg"), QSize(100, 150));
+        }
+
+        ExportImageQueue queue(cancelFlag);
+        queue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+        queue.add(poster, dir.filePath("2-poster_100x150.jpg"), QSize(100, 150));
+        REQUIRE(queue.waitForDone(10000));
+        CHECK(queue.scaledCount() == 0);
+        CHECK(queue.skippedCount() == 2);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        QFile file(dir.filePath("1-poster_100x150.jpg"));
+        REQUIRE(file.open(QIODevice::ReadWrite));
+        REQUIRE(file.setFileTime(QDateTime::currentDateTime().addDays(-1), QFileDevice::FileModificationTime));
+        file.close();
+
+        ExportImageQueue outdatedQueue(cancelFlag);
+        outdatedQueue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+        REQUIRE(outdatedQueue.waitForDone(10000));
+        CHECK(outdatedQueue.scaledCount() == 1);
+#endif
+    }
+
+    SECTION("missing images and cancelled exports are ignored")
+    {
+        ExportImageQueue queue(cancelFlag);
+        queue.add(dir.filePath("missing.png"), dir.filePath("missing_100x150.jpg"), QSize(100, 150));
+        cancelFlag = true;
+        queue.add(poster, dir.filePath("1-poster_100x150.jpg"), QSize(100, 150));
+        REQUIRE(queue.waitForDone(10000));
+        CHECK(queue.scaledCount() == 0);
+        CHECK_FALSE(QFile::exists(dir.filePath("missing_100x150.jpg")));
+        CHECK_FALSE(QFile::exists(dir.filePath("1-poster_100x150.jpg")));
+    }
+}
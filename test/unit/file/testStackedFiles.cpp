@@ -0,0 +1,89 @@
+#include "test/test_helpers.h"
+
+#include "file/FilenameUtils.h"
+
+#include <QElapsedTimer>
+
+using namespace mediaelch::file;
+
+TEST_CASE("isExtraFile", "[filename]")
+{
+    CHECK(isExtraFile("movie-trailer.mkv"));
+    CHECK(isExtraFile("Movie-TRAILER.mkv"));
+    CHECK(isExtraFile("movie-behindthescenes.mkv"));
+    CHECK(isExtraFile("movie-shortfilm.mkv"));
+    CHECK(isExtraFile("movie - part 1-sample.mkv"));
+    CHECK_FALSE(isExtraFile("movie.mkv"));
+    CHECK_FALSE(isExtraFile("movie-trail.mkv"));
+    CHECK_FALSE(isExtraFile("movie trailer.mkv"));
+    CHECK_FALSE(isExtraFile("movie-"));
+
+    CHECK(isTrailerOrSampleFile("movie-Sample.mkv"));
+    CHECK_FALSE(isTrailerOrSampleFile("movie-featurette.mkv"));
+}
+
+TEST_CASE("groupStackedFiles", "[filename]")
+{
+    SECTION("parts and letters")
+    {
+        const QStringList files{"Film cd1.avi",
+            "Film cd2.avi",
+            "Film.cd3.avi",
+            "Film trailer.avi",
+            "Other Movie (a).mkv",
+            "Other Movie (b).mkv"};
+        const QVector<QStringList> expected{
+            {"Film cd1.avi", "Film cd2.avi", "Film.cd3.avi"},
+            {"Film trailer.avi"},
+            {"Other Movie (a).mkv", "Other Movie (b).mkv"},
+        };
+        CHECK(groupStackedFiles(files, StackingPattern::PartsAndLetters) == expected);
+    }
+
+    SECTION("only the last part marker is replaced")
+    {
+        const QStringList files{"Movie B part1.avi", "Movie B part2.avi", "Movie C part1.avi"};
+        const QVector<QStringList> expected{
+            {"Movie B part1.avi", "Movie B part2.avi"},
+            {"Movie C part1.avi"},
+        };
+        CHECK(groupStackedFiles(files, StackingPattern::PartsAndLetters) == expected);
+    }
+
+    SECTION("parts only")
+    {
+        const QStringList files{"Concert Part 1.mkv", "Concert Part 2.mkv", "Concert a.mkv", "Concert b.mkv"};
+        const QVector<QStringList> expected{
+            {"Concert Part 1.mkv", "Concert Part 2.mkv"},
+            {"Concert a.mkv"},
+            {"Concert b.mkv"},
+        };
+        CHECK(groupStackedFiles(files, StackingPattern::Parts) == expected);
+    }
+}
+
+TEST_CASE("groupStackedFiles benchmark", "[filename][.benchmark]")
+{
+    // Not run by default. Run with: mediaelch_unit "[benchmark]"
+    QStringList files;
+    files.reserve(1000000);
+    for (int i = 0; i < 250000; ++i) {
+        const QString name = QStringLiteral("Some Movie Title %1 (2021)").arg(i);
+        files << name + " cd1.mkv" << name + " cd2.mkv" << name + "-trailer.mkv" << name + ".mkv";
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int extras = 0;
+    for (const QString& file : asConst(files)) {
+        extras += isExtraFile(file) ? 1 : 0;
+    }
+    const qint64 extrasTime = timer.restart();
+    const QVector<QStringList> groups = groupStackedFiles(files, StackingPattern::PartsAndLetters);
+    const qint64 groupTime = timer.elapsed();
+
+    WARN("isExtraFile: " << extrasTime << "ms, groupStackedFiles: " << groupTime << "ms for " << files.size()
+                         << " files");
+    CHECK(extras == 250000);
+    CHECK(groups.size() == 750000);
+}
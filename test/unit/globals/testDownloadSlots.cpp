@@ -0,0 +1,66 @@
+#include "test/test_helpers.h"
+
+#include "globals/DownloadSlots.h"
+
+#include <QObject>
+#include <QStringList>
+
+TEST_CASE("DownloadSlots limits parallel downloads", "[download]")
+{
+    DownloadSlots downloadSlots;
+
+    SECTION("per host")
+    {
+        const QString host = "assets.fanart.tv";
+        REQUIRE(DownloadSlots::maxDownloadsForHost(host) == 2);
+        CHECK(downloadSlots.tryAcquire(host));
+        CHECK(downloadSlots.tryAcquire(host));
+        CHECK_FALSE(downloadSlots.tryAcquire(host));
+        // Other hosts are not affected.
+        CHECK(downloadSlots.tryAcquire("image.tmdb.org"));
+
+        downloadSlots.release(host);
+        CHECK(downloadSlots.tryAcquire(host));
+    }
+
+    SECTION("in total")
+    {
+        for (int i = 0; i < DownloadSlots::maxParallelDownloads(); ++i) {
+            REQUIRE(downloadSlots.tryAcquire(QStringLiteral("host%1.example.com").arg(i)));
+        }
+        CHECK_FALSE(downloadSlots.tryAcquire("other.example.com"));
+
+        downloadSlots.release("host0.example.com");
+        CHECK(downloadSlots.tryAcquire("other.example.com"));
+    }
+}
+
+TEST_CASE("DownloadSlots notifies waiting managers by priority", "[download]")
+{
+    DownloadSlots downloadSlots;
+    QObject background;
+    QObject normal;
+    QObject visible;
+    QObject releasing;
+    QStringList notified;
+
+    downloadSlots.setWaiting(&background, DownloadPriority::Background, [&notified]() { notified << "background"; });
+    downloadSlots.setWaiting(&visible, DownloadPriority::Visible, [&notified]() { notified << "visible"; });
+    downloadSlots.setWaiting(&normal, DownloadPriority::Background, [&notified]() { notified << "normal"; });
+    downloadSlots.setWaiting(&releasing, DownloadPriority::Visible, [&notified]() { notified << "releasing"; });
+    // The priority is updated, e.g. after a more important download was queued.
+    downloadSlots.setWaiting(&normal, DownloadPriority::Normal, [&notified]() { notified << "unused"; });
+
+    SECTION("most important downloads first, except the releasing manager")
+    {
+        downloadSlots.notifyWaiting(&releasing);
+        CHECK(notified == QStringList{"visible", "normal", "background"});
+    }
+
+    SECTION("managers that are not waiting anymore are not notified")
+    {
+        downloadSlots.removeWaiting(&visible);
+        downloadSlots.notifyWaiting(&releasing);
+        CHECK(notified == QStringList{"normal", "background"});
+    }
+}
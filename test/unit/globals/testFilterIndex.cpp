@@ -0,0 +1,180 @@
+#include "test/test_helpers.h"
+
+#include "globals/Filter.h"
+#include "globals/FilterIndex.h"
+#include "movies/Movie.h"
+#include "movies/MovieModel.h"
+
+#include <QObject>
+#include <memory>
+
+using namespace mediaelch;
+
+TEST_CASE("FilterIndex", "[globals][filter]")
+{
+    FilterIndex index;
+    QObject a;
+    QObject b;
+    const int genres = static_cast<int>(MovieFilters::Genres);
+    const int tags = static_cast<int>(MovieFilters::Tags);
+
+    SECTION("values are looked up by term id")
+    {
+        index.setValues(&a, genres, {"Action", "Drama", "", "Action"});
+        index.setValues(&b, genres, {"Drama"});
+
+        const int action = index.termId(genres, "Action");
+        const int drama = index.termId(genres, "Drama");
+        CHECK(index.hasTerm(&a, action));
+        CHECK(index.hasTerm(&a, drama));
+        CHECK_FALSE(index.hasTerm(&b, action));
+        CHECK(index.hasTerm(&b, drama));
+        // Same value but different field
+        CHECK_FALSE(index.hasTerm(&a, index.termId(tags, "Action")));
+        CHECK(index.hasValues(&a, genres));
+        CHECK_FALSE(index.hasValues(&a, tags));
+
+        QStringList values = index.values(genres);
+        values.sort();
+        CHECK(values == QStringList{"Action", "Drama"});
+    }
+
+    SECTION("term ids stay valid when items change")
+    {
+        const int comedy = index.termId(genres, "Comedy");
+        CHECK_FALSE(index.hasTerm(&a, comedy));
+        CHECK(index.values(genres).isEmpty());
+
+        index.setValues(&a, genres, {"Comedy"});
+        CHECK(index.hasTerm(&a, comedy));
+
+        index.setValues(&a, genres, {});
+        CHECK_FALSE(index.hasTerm(&a, comedy));
+        CHECK_FALSE(index.hasValues(&a, genres));
+
+        index.setValues(&a, genres, {"Comedy"});
+        index.clear();
+        CHECK(index.itemCount() == 0);
+        index.setValues(&b, genres, {"Comedy"});
+        CHECK(index.termId(genres, "Comedy") == comedy);
+        CHECK(index.hasTerm(&b, comedy));
+        CHECK_FALSE(index.hasTerm(&a, comedy));
+    }
+
+    SECTION("removed items have no values")
+    {
+        index.setValues(&a, genres, {"Action"});
+        index.setText(&a, static_cast<int>(MovieFilters::Title), "Alien");
+        CHECK(index.containsItem(&a));
+
+        index.removeItem(&a);
+        CHECK_FALSE(index.containsItem(&a));
+        CHECK_FALSE(index.hasTerm(&a, index.termId(genres, "Action")));
+        CHECK(index.text(&a, static_cast<int>(MovieFilters::Title)).isEmpty());
+        CHECK(index.values(genres).isEmpty());
+    }
+
+    SECTION("texts are case folded")
+    {
+        index.setText(&a, static_cast<int>(MovieFilters::Title), "Ärger im Paradies");
+        CHECK(index.text(&a, static_cast<int>(MovieFilters::Title)) == FilterIndex::folded("äRGER IM paradies"));
+        CHECK(index.text(&a, static_cast<int>(MovieFilters::Title)).contains(FilterIndex::folded("ÄRGER")));
+    }
+}
+
+TEST_CASE("Compiled movie filters", "[globals][filter]")
+{
+    auto model = std::make_unique<MovieModel>();
+    auto alien = std::make_unique<Movie>();
+    auto heat = std::make_unique<Movie>();
+    auto unknown = std::make_unique<Movie>();
+
+    alien->setName("Alien");
+    alien->setOriginalName("Alien - Das unheimliche Wesen");
+    alien->addGenre("Horror");
+    alien->addGenre("Science Fiction");
+    alien->addStudio("20th Century Fox");
+    alien->addCountry("USA");
+    alien->addTag("Classic");
+    alien->setDirector("Ridley Scott");
+    alien->setCertification(Certification("R"));
+    alien->setReleased(QDate(1979, 5, 25));
+    alien->setImdbId(ImdbId("tt0078748"));
+    alien->setFiles(QStringList{"/movies/Alien (1979)/Alien.mkv"});
+    alien->setLabel(ColorLabel::Red);
+
+    heat->setName("Heat");
+    heat->addGenre("Crime");
+    heat->addGenre("Drama");
+    heat->setDirector("Michael Mann");
+    heat->setReleased(QDate(1995, 12, 15));
+    MovieSet set;
+    set.name = "Heat Collection";
+    heat->setSet(set);
+    heat->setFiles(QStringList{"/movies/Heat/Heat.CD1.avi", "/movies/Heat/Heat.CD2.avi"});
+
+    model->addMovies({alien.get(), heat.get(), unknown.get()});
+
+    const QVector<Filter> filters{
+        Filter("", "alien", {}, MovieFilters::Title, true),
+        Filter("", "WESEN", {}, MovieFilters::OriginalTitle, true),
+        Filter("", "cd2", {}, MovieFilters::Path, true),
+        Filter("", "Horror", {}, MovieFilters::Genres, true),
+        Filter("", "Drama", {}, MovieFilters::Genres, true),
+        Filter("", "Comedy", {}, MovieFilters::Genres, true),
+        Filter("", "", {}, MovieFilters::Genres, false),
+        Filter("", "20th Century Fox", {}, MovieFilters::Studio, true),
+        Filter("", "", {}, MovieFilters::Studio, false),
+        Filter("", "USA", {}, MovieFilters::Country, true),
+        Filter("", "Classic", {}, MovieFilters::Tags, true),
+        Filter("", "", {}, MovieFilters::Tags, false),
+        Filter("", "Michael Mann", {}, MovieFilters::Director, true),
+        Filter("", "", {}, MovieFilters::Director, true),
+        Filter("", "Heat Collection", {}, MovieFilters::Set, true),
+        Filter("", "", {}, MovieFilters::Set, false),
+        Filter("", "R", {}, MovieFilters::Certification, true),
+        Filter("", "", {}, MovieFilters::Certification, false),
+        Filter("", "1995", {}, MovieFilters::Released, true),
+        Filter("", "tt0078748", {}, MovieFilters::ImdbId, true),
+        Filter("", "", {}, MovieFilters::ImdbId, false),
+        Filter("", "", {}, MovieFilters::TmdbId, false),
+        Filter("", "", {}, MovieFilters::Label, true, ColorLabel::Red),
+        Filter("", "1080p", {}, MovieFilters::Quality, true),
+        Filter("", "5.1", {}, MovieFilters::AudioChannels, true),
+        Filter("", "", {}, MovieFilters::Poster, false),
+        Filter("", "", {}, MovieFilters::Watched, true),
+    };
+
+    const auto checkSameResults = [&]() {
+        for (Filter filter : filters) {
+            const Filter::MoviePredicate accepts = filter.compileMovieFilter(model->filterIndex());
+            for (Movie* movie : model->movies()) {
+                CAPTURE(filter.shortText(), movie->name());
+                CHECK(accepts(movie) == filter.accepts(movie));
+            }
+        }
+    };
+
+    SECTION("same results as uncompiled filters")
+    {
+        checkSameResults();
+
+        const Filter horror("", "Horror", {}, MovieFilters::Genres, true);
+        CHECK(horror.compileMovieFilter(model->filterIndex())(alien.get()));
+        const Filter title("", "eat", {}, MovieFilters::Title, true);
+        CHECK_FALSE(title.compileMovieFilter(model->filterIndex())(alien.get()));
+        CHECK(title.compileMovieFilter(model->filterIndex())(heat.get()));
+    }
+
+    SECTION("compiled filters see changes of movies")
+    {
+        const Filter comedy("", "Comedy", {}, MovieFilters::Genres, true);
+        const Filter::MoviePredicate accepts = comedy.compileMovieFilter(model->filterIndex());
+        CHECK_FALSE(accepts(heat.get()));
+
+        heat->addGenre("Comedy");
+        heat->setName("Heat 2");
+        CHECK(accepts(heat.get()));
+        checkSameResults();
+    }
+}
@@ -0,0 +1,39 @@
+#include "test/test_helpers.h"
+
+#include "globals/LocaleSortKey.h"
+
+#include <QStringList>
+
+using namespace mediaelch;
+
+namespace {
+
+int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+} // namespace
+
+TEST_CASE("LocaleSortKey", "[globals]")
+{
+    SECTION("empty strings are sorted first")
+    {
+        CHECK(LocaleSortKey().compare(LocaleSortKey(QString())) == 0);
+        CHECK(LocaleSortKey() < LocaleSortKey("A"));
+        CHECK_FALSE(LocaleSortKey("A") < LocaleSortKey());
+    }
+
+    SECTION("same order as QString::localeAwareCompare")
+    {
+        const QStringList titles{
+            "Alien", "alien", "Aliens", "Zodiac", "Ärger im Paradies", "Batman Begins", "10 Things"};
+        for (const QString& left : titles) {
+            for (const QString& right : titles) {
+                CAPTURE(left, right);
+                CHECK(sign(LocaleSortKey(left).compare(LocaleSortKey(right)))
+                      == sign(QString::localeAwareCompare(left, right)));
+            }
+        }
+    }
+}
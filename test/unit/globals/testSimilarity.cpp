@@ -0,0 +1,74 @@
+#include "test/test_helpers.h"
+
+#include "globals/Helper.h"
+
+#include <random>
+
+namespace {
+
+int referenceEditDistance(const QString& s1, const QString& s2)
+{
+    QVector<QVector<int>> d(s1.length() + 1, QVector<int>(s2.length() + 1));
+    for (int i = 0; i <= s1.length(); ++i) {
+        d[i][0] = i;
+    }
+    for (int j = 0; j <= s2.length(); ++j) {
+        d[0][j] = j;
+    }
+    for (int i = 1; i <= s1.length(); ++i) {
+        for (int j = 1; j <= s2.length(); ++j) {
+            d[i][j] = qMin(qMin(d[i - 1][j] + 1, d[i][j - 1] + 1), d[i - 1][j - 1] + (s1[i - 1] == s2[j - 1] ? 0 : 1));
+        }
+    }
+    return d[s1.length()][s2.length()];
+}
+
+QString randomString(std::mt19937& random, int maxLength)
+{
+    const QString alphabet = QStringLiteral("ab.ä");
+    std::uniform_int_distribution<int> lengthDistribution(1, maxLength);
+    std::uniform_int_distribution<int> charDistribution(0, qsizetype_to_int(alphabet.length()) - 1);
+    QString str;
+    const int length = lengthDistribution(random);
+    for (int i = 0; i < length; ++i) {
+        str.append(alphabet.at(charDistribution(random)));
+    }
+    return str;
+}
+
+} // namespace
+
+TEST_CASE("helper::similarity", "[globals]")
+{
+    SECTION("simple cases")
+    {
+        CHECK(helper::similarity("", "") == Approx(1));
+        CHECK(helper::similarity("Movie", "") == Approx(0));
+        CHECK(helper::similarity("Movie", "Movie") == Approx(1));
+        CHECK(helper::similarity("Movie", "Movies") == Approx(1 - 1 / 6.0));
+        CHECK(helper::similarity("kitten", "sitting") == Approx(1 - 3 / 7.0));
+    }
+
+    SECTION("minimum similarity")
+    {
+        CHECK(helper::similarity("kitten", "sitting", 0.5) == Approx(1 - 3 / 7.0));
+        CHECK(helper::similarity("kitten", "sitting", 0.7) == Approx(0));
+        CHECK(helper::similarity("Movie.2019.1080p", "Movie", 0.7) == Approx(0));
+    }
+
+    SECTION("same results as a full distance matrix")
+    {
+        std::mt19937 random(42);
+        // Strings longer than 64 characters are compared using a different algorithm.
+        for (int maxLength : {20, 100}) {
+            for (int i = 0; i < 500; ++i) {
+                const QString s1 = randomString(random, maxLength);
+                const QString s2 = randomString(random, maxLength);
+                const qreal expected =
+                    1 - referenceEditDistance(s1, s2) / static_cast<qreal>(qMax(s1.length(), s2.length()));
+                CHECK(helper::similarity(s1, s2) == Approx(expected));
+                CHECK(helper::similarity(s1, s2, 0.613) == Approx(expected >= 0.613 ? expected : 0));
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "test/test_helpers.h"
+
+#include "imports/FileTransfer.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+QByteArray testContent()
+{
+    QByteArray content;
+    for (int i = 0; i < 300000; ++i) {
+        content.append(static_cast<char>(i % 251));
+    }
+    return content;
+}
+
+void writeFile(const QString& fileName, const QByteArray& content)
+{
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(content) == content.size());
+}
+
+QByteArray readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+} // namespace
+
+TEST_CASE("FileTransfer", "[imports]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QByteArray content = testContent();
+    const QString source = dir.filePath("source.mkv");
+    const QString destination = dir.filePath("destination.mkv");
+    writeFile(source, content);
+
+    qint64 lastProgress = -1;
+    FileTransfer transfer(source, destination);
+    transfer.setProgressCallback([&](qint64 bytesDone) { lastProgress = bytesDone; });
+
+    SECTION("copies files")
+    {
+        transfer.setVerifyChecksum(true);
+        REQUIRE(transfer.copy());
+        CHECK_FALSE(transfer.wasResumed());
+        CHECK(readFile(destination) == content);
+        CHECK(QFile::exists(source));
+        CHECK_FALSE(QFile::exists(FileTransfer::partFileName(destination)));
+        CHECK(lastProgress == content.size());
+    }
+
+    SECTION("does not overwrite existing files")
+    {
+        writeFile(destination, "existing");
+        CHECK_FALSE(transfer.copy());
+        CHECK_FALSE(transfer.move());
+        CHECK(readFile(destination) == "existing");
+        CHECK(QFile::exists(source));
+    }
+
+    SECTION("resumes partial copies")
+    {
+        writeFile(FileTransfer::partFileName(destination), content.left(100000));
+        REQUIRE(transfer.copy());
+        CHECK(transfer.wasResumed());
+        CHECK(readFile(destination) == content);
+        CHECK(lastProgress == content.size());
+    }
+
+    SECTION("copies again if a partial copy differs from the source")
+    {
+        writeFile(FileTransfer::partFileName(destination), QByteArray(100000, 'x'));
+        REQUIRE(transfer.copy());
+        CHECK(readFile(destination) == content);
+        CHECK_FALSE(QFile::exists(FileTransfer::partFileName(destination)));
+    }
+
+    SECTION("moves files")
+    {
+        REQUIRE(transfer.move());
+        CHECK(readFile(destination) == content);
+        CHECK_FALSE(QFile::exists(source));
+        CHECK(lastProgress == content.size());
+    }
+}
@@ -4,10 +4,13 @@
 #include "globals/Meta.h"
 
 #include <QApplication>
+#include <QStandardPaths>
 
 int main(int argc, char** argv)
 {
     QApplication app(argc, argv);
+    // Tests that use Manager must never touch the user's database or caches.
+    QStandardPaths::setTestModeEnabled(true);
     registerAllMetaTypes();
     Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
     const int res = session.run(argc, argv);
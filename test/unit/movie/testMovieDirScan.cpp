@@ -0,0 +1,72 @@
+#include "test/test_helpers.h"
+
+#include "movies/file_searcher/MovieDirScan.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+static void createFile(const QString& path)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+static QVector<QStringList> scanDir(const QString& path, bool separateFolders, bool firstScan)
+{
+    QVector<QStringList> contents;
+    mediaelch::MovieDirScan scanner;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_DEPRECATED
+    scanner.scanDir(path, path, contents, separateFolders, firstScan);
+    QT_WARNING_POP
+    return contents;
+}
+
+TEST_CASE("MovieDirScan groups movie files", "[movie]")
+{
+    QTemporaryDir tmp;
+    REQUIRE(tmp.isValid());
+    const QString root = tmp.path();
+    const auto native = [&root](const QString& relative) { return QDir::toNativeSeparators(root + "/" + relative); };
+
+    createFile(root + "/Movie A/Movie A.mkv");
+    createFile(root + "/Movie A/Movie A-trailer.mkv");
+    createFile(root + "/Movie A/Extras/Bonus.mkv");
+    createFile(root + "/Movie B/Film cd1.avi");
+    createFile(root + "/Movie B/Film cd2.avi");
+    createFile(root + "/Movie B/Nested/Movie C.mp4");
+    createFile(root + "/DVD Movie/VIDEO_TS/VIDEO_TS.IFO");
+    createFile(root + "/BluRay Movie/BDMV/index.bdmv");
+    createFile(root + "/BluRay Movie/BDMV/STREAM/00001.m2ts");
+    createFile(root + "/Movie D.mkv");
+    createFile(root + "/readme.txt");
+
+    SECTION("movies in subdirectories are found recursively")
+    {
+        const QVector<QStringList> contents = scanDir(root, false, true);
+        const QVector<QStringList> expected{
+            {native("BluRay Movie/BDMV/index.bdmv")},
+            {native("DVD Movie/VIDEO_TS/VIDEO_TS.IFO")},
+            {native("Movie A/Movie A.mkv")},
+            {native("Movie B/Nested/Movie C.mp4")},
+            {native("Movie B/Film cd1.avi"), native("Movie B/Film cd2.avi")},
+            {native("Movie D.mkv")},
+        };
+        CHECK(contents == expected);
+    }
+
+    SECTION("separate folders only scan direct subdirectories")
+    {
+        const QVector<QStringList> contents = scanDir(root, true, true);
+        const QVector<QStringList> expected{
+            {native("BluRay Movie/BDMV/index.bdmv")},
+            {native("DVD Movie/VIDEO_TS/VIDEO_TS.IFO")},
+            {native("Movie A/Movie A.mkv")},
+            {native("Movie B/Film cd1.avi"), native("Movie B/Film cd2.avi")},
+            {native("Movie D.mkv")},
+        };
+        CHECK(contents == expected);
+    }
+}
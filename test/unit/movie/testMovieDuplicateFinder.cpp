@@ -0,0 +1,100 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "movies/MovieDuplicateFinder.h"
+
+using namespace mediaelch;
+
+namespace {
+
+MovieDuplicateFinder::Candidate makeCandidate(Movie& movie, QString title, QString imdbId = {}, QString tmdbId = {})
+{
+    MovieDuplicateFinder::Candidate candidate;
+    candidate.movie = &movie;
+    candidate.title = std::move(title);
+    candidate.imdbId = std::move(imdbId);
+    candidate.tmdbId = std::move(tmdbId);
+    return candidate;
+}
+
+} // namespace
+
+TEST_CASE("MovieDuplicateFinder normalizes titles", "[movie]")
+{
+    CHECK(MovieDuplicateFinder::normalizedTitle("Alien") == "alien");
+    CHECK(MovieDuplicateFinder::normalizedTitle("  Star Wars: Episode IV - A New Hope ")
+          == "star wars episode iv a new hope");
+    CHECK(MovieDuplicateFinder::normalizedTitle("...").isEmpty());
+}
+
+TEST_CASE("MovieDuplicateFinder finds duplicates", "[movie]")
+{
+    Movie a;
+    Movie b;
+    Movie c;
+    Movie d;
+    Movie e;
+
+    SECTION("same groups as a pairwise comparison")
+    {
+        a.setName("Alien");
+        a.setImdbId(ImdbId("tt0078748"));
+        b.setName("Alien (Director's Cut)");
+        b.setImdbId(ImdbId("tt0078748"));
+        c.setName("Alien");
+        d.setName("Aliens");
+        d.setTmdbId(TmdbId("679"));
+        e.setName("Aliens - Extended");
+        e.setTmdbId(TmdbId("679"));
+
+        const QVector<Movie*> movies{&a, &b, &c, &d, &e};
+        QVector<MovieDuplicateFinder::Candidate> candidates;
+        for (Movie* movie : movies) {
+            candidates.append(MovieDuplicateFinder::candidate(movie));
+        }
+        const auto duplicates = MovieDuplicateFinder::findDuplicates(candidates, false);
+
+        for (Movie* movie : movies) {
+            QVector<Movie*> expected{movie};
+            for (Movie* other : movies) {
+                if (movie != other && other->isDuplicate(movie)) {
+                    expected.append(other);
+                }
+            }
+            if (expected.size() > 1) {
+                CHECK(duplicates.value(movie) == expected);
+            } else {
+                CHECK_FALSE(duplicates.contains(movie));
+            }
+        }
+        CHECK(duplicates.value(&a) == QVector<Movie*>{&a, &b, &c});
+        CHECK(duplicates.value(&c) == QVector<Movie*>{&c, &a});
+        CHECK(duplicates.value(&e) == QVector<Movie*>{&e, &d});
+    }
+
+    SECTION("invalid ids and empty titles are ignored")
+    {
+        const QVector<MovieDuplicateFinder::Candidate> candidates{
+            makeCandidate(a, ""), makeCandidate(b, ""), makeCandidate(c, "Up")};
+        CHECK(MovieDuplicateFinder::findDuplicates(candidates, true).isEmpty());
+    }
+
+    SECTION("similar titles are only found if requested")
+    {
+        const QVector<MovieDuplicateFinder::Candidate> candidates{makeCandidate(a, "The Lord of the Rings"),
+            makeCandidate(b, "the lord of the rings."),
+            makeCandidate(c, "The Lord of the Rings: The Two Towers"),
+            makeCandidate(d, "Rocky 2"),
+            makeCandidate(e, "Rocky 3")};
+
+        CHECK(MovieDuplicateFinder::findDuplicates(candidates, false).isEmpty());
+
+        int lastProgress = 0;
+        const auto duplicates = MovieDuplicateFinder::findDuplicates(
+            candidates, true, [&lastProgress](int processed, int /*total*/) { lastProgress = processed; });
+        CHECK(duplicates.size() == 2);
+        CHECK(duplicates.value(&a) == QVector<Movie*>{&a, &b});
+        CHECK(duplicates.value(&b) == QVector<Movie*>{&b, &a});
+        CHECK(lastProgress == 10);
+    }
+}
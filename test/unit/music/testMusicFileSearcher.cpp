@@ -0,0 +1,88 @@
+#include "test/test_helpers.h"
+
+#include "globals/Manager.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "music/MusicFileSearcher.h"
+#include "music/MusicModel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <algorithm>
+
+static void createFile(const QTemporaryDir& dir, const QString& fileName)
+{
+    const QString path = dir.filePath(fileName);
+    REQUIRE(QDir().mkpath(QFileInfo(path).absolutePath()));
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+/// \brief "Artist: Album 1, Album 2" strings of all artists in the model, sorted.
+static QStringList loadedArtists()
+{
+    QStringList artists;
+    for (const Artist* artist : Manager::instance()->musicModel()->artists()) {
+        QStringList albums;
+        for (const Album* album : artist->albums()) {
+            albums << album->title();
+        }
+        albums.sort();
+        artists << QStringLiteral("%1: %2").arg(artist->name(), albums.join(", "));
+    }
+    artists.sort();
+    return artists;
+}
+
+TEST_CASE("MusicFileSearcher loads artists and albums", "[music][file_searcher]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    createFile(dir, "Artist A/Album 1/01 Song.mp3");
+    createFile(dir, "Artist A/Album 2/01 Song.flac");
+    createFile(dir, "Artist A/extrafanart/fanart1.jpg");
+    createFile(dir, "Artist B/Album 3/01 Song.mp3");
+
+    SettingsDir settingsDir;
+    settingsDir.path = QDir(dir.path());
+
+    MusicFileSearcher* searcher = Manager::instance()->musicFileSearcher();
+    searcher->setMusicDirectories({settingsDir});
+    // Loads all artists from disk and stores them in the database.
+    searcher->reload(true);
+
+    const QStringList expected{"Artist A: Album 1, Album 2", "Artist B: Album 3"};
+    CHECK(loadedArtists() == expected);
+
+    SECTION("artists are loaded from the database")
+    {
+        searcher->reload(false);
+        CHECK(loadedArtists() == expected);
+    }
+
+    SECTION("aborting deletes all artists that were not added to the model")
+    {
+        const auto artistCount = [searcher]() {
+            return searcher->findChildren<Artist*>(QString(), Qt::FindDirectChildrenOnly).size();
+        };
+        const auto countBefore = artistCount();
+
+        const QMetaObject::Connection connection =
+            QObject::connect(searcher, &MusicFileSearcher::searchStarted, searcher, [searcher](QString message) {
+                // Abort once the artists from the database are loaded.
+                if (message == "Loading Music...") {
+                    searcher->abort();
+                }
+            });
+        searcher->reload(false);
+        QObject::disconnect(connection);
+
+        CHECK(loadedArtists().isEmpty());
+        CHECK(artistCount() == countBefore);
+    }
+
+    searcher->setMusicDirectories({});
+    Manager::instance()->musicModel()->clear();
+}
@@ -0,0 +1,99 @@
+#include "test/test_helpers.h"
+
+#include "network/WebsiteCache.h"
+
+#include <QDirIterator>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+using namespace mediaelch::scraper;
+
+TEST_CASE("WebsiteCache stores elements", "[network]")
+{
+    const QUrl url("https://example.com/api/movie/1");
+    const Locale german("de-DE");
+
+    SECTION("in memory")
+    {
+        WebsiteCache::setupPersistentCache({}, WebsiteCache::timeoutSeconds, 0);
+        WebsiteCache cache;
+
+        CHECK_FALSE(cache.hasValidElement(url, Locale::English));
+        cache.addElement(url, Locale::English, "english");
+        cache.addElement(url, german, "german");
+
+        CHECK(cache.hasValidElement(url, Locale::English));
+        CHECK(cache.getElement(url, Locale::English) == "english");
+        CHECK(cache.getElement(url, german) == "german");
+        // All instances share the same elements.
+        CHECK(WebsiteCache().getElement(url, german) == "german");
+
+        WebsiteCache::clear();
+        CHECK_FALSE(cache.hasValidElement(url, Locale::English));
+    }
+
+    SECTION("on disk")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1024 * 1024);
+        WebsiteCache().addElement(url, german, "german");
+
+        // Setting up the cache again drops all elements in memory.
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1024 * 1024);
+        CHECK(WebsiteCache().hasValidElement(url, german));
+        CHECK(WebsiteCache().getElement(url, german) == "german");
+        CHECK_FALSE(WebsiteCache().hasValidElement(url, Locale::English));
+
+        WebsiteCache::clear();
+        WebsiteCache::setupPersistentCache({}, WebsiteCache::timeoutSeconds, 0);
+    }
+
+    SECTION("least recently used elements are removed if the cache is full")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        // Each element is larger than a third of the cache.
+        const QString data(200, 'x');
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1000);
+        WebsiteCache cache;
+        cache.addElement(QUrl("https://example.com/1"), german, data);
+        cache.addElement(QUrl("https://example.com/2"), german, data);
+        cache.addElement(QUrl("https://example.com/3"), german, data);
+
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1000);
+        CHECK_FALSE(cache.hasValidElement(QUrl("https://example.com/1"), german));
+        CHECK(cache.hasValidElement(QUrl("https://example.com/3"), german));
+
+        WebsiteCache::clear();
+        WebsiteCache::setupPersistentCache({}, WebsiteCache::timeoutSeconds, 0);
+    }
+
+    SECTION("corrupt files are removed")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1024 * 1024);
+        WebsiteCache().addElement(url, german, "german");
+
+        QDirIterator it(dir.path(), {"*.cache"}, QDir::Files, QDirIterator::Subdirectories);
+        REQUIRE(it.hasNext());
+        const QString file = it.next();
+        {
+            QFile corrupt(file);
+            REQUIRE(corrupt.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            corrupt.write("not a cache file");
+        }
+
+        WebsiteCache::setupPersistentCache(dir.path(), 60, 1024 * 1024);
+        CHECK_FALSE(WebsiteCache().hasValidElement(url, german));
+        CHECK_FALSE(QFile::exists(file));
+
+        WebsiteCache::clear();
+        WebsiteCache::setupPersistentCache({}, WebsiteCache::timeoutSeconds, 0);
+    }
+}
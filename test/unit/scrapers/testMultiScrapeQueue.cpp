@@ -0,0 +1,117 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/MultiScrapeQueue.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+using namespace mediaelch::scraper;
+
+namespace {
+
+/// \brief Process events until the queue is done, finishing all running items in each iteration.
+void runQueue(MultiScrapeQueue& queue)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (queue.isRunning() && timer.elapsed() < 10000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        for (int index : queue.runningItems()) {
+            queue.finishItem(index);
+        }
+    }
+    REQUIRE_FALSE(queue.isRunning());
+}
+
+} // namespace
+
+TEST_CASE("MultiScrapeQueue", "[scraper][multi]")
+{
+    MultiScrapeQueue queue;
+    QVector<int> started;
+    int maxRunning = 0;
+    int finishedSignals = 0;
+    QObject::connect(&queue, &MultiScrapeQueue::sigStartItem, [&](int index) {
+        started << index;
+        maxRunning = qMax(maxRunning, static_cast<int>(queue.runningItems().size()));
+    });
+    QObject::connect(&queue, &MultiScrapeQueue::sigFinished, [&]() { ++finishedSignals; });
+
+    SECTION("all items are started in order without exceeding the limit")
+    {
+        queue.setLimits({2, 0});
+        queue.start(5);
+        CHECK(started.isEmpty()); // items are started from the event loop
+        runQueue(queue);
+        CHECK(started == QVector<int>{0, 1, 2, 3, 4});
+        CHECK(maxRunning == 2);
+        CHECK(queue.finishedCount() == 5);
+        CHECK(finishedSignals == 1);
+    }
+
+    SECTION("items can be finished right away")
+    {
+        QObject::connect(&queue, &MultiScrapeQueue::sigStartItem, [&](int index) { queue.finishItem(index); });
+        queue.start(1000);
+        runQueue(queue);
+        CHECK(started.size() == 1000);
+        CHECK(queue.finishedCount() == 1000);
+        CHECK(finishedSignals == 1);
+    }
+
+    SECTION("unknown items can't be finished")
+    {
+        queue.start(1);
+        CHECK_FALSE(queue.finishItem(0));
+        runQueue(queue);
+        CHECK_FALSE(queue.finishItem(0));
+        CHECK(queue.finishedCount() == 1);
+    }
+
+    SECTION("empty queues finish immediately")
+    {
+        queue.start(0);
+        runQueue(queue);
+        CHECK(started.isEmpty());
+        CHECK(finishedSignals == 1);
+    }
+
+    SECTION("aborted queues don't start further items")
+    {
+        queue.setLimits({2, 0});
+        queue.start(5);
+        QElapsedTimer timer;
+        timer.start();
+        while (started.size() < 2 && timer.elapsed() < 10000) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        REQUIRE(started.size() == 2);
+        queue.abort();
+        CHECK(queue.runningItems().isEmpty());
+        CHECK_FALSE(queue.finishItem(0));
+        QCoreApplication::processEvents();
+        CHECK(started.size() == 2);
+        CHECK(finishedSignals == 0);
+    }
+
+    SECTION("items are started with a minimum interval")
+    {
+        queue.setLimits({3, 50});
+        QElapsedTimer timer;
+        timer.start();
+        queue.start(3);
+        runQueue(queue);
+        CHECK(started.size() == 3);
+        CHECK(timer.elapsed() >= 100);
+    }
+}
+
+TEST_CASE("ScrapeLimits", "[scraper][multi]")
+{
+    CHECK(ScrapeLimits::forScraper(TmdbMovie::ID).maxInFlight > 1);
+    CHECK(ScrapeLimits::forScraper(ImdbMovie::ID).maxInFlight > 1);
+    CHECK(ScrapeLimits::forScraper("unknown").maxInFlight == 1);
+    CHECK(ScrapeLimits::sequential().maxInFlight == 1);
+}
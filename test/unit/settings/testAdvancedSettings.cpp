@@ -140,6 +140,90 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         }
     }
 
+    SECTION("library watcher")
+    {
+        QString xml = addBaseXml(R"xml(
+            <libraryWatcher>
+                <enabled>true</enabled>
+                <maxDirectories>20000</maxDirectories>
+                <delay>0</delay>
+            </libraryWatcher>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+        const auto settings = pair.first;
+        const auto messages = pair.second;
+
+        CHECK(settings.libraryWatcherEnabled());
+        CHECK(settings.libraryWatcherMaxDirectories() == 20000);
+        CHECK(settings.libraryWatcherDelay() == AdvancedSettings().libraryWatcherDelay());
+        REQUIRE(messages.size() == 1);
+        CHECK(messages[0].tag == "delay");
+        CHECK(messages[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+    }
+
+    SECTION("image cache size")
+    {
+        QString xml = addBaseXml(R"xml(
+            <gui>
+                <forceCache>true</forceCache>
+                <imageCacheMaxSize>1000</imageCacheMaxSize>
+            </gui>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+        CHECK(pair.first.forceCache());
+        CHECK(pair.first.imageCacheMaxSize() == 1000);
+        CHECK(pair.second.isEmpty());
+    }
+
+    SECTION("stream details workers")
+    {
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(
+            addBaseXml("<streamDetailsWorkers>8</streamDetailsWorkers>"));
+        CHECK(pair.first.streamDetailsWorkers() == 8);
+        CHECK(pair.second.isEmpty());
+
+        const auto invalid = AdvancedSettingsXmlReader::loadFromXml(
+            addBaseXml("<streamDetailsWorkers>0</streamDetailsWorkers>"));
+        CHECK(invalid.first.streamDetailsWorkers() == AdvancedSettings().streamDetailsWorkers());
+        REQUIRE(invalid.second.size() == 1);
+        CHECK(invalid.second[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+    }
+
+    SECTION("verify imported files")
+    {
+        CHECK_FALSE(AdvancedSettings().verifyImportedFiles());
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(
+            addBaseXml("<verifyImportedFiles>true</verifyImportedFiles>"));
+        CHECK(pair.first.verifyImportedFiles());
+        CHECK(pair.second.isEmpty());
+    }
+
+    SECTION("website cache")
+    {
+        QString xml = addBaseXml(R"xml(
+            <websiteCache>
+                <enabled>true</enabled>
+                <timeout>48</timeout>
+                <maxSize>-1</maxSize>
+            </websiteCache>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+        const auto settings = pair.first;
+        const auto messages = pair.second;
+
+        // Disabled by default, i.e. responses are only kept in memory for WebsiteCache::timeoutSeconds.
+        CHECK_FALSE(AdvancedSettings().websiteCacheEnabled());
+        CHECK(settings.websiteCacheEnabled());
+        CHECK(settings.websiteCacheTimeout() == 48);
+        CHECK(settings.websiteCacheMaxSize() == AdvancedSettings().websiteCacheMaxSize());
+        REQUIRE(messages.size() == 1);
+        CHECK(messages[0].tag == "maxSize");
+        CHECK(messages[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+    }
+
     SECTION("read attributes correctly")
     {
         QString xml = addBaseXml(R"xml(
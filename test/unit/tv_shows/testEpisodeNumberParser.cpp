@@ -0,0 +1,100 @@
+#include "test/test_helpers.h"
+
+#include "tv_shows/EpisodeNumberParser.h"
+
+#include <QElapsedTimer>
+
+using namespace mediaelch;
+
+TEST_CASE("EpisodeNumberParser", "[show][utils]")
+{
+    EpisodeNumberParser parser;
+
+    SECTION("season and episodes are parsed together")
+    {
+        const EpisodeFileNumbers numbers = parser.parse({"dir/Show.S02E03E04.720p.mkv"});
+        CHECK(numbers.season == SeasonNumber(2));
+        CHECK(numbers.episodes == QVector<EpisodeNumber>{EpisodeNumber(3), EpisodeNumber(4)});
+
+        const EpisodeFileNumbers xNumbers = parser.parse({"dir/Show - 3x12 - Title.avi"});
+        CHECK(xNumbers.season == SeasonNumber(3));
+        CHECK(xNumbers.episodes == QVector<EpisodeNumber>{EpisodeNumber(12)});
+    }
+
+    SECTION("files without numbers")
+    {
+        CHECK(parser.parse({}).season == SeasonNumber::NoSeason);
+        CHECK(parser.parse({}).episodes.isEmpty());
+
+        const EpisodeFileNumbers numbers = parser.parse({"dir/Pilot.mkv"});
+        CHECK(numbers.season == SeasonNumber::SpecialsSeason);
+        CHECK(numbers.episodes.isEmpty());
+    }
+
+    SECTION("results are cached by file name")
+    {
+        CHECK(parser.cacheSize() == 0);
+        const EpisodeFileNumbers first = parser.parse({"dir/Show.S01E01.mkv"});
+        // Same file name in another directory
+        const EpisodeFileNumbers second = parser.parse({"other/Show.S01E01.mkv"});
+        CHECK(parser.cacheSize() == 1);
+        CHECK(first.season == second.season);
+        CHECK(first.episodes == second.episodes);
+
+        parser.clearCache();
+        CHECK(parser.cacheSize() == 0);
+    }
+
+    SECTION("least recently used file names are removed from a full cache")
+    {
+        EpisodeNumberParser smallParser(2);
+        smallParser.parse({"dir/Show.S01E01.mkv"});
+        smallParser.parse({"dir/Show.S01E02.mkv"});
+        smallParser.parse({"dir/Show.S01E01.mkv"});
+        smallParser.parse({"dir/Show.S01E03.mkv"});
+        CHECK(smallParser.cacheSize() == 2);
+        CHECK(smallParser.parse({"dir/Show.S01E01.mkv"}).episodes == QVector<EpisodeNumber>{EpisodeNumber(1)});
+        CHECK(smallParser.parse({"dir/Show.S01E02.mkv"}).episodes == QVector<EpisodeNumber>{EpisodeNumber(2)});
+        CHECK(smallParser.cacheSize() == 2);
+    }
+
+    SECTION("ambiguous matches are ignored")
+    {
+        const EpisodeFileNumbers numbers = parser.parse({"dir/21x04 - Hammond vs. 6x6.mp4"});
+        CHECK(numbers.season == SeasonNumber(21));
+        CHECK(numbers.episodes == QVector<EpisodeNumber>{EpisodeNumber(4)});
+    }
+}
+
+TEST_CASE("EpisodeNumberParser benchmark", "[show][.benchmark]")
+{
+    // Not run by default. Run with: mediaelch_unit "[benchmark]"
+    QStringList files;
+    files.reserve(1000000);
+    for (int i = 0; i < 250000; ++i) {
+        const int season = i % 30 + 1;
+        const int episode = i % 24 + 1;
+        const QString show = QStringLiteral("dir/Some Show %1/").arg(i / 100);
+        files << show + QStringLiteral("Some.Show.S%1E%2.720p.HDTV.x264.mkv").arg(season).arg(episode)
+              << show + QStringLiteral("Some Show - %1x%2 - Episode %3.avi").arg(season).arg(episode).arg(i)
+              << show + QStringLiteral("some.show.%1%2.hdtv.mp4").arg(season).arg(episode, 2, 10, QChar('0'))
+              << show + QStringLiteral("Some Show Season %1 Episode %2.mkv").arg(season).arg(episode);
+    }
+
+    EpisodeNumberParser parser;
+    QElapsedTimer timer;
+    timer.start();
+    int episodes = 0;
+    for (const QString& file : asConst(files)) {
+        episodes += qsizetype_to_int(parser.parse({file}).episodes.size());
+    }
+    const qint64 parseTime = timer.restart();
+    for (const QString& file : asConst(files)) {
+        episodes += qsizetype_to_int(parser.parse({file}).episodes.size());
+    }
+    const qint64 cachedTime = timer.elapsed();
+
+    WARN("EpisodeNumberParser: " << parseTime << "ms, again: " << cachedTime << "ms for " << files.size()
+                                 << " files");
+    CHECK(episodes >= 2 * files.size());
+}
@@ -1,6 +1,15 @@
 #include "test/test_helpers.h"
 
+#include "globals/Manager.h"
+#include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowFileSearcher.h"
+#include "tv_shows/TvShowModel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <algorithm>
 
 static EpisodeNumber getEpisodeNumber(QString filename)
 {
@@ -18,6 +27,26 @@ static QVector<EpisodeNumber> getEpisodeNumbers(QString filename)
     return numbers;
 }
 
+static void createFile(const QTemporaryDir& dir, const QString& fileName)
+{
+    const QString path = dir.filePath(fileName);
+    REQUIRE(QDir().mkpath(QFileInfo(path).absolutePath()));
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+/// \brief "S01E02" strings of all episodes of the show, sorted.
+static QStringList episodeNames(const TvShow& show)
+{
+    QStringList names;
+    for (const TvShowEpisode* episode : show.episodes()) {
+        names << QStringLiteral("S%1E%2").arg(
+            episode->seasonNumber().toPaddedString(), episode->episodeNumber().toPaddedString());
+    }
+    names.sort();
+    return names;
+}
+
 static QVector<EpisodeNumber> episodeList(QVector<int> episodes)
 {
     QVector<EpisodeNumber> list;
@@ -75,3 +104,50 @@ TEST_CASE("TvShowFileSearcher parses season and episode data", "[show][utils]")
         CHECK(getEpisodeNumbers("Oz/Oz.S01E01E02.Emerald City (720p)") == episodeList({1, 2}));
     }
 }
+
+TEST_CASE("TvShowFileSearcher loads shows and episodes from disk", "[show][file_searcher]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    createFile(dir, "Show A/Season 1/Show.A.S01E01.mkv");
+    createFile(dir, "Show A/Season 1/Show.A.S01E02.mkv");
+    createFile(dir, "Show A/Extras/Show.A.S01E03.mkv");
+    createFile(dir, "Show A/Season 1/notes.txt");
+    createFile(dir, "Show B/Show.B.S02E05E06.mkv");
+    createFile(dir, "Show B/Season 3/Show.B.S03E01.avi");
+    REQUIRE(QDir().mkpath(dir.filePath("Empty Show")));
+
+    SettingsDir settingsDir;
+    settingsDir.path = QDir(dir.path());
+    // Loaded from disk only; shows of this directory are never read from the database.
+    settingsDir.autoReload = true;
+
+    TvShowFileSearcher* searcher = Manager::instance()->tvShowFileSearcher();
+    TvShowModel* model = Manager::instance()->tvShowModel();
+    searcher->setTvShowDirectories({settingsDir});
+    searcher->reload(false);
+
+    QVector<TvShow*> shows = model->tvShows();
+    std::sort(shows.begin(), shows.end(), [](const TvShow* lhs, const TvShow* rhs) {
+        return lhs->dir().dirName() < rhs->dir().dirName();
+    });
+    REQUIRE(shows.size() == 3);
+
+    CHECK(shows[0]->dir().dirName() == "Empty Show");
+    CHECK(shows[0]->episodes().isEmpty());
+
+    CHECK(shows[1]->dir().dirName() == "Show A");
+    CHECK(episodeNames(*shows[1]) == QStringList({"S01E01", "S01E02"}));
+
+    CHECK(shows[2]->dir().dirName() == "Show B");
+    CHECK(episodeNames(*shows[2]) == QStringList({"S02E05", "S02E06", "S03E01"}));
+
+    SECTION("reloading does not duplicate shows")
+    {
+        searcher->reload(false);
+        CHECK(model->tvShows().size() == 3);
+    }
+
+    searcher->setTvShowDirectories({});
+    model->clear();
+}